@@ -0,0 +1,198 @@
+// bufbench.cpp
+//
+// Throughput vs. buffer memory for fixed and auto-tuned socket buffers.
+//
+// A number of TCP connections stream bulk data over the loopback at the
+// same time. This is run with:
+//   - small:  fixed 64K buffers, set with SO_SNDBUF and SO_RCVBUF.
+//   - large:  fixed 4M buffers.
+//   - kernel: the kernel's own auto-tuning (nothing set).
+//   - tuner:  the buffer_tuner, within the memory budget.
+// For each, it reports the total throughput, and the peak of the total
+// buffer sizes, as reported by the kernel, sampled as it runs.
+//
+// The loopback RTT is only tens of microseconds, so its BDP is tiny. To see
+// how the sizes follow a longer path, add a delay to the loopback first,
+// e.g.:
+//     tc qdisc add dev lo root netem delay 5ms
+//
+// USAGE:
+//     bufbench [nconn [secs [budget_mb]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/buffer_tuner.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t nconn = 8;
+static double secs = 2.0;
+static size_t budget = 32*1024*1024;
+
+static const size_t BUF_SIZE = 256*1024;
+
+// --------------------------------------------------------------------------
+
+struct conn
+{
+	sockpp::tcp_connector tx;
+	sockpp::tcp_socket rx;
+	uint64_t nrecv = 0;
+
+	explicit conn(sockpp::tcp_acceptor& acc) : tx(acc.address()), rx(acc.accept()) {}
+};
+
+static int get_buf(sockpp::socket& sock, int opt)
+{
+	int val = 0;
+	socklen_t len = sizeof(int);
+	sock.get_option(SOL_SOCKET, opt, &val, &len);
+	return val;
+}
+
+static void set_buf(sockpp::socket& sock, int opt, int val)
+{
+	sock.set_option(SOL_SOCKET, opt, &val, sizeof(int));
+}
+
+// The setup function is called on each new connection.
+
+template <typename SetupFunc>
+static void run(const char* name, SetupFunc&& setup, sockpp::buffer_tuner* tuner=nullptr)
+{
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	vector<unique_ptr<conn>> conns;
+
+	for (size_t i=0; i<nconn; ++i) {
+		conns.emplace_back(new conn(acc));
+		setup(*conns.back());
+	}
+
+	auto stop = steady_clock::now() + duration_cast<nanoseconds>(duration<double>(secs));
+	vector<thread> thrs;
+
+	for (auto& c : conns) {
+		conn* pc = c.get();
+		thrs.emplace_back([pc, stop] {
+			vector<char> buf(BUF_SIZE, 'x');
+			while (steady_clock::now() < stop && pc->tx.write(buf.data(), buf.size()) > 0)
+				;
+			pc->tx.shutdown(SHUT_WR);
+		});
+		thrs.emplace_back([pc] {
+			vector<char> buf(BUF_SIZE);
+			ssize_t n;
+			while ((n = pc->rx.read(buf.data(), buf.size())) > 0)
+				pc->nrecv += n;
+		});
+	}
+
+	size_t peak = 0;
+	while (steady_clock::now() < stop) {
+		this_thread::sleep_for(milliseconds(100));
+		if (tuner)
+			tuner->tune();
+
+		size_t mem = 0;
+		for (auto& c : conns)
+			mem += get_buf(c->tx, SO_SNDBUF) + get_buf(c->tx, SO_RCVBUF)
+				+ get_buf(c->rx, SO_SNDBUF) + get_buf(c->rx, SO_RCVBUF);
+		peak = max(peak, mem);
+	}
+
+	for (auto& thr : thrs)
+		thr.join();
+
+	uint64_t total = 0;
+	for (auto& c : conns) {
+		total += c->nrecv;
+		if (tuner) {
+			tuner->remove(c->tx);
+			tuner->remove(c->rx);
+		}
+	}
+
+	cout << setw(8) << name << setw(14) << (total / secs / 1.0e6)
+		<< setw(14) << (peak / 1048576.0) << endl;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) nconn = size_t(atoi(argv[1]));
+	if (argc > 2) secs = atof(argv[2]);
+	if (argc > 3) budget = size_t(atof(argv[3]) * 1048576);
+
+	sockpp::socket_initializer sockInit;
+
+	cout << nconn << " connections for " << secs << " s, tuner budget "
+		<< (budget / 1048576.0) << " MB\n" << endl;
+
+	cout << setw(8) << "buffers" << setw(14) << "MB/s" << setw(14) << "peak mem (MB)"
+		<< endl;
+	cout << fixed << setprecision(1);
+
+	auto fixed_size = [](int sz) {
+		return [sz](conn& c) {
+			set_buf(c.tx, SO_SNDBUF, sz/2);
+			set_buf(c.tx, SO_RCVBUF, sz/2);
+			set_buf(c.rx, SO_SNDBUF, sz/2);
+			set_buf(c.rx, SO_RCVBUF, sz/2);
+		};
+	};
+
+	run("small", fixed_size(64*1024));
+	run("large", fixed_size(4*1024*1024));
+	run("kernel", [](conn&) {});
+
+	sockpp::buffer_tuner tuner(budget);
+	run("tuner", [&tuner](conn& c) {
+		tuner.add(c.tx);
+		tuner.add(c.rx);
+	}, &tuner);
+
+	return 0;
+}
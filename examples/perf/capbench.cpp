@@ -0,0 +1,222 @@
+// capbench.cpp
+//
+// Packet capture rate, with and without a memory-mapped receive ring.
+//
+// A burst of UDP datagrams is blasted over the loopback, in batches with
+// sendmmsg(), while a packet socket on the loopback captures them with:
+//   - recvfrom:  one system call, and one copy, for each packet.
+//   - ring:      a TPACKET_V3 ring, reading each block of packets in place.
+// The capture rate is what was captured, over the time from the first
+// packet to the last. The drops are the packets that the kernel had no room
+// for, as reported by the socket.
+//
+// Capturing packets requires CAP_NET_RAW.
+//
+// USAGE:
+//     capbench [npkt] [pkt_size]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include "sockpp/datagram_socket.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/packet_socket.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t npkt = 500000;
+static size_t pktSize = 64;
+
+// The capture buffer, for both modes: the ring, or the socket buffer.
+static const size_t BLOCK_SIZE = 1 << 18;
+static const unsigned NUM_BLOCKS = 16;
+
+// --------------------------------------------------------------------------
+
+struct result {
+	size_t ncap;
+	unsigned drops;
+	double secs;
+};
+
+// Sends the packets in batches, as fast as possible.
+
+static void blast(sockpp::datagram_socket& sock)
+{
+	const size_t BATCH = 64;
+	vector<char> buf(pktSize, 'x');
+	vector<iovec> iov(BATCH, iovec{ buf.data(), pktSize });
+	vector<mmsghdr> msgs(BATCH);
+
+	for (size_t i=0; i<BATCH; ++i) {
+		msgs[i] = mmsghdr{};
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	for (size_t sent=0; sent<npkt; ) {
+		unsigned n = unsigned(min(BATCH, npkt - sent));
+		int ret = sock.sendmmsg(msgs.data(), n);
+		if (ret < 0) {
+			if (sock.last_error() == ENOBUFS || sock.last_error() == EAGAIN)
+				continue;
+			cerr << "Send error: " << sock.last_error_str() << endl;
+			return;
+		}
+		sent += size_t(ret);
+	}
+}
+
+// Captures until the traffic has been quiet for a while. Each packet's
+// first byte is read, so that both modes touch the data.
+
+template <typename CaptureFunc>
+static result run(CaptureFunc&& capture, bool useRing)
+{
+	sockpp::packet_socket cap(sockpp::link_address("lo", ETH_P_IP), SOCK_DGRAM);
+	if (!cap) {
+		cerr << "Can't open the packet socket: " << cap.last_error_str() << endl;
+		exit(1);
+	}
+
+	if (useRing) {
+		if (!cap.setup_rx_ring(BLOCK_SIZE, NUM_BLOCKS, 2048, milliseconds(10))) {
+			cerr << "Can't set up the ring: " << cap.last_error_str() << endl;
+			exit(1);
+		}
+	}
+	else {
+		int bufSize = int(BLOCK_SIZE * NUM_BLOCKS);
+		cap.set_option(SOL_SOCKET, SO_RCVBUFFORCE, &bufSize, sizeof(int));
+	}
+
+	sockpp::inet_address localhost("localhost", 0);
+	sockpp::sock_address addr(localhost.sockaddr_ptr(), localhost.size());
+
+	sockpp::datagram_socket tx, rx;
+	rx.bind(addr);
+	tx.connect(rx.address());
+
+	sockpp::packet_stats st;
+	cap.get_stats(st);		// Reset the counters
+
+	result res { 0, 0, 0.0 };
+	steady_clock::time_point first, last;
+
+	thread sndr([&] { blast(tx); });
+	capture(cap, res.ncap, first, last);
+	sndr.join();
+
+	cap.get_stats(st);
+	res.drops = st.drops;
+	res.secs = duration<double>(last - first).count();
+	return res;
+}
+
+static void capture_recvfrom(sockpp::packet_socket& sock, size_t& ncap,
+							 steady_clock::time_point& first,
+							 steady_clock::time_point& last)
+{
+	vector<uint8_t> buf(65536);
+	pollfd pfd { sock.handle(), POLLIN, 0 };
+	unsigned sum = 0;
+
+	while (::poll(&pfd, 1, 250) > 0) {
+		if (sock.recv(buf.data(), buf.size()) < 0)
+			break;
+		sum += buf[0];
+		if (ncap++ == 0)
+			first = steady_clock::now();
+	}
+	last = steady_clock::now() - milliseconds(250);
+	(void) sum;
+}
+
+static void capture_ring(sockpp::packet_socket& sock, size_t& ncap,
+						 steady_clock::time_point& first,
+						 steady_clock::time_point& last)
+{
+	unsigned sum = 0;
+
+	while (true) {
+		auto blk = sock.next_block(milliseconds(250));
+		if (!blk)
+			break;
+		if (ncap == 0)
+			first = steady_clock::now();
+		for (const auto& f : blk) {
+			sum += f.data()[0];
+			++ncap;
+		}
+	}
+	last = steady_clock::now() - milliseconds(250);
+	(void) sum;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) npkt = size_t(atoi(argv[1]));
+	if (argc > 2) pktSize = size_t(atoi(argv[2]));
+
+	sockpp::socket_initializer sockInit;
+
+	cout << npkt << " UDP packets of " << pktSize << " bytes over the loopback, "
+		<< (BLOCK_SIZE * NUM_BLOCKS / 1024) << " kB of capture buffer\n" << endl;
+
+	cout << setw(10) << "mode" << setw(12) << "captured" << setw(12) << "drops"
+		<< setw(10) << "drop %" << setw(14) << "kpkt/s" << endl;
+
+	auto print = [](const char* name, const result& res) {
+		double total = double(res.ncap + res.drops);
+		double pct = total > 0 ? 100.0 * res.drops / total : 0.0;
+		double rate = res.secs > 0 ? res.ncap / res.secs / 1000.0 : 0.0;
+		cout << setw(10) << name << setw(12) << res.ncap << setw(12) << res.drops
+			<< fixed << setprecision(1) << setw(10) << pct
+			<< setw(14) << rate << endl;
+	};
+
+	print("recvfrom", run(capture_recvfrom, false));
+	print("ring", run(capture_ring, true));
+
+	return 0;
+}
@@ -0,0 +1,219 @@
+// compbench.cpp
+//
+// Effective throughput of compressed streams over a slow link.
+//
+// The data goes from a sender, through a relay that forwards it at a fixed
+// rate, to a receiver, all over loopback TCP. The relay stands in for a
+// bandwidth-limited WAN link. The sender writes text records, like a
+// replication log, uncompressed and with the compressors built into the
+// library, at fixed levels and with the level adapting to the backlog.
+//
+// The throughput is the rate of uncompressed data delivered to the
+// receiver.
+//
+// USAGE:
+//     compbench [rate_mbps [total_mb]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/compressed_socket.h"
+
+using namespace std;
+using namespace std::chrono;
+
+using sockpp::compressed_socket;
+
+// --------------------------------------------------------------------------
+// Log-like records with some variation, so they compress, but not
+// absurdly well.
+
+static string make_data(size_t n)
+{
+	static const char* const OPS[] = { "insert", "update", "delete", "upsert" };
+	static const char* const TABLES[] = { "orders", "customers", "inventory", "audit" };
+
+	string s;
+	s.reserve(n + 256);
+
+	uint64_t x = 88172645463325252ULL;
+	while (s.size() < n) {
+		x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+		s += "{\"seq\":" + to_string(s.size()) + ",\"op\":\"" + OPS[x & 3]
+			+ "\",\"table\":\"" + TABLES[(x >> 2) & 3] + "\",\"key\":"
+			+ to_string((x >> 8) % 1000000) + ",\"value\":"
+			+ to_string((x >> 24) % 100000) + ",\"ts\":"
+			+ to_string(1700000000000ULL + (x >> 40)) + "}\n";
+	}
+	s.resize(n);
+	return s;
+}
+
+// --------------------------------------------------------------------------
+// Forwards everything from one socket to another at a fixed rate.
+
+static void relay(sockpp::stream_socket in, sockpp::stream_socket out, double rate)
+{
+	vector<char> buf(16*1024);
+	auto next = steady_clock::now();
+	ssize_t n;
+
+	while ((n = in.read(buf.data(), buf.size())) > 0) {
+		if (out.write_n(buf.data(), size_t(n)) != n)
+			break;
+		next += duration_cast<steady_clock::duration>(duration<double>(n / rate));
+		this_thread::sleep_until(next);
+	}
+	out.shutdown(SHUT_WR);
+}
+
+// --------------------------------------------------------------------------
+
+struct config {
+	const char* name;
+	bool compress;
+	compressed_socket::algorithm alg;
+	int minLevel, maxLevel;
+};
+
+static void run(const config& cfg, const string& data, double rate)
+{
+	const size_t MSG_SIZE = 16*1024;
+
+	sockpp::tcp_acceptor relayAcc(sockpp::inet_address("localhost", 0)),
+						 recvAcc(sockpp::inet_address("localhost", 0));
+
+	thread relayThr([&] {
+		sockpp::stream_socket in = relayAcc.accept();
+		sockpp::tcp_connector out(recvAcc.address());
+		relay(std::move(in), std::move(out), rate);
+	});
+
+	int finalLevel = 0;
+	uint64_t wireBytes = data.size();
+
+	thread sendThr([&] {
+		sockpp::tcp_connector conn(relayAcc.address());
+		if (!cfg.compress) {
+			conn.write_n(data.data(), data.size());
+			conn.shutdown(SHUT_WR);
+			return;
+		}
+
+		compressed_socket sock(std::move(conn), cfg.alg, cfg.minLevel);
+		sock.set_level_range(cfg.minLevel, cfg.maxLevel);
+
+		for (size_t i=0; i<data.size(); i+=MSG_SIZE) {
+			if (sock.write(data.data()+i, min(MSG_SIZE, data.size()-i)) < 0)
+				break;
+		}
+		sock.finish();
+		sock.shutdown(SHUT_WR);
+		finalLevel = sock.level();
+		wireBytes = sock.wire_bytes_sent();
+	});
+
+	sockpp::stream_socket recv = recvAcc.accept();
+	compressed_socket crecv;
+	if (cfg.compress)
+		crecv = compressed_socket(std::move(recv), cfg.alg);
+	sockpp::stream_socket& sock = cfg.compress ? crecv : recv;
+
+	vector<char> buf(64*1024);
+	size_t nr = 0;
+	ssize_t n;
+
+	auto start = steady_clock::now();
+	while ((n = sock.read(buf.data(), buf.size())) > 0)
+		nr += size_t(n);
+	double secs = duration<double>(steady_clock::now() - start).count();
+
+	sendThr.join();
+	relayThr.join();
+
+	cout << setw(16) << left << cfg.name << right << fixed << setprecision(1)
+		<< setw(10) << (nr / secs / 1.0e6) << " MB/s"
+		<< setw(8) << setprecision(2) << (double(data.size()) / wireBytes) << "x";
+	if (cfg.compress && cfg.minLevel != cfg.maxLevel)
+		cout << "   final level " << finalLevel;
+	if (nr != data.size())
+		cout << "  [SHORT READ: " << nr << "]";
+	cout << endl;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	double rate = ((argc > 1) ? atof(argv[1]) : 50.0) * 1.0e6;
+	size_t total = size_t((argc > 2) ? atoi(argv[2]) : 64) * 1024 * 1024;
+
+	sockpp::socket_initializer sockInit;
+
+	string data = make_data(total);
+
+	cout << "Sending " << (total >> 20) << " MB over a "
+		<< (rate / 1.0e6) << " MB/s link\n" << endl;
+
+	const auto LZ4 = compressed_socket::LZ4;
+	const auto ZSTD = compressed_socket::ZSTD;
+
+	vector<config> configs { { "none", false, LZ4, 0, 0 } };
+
+	if (compressed_socket::supported(LZ4)) {
+		configs.push_back({ "lz4", true, LZ4, 0, 0 });
+		configs.push_back({ "lz4 hc9", true, LZ4, 9, 9 });
+		configs.push_back({ "lz4 adaptive", true, LZ4, 0, 9 });
+	}
+
+	if (compressed_socket::supported(ZSTD)) {
+		configs.push_back({ "zstd 1", true, ZSTD, 1, 1 });
+		configs.push_back({ "zstd 3", true, ZSTD, 3, 3 });
+		configs.push_back({ "zstd 9", true, ZSTD, 9, 9 });
+		configs.push_back({ "zstd adaptive", true, ZSTD, 1, 12 });
+	}
+
+	for (const auto& cfg : configs)
+		run(cfg, data, rate);
+
+	return 0;
+}
@@ -0,0 +1,174 @@
+// corkbench.cpp
+//
+// Benchmark of sending multi-part responses over a TCP loopback link.
+//
+// Each response is written as a small header followed by several body
+// pieces, with Nagle's algorithm turned off. This compares plain writes
+// against corking the socket for each response and against sending the
+// leading pieces with MSG_MORE. For each, it reports the number of TCP
+// data segments sent per response, as counted by the kernel, and the
+// response throughput.
+//
+// Each is run twice: once streaming responses back-to-back, and once in
+// lock-step, where the peer acknowledges every response before the next
+// is sent. When streaming, the kernel's own auto-corking already merges
+// much of the data, since the send queue rarely drains. The lock-step
+// case is the typical request/response pattern, where it can't.
+//
+// USAGE:
+//     corkbench [nresp [nparts [partsz]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+enum class mode { WRITE, CORK, MSG_MORE };
+
+// --------------------------------------------------------------------------
+// Reads and discards everything from the socket until the peer closes it.
+// If 'respsz' is non-zero, it replies with a single byte after reading
+// each response.
+
+void run_sink(sockpp::tcp_socket sock, size_t respsz)
+{
+	char buf[64*1024];
+	ssize_t n;
+	size_t nrd = 0;
+
+	while ((n = sock.read(buf, sizeof(buf))) > 0) {
+		if (respsz == 0)
+			continue;
+		for (nrd += n; nrd >= respsz; nrd -= respsz)
+			sock.write(buf, 1);
+	}
+}
+
+// --------------------------------------------------------------------------
+
+void send_response(sockpp::stream_socket& sock, mode m, const string& hdr,
+				   const string& part, int nparts)
+{
+	switch (m) {
+		case mode::WRITE:
+			sock.write(hdr);
+			for (int i=0; i<nparts; ++i)
+				sock.write(part);
+			break;
+
+		case mode::CORK: {
+			sockpp::cork_guard cork(sock);
+			sock.write(hdr);
+			for (int i=0; i<nparts; ++i)
+				sock.write(part);
+			break;
+		}
+
+		case mode::MSG_MORE:
+			sock.write_more(hdr.data(), hdr.size());
+			for (int i=0; i<nparts-1; ++i)
+				sock.write_more(part.data(), part.size());
+			sock.write(part);
+			break;
+	}
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	int nresp = (argc > 1) ? atoi(argv[1]) : 100000;
+	int nparts = (argc > 2) ? atoi(argv[2]) : 4;
+	size_t partsz = (argc > 3) ? size_t(atoi(argv[3])) : 200;
+
+	sockpp::socket_initializer sockInit;
+
+	string hdr(64, 'h'), part(partsz, 'b');
+
+	cout << nresp << " responses of a " << hdr.size() << " byte header and "
+		<< nparts << " x " << partsz << " byte parts" << endl;
+
+	const mode modes[] = { mode::WRITE, mode::CORK, mode::MSG_MORE };
+	const char* names[] = { "  write:    ", "  cork:     ", "  MSG_MORE: " };
+
+	for (int lockstep=0; lockstep<2; ++lockstep) {
+		cout << (lockstep ? "Lock-step:" : "Streaming:") << endl;
+
+		for (int i=0; i<3; ++i) {
+			sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+			sockpp::tcp_connector conn(acc.address());
+			if (!conn) {
+				cerr << "Error connecting: " << conn.last_error_str() << endl;
+				return 1;
+			}
+
+			int nodelay = 1;
+			conn.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+
+			size_t respsz = lockstep ? (hdr.size() + nparts*partsz) : 0;
+			thread sink(run_sink, acc.accept(), respsz);
+
+			sockpp::tcp_stats st0, st1;
+			conn.get_tcp_stats(st0);
+
+			char ack;
+			auto start = steady_clock::now();
+			for (int j=0; j<nresp; ++j) {
+				send_response(conn, modes[i], hdr, part, nparts);
+				if (lockstep)
+					conn.read_n(&ack, 1);
+			}
+			double secs = duration<double>(steady_clock::now() - start).count();
+
+			conn.get_tcp_stats(st1);
+			conn.close();
+			sink.join();
+
+			double nsegs = double(st1.tcpi_data_segs_out - st0.tcpi_data_segs_out);
+
+			cout << names[i] << (nsegs / nresp) << " segments/response, "
+				<< (nresp / secs / 1000.0) << " kresp/s" << endl;
+		}
+	}
+
+	return 0;
+}
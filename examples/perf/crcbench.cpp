@@ -0,0 +1,151 @@
+// crcbench.cpp
+//
+// Benchmark of the CRC32C checksum implementations.
+//
+// This measures the throughput of each implementation that the CPU
+// supports, over a range of block sizes, against the classic byte-at-a-time
+// table lookup. The cost is shown both as GB/s and as milliseconds of CPU
+// time spent per GB checksummed.
+//
+// USAGE:
+//     crcbench [total_mb]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "sockpp/crc32c.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// The baseline: a single 256-entry table, one byte at a time.
+
+static uint32_t crc_table[256];
+
+void init_bytewise()
+{
+	for (uint32_t i=0; i<256; ++i) {
+		uint32_t c = i;
+		for (int k=0; k<8; ++k)
+			c = (c & 1) ? ((c >> 1) ^ 0x82F63B78) : (c >> 1);
+		crc_table[i] = c;
+	}
+}
+
+__attribute__((noinline))
+uint32_t crc_bytewise(const uint8_t* p, size_t n)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	while (n--)
+		crc = (crc >> 8) ^ crc_table[(crc ^ *p++) & 0xFF];
+	return ~crc;
+}
+
+// --------------------------------------------------------------------------
+// Checksums blocks of the given size over and over until the total is
+// reached, returning the rate in GB/s.
+
+template <typename F>
+double run(size_t blockSz, size_t total, F crc)
+{
+	vector<uint8_t> buf(blockSz);
+	for (size_t i=0; i<blockSz; ++i)
+		buf[i] = uint8_t(i * 31);
+
+	size_t nblocks = std::max<size_t>(total / blockSz, 1);
+	uint32_t sum = 0;
+
+	auto start = steady_clock::now();
+	for (size_t i=0; i<nblocks; ++i)
+		sum += crc(buf.data(), blockSz);
+	double secs = duration<double>(steady_clock::now() - start).count();
+
+	// Use the result so the work can't be optimized away
+	volatile uint32_t sink = sum;
+	(void) sink;
+
+	return double(nblocks) * blockSz / secs / 1.0e9;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	size_t total = size_t((argc > 1) ? atoi(argv[1]) : 256) * 1024 * 1024;
+
+	init_bytewise();
+
+	struct impl_info { sockpp::crc32c_impl impl; const char* name; };
+	vector<impl_info> impls;
+
+	for (auto info : { impl_info{ sockpp::crc32c_impl::TABLE, "table8" },
+					   impl_info{ sockpp::crc32c_impl::SSE42, "sse42" },
+					   impl_info{ sockpp::crc32c_impl::PCLMUL, "pclmul" } }) {
+		if (sockpp::crc32c_supported(info.impl))
+			impls.push_back(info);
+	}
+
+	cout << "CRC32C throughput, GB/s [ms per GB] ("
+		<< (total >> 20) << " MB per run)\n" << endl;
+
+	cout << setw(8) << "size" << setw(18) << "bytewise";
+	for (auto& info : impls)
+		cout << setw(18) << info.name;
+	cout << endl;
+
+	cout << fixed << setprecision(2);
+
+	auto show = [](double gbps) {
+		cout << setw(8) << gbps << " [" << setw(7) << (1000.0 / gbps) << "]";
+	};
+
+	for (size_t sz : { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576 }) {
+		cout << setw(8) << sz;
+		show(run(sz, total, crc_bytewise));
+
+		for (auto& info : impls) {
+			show(run(sz, total, [&](const uint8_t* p, size_t n) {
+				return sockpp::crc32c(info.impl, p, n);
+			}));
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
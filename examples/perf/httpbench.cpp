@@ -0,0 +1,160 @@
+// httpbench.cpp
+//
+// Loopback benchmark of the HTTP server engine with request pipelining.
+//
+// A client sends a batch of requests in a single write, then reads all of
+// the responses, for pipelining depths from 1 to 16. The server handles
+// each batch with one read and one gather write.
+//
+// USAGE:
+//     httpbench [secs_per_depth [nconn]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/http_server.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static const string REQUEST =
+	"GET /health HTTP/1.1\r\n"
+	"Host: localhost\r\n"
+	"User-Agent: httpbench\r\n"
+	"Accept: */*\r\n"
+	"\r\n";
+
+static const string BODY = "OK\n";
+
+// --------------------------------------------------------------------------
+// Runs one client connection at the given depth until the deadline,
+// returning the number of requests completed.
+
+size_t run_client(const sockpp::inet_address& addr, int depth, size_t rspSize,
+				  steady_clock::time_point deadline)
+{
+	sockpp::tcp_connector conn(addr);
+	if (!conn) {
+		cerr << "Error connecting: " << conn.last_error_str() << endl;
+		return 0;
+	}
+	int nodelay = 1;
+	conn.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+
+	string batch;
+	for (int i=0; i<depth; ++i)
+		batch += REQUEST;
+
+	vector<char> buf(rspSize * depth);
+	size_t nreq = 0;
+
+	while (steady_clock::now() < deadline) {
+		if (conn.write(batch) != ssize_t(batch.size()))
+			break;
+		if (conn.read_n(buf.data(), buf.size()) != ssize_t(buf.size()))
+			break;
+		nreq += depth;
+	}
+	return nreq;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	double secs = (argc > 1) ? atof(argv[1]) : 1.0;
+	int nconn = (argc > 2) ? atoi(argv[2]) : 1;
+
+	sockpp::socket_initializer sockInit;
+
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	if (!acc) {
+		cerr << "Error creating the acceptor: " << acc.last_error_str() << endl;
+		return 1;
+	}
+
+	sockpp::http_server srv([](const sockpp::http_request&, sockpp::http_response& rsp) {
+		rsp.add_header("Content-Type", "text/plain");
+		rsp.set_body(BODY);
+	});
+
+	thread thr([&] { srv.run(acc); });
+
+	// All the responses are the same, so we know how much to read
+	size_t rspSize = string("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+							"Content-Length: 3\r\n\r\n").size() + BODY.size();
+
+	auto addr = acc.address();
+
+	cout << nconn << " connection(s), " << secs << " sec per depth\n" << endl;
+	cout << setw(6) << "depth" << setw(14) << "req/s" << setw(14) << "usec/req" << endl;
+
+	for (int depth : { 1, 2, 4, 8, 16 }) {
+		auto deadline = steady_clock::now() + duration_cast<steady_clock::duration>(
+			duration<double>(secs));
+
+		vector<thread> clients;
+		vector<size_t> counts(nconn, 0);
+
+		auto start = steady_clock::now();
+		for (int i=0; i<nconn; ++i) {
+			clients.emplace_back([&, i] {
+				counts[i] = run_client(addr, depth, rspSize, deadline);
+			});
+		}
+		for (auto& t : clients)
+			t.join();
+		double elapsed = duration<double>(steady_clock::now() - start).count();
+
+		size_t nreq = 0;
+		for (auto n : counts)
+			nreq += n;
+
+		cout << setw(6) << depth << setw(14) << size_t(nreq / elapsed)
+			<< setw(14) << fixed << setprecision(2) << (elapsed * 1e6 / nreq)
+			<< endl;
+	}
+
+	srv.shutdown(seconds(1));
+	thr.join();
+	return 0;
+}
@@ -0,0 +1,460 @@
+// loadgen.cpp
+//
+// Open-loop load generator, with latency corrected for coordinated
+// omission.
+//
+// Requests are sent at a constant rate, spread round-robin over a number
+// of connections, regardless of how quickly the server responds. Each
+// request's latency is measured from the time it was *scheduled* to go
+// out, not from when it actually went out. When the server stalls, a
+// closed-loop client stops sending, and so never measures the requests
+// that would have waited behind the stall. This one keeps to the schedule
+// and charges the wait to every request caught behind it. The latency
+// from the actual send time is reported too, for comparison.
+//
+// Requests are built by a pluggable encoder, which also finds the
+// responses in the incoming data. The server is expected to send back a
+// response for each request with the same encoding, like an echo server:
+//   - echo: fixed-size messages, the first 8 bytes holding the request ID
+//   - lp:   a 32-bit big-endian length, followed by the message
+//
+// Without a server address, it starts an echo server on loopback.
+//
+// USAGE:
+//     loadgen [-r rate] [-c conns] [-d secs] [-s size] [-e echo|lp] [-u]
+//             [host:port]
+//
+//   -r rate     Requests per second, over all connections (default 10000)
+//   -c conns    Number of connections (default 16)
+//   -d secs     Test duration, in seconds (default 10)
+//   -s size     Message size, in bytes (default 64)
+//   -e encoder  The request encoding (default echo)
+//   -u          Use UDP instead of TCP. Each request is a datagram.
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include "sockpp/datagram_socket.h"
+#include "sockpp/latency_histogram.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// Encoders
+
+/**
+ * Builds requests and picks the responses out of the incoming data.
+ */
+class encoder
+{
+public:
+	virtual ~encoder() {}
+	/** Appends a request carrying the ID to the string. */
+	virtual void encode(uint64_t id, string& out) =0;
+	/**
+	 * Finds the complete responses at the front of the data, adding their
+	 * IDs to the vector.
+	 * @return The number of bytes used.
+	 */
+	virtual size_t decode(const char* p, size_t n, vector<uint64_t>& ids) =0;
+};
+
+/** Fixed-size messages, starting with the ID. */
+class echo_encoder : public encoder
+{
+	size_t size_;
+
+public:
+	explicit echo_encoder(size_t size) : size_(max<size_t>(size, 8)) {}
+
+	void encode(uint64_t id, string& out) override {
+		size_t pos = out.size();
+		out.resize(pos + size_, 'x');
+		memcpy(&out[pos], &id, 8);
+	}
+
+	size_t decode(const char* p, size_t n, vector<uint64_t>& ids) override {
+		size_t used = 0;
+		for (; n - used >= size_; used += size_) {
+			uint64_t id;
+			memcpy(&id, p + used, 8);
+			ids.push_back(id);
+		}
+		return used;
+	}
+};
+
+/** Length-prefixed messages: a 32-bit big-endian length, then the body. */
+class lp_encoder : public encoder
+{
+	size_t size_;
+
+public:
+	explicit lp_encoder(size_t size) : size_(max<size_t>(size, 8)) {}
+
+	void encode(uint64_t id, string& out) override {
+		size_t pos = out.size();
+		out.resize(pos + 4 + size_, 'x');
+
+		uint32_t len = uint32_t(size_);
+		out[pos] = char(len >> 24);
+		out[pos+1] = char(len >> 16);
+		out[pos+2] = char(len >> 8);
+		out[pos+3] = char(len);
+		memcpy(&out[pos+4], &id, 8);
+	}
+
+	size_t decode(const char* p, size_t n, vector<uint64_t>& ids) override {
+		size_t used = 0;
+		while (n - used >= 4) {
+			auto q = reinterpret_cast<const uint8_t*>(p + used);
+			size_t len = (size_t(q[0]) << 24) | (size_t(q[1]) << 16)
+				| (size_t(q[2]) << 8) | size_t(q[3]);
+			if (n - used < 4 + len)
+				break;
+
+			if (len >= 8) {
+				uint64_t id;
+				memcpy(&id, q + 4, 8);
+				ids.push_back(id);
+			}
+			used += 4 + len;
+		}
+		return used;
+	}
+};
+
+/** Creates an encoder by name, or returns null if it's unknown. */
+static unique_ptr<encoder> make_encoder(const string& name, size_t size)
+{
+	if (name == "echo")
+		return unique_ptr<encoder>(new echo_encoder(size));
+	if (name == "lp")
+		return unique_ptr<encoder>(new lp_encoder(size));
+	return nullptr;
+}
+
+// --------------------------------------------------------------------------
+// A client connection, over TCP or UDP.
+
+struct connection
+{
+	unique_ptr<sockpp::tcp_connector> tcp;
+	unique_ptr<sockpp::datagram_socket> udp;
+	string rxbuf;
+
+	bool connect(const sockpp::inet_address& addr, bool useUdp) {
+		if (useUdp) {
+			udp.reset(new sockpp::datagram_socket());
+			return udp->connect(addr.to_sock_address());
+		}
+		tcp.reset(new sockpp::tcp_connector(addr));
+		if (!*tcp)
+			return false;
+		int nodelay = 1;
+		return tcp->set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+	}
+
+	int handle() const { return tcp ? tcp->handle() : udp->handle(); }
+
+	bool send(const string& msg) {
+		if (tcp)
+			return tcp->write_n(msg.data(), msg.size()) == ssize_t(msg.size());
+		return udp->send(msg) == int(msg.size());
+	}
+
+	ssize_t recv(char* buf, size_t n) {
+		return tcp ? tcp->read(buf, n) : ssize_t(udp->recv(buf, n));
+	}
+};
+
+// --------------------------------------------------------------------------
+// The built-in echo servers
+
+static void tcp_echo_server(sockpp::tcp_acceptor& acc)
+{
+	while (true) {
+		sockpp::tcp_socket sock = acc.accept();
+		if (!sock)
+			break;
+
+		thread([](sockpp::tcp_socket sock) {
+			int nodelay = 1;
+			sock.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+
+			char buf[64*1024];
+			ssize_t n;
+			while ((n = sock.read(buf, sizeof(buf))) > 0) {
+				if (sock.write_n(buf, size_t(n)) != n)
+					break;
+			}
+		}, std::move(sock)).detach();
+	}
+}
+
+static void udp_echo_server(sockpp::datagram_socket& sock)
+{
+	char buf[64*1024];
+	sockpp::sock_address addr;
+	int n;
+
+	while ((n = sock.recvfrom(buf, sizeof(buf), addr)) > 0)
+		sock.sendto(buf, size_t(n), addr);
+}
+
+// --------------------------------------------------------------------------
+
+static void usage()
+{
+	cerr << "USAGE: loadgen [-r rate] [-c conns] [-d secs] [-s size] "
+		"[-e echo|lp] [-u] [host:port]" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	double rate = 10000;
+	size_t nconn = 16, size = 64;
+	double secs = 10;
+	string encName = "echo";
+	bool useUdp = false;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "r:c:d:s:e:u")) != -1) {
+		switch (opt) {
+			case 'r': rate = atof(optarg); break;
+			case 'c': nconn = size_t(atoi(optarg)); break;
+			case 'd': secs = atof(optarg); break;
+			case 's': size = size_t(atoi(optarg)); break;
+			case 'e': encName = optarg; break;
+			case 'u': useUdp = true; break;
+			default: usage(); return 2;
+		}
+	}
+
+	auto enc = make_encoder(encName, size);
+	if (!enc || rate <= 0 || nconn == 0 || secs <= 0) {
+		usage();
+		return 2;
+	}
+
+	sockpp::socket_initializer sockInit;
+
+	// Start our own server, if we weren't given one
+
+	// With no target, we run our own echo server on an ephemeral port
+	string host { "localhost" };
+	in_port_t port = 0;
+	unique_ptr<sockpp::tcp_acceptor> acc;
+	unique_ptr<sockpp::datagram_socket> srvSock;
+	thread srvThr;
+
+	if (optind < argc) {
+		string hostPort = argv[optind];
+		size_t colon = hostPort.rfind(':');
+		if (colon == string::npos) {
+			usage();
+			return 2;
+		}
+		host = hostPort.substr(0, colon);
+		port = in_port_t(atoi(hostPort.c_str() + colon + 1));
+	}
+	else if (useUdp) {
+		srvSock.reset(new sockpp::datagram_socket(
+			sockpp::inet_address("localhost", 0).to_sock_address()));
+		port = sockpp::inet_address(srvSock->address()).port();
+		srvThr = thread(udp_echo_server, std::ref(*srvSock));
+	}
+	else {
+		acc.reset(new sockpp::tcp_acceptor(sockpp::inet_address("localhost", 0)));
+		port = acc->address().port();
+		srvThr = thread(tcp_echo_server, std::ref(*acc));
+	}
+
+	sockpp::inet_address addr(host, port);
+
+	vector<connection> conns(nconn);
+	for (auto& c : conns) {
+		if (!c.connect(addr, useUdp)) {
+			cerr << "Error connecting to " << addr << endl;
+			return 1;
+		}
+	}
+
+	const uint64_t total = uint64_t(rate * secs);
+	const double interval = 1.0e9 / rate;
+
+	cout << "Sending " << total << " " << encName << " requests of " << size
+		<< " bytes at " << rate << "/s over " << nconn << (useUdp ? " UDP" : " TCP")
+		<< " connections to " << addr << "\n" << endl;
+
+	// The actual send time of each request, in ns from the start
+	unique_ptr<atomic<int64_t>[]> sent(new atomic<int64_t>[total]);
+	for (uint64_t i=0; i<total; ++i)
+		sent[i].store(-1, memory_order_relaxed);
+
+	auto start = steady_clock::now();
+	auto elapsed = [start] {
+		return duration_cast<nanoseconds>(steady_clock::now() - start).count();
+	};
+
+	atomic<bool> sendDone { false };
+	size_t nsendErr = 0;
+
+	// The time spent in each send call, recorded by the sender thread
+	sockpp::latency_recorder sendLatency;
+
+	// The sender keeps to the schedule. If it falls behind, it sends the
+	// overdue requests right away, without skipping any.
+
+	thread sender([&] {
+		string msg;
+		for (uint64_t id=0; id<total; ++id) {
+			auto due = start + nanoseconds(int64_t(id * interval));
+			if (steady_clock::now() < due)
+				this_thread::sleep_until(due);
+
+			msg.clear();
+			enc->encode(id, msg);
+			sent[id].store(elapsed(), memory_order_release);
+
+			connection& c = conns[id % nconn];
+			if (!sockpp::timed(sendLatency, [&] { return c.send(msg); }))
+				++nsendErr;
+		}
+		sendDone = true;
+	});
+
+	// The receiver polls all the connections, matching responses to
+	// requests by ID.
+
+	sockpp::latency_histogram corrected, uncorrected;
+
+	vector<pollfd> fds(nconn);
+	for (size_t i=0; i<nconn; ++i)
+		fds[i] = pollfd{ conns[i].handle(), POLLIN, 0 };
+
+	vector<char> buf(64*1024);
+	vector<uint64_t> ids;
+	int64_t lastRecv = elapsed();
+	const int64_t DRAIN_TIMEOUT = 2000000000;
+
+	while (corrected.count() < total) {
+		if (sendDone && elapsed() - lastRecv > DRAIN_TIMEOUT)
+			break;
+
+		if (::poll(fds.data(), fds.size(), 100) <= 0)
+			continue;
+
+		for (size_t i=0; i<nconn; ++i) {
+			if (!(fds[i].revents & (POLLIN | POLLERR | POLLHUP)))
+				continue;
+
+			connection& c = conns[i];
+			ssize_t n = c.recv(buf.data(), buf.size());
+			if (n <= 0) {
+				if (n == 0 || !useUdp)
+					fds[i].fd = -1;
+				continue;
+			}
+
+			ids.clear();
+			if (useUdp)
+				enc->decode(buf.data(), size_t(n), ids);
+			else {
+				c.rxbuf.append(buf.data(), size_t(n));
+				size_t used = enc->decode(c.rxbuf.data(), c.rxbuf.size(), ids);
+				c.rxbuf.erase(0, used);
+			}
+
+			int64_t now = elapsed();
+			lastRecv = now;
+
+			for (auto id : ids) {
+				if (id >= total)
+					continue;
+				int64_t ts = sent[id].load(memory_order_acquire);
+				if (ts < 0)
+					continue;
+				corrected.record(nanoseconds(now - int64_t(id * interval)));
+				uncorrected.record(nanoseconds(now - ts));
+			}
+		}
+	}
+
+	double runSecs = lastRecv / 1.0e9;
+	sender.join();
+
+	conns.clear();
+	if (srvThr.joinable()) {
+		if (acc)
+			acc->shutdown();
+		else
+			srvSock->shutdown();
+		srvThr.join();
+	}
+
+	cout << "Completed " << corrected.count() << " of " << total << " requests in "
+		<< fixed << setprecision(2) << runSecs << " s ("
+		<< setprecision(0) << (corrected.count() / runSecs) << "/s)";
+	if (corrected.count() < total)
+		cout << ", " << (total - corrected.count()) << " lost";
+	if (nsendErr)
+		cout << ", " << nsendErr << " send errors";
+	cout << "\n" << endl;
+
+	if (corrected.empty())
+		return 1;
+
+	corrected.print_summary(cout, "Latency, corrected for coordinated omission:");
+	uncorrected.print_summary(cout, "Latency from the actual send (uncorrected):");
+	sendLatency.snapshot().print_summary(cout, "Time spent in the send call:");
+	corrected.print_spectrum(cout, "Detailed percentile spectrum (corrected):");
+
+	return 0;
+}
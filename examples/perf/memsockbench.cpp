@@ -0,0 +1,140 @@
+// memsockbench.cpp
+//
+// Throughput of checksummed framing over in-memory and kernel sockets.
+//
+// This streams CRC32C frames through the framer, over:
+//   - mem 1-thread: an in-memory pair, writing and reading each frame in
+//                   turn from a single thread. This is the cost of the
+//                   framing code alone.
+//   - mem 2-thread: an in-memory pair with a writer and reader thread.
+//   - unix:         a kernel AF_UNIX socket pair, with two threads.
+//
+// USAGE:
+//     memsockbench [total_mb]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/crc32c.h"
+#include "sockpp/mem_socket.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// Streams frames from one socket to the other with a writer thread,
+// returning the rate in MB/s.
+
+static double run_threaded(sockpp::stream_socket& tx, sockpp::stream_socket& rx,
+						   size_t frameSz, size_t nframes)
+{
+	vector<char> out(frameSz, 'x'), in(frameSz);
+
+	auto start = steady_clock::now();
+
+	thread thr([&] {
+		sockpp::crc_framer framer(tx);
+		for (size_t i=0; i<nframes; ++i)
+			framer.write_frame(out.data(), out.size());
+	});
+
+	sockpp::crc_framer framer(rx);
+	size_t nr = 0;
+	for (size_t i=0; i<nframes; ++i) {
+		if (framer.read_frame(in.data(), in.size()) != ssize_t(frameSz))
+			break;
+		++nr;
+	}
+	thr.join();
+
+	double secs = duration<double>(steady_clock::now() - start).count();
+	return nr * frameSz / secs / 1.0e6;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	size_t total = size_t((argc > 1) ? atoi(argv[1]) : 256) * 1024 * 1024;
+
+	sockpp::socket_initializer sockInit;
+
+	cout << "Framed throughput, MB/s (" << (total >> 20) << " MB per run)\n" << endl;
+	cout << setw(8) << "frame" << setw(16) << "mem 1-thread"
+		<< setw(16) << "mem 2-thread" << setw(12) << "unix" << endl;
+	cout << fixed << setprecision(1);
+
+	for (size_t sz : { 64, 512, 4096, 32768 }) {
+		size_t nframes = total / sz;
+		cout << setw(8) << sz;
+
+		// Single thread: each frame is written, then read back
+		{
+			sockpp::mem_socket tx, rx;
+			tie(tx, rx) = sockpp::mem_socket::pair(256*1024);
+			sockpp::crc_framer wr(tx), rd(rx);
+
+			vector<char> out(sz, 'x'), in(sz);
+
+			auto start = steady_clock::now();
+			for (size_t i=0; i<nframes; ++i) {
+				wr.write_frame(out.data(), sz);
+				rd.read_frame(in.data(), sz);
+			}
+			double secs = duration<double>(steady_clock::now() - start).count();
+			cout << setw(16) << (nframes * sz / secs / 1.0e6);
+		}
+
+		{
+			sockpp::mem_socket tx, rx;
+			tie(tx, rx) = sockpp::mem_socket::pair(256*1024);
+			cout << setw(16) << run_threaded(tx, rx, sz, nframes);
+		}
+
+		{
+			sockpp::stream_socket tx, rx;
+			tie(tx, rx) = sockpp::stream_socket::pair();
+			cout << setw(12) << run_threaded(tx, rx, sz, nframes);
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,268 @@
+// muxbench.cpp
+//
+// Multiplexed requests over one connection vs. a pool of connections.
+//
+// This runs a closed loop of small echo requests against a local server,
+// keeping a fixed number of them in flight, in two ways:
+//   - pool: one connection and one thread for each request in flight,
+//           each sending a request and waiting for its response.
+//   - mux:  a single connection, with a mux_client keeping all the
+//           requests in flight, and starting a new one from the
+//           completion callback of each.
+//
+// The server is the same for both: a thread per connection that reads
+// whatever requests have arrived, and answers them all in one write. It
+// reports the throughput and the p50 and p99 latency for each.
+//
+// USAGE:
+//     muxbench [nreq [size]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/latency_histogram.h"
+#include "sockpp/mux_client.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t nreq = 200000;
+static size_t msgsz = 64;
+
+// --------------------------------------------------------------------------
+
+static void set_nodelay(sockpp::stream_socket& sock)
+{
+	int on = 1;
+	sock.set_option(IPPROTO_TCP, TCP_NODELAY, &on, sizeof(int));
+}
+
+// --------------------------------------------------------------------------
+// The server side of a connection. It echoes each request frame, batching
+// the responses to everything that came in with a single read.
+
+static void serve(sockpp::tcp_socket sock)
+{
+	const size_t HDR = sockpp::mux_client::HEADER_SIZE;
+	vector<char> buf(64*1024);
+	string out;
+	size_t len = 0;
+	ssize_t n;
+
+	while ((n = sock.read(&buf[len], buf.size() - len)) > 0) {
+		len += size_t(n);
+		size_t pos = 0;
+		out.clear();
+
+		while (len - pos >= HDR) {
+			auto p = reinterpret_cast<const uint8_t*>(&buf[pos]);
+			size_t plen = (size_t(p[0]) << 24) | (size_t(p[1]) << 16)
+				| (size_t(p[2]) << 8) | size_t(p[3]);
+			if (len - pos < HDR + plen)
+				break;
+			out.append(&buf[pos], HDR + plen);
+			pos += HDR + plen;
+		}
+
+		if (!out.empty() && sock.write_n(out.data(), out.size()) < 0)
+			break;
+
+		len -= pos;
+		memmove(buf.data(), &buf[pos], len);
+	}
+}
+
+// --------------------------------------------------------------------------
+
+struct result {
+	double rate;
+	sockpp::latency_histogram lat;
+};
+
+static result run_pool(const sockpp::inet_address& addr, size_t nconn)
+{
+	vector<unique_ptr<sockpp::latency_recorder>> recs;
+	vector<thread> thrs;
+	size_t per = nreq / nconn;
+
+	for (size_t i=0; i<nconn; ++i)
+		recs.emplace_back(new sockpp::latency_recorder);
+
+	vector<unique_ptr<sockpp::tcp_connector>> conns;
+	for (size_t i=0; i<nconn; ++i) {
+		conns.emplace_back(new sockpp::tcp_connector(addr));
+		set_nodelay(*conns.back());
+	}
+
+	auto start = steady_clock::now();
+
+	for (size_t i=0; i<nconn; ++i) {
+		thrs.emplace_back([&, i] {
+			string req(msgsz, 'x'), resp;
+			uint32_t id;
+			for (size_t j=0; j<per; ++j) {
+				auto t = steady_clock::now();
+				if (!sockpp::mux_client::write_frame(*conns[i], 0, req.data(), req.size())
+						|| !sockpp::mux_client::read_frame(*conns[i], id, resp))
+					break;
+				recs[i]->record(steady_clock::now() - t);
+			}
+		});
+	}
+
+	for (auto& thr : thrs)
+		thr.join();
+
+	double secs = duration<double>(steady_clock::now() - start).count();
+
+	result res;
+	for (auto& rec : recs)
+		res.lat += rec->snapshot();
+	res.rate = res.lat.count() / secs;
+	return res;
+}
+
+// The completions all come in on the client's reader thread, so they can
+// record to a plain histogram.
+
+static result run_mux(const sockpp::inet_address& addr, size_t inFlight)
+{
+	sockpp::tcp_connector conn(addr);
+	set_nodelay(conn);
+	sockpp::mux_client cli(std::move(conn));
+
+	const string req(msgsz, 'x');
+	result res;
+	atomic<size_t> issued { 0 };
+	size_t nerr = 0, ndone = 0;
+	mutex mtx;
+	condition_variable cv;
+
+	function<void()> issue = [&] {
+		if (issued++ >= nreq)
+			return;
+		auto t = steady_clock::now();
+		cli.async_call(req, seconds(5), [&, t](int err, string&&) {
+			if (err == 0)
+				res.lat.record(steady_clock::now() - t);
+			else
+				++nerr;
+			issue();
+
+			lock_guard<mutex> lk(mtx);
+			if (++ndone == nreq)
+				cv.notify_one();
+		});
+	};
+
+	auto start = steady_clock::now();
+	for (size_t i=0; i<inFlight; ++i)
+		issue();
+
+	{
+		unique_lock<mutex> lk(mtx);
+		cv.wait(lk, [&] { return ndone == nreq; });
+	}
+
+	double secs = duration<double>(steady_clock::now() - start).count();
+	res.rate = res.lat.count() / secs;
+	if (nerr)
+		cerr << nerr << " requests failed" << endl;
+	return res;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) nreq = size_t(atoi(argv[1]));
+	if (argc > 2) msgsz = size_t(atoi(argv[2]));
+
+	sockpp::socket_initializer sockInit;
+
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	if (!acc) {
+		cerr << "Error creating the acceptor: " << acc.last_error_str() << endl;
+		return 1;
+	}
+	sockpp::inet_address addr = acc.address();
+
+	thread srvr([&acc] {
+		vector<thread> thrs;
+		while (true) {
+			sockpp::tcp_socket sock = acc.accept();
+			if (!sock)
+				break;
+			set_nodelay(sock);
+			thrs.emplace_back(serve, std::move(sock));
+		}
+		for (auto& thr : thrs)
+			thr.join();
+	});
+
+	cout << nreq << " echo requests of " << msgsz << " bytes\n" << endl;
+	cout << setw(10) << "in flight" << setw(8) << "mode" << setw(8) << "conns"
+		<< setw(12) << "req/s" << setw(12) << "p50 (us)" << setw(12) << "p99 (us)"
+		<< endl;
+	cout << fixed;
+
+	auto print = [](size_t inFlight, const char* mode, size_t nconn, const result& res) {
+		cout << setw(10) << inFlight << setw(8) << mode << setw(8) << nconn
+			<< setw(12) << setprecision(0) << res.rate
+			<< setw(12) << setprecision(1) << (res.lat.value_at_percentile(50.0) / 1000.0)
+			<< setw(12) << (res.lat.value_at_percentile(99.0) / 1000.0) << endl;
+	};
+
+	for (size_t n : { 1, 16, 128, 512 }) {
+		print(n, "pool", n, run_pool(addr, n));
+		print(n, "mux", 1, run_mux(addr, n));
+	}
+
+	acc.shutdown();
+	srvr.join();
+	return 0;
+}
@@ -0,0 +1,196 @@
+// pacebench.cpp
+//
+// Inter-packet gaps of paced and unpaced UDP senders.
+//
+// A burst of datagrams is sent over the loopback at a target rate, and the
+// receiver measures the gaps between them with kernel receive timestamps.
+// This is done with:
+//   - burst:   plain sends, as fast as the sender can go.
+//   - paced:   the user-space token-bucket pacer, sleeping between packets.
+//   - spin:    the same, but spinning for the last 20 us before each packet.
+//   - txtime:  the pacer handing whole batches to the kernel, each packet
+//              stamped with its SO_TXTIME departure.
+//   - maxrate: plain sends with SO_MAX_PACING_RATE set on the socket.
+//
+// The last two are only paced by the kernel if the outgoing interface uses
+// the fq queuing discipline, which the loopback normally doesn't:
+//     tc qdisc add dev lo root fq
+// Without it, they look just like the burst.
+//
+// USAGE:
+//     pacebench [npkt [pktsz [rate_mbps]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include "sockpp/inet_address.h"
+#include "sockpp/latency_histogram.h"
+#include "sockpp/pacer.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t npkt = 2000;
+static size_t pktSize = 1200;
+static double rateMbps = 100.0;
+
+// --------------------------------------------------------------------------
+
+struct result {
+	size_t nrecv;
+	double secs;
+	sockpp::latency_histogram gaps;
+};
+
+// Receives until the sender has been quiet for a while, recording the gaps
+// between the arrival times.
+
+static void receive(sockpp::datagram_socket& sock, result& res)
+{
+	vector<char> buf(pktSize + 64);
+	pollfd pfd { sock.handle(), POLLIN, 0 };
+	int64_t first = 0, prev = 0;
+	timespec ts;
+
+	res.nrecv = 0;
+	while (::poll(&pfd, 1, 250) > 0) {
+		if (sock.recv_timestamped(buf.data(), buf.size(), ts) < 0)
+			break;
+
+		int64_t t = int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+		if (res.nrecv++ == 0)
+			first = t;
+		else
+			res.gaps.record(nanoseconds(t - prev));
+		prev = t;
+	}
+	res.secs = (prev - first) / 1.0e9;
+}
+
+template <typename SendFunc>
+static result run(SendFunc&& send)
+{
+	sockpp::inet_address localhost("localhost", 0);
+	sockpp::sock_address addr(localhost.sockaddr_ptr(), localhost.size());
+
+	sockpp::datagram_socket tx, rx;
+	rx.bind(addr);
+	tx.bind(addr);
+	tx.connect(rx.address());
+
+	int bufSize = 8*1024*1024;
+	rx.set_option(SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(int));
+	rx.rx_timestamps();
+
+	result res;
+	thread rcvr([&] { receive(rx, res); });
+
+	vector<char> buf(npkt * pktSize, 'x');
+	vector<iovec> pkts;
+	for (size_t i=0; i<npkt; ++i)
+		pkts.push_back(iovec{ &buf[i*pktSize], pktSize });
+
+	send(tx, pkts);
+	rcvr.join();
+	return res;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) npkt = size_t(atoi(argv[1]));
+	if (argc > 2) pktSize = size_t(atoi(argv[2]));
+	if (argc > 3) rateMbps = atof(argv[3]);
+
+	sockpp::socket_initializer sockInit;
+
+	uint64_t rate = uint64_t(rateMbps * 1.0e6 / 8);
+	double gapUs = pktSize * 1.0e6 / rate;
+
+	cout << npkt << " packets of " << pktSize << " bytes at " << rateMbps
+		<< " Mbps (" << fixed << setprecision(1) << gapUs << " us apart)\n" << endl;
+
+	cout << setw(10) << "mode" << setw(10) << "recv" << setw(12) << "Mbps"
+		<< setw(12) << "p1 (us)" << setw(12) << "p50 (us)"
+		<< setw(12) << "p99 (us)" << setw(12) << "max (us)" << endl;
+
+	auto print = [](const char* name, const result& res) {
+		double mbps = res.secs > 0 ? (res.nrecv - 1) * pktSize * 8 / res.secs / 1.0e6 : 0.0;
+		const auto& g = res.gaps;
+		cout << setw(10) << name << setw(10) << res.nrecv << setw(12) << mbps
+			<< setw(12) << (g.value_at_percentile(1.0) / 1000.0)
+			<< setw(12) << (g.value_at_percentile(50.0) / 1000.0)
+			<< setw(12) << (g.value_at_percentile(99.0) / 1000.0)
+			<< setw(12) << (g.max() / 1000.0) << endl;
+	};
+
+	print("burst", run([](sockpp::datagram_socket& sock, const vector<iovec>& pkts) {
+		for (const auto& pkt : pkts)
+			sock.send(pkt.iov_base, pkt.iov_len);
+	}));
+
+	print("paced", run([rate](sockpp::datagram_socket& sock, const vector<iovec>& pkts) {
+		sockpp::pacer p(rate, pktSize);
+		p.send(sock, pkts.data(), pkts.size());
+	}));
+
+	print("spin", run([rate](sockpp::datagram_socket& sock, const vector<iovec>& pkts) {
+		sockpp::pacer p(rate, pktSize);
+		p.set_spin(microseconds(20));
+		p.send(sock, pkts.data(), pkts.size());
+	}));
+
+	print("txtime", run([rate](sockpp::datagram_socket& sock, const vector<iovec>& pkts) {
+		sockpp::pacer p(rate, pktSize);
+		if (!p.use_txtime(sock))
+			cerr << "    [SO_TXTIME: " << sock.last_error_str() << "]" << endl;
+		p.send(sock, pkts.data(), pkts.size());
+	}));
+
+	print("maxrate", run([rate](sockpp::datagram_socket& sock, const vector<iovec>& pkts) {
+		if (!sock.max_pacing_rate(rate))
+			cerr << "    [SO_MAX_PACING_RATE: " << sock.last_error_str() << "]" << endl;
+		for (const auto& pkt : pkts)
+			sock.send(pkt.iov_base, pkt.iov_len);
+	}));
+
+	return 0;
+}
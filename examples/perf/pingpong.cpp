@@ -0,0 +1,255 @@
+// pingpong.cpp
+//
+// Round-trip latency benchmark, with and without busy polling.
+//
+// A small message is bounced back and forth between two threads over a
+// loopback TCP connection, and then over a pair of UDP sockets. Each is
+// run once with normal blocking reads, and once in low-latency mode, with
+// SO_BUSY_POLL set and reads that spin before blocking. On Linux, the TCP
+// test is also run with each side waiting in a poller (epoll), which is
+// how an event loop waits, once as is and once with the poller's own busy
+// polling (Linux 6.9 or later). It reports the round-trip times at a
+// range of percentiles.
+//
+// Setting a busy poll time above the net.core.busy_read sysctl requires
+// CAP_NET_ADMIN. Without it, only the read spinning takes effect. Note,
+// too, that spinning needs a spare CPU for each side to be of any use. On
+// a single CPU, the spinning thread just steals time from its peer, and
+// the latency gets much worse.
+//
+// USAGE:
+//     pingpong [niter [spin_us [msgsz]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "sockpp/datagram_socket.h"
+#include "sockpp/latency_histogram.h"
+#include "sockpp/poller.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static int niter = 100000;
+static microseconds spin { 50 };
+static size_t msgsz = 64;
+
+// --------------------------------------------------------------------------
+
+void run_tcp(bool lowLatency)
+{
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	sockpp::tcp_connector conn(acc.address());
+	sockpp::tcp_socket sock = acc.accept();
+
+	int nodelay = 1;
+	conn.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+	sock.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+
+	microseconds spinTime = lowLatency ? spin : microseconds(0);
+	if (lowLatency) {
+		conn.busy_poll(spin);
+		sock.busy_poll(spin);
+	}
+
+	thread echo([&] {
+		string buf(msgsz, '\0');
+		ssize_t n;
+		while ((n = sock.read_spin(&buf[0], msgsz, spinTime)) > 0)
+			sock.write_n(buf.data(), n);
+	});
+
+	string msg(msgsz, 'x'), buf(msgsz, '\0');
+	sockpp::latency_histogram rtt;
+
+	for (int i=0; i<niter; ++i) {
+		auto start = steady_clock::now();
+		conn.write_n(msg.data(), msgsz);
+
+		for (size_t nr = 0; nr < msgsz; ) {
+			ssize_t n = conn.read_spin(&buf[nr], msgsz-nr, spinTime);
+			if (n <= 0)
+				break;
+			nr += n;
+		}
+		rtt.record(steady_clock::now() - start);
+	}
+
+	conn.close();
+	echo.join();
+
+	rtt.print_summary(cout, lowLatency ? "TCP busy poll round trip:" : "TCP blocking round trip:");
+}
+
+// --------------------------------------------------------------------------
+// Each side waits for the socket to be readable in its own poller before
+// reading, as it would in an event loop. In low-latency mode, the busy
+// polling is done inside the wait.
+
+#if defined(__linux__)
+void run_tcp_epoll(bool lowLatency)
+{
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	sockpp::tcp_connector conn(acc.address());
+	sockpp::tcp_socket sock = acc.accept();
+
+	int nodelay = 1;
+	conn.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+	sock.set_option(IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(int));
+
+	sockpp::poller cliPoll, srvPoll;
+	cliPoll.add(conn);
+	srvPoll.add(sock);
+
+	if (lowLatency) {
+		conn.busy_poll(spin);
+		sock.busy_poll(spin);
+		if (!cliPoll.busy_poll(spin) || !srvPoll.busy_poll(spin)) {
+			cerr << "epoll busy poll: " << cliPoll.last_error_str() << endl;
+			return;
+		}
+	}
+
+	thread echo([&] {
+		string buf(msgsz, '\0');
+		epoll_event ev;
+		ssize_t n;
+		while (srvPoll.wait(&ev, 1, milliseconds(-1)) >= 0) {
+			if ((n = sock.read(&buf[0], msgsz)) <= 0)
+				break;
+			sock.write_n(buf.data(), n);
+		}
+	});
+
+	string msg(msgsz, 'x'), buf(msgsz, '\0');
+	sockpp::latency_histogram rtt;
+	epoll_event ev;
+
+	for (int i=0; i<niter; ++i) {
+		auto start = steady_clock::now();
+		conn.write_n(msg.data(), msgsz);
+
+		for (size_t nr = 0; nr < msgsz; ) {
+			if (cliPoll.wait(&ev, 1, milliseconds(-1)) < 0)
+				break;
+			ssize_t n = conn.read(&buf[nr], msgsz-nr);
+			if (n <= 0)
+				break;
+			nr += n;
+		}
+		rtt.record(steady_clock::now() - start);
+	}
+
+	cliPoll.remove(conn);
+	conn.close();
+	echo.join();
+
+	rtt.print_summary(cout, lowLatency ? "TCP epoll busy poll round trip:"
+						: "TCP epoll round trip:");
+}
+#endif
+
+// --------------------------------------------------------------------------
+
+void run_udp(bool lowLatency)
+{
+	sockpp::inet_address localhost("localhost", 0);
+
+	sockpp::datagram_socket srvr, cli;
+	srvr.bind(sockpp::sock_address(localhost.sockaddr_ptr(), localhost.size()));
+	cli.bind(sockpp::sock_address(localhost.sockaddr_ptr(), localhost.size()));
+
+	srvr.connect(cli.address());
+	cli.connect(srvr.address());
+
+	microseconds spinTime = lowLatency ? spin : microseconds(0);
+	if (lowLatency) {
+		srvr.busy_poll(spin);
+		cli.busy_poll(spin);
+	}
+
+	thread echo([&] {
+		string buf(msgsz, '\0');
+		int n;
+		while ((n = srvr.recv_spin(&buf[0], msgsz, spinTime)) > 0)
+			srvr.send(buf.data(), size_t(n));
+	});
+
+	string msg(msgsz, 'x'), buf(msgsz, '\0');
+	sockpp::latency_histogram rtt;
+
+	for (int i=0; i<niter; ++i) {
+		auto start = steady_clock::now();
+		cli.send(msg.data(), msgsz);
+		cli.recv_spin(&buf[0], msgsz, spinTime);
+		rtt.record(steady_clock::now() - start);
+	}
+
+	// A zero-length datagram tells the echo thread to quit
+	cli.send(msg.data(), size_t(0));
+	echo.join();
+
+	rtt.print_summary(cout, lowLatency ? "UDP busy poll round trip:" : "UDP blocking round trip:");
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) niter = atoi(argv[1]);
+	if (argc > 2) spin = microseconds(atoi(argv[2]));
+	if (argc > 3) msgsz = size_t(atoi(argv[3]));
+
+	sockpp::socket_initializer sockInit;
+
+	cout << niter << " round trips of " << msgsz << " bytes, spinning up to "
+		<< spin.count() << " us" << endl;
+
+	run_tcp(false);
+	run_tcp(true);
+	#if defined(__linux__)
+		run_tcp_epoll(false);
+		run_tcp_epoll(true);
+	#endif
+	run_udp(false);
+	run_udp(true);
+
+	return 0;
+}
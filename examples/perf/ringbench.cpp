@@ -0,0 +1,283 @@
+// ringbench.cpp
+//
+// Parse throughput of length-prefixed messages from a ring buffer, where
+// many of them straddle the end of the ring.
+//
+// The messages have a 4-byte length and a payload of 64 to 4096 bytes,
+// through a 64 kB ring (by default), and each one is "parsed" by taking the CRC-32C of
+// its payload. This is done with:
+//   - copy:    an ordinary ring, filled with two copies, or a readv() of
+//              two pieces, at the wrap, and with each message that
+//              straddles it copied into a scratch buffer to be parsed.
+//   - mirror:  the mirrored_ring, filled with one copy, or one read(),
+//              and parsed in place.
+// The data comes from memory, to isolate the cost of the ring, and then
+// from a Unix-domain socket, written by another thread.
+//
+// USAGE:
+//     ringbench [total_MB] [ring_kB]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include <sys/uio.h>
+#include "sockpp/crc32c.h"
+#include "sockpp/mirrored_ring.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t totalMB = 256;
+static size_t ringSize = 64*1024;
+static const size_t HDR_SIZE = 4;
+
+// --------------------------------------------------------------------------
+
+// An ordinary ring, which copies a message into a scratch buffer when it
+// wraps around the end.
+
+class copy_ring
+{
+	vector<uint8_t> buf_, scratch_;
+	size_t head_ = 0, size_ = 0;
+
+public:
+	uint64_t copied = 0;
+
+	copy_ring() : buf_(ringSize), scratch_(ringSize) {}
+
+	size_t size() const { return size_; }
+
+	// The free space, in one or two pieces
+	int writable(iovec iov[2]) {
+		size_t cap = buf_.size(), tail = (head_ + size_) % cap,
+			   free = cap - size_;
+		size_t n1 = min(free, cap - tail);
+		iov[0] = iovec{ &buf_[tail], n1 };
+		iov[1] = iovec{ buf_.data(), free - n1 };
+		return iov[1].iov_len ? 2 : 1;
+	}
+	void commit(size_t n) { size_ += n; }
+
+	const uint8_t* peek(size_t off, size_t n) {
+		size_t cap = buf_.size(), pos = (head_ + off) % cap;
+		if (pos + n <= cap)
+			return &buf_[pos];
+
+		size_t n1 = cap - pos;
+		memcpy(scratch_.data(), &buf_[pos], n1);
+		memcpy(&scratch_[n1], buf_.data(), n - n1);
+		copied += n;
+		return scratch_.data();
+	}
+	void consume(size_t n) {
+		head_ = (head_ + n) % buf_.size();
+		size_ -= n;
+	}
+};
+
+// The mirrored ring, with the same interface.
+
+class mirror_ring
+{
+	sockpp::mirrored_ring ring_;
+
+public:
+	uint64_t copied = 0;
+
+	mirror_ring() : ring_(ringSize) {}
+
+	size_t size() const { return ring_.size(); }
+
+	int writable(iovec iov[2]) {
+		iov[0] = ring_.writable();
+		return 1;
+	}
+	void commit(size_t n) { ring_.commit(n); }
+
+	const uint8_t* peek(size_t off, size_t) { return ring_.data() + off; }
+	void consume(size_t n) { ring_.consume(n); }
+};
+
+// --------------------------------------------------------------------------
+
+// Makes a stream of messages with random sizes.
+
+static vector<uint8_t> make_stream(size_t nbytes, size_t& nmsg)
+{
+	vector<uint8_t> v;
+	v.reserve(nbytes + 4096 + HDR_SIZE);
+	mt19937 rng(42);
+	uniform_int_distribution<uint32_t> len(64, 4096);
+
+	nmsg = 0;
+	while (v.size() < nbytes) {
+		uint32_t n = len(rng);
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(&n);
+		v.insert(v.end(), p, p + HDR_SIZE);
+		for (uint32_t i=0; i<n; ++i)
+			v.push_back(uint8_t(i * 131 + n));
+		++nmsg;
+	}
+	return v;
+}
+
+// Parses all the complete messages in the ring.
+
+template <typename Ring>
+static size_t parse(Ring& ring, uint32_t& crc)
+{
+	size_t n = 0;
+	while (ring.size() >= HDR_SIZE) {
+		uint32_t len;
+		memcpy(&len, ring.peek(0, HDR_SIZE), HDR_SIZE);
+		if (ring.size() < HDR_SIZE + len)
+			break;
+
+		crc = sockpp::crc32c(ring.peek(HDR_SIZE, len), len, crc);
+		ring.consume(HDR_SIZE + len);
+		++n;
+	}
+	return n;
+}
+
+struct result {
+	size_t nmsg;
+	double secs;
+	uint64_t copied;
+	uint32_t crc;
+};
+
+// Fills the ring from memory, with a copy for each piece of free space.
+
+template <typename Ring>
+static result run_mem(const vector<uint8_t>& stream)
+{
+	Ring ring;
+	result res { 0, 0.0, 0, 0 };
+	size_t pos = 0;
+	iovec iov[2];
+
+	auto start = steady_clock::now();
+
+	while (pos < stream.size()) {
+		int niov = ring.writable(iov);
+		for (int i=0; i<niov && pos < stream.size(); ++i) {
+			size_t n = min(iov[i].iov_len, stream.size() - pos);
+			memcpy(iov[i].iov_base, &stream[pos], n);
+			ring.commit(n);
+			pos += n;
+		}
+		res.nmsg += parse(ring, res.crc);
+	}
+
+	res.secs = duration<double>(steady_clock::now() - start).count();
+	res.copied = ring.copied;
+	return res;
+}
+
+// Fills the ring from a socket, with a single read() or readv().
+
+template <typename Ring>
+static result run_sock(const vector<uint8_t>& stream)
+{
+	sockpp::stream_socket tx, rx;
+	std::tie(tx, rx) = sockpp::stream_socket::pair();
+
+	Ring ring;
+	result res { 0, 0.0, 0, 0 };
+	iovec iov[2];
+
+	auto start = steady_clock::now();
+
+	thread sndr([&] {
+		tx.write_n(stream.data(), stream.size());
+		tx.shutdown(SHUT_WR);
+	});
+
+	while (true) {
+		int niov = ring.writable(iov);
+		ssize_t n = (niov == 1) ? rx.read(iov[0].iov_base, iov[0].iov_len)
+			: ::readv(rx.handle(), iov, niov);
+		if (n <= 0)
+			break;
+		ring.commit(size_t(n));
+		res.nmsg += parse(ring, res.crc);
+	}
+
+	sndr.join();
+	res.secs = duration<double>(steady_clock::now() - start).count();
+	res.copied = ring.copied;
+	return res;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) totalMB = size_t(atoi(argv[1]));
+	if (argc > 2) ringSize = size_t(atoi(argv[2])) * 1024;
+
+	sockpp::socket_initializer sockInit;
+
+	size_t nmsg;
+	auto stream = make_stream(totalMB * 1024 * 1024, nmsg);
+
+	cout << nmsg << " messages, " << (stream.size() >> 20) << " MB, through a "
+		<< (ringSize / 1024) << " kB ring\n" << endl;
+
+	cout << setw(8) << "source" << setw(8) << "ring" << setw(12) << "MB/s"
+		<< setw(12) << "kmsg/s" << setw(14) << "copied MB" << setw(12) << "crc" << endl;
+
+	auto print = [&](const char* src, const char* name, const result& res) {
+		cout << setw(8) << src << setw(8) << name << fixed << setprecision(1)
+			<< setw(12) << (stream.size() / res.secs / 1.0e6)
+			<< setw(12) << (res.nmsg / res.secs / 1.0e3)
+			<< setw(14) << (res.copied / 1.0e6)
+			<< setw(12) << hex << res.crc << dec
+			<< (res.nmsg != nmsg ? "  [incomplete]" : "") << endl;
+	};
+
+	print("memory", "copy", run_mem<copy_ring>(stream));
+	print("memory", "mirror", run_mem<mirror_ring>(stream));
+	print("socket", "copy", run_sock<copy_ring>(stream));
+	print("socket", "mirror", run_sock<mirror_ring>(stream));
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+// rudpbench.cpp
+//
+// Tail latency of reliable UDP messaging vs. TCP, with packet loss.
+//
+// A stream of small, timestamped messages is sent at a steady rate over
+// the loopback, and the receiver records how long each one took to be
+// delivered. This is run over:
+//   - tcp:        a TCP connection, with Nagle turned off.
+//   - rudp:       an rudp_socket, in order.
+//   - rudp lossy: an rudp_socket, in order, dropping a fraction of the
+//                 packets in each direction.
+//   - unordered:  the same, but with unordered delivery, so a lost packet
+//                 only delays itself.
+//
+// The loss is injected by the rudp_socket itself. To see what the same
+// loss does to TCP, use netem on the loopback, e.g.:
+//     tc qdisc add dev lo root netem loss 1%
+// and then run with a loss of zero, so that it applies to both.
+//
+// USAGE:
+//     rudpbench [nmsg [rate [loss_pct]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "sockpp/inet_address.h"
+#include "sockpp/latency_histogram.h"
+#include "sockpp/rudp_socket.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t nmsg = 50000;
+static double rate = 20000;
+static double loss = 0.01;
+
+static const size_t MSG_SIZE = 64;
+
+// --------------------------------------------------------------------------
+
+static int64_t now_ns()
+{
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Sends the messages on schedule, each stamped with its send time. The
+// sender sleeps between bursts, rather than for each message.
+
+template <typename SendFunc>
+static void send_stream(SendFunc&& send)
+{
+	char msg[MSG_SIZE] = {};
+	auto start = steady_clock::now();
+	auto interval = duration<double>(1.0 / rate);
+
+	for (size_t i=0; i<nmsg; ++i) {
+		auto due = start + duration_cast<nanoseconds>(interval * double(i));
+		if (steady_clock::now() < due)
+			this_thread::sleep_until(due);
+
+		int64_t t = now_ns();
+		memcpy(msg, &t, sizeof(t));
+		send(msg, MSG_SIZE);
+	}
+}
+
+static void record(sockpp::latency_histogram& lat, const char* msg)
+{
+	int64_t t;
+	memcpy(&t, msg, sizeof(t));
+	lat.record(nanoseconds(now_ns() - t));
+}
+
+// --------------------------------------------------------------------------
+
+static sockpp::latency_histogram run_tcp()
+{
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+	sockpp::tcp_connector conn(acc.address());
+	sockpp::tcp_socket sock = acc.accept();
+
+	int on = 1;
+	conn.set_option(IPPROTO_TCP, TCP_NODELAY, &on, sizeof(int));
+
+	thread sender([&conn] {
+		send_stream([&conn](const char* p, size_t n) { conn.write_n(p, n); });
+	});
+
+	sockpp::latency_histogram lat;
+	char msg[MSG_SIZE];
+	for (size_t i=0; i<nmsg; ++i) {
+		if (sock.read_n(msg, MSG_SIZE) != ssize_t(MSG_SIZE))
+			break;
+		record(lat, msg);
+	}
+	sender.join();
+	return lat;
+}
+
+static sockpp::latency_histogram run_rudp(double lossRate, bool ordered)
+{
+	sockpp::inet_address localhost("localhost", 0);
+	sockpp::sock_address addr(localhost.sockaddr_ptr(), localhost.size());
+
+	sockpp::datagram_socket a, b;
+	a.bind(addr);
+	b.bind(addr);
+	a.connect(b.address());
+	b.connect(a.address());
+
+	sockpp::rudp_socket tx(std::move(a)), rx(std::move(b));
+	tx.set_loss(lossRate);
+	rx.set_loss(lossRate);
+	tx.set_ordered(ordered);
+
+	thread sender([&tx] {
+		send_stream([&tx](const char* p, size_t n) { tx.send(p, n); });
+	});
+
+	sockpp::latency_histogram lat;
+	string msg;
+	for (size_t i=0; i<nmsg; ++i) {
+		if (!rx.recv(msg, seconds(10)))
+			break;
+		record(lat, msg.data());
+	}
+	sender.join();
+	tx.flush(seconds(10));
+
+	auto st = tx.get_stats();
+	cerr << "    [" << st.retransmits << " retransmits, " << st.timeouts
+		<< " timeouts, srtt " << st.srttUs << " us]" << endl;
+	return lat;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) nmsg = size_t(atoi(argv[1]));
+	if (argc > 2) rate = atof(argv[2]);
+	if (argc > 3) loss = atof(argv[3]) / 100.0;
+
+	sockpp::socket_initializer sockInit;
+
+	cout << nmsg << " messages of " << MSG_SIZE << " bytes at " << rate
+		<< "/s, " << (loss * 100.0) << "% loss\n" << endl;
+
+	cout << setw(12) << "transport" << setw(8) << "loss" << setw(10) << "count"
+		<< setw(12) << "p50 (us)" << setw(12) << "p99 (us)"
+		<< setw(12) << "p99.9 (us)" << setw(12) << "max (us)" << endl;
+	cout << fixed;
+
+	auto print = [](const char* name, double lossRate, const sockpp::latency_histogram& lat) {
+		cout << setw(12) << name << setw(7) << setprecision(1) << (lossRate * 100.0) << "%"
+			<< setw(10) << lat.count()
+			<< setw(12) << (lat.value_at_percentile(50.0) / 1000.0)
+			<< setw(12) << (lat.value_at_percentile(99.0) / 1000.0)
+			<< setw(12) << (lat.value_at_percentile(99.9) / 1000.0)
+			<< setw(12) << (lat.max() / 1000.0) << endl;
+	};
+
+	print("tcp", 0.0, run_tcp());
+	print("rudp", 0.0, run_rudp(0.0, true));
+	print("rudp", loss, run_rudp(loss, true));
+	print("unordered", loss, run_rudp(loss, false));
+
+	return 0;
+}
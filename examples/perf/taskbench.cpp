@@ -0,0 +1,210 @@
+// taskbench.cpp
+//
+// Post-to-run latency and throughput of tasks handed to an event loop
+// thread, across 1 to 32 producer threads.
+//
+// In the flood, each producer posts its share of the tasks as fast as it
+// can, which measures the throughput. In the paced run, each one posts a
+// task every 200 us, so that the loop is usually asleep, which measures
+// the latency of the wakeup. The loop thread records the time from each
+// post to when the task ran. This is done with:
+//   - locked:  a mutex-protected deque, with a byte written to a wakeup
+//              pipe for every post.
+//   - mpsc:    the lock-free task_queue, which only writes to its eventfd
+//              when the loop is about to sleep, and runs tasks in batches.
+//
+// USAGE:
+//     taskbench [n_flood] [n_paced]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "sockpp/latency_histogram.h"
+#include "sockpp/task_queue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+using task = function<void()>;
+
+static size_t ntasks = 400000;
+static size_t npaced = 20000;
+static const microseconds PACED_GAP(200);
+
+// --------------------------------------------------------------------------
+
+// The usual way: a locked queue and a pipe to wake the loop.
+
+class locked_queue
+{
+	mutex lock_;
+	deque<task> que_;
+	int fds_[2];
+	uint64_t nwakeups_ = 0;
+
+public:
+	locked_queue() {
+		if (::pipe2(fds_, O_CLOEXEC | O_NONBLOCK) != 0)
+			fds_[0] = fds_[1] = -1;
+	}
+	~locked_queue() {
+		::close(fds_[0]);
+		::close(fds_[1]);
+	}
+	void post(task fn) {
+		{
+			lock_guard<mutex> lk(lock_);
+			que_.push_back(std::move(fn));
+			++nwakeups_;
+		}
+		char c = 0;
+		(void) !::write(fds_[1], &c, 1);
+	}
+	size_t run(const milliseconds& timeout) {
+		pollfd pfd { fds_[0], POLLIN, 0 };
+		if (::poll(&pfd, 1, int(timeout.count())) <= 0)
+			return 0;
+
+		char buf[4096];
+		while (::read(fds_[0], buf, sizeof(buf)) == ssize_t(sizeof(buf)))
+			;
+
+		deque<task> tasks;
+		{
+			lock_guard<mutex> lk(lock_);
+			tasks.swap(que_);
+		}
+		for (auto& fn : tasks)
+			fn();
+		return tasks.size();
+	}
+	uint64_t num_wakeups() {
+		lock_guard<mutex> lk(lock_);
+		return nwakeups_;
+	}
+};
+
+// --------------------------------------------------------------------------
+
+struct result {
+	sockpp::latency_histogram lat;
+	double secs;
+	uint64_t wakeups;
+};
+
+template <typename Queue>
+static result run(size_t nprod, size_t n, const microseconds& gap)
+{
+	Queue q;
+	result res;
+	size_t nrun = 0;
+	size_t perProd = n / nprod, total = perProd * nprod;
+
+	auto start = steady_clock::now();
+
+	vector<thread> prods;
+	for (size_t i=0; i<nprod; ++i) {
+		prods.emplace_back([&] {
+			for (size_t j=0; j<perProd; ++j) {
+				auto t0 = steady_clock::now();
+				q.post([&res, &nrun, t0] {
+					res.lat.record(steady_clock::now() - t0);
+					++nrun;
+				});
+				if (gap.count() > 0)
+					this_thread::sleep_for(gap);
+			}
+		});
+	}
+
+	while (nrun < total)
+		q.run(milliseconds(100));
+
+	res.secs = duration<double>(steady_clock::now() - start).count();
+
+	for (auto& thr : prods)
+		thr.join();
+
+	res.wakeups = q.num_wakeups();
+	return res;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) ntasks = size_t(atoi(argv[1]));
+	if (argc > 2) npaced = size_t(atoi(argv[2]));
+
+	sockpp::socket_initializer sockInit;
+
+	cout << "Tasks posted to one loop thread: " << ntasks << " in a flood, "
+		<< npaced << " paced\n" << endl;
+	cout << setw(8) << "mode" << setw(6) << "prod" << setw(12) << "ktask/s"
+		<< setw(12) << "p50 (us)" << setw(12) << "p99 (us)"
+		<< setw(12) << "max (us)" << setw(14) << "wake/1k task" << endl;
+
+	auto print = [](const char* name, size_t nprod, const result& res) {
+		const auto& h = res.lat;
+		cout << setw(8) << name << setw(6) << nprod << fixed << setprecision(2)
+			<< setw(12) << (h.count() / res.secs / 1.0e3)
+			<< setw(12) << (h.value_at_percentile(50.0) / 1000.0)
+			<< setw(12) << (h.value_at_percentile(99.0) / 1000.0)
+			<< setw(12) << (h.max() / 1000.0)
+			<< setw(14) << (1000.0 * res.wakeups / h.count()) << endl;
+	};
+
+	cout << "flood" << endl;
+	for (size_t nprod : { 1, 2, 4, 8, 16, 32 }) {
+		print("locked", nprod, run<locked_queue>(nprod, ntasks, microseconds(0)));
+		print("mpsc", nprod, run<sockpp::task_queue>(nprod, ntasks, microseconds(0)));
+	}
+
+	cout << "\npaced" << endl;
+	for (size_t nprod : { 1, 2, 4, 8, 16, 32 }) {
+		print("locked", nprod, run<locked_queue>(nprod, npaced, PACED_GAP));
+		print("mpsc", nprod, run<sockpp::task_queue>(nprod, npaced, PACED_GAP));
+	}
+	return 0;
+}
@@ -0,0 +1,136 @@
+// tfobench.cpp
+//
+// Benchmark of short-lived request/response connections with and without
+// TCP Fast Open.
+//
+// A local server, with TFO enabled on its acceptor, reads a request and
+// replies with a single byte. The client makes a fresh connection for each
+// request, first with a regular connect() and write(), then with
+// connect_fast_open(). It reports the average time per request and how
+// many of the requests actually carried their data in the SYN.
+//
+// On Linux, TFO must be enabled for both client and server with:
+//     sysctl -w net.ipv4.tcp_fastopen=3
+//
+// This can be done without affecting the host by running the benchmark in
+// its own network namespace, like:
+//     unshare -n sh -c 'ip link set lo up;
+//         echo 3 > /proc/sys/net/ipv4/tcp_fastopen; ./tfobench'
+//
+// USAGE:
+//     tfobench [nreq [reqsz]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// The server answers each request with a single byte, then closes.
+
+void run_server(sockpp::tcp_acceptor* acc, int nreq, size_t reqsz)
+{
+	string buf(reqsz, '\0');
+
+	for (int i=0; i<nreq; ++i) {
+		sockpp::tcp_socket sock = acc->accept();
+		if (sock.read_n(&buf[0], reqsz) == ssize_t(reqsz))
+			sock.write("R", 1);
+	}
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	int nreq = (argc > 1) ? atoi(argv[1]) : 10000;
+	size_t reqsz = (argc > 2) ? size_t(atoi(argv[2])) : 100;
+
+	sockpp::socket_initializer sockInit;
+
+	sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0), 1024);
+	if (!acc) {
+		cerr << "Error creating the acceptor: " << acc.last_error_str() << endl;
+		return 1;
+	}
+
+	if (!acc.fast_open(1024))
+		cerr << "Error enabling TFO on the acceptor: " << acc.last_error_str() << endl;
+
+	string req(reqsz, 'q');
+	cout << nreq << " connections, each with a " << reqsz << " byte request" << endl;
+
+	for (int tfo=0; tfo<2; ++tfo) {
+		thread srvr(run_server, &acc, nreq, reqsz);
+
+		int nsyn = 0;
+		char resp;
+
+		auto start = steady_clock::now();
+		for (int i=0; i<nreq; ++i) {
+			sockpp::tcp_connector conn;
+			ssize_t n;
+
+			if (tfo)
+				n = conn.connect_fast_open(acc.address(), req.data(), reqsz);
+			else
+				n = conn.connect(acc.address()) ? conn.write_n(req.data(), reqsz) : -1;
+
+			if (n != ssize_t(reqsz) || conn.read_n(&resp, 1) != 1) {
+				cerr << "Request error: " << conn.last_error_str() << endl;
+				srvr.detach();
+				return 1;
+			}
+
+			if (conn.used_fast_open())
+				++nsyn;
+		}
+		double secs = duration<double>(steady_clock::now() - start).count();
+		srvr.join();
+
+		cout << (tfo ? "Fast Open: " : "Regular:   ")
+			<< (secs / nreq * 1.0e6) << " us/request, "
+			<< nsyn << " with data in the SYN" << endl;
+	}
+
+	return 0;
+}
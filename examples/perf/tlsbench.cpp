@@ -0,0 +1,211 @@
+// tlsbench.cpp
+//
+// Loopback bulk throughput of TLS connections.
+//
+// This sends a stream of data from a server to a client over TLS in three
+// ways:
+//   - user:     OpenSSL encrypts the records in user space
+//   - ktls:     the kernel encrypts the records (kTLS), with plain writes
+//   - sendfile: kTLS, sending a file with sendfile(), with no user copy
+//
+// If the kernel doesn't support kTLS (the "tls" TCP ULP), or the cipher
+// can't be offloaded, the last two fall back to user-space records, and
+// the output says so.
+//
+// USAGE:
+//     tlsbench [total_mb]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/tls_socket.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// Creates a self-signed certificate and key, as PEM text.
+
+static void make_cert(string& certPem, string& keyPem)
+{
+	EVP_PKEY* key = EVP_EC_gen("P-256");
+	X509* cert = X509_new();
+
+	ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+	X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+	X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+	X509_set_pubkey(cert, key);
+
+	X509_NAME* name = X509_get_subject_name(cert);
+	X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+							   reinterpret_cast<const unsigned char*>("localhost"),
+							   -1, -1, 0);
+	X509_set_issuer_name(cert, name);
+	X509_sign(cert, key, EVP_sha256());
+
+	auto to_pem = [](BIO* bio) {
+		char* p;
+		long n = BIO_get_mem_data(bio, &p);
+		string pem(p, size_t(n));
+		BIO_free(bio);
+		return pem;
+	};
+
+	BIO* bio = BIO_new(BIO_s_mem());
+	PEM_write_bio_X509(bio, cert);
+	certPem = to_pem(bio);
+
+	bio = BIO_new(BIO_s_mem());
+	PEM_write_bio_PrivateKey(bio, key, nullptr, nullptr, 0, nullptr, nullptr);
+	keyPem = to_pem(bio);
+
+	X509_free(cert);
+	EVP_PKEY_free(key);
+}
+
+// --------------------------------------------------------------------------
+
+enum class mode { USER, KTLS, SENDFILE };
+
+int main(int argc, char* argv[])
+{
+	size_t total = size_t((argc > 1) ? atoi(argv[1]) : 512) * 1024 * 1024;
+
+	sockpp::socket_initializer sockInit;
+
+	string certPem, keyPem;
+	make_cert(certPem, keyPem);
+
+	// The source data, in memory and in a file
+	const size_t CHUNK = 64*1024, FILE_SZ = 16*1024*1024;
+	vector<char> data(FILE_SZ);
+	for (size_t i=0; i<data.size(); ++i)
+		data[i] = char(i * 131);
+
+	FILE* f = tmpfile();
+	if (!f || fwrite(data.data(), 1, data.size(), f) != data.size()) {
+		cerr << "Error creating the data file" << endl;
+		return 1;
+	}
+	fflush(f);
+
+	cout << "Sending " << (total >> 20) << " MB over loopback TLS\n" << endl;
+
+	for (auto m : { mode::USER, mode::KTLS, mode::SENDFILE }) {
+		bool ktls = (m != mode::USER);
+
+		sockpp::tls_context srvCtx(sockpp::tls_context::SERVER),
+							cliCtx(sockpp::tls_context::CLIENT);
+		srvCtx.use_certificate(certPem, keyPem);
+		cliCtx.add_ca_certificate(certPem);
+		srvCtx.enable_ktls(ktls);
+		cliCtx.enable_ktls(ktls);
+
+		sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+		if (!acc) {
+			cerr << "Error creating the acceptor: " << acc.last_error_str() << endl;
+			return 1;
+		}
+
+		bool ktlsSend = false;
+		thread srvThr([&] {
+			sockpp::tls_socket srv(srvCtx, acc.accept());
+			if (!srv.handshake()) {
+				cerr << "Server handshake failed: " << srv.last_error_str() << endl;
+				return;
+			}
+			ktlsSend = srv.ktls_send();
+
+			size_t nw = 0;
+			while (nw < total) {
+				size_t n = min(total - nw, (m == mode::SENDFILE) ? FILE_SZ : CHUNK);
+				ssize_t nx = (m == mode::SENDFILE)
+					? srv.sendfile(fileno(f), 0, n)
+					: srv.write_n(data.data() + nw % FILE_SZ, n);
+				if (nx <= 0)
+					break;
+				nw += size_t(nx);
+			}
+			srv.close_notify();
+		});
+
+		sockpp::tls_socket cli(cliCtx, sockpp::tcp_connector(acc.address()));
+		cli.set_host("localhost");
+		if (!cli.handshake()) {
+			cerr << "Client handshake failed: " << cli.last_error_str() << endl;
+			srvThr.join();
+			return 1;
+		}
+
+		vector<char> buf(256*1024);
+		size_t nr = 0;
+		ssize_t n;
+
+		auto start = steady_clock::now();
+		while ((n = cli.read(buf.data(), buf.size())) > 0)
+			nr += size_t(n);
+		double secs = duration<double>(steady_clock::now() - start).count();
+
+		srvThr.join();
+
+		const char* name = (m == mode::USER) ? "user:    "
+						 : (m == mode::KTLS) ? "ktls:    " : "sendfile:";
+
+		cout << name << setw(9) << fixed << setprecision(1)
+			<< (nr / secs / 1.0e6) << " MB/s  [" << cli.version()
+			<< " " << cli.cipher() << "]";
+		if (ktls) {
+			cout << (ktlsSend ? "  kernel TX" : "  kTLS unavailable, user-space records")
+				<< (cli.ktls_recv() ? ", kernel RX" : "");
+		}
+		if (nr != total)
+			cout << "  [SHORT READ: " << nr << "]";
+		cout << endl;
+	}
+
+	fclose(f);
+	return 0;
+}
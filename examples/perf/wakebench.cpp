@@ -0,0 +1,181 @@
+// wakebench.cpp
+//
+// Cross-thread wakeup latency, with a pipe and with an event_fd.
+//
+// Two threads take turns waking each other, each waiting in a poller, as
+// an event loop would. The round-trip times are measured with:
+//   - pipe:      a byte written to a pipe, and read back out.
+//   - eventfd:   an event_fd counter, notified, and read.
+// Then one thread notifies the other as fast as it can, to show how many
+// notifications the reader takes with each read, as they coalesce in the
+// counter.
+//
+// USAGE:
+//     wakebench [n_round_trips]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+#include "sockpp/event_fd.h"
+#include "sockpp/latency_histogram.h"
+#include "sockpp/poller.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static size_t nrt = 100000;
+
+// --------------------------------------------------------------------------
+
+// A wakeup channel, from one thread to another.
+
+class pipe_chan
+{
+	sockpp::socket rd_, wr_;
+
+public:
+	pipe_chan() {
+		int fds[2];
+		if (::pipe2(fds, O_CLOEXEC) == 0) {
+			rd_.reset(fds[0]);
+			wr_.reset(fds[1]);
+		}
+	}
+	const sockpp::socket& handle() const { return rd_; }
+	void notify() { char c = 0; (void) !::write(wr_.handle(), &c, 1); }
+	void consume() { char c; (void) !::read(rd_.handle(), &c, 1); }
+};
+
+class event_chan
+{
+	sockpp::event_fd evt_;
+
+public:
+	const sockpp::socket& handle() const { return evt_; }
+	void notify() { evt_.notify(); }
+	void consume() { uint64_t n; evt_.read(n); }
+};
+
+// Each side waits in a poller for its channel, then wakes the other.
+
+template <typename Chan>
+static sockpp::latency_histogram ping_pong()
+{
+	Chan ping, pong;
+	sockpp::poller p1, p2;
+	p1.add(pong.handle());
+	p2.add(ping.handle());
+
+	thread peer([&] {
+		epoll_event ev;
+		for (size_t i=0; i<nrt; ++i) {
+			while (p2.wait(&ev, 1, milliseconds(-1)) < 1)
+				;
+			ping.consume();
+			pong.notify();
+		}
+	});
+
+	sockpp::latency_histogram hist;
+	epoll_event ev;
+
+	for (size_t i=0; i<nrt; ++i) {
+		auto t0 = steady_clock::now();
+		ping.notify();
+		while (p1.wait(&ev, 1, milliseconds(-1)) < 1)
+			;
+		pong.consume();
+		hist.record(steady_clock::now() - t0);
+	}
+
+	peer.join();
+	return hist;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1) nrt = size_t(atoi(argv[1]));
+
+	sockpp::socket_initializer sockInit;
+
+	cout << nrt << " round trips between two threads\n" << endl;
+	cout << setw(10) << "mode" << setw(12) << "p50 (us)" << setw(12) << "p99 (us)"
+		<< setw(12) << "p99.9 (us)" << setw(12) << "max (us)" << endl;
+
+	auto print = [](const char* name, const sockpp::latency_histogram& h) {
+		cout << setw(10) << name << fixed << setprecision(2)
+			<< setw(12) << (h.value_at_percentile(50.0) / 1000.0)
+			<< setw(12) << (h.value_at_percentile(99.0) / 1000.0)
+			<< setw(12) << (h.value_at_percentile(99.9) / 1000.0)
+			<< setw(12) << (h.max() / 1000.0) << endl;
+	};
+
+	print("pipe", ping_pong<pipe_chan>());
+	print("eventfd", ping_pong<event_chan>());
+
+	// Coalescing: a burst of notifications, and how many reads they take.
+
+	const uint64_t NBURST = 1000000;
+	sockpp::event_fd evt;
+	sockpp::poller p;
+	p.add(evt);
+
+	thread prod([&] {
+		for (uint64_t i=0; i<NBURST; ++i)
+			evt.notify();
+	});
+
+	uint64_t total = 0, nreads = 0, n;
+	epoll_event ev;
+	while (total < NBURST) {
+		if (p.wait(&ev, 1, milliseconds(-1)) < 1)
+			continue;
+		evt.read(n);
+		total += n;
+		++nreads;
+	}
+	prod.join();
+
+	cout << "\n" << NBURST << " notifications taken in " << nreads << " reads ("
+		<< setprecision(1) << (double(NBURST) / nreads) << " per read)" << endl;
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+// wqbench.cpp
+//
+// Benchmark of multiple producer threads writing to a single TCP socket.
+//
+// This compares producers that serialize on a mutex around write_n()
+// against producers that submit to a lock-free write_queue which a single
+// owner thread drains with gather writes.
+//
+// USAGE:
+//     wqbench [nprod [nmsg [msgsz]]]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/write_queue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// Reads and discards everything from the socket until the peer closes it.
+
+void run_sink(sockpp::tcp_socket sock, size_t* nrd)
+{
+	char buf[64*1024];
+	ssize_t n;
+
+	while ((n = sock.read(buf, sizeof(buf))) > 0)
+		*nrd += n;
+}
+
+// --------------------------------------------------------------------------
+
+double run_mutex(sockpp::stream_socket& sock, int nprod, int nmsg, const string& msg)
+{
+	mutex mtx;
+	vector<thread> prods;
+
+	auto start = steady_clock::now();
+
+	for (int i=0; i<nprod; ++i) {
+		prods.emplace_back([&] {
+			for (int j=0; j<nmsg; ++j) {
+				lock_guard<mutex> lk(mtx);
+				sock.write_n(msg.data(), msg.size());
+			}
+		});
+	}
+
+	for (auto& thr : prods)
+		thr.join();
+
+	return duration<double>(steady_clock::now() - start).count();
+}
+
+// --------------------------------------------------------------------------
+
+double run_queue(sockpp::stream_socket& sock, int nprod, int nmsg, const string& msg)
+{
+	sockpp::write_queue que(sock);
+	atomic<int> nrunning { nprod };
+	vector<thread> prods;
+
+	auto start = steady_clock::now();
+
+	for (int i=0; i<nprod; ++i) {
+		prods.emplace_back([&] {
+			for (int j=0; j<nmsg; ++j) {
+				while (que.over_watermark())
+					this_thread::yield();
+				que.push(msg);
+			}
+			--nrunning;
+		});
+	}
+
+	while (nrunning > 0 || !que.empty()) {
+		if (que.flush() == 0)
+			this_thread::yield();
+	}
+
+	for (auto& thr : prods)
+		thr.join();
+
+	return duration<double>(steady_clock::now() - start).count();
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	int nprod = (argc > 1) ? atoi(argv[1]) : 8;
+	int nmsg  = (argc > 2) ? atoi(argv[2]) : 100000;
+	size_t sz = (argc > 3) ? size_t(atoi(argv[3])) : 64;
+
+	sockpp::socket_initializer sockInit;
+
+	string msg(sz, 'x');
+	double nbytes = double(nprod) * nmsg * sz;
+
+	cout << nprod << " producers, " << nmsg << " messages each, "
+		<< sz << " bytes per message" << endl;
+
+	for (int mode=0; mode<2; ++mode) {
+		sockpp::tcp_acceptor acc(sockpp::inet_address("localhost", 0));
+		if (!acc) {
+			cerr << "Error creating the acceptor: " << acc.last_error_str() << endl;
+			return 1;
+		}
+
+		sockpp::tcp_connector conn(acc.address());
+		if (!conn) {
+			cerr << "Error connecting: " << conn.last_error_str() << endl;
+			return 1;
+		}
+
+		size_t nrd = 0;
+		thread sink(run_sink, acc.accept(), &nrd);
+
+		double secs = (mode == 0) ? run_mutex(conn, nprod, nmsg, msg)
+								  : run_queue(conn, nprod, nmsg, msg);
+		conn.close();
+		sink.join();
+
+		cout << ((mode == 0) ? "mutex + write_n: " : "write_queue:     ")
+			<< (nprod * double(nmsg) / secs / 1.0e6) << " Mmsg/s, "
+			<< (nbytes / secs / 1.0e6) << " MB/s"
+			<< ((nrd == size_t(nbytes)) ? "" : " [SHORT READ]") << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+// wsmaskbench.cpp
+//
+// Benchmark of WebSocket payload masking.
+//
+// This measures the throughput of each masking implementation that the CPU
+// supports, over a range of frame sizes, against a byte-at-a-time loop
+// like the ones typically written by hand.
+//
+// USAGE:
+//     wsmaskbench [total_mb]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "sockpp/websocket.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+// The baseline: one byte at a time. The noinline keeps the compiler from
+// folding it into the timing loop.
+
+__attribute__((noinline))
+void mask_bytewise(uint8_t* p, size_t n, const uint8_t key[4])
+{
+	for (size_t i=0; i<n; ++i)
+		p[i] ^= key[i & 3];
+}
+
+// --------------------------------------------------------------------------
+// Masks frames of the given size over and over until the total is reached,
+// returning the rate in GB/s.
+
+template <typename F>
+double run(size_t frameSz, size_t total, F mask)
+{
+	vector<uint8_t> buf(frameSz, 0x5A);
+	size_t nframes = std::max<size_t>(total / frameSz, 1);
+
+	auto start = steady_clock::now();
+	for (size_t i=0; i<nframes; ++i)
+		mask(buf.data(), frameSz);
+	double secs = duration<double>(steady_clock::now() - start).count();
+
+	// Use the result so the work can't be optimized away
+	volatile uint8_t sink = buf[frameSz/2];
+	(void) sink;
+
+	return double(nframes) * frameSz / secs / 1.0e9;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	size_t total = size_t((argc > 1) ? atoi(argv[1]) : 256) * 1024 * 1024;
+	const uint8_t key[4] = { 0x12, 0x34, 0x56, 0x78 };
+
+	struct impl_info { sockpp::ws_mask_impl impl; const char* name; };
+	vector<impl_info> impls;
+
+	for (auto info : { impl_info{ sockpp::ws_mask_impl::SCALAR, "scalar" },
+					   impl_info{ sockpp::ws_mask_impl::SSE2, "sse2" },
+					   impl_info{ sockpp::ws_mask_impl::AVX2, "avx2" },
+					   impl_info{ sockpp::ws_mask_impl::AVX512, "avx512" } }) {
+		if (sockpp::ws_mask_supported(info.impl))
+			impls.push_back(info);
+	}
+
+	cout << "Masking throughput, GB/s (" << (total >> 20) << " MB per run)\n" << endl;
+
+	cout << setw(8) << "size" << setw(10) << "bytewise";
+	for (auto& info : impls)
+		cout << setw(10) << info.name;
+	cout << endl;
+
+	cout << fixed << setprecision(2);
+
+	for (size_t sz : { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576 }) {
+		cout << setw(8) << sz;
+		cout << setw(10) << run(sz, total, [&](uint8_t* p, size_t n) {
+			mask_bytewise(p, n, key);
+		});
+
+		for (auto& info : impls) {
+			cout << setw(10) << run(sz, total, [&](uint8_t* p, size_t n) {
+				sockpp::ws_mask(info.impl, p, n, key);
+			});
+		}
+		cout << endl;
+	}
+
+	return 0;
+}
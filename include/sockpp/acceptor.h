@@ -52,6 +52,30 @@ namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Statistics for the queue of connections waiting to be accepted.
+ */
+struct listen_stats
+{
+	/** The number of connections in the queue, waiting to be accepted */
+	unsigned pending;
+	/** The maximum size of the queue (the effective backlog) */
+	unsigned max_pending;
+	/**
+	 * The number of times a connection could not be queued because the
+	 * queue was full. On Linux, the kernel only keeps this for the whole
+	 * network namespace, not for each socket.
+	 */
+	uint64_t overflows;
+	/**
+	 * The number of incoming connection requests that were dropped,
+	 * including overflows. This is also namespace-wide on Linux.
+	 */
+	uint64_t drops;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
 /// Class for creating a streaming server.
 /// Objects of this class bind and listen on streaming ports for incoming
 /// connections. Normally, a server thread creates one of these and blocks
@@ -65,11 +89,19 @@ class acceptor : public socket
 	acceptor(const acceptor&) =delete;
 	acceptor& operator=(const acceptor&) =delete;
 
-protected:
+public:
+	/**
+	 * Queue size value that tells the acceptor to use the largest
+	 * listener queue that the system allows.
+	 * @sa max_que_size()
+	 */
+	static const int AUTO_QUE_SIZE = -1;
 	/**
 	 * The default listener queue size.
 	 */
-	static const int DFLT_QUE_SIZE = 4;
+	static const int DFLT_QUE_SIZE = AUTO_QUE_SIZE;
+
+protected:
 	/**
 	 * The local address to which the acceptor is bound.
 	 */
@@ -82,10 +114,13 @@ protected:
 	bool bind(const sockaddr* addr, socklen_t len);
 	/**
 	 * Sets the socket listening on the address to which it is bound.
-	 * @param queSize The listener queue size.
+	 * @param queSize The listener queue size, or @ref AUTO_QUE_SIZE to use
+	 *  			  the system maximum.
 	 * @return @em true on success, @em false on error
 	 */
 	bool listen(int queSize) {
+		if (queSize < 0)
+			queSize = max_que_size();
 		return check_ret_bool(::listen(handle(), queSize));
 	};
 
@@ -103,6 +138,14 @@ public:
     acceptor(sock_address_ref addr, int queSize=DFLT_QUE_SIZE) {
         open(addr.sockaddr_ptr(), addr.size(), queSize);
     }
+	/**
+	 * Gets the largest listener queue size that the system allows.
+	 * On Linux this is read from the `net.core.somaxconn` sysctl, and
+	 * otherwise is SOMAXCONN. This is what's used for a queue size of
+	 * @ref AUTO_QUE_SIZE.
+	 * @return The maximum listener queue size.
+	 */
+	static int max_que_size();
 	/**
 	 * Gets the local address to which we are bound.
 	 * @return The local address to which we are bound.
@@ -133,6 +176,54 @@ public:
 	bool open(const sock_address_ref& addr, int queSize=DFLT_QUE_SIZE) {
 		return open(addr.sockaddr_ptr(), addr.size(), queSize);
 	}
+	/**
+	 * Defers accepting a connection until the client has sent data.
+	 *
+	 * Normally a connection becomes ready to accept as soon as the
+	 * handshake completes, and the thread that accepts it then blocks
+	 * waiting for the request. With this, the kernel holds on to the
+	 * connection until data arrives, up to the timeout. It uses
+	 * TCP_DEFER_ACCEPT on Linux, and the "dataready" accept filter
+	 * (SO_ACCEPTFILTER) on the BSD's, which ignores the timeout.
+	 *
+	 * This is only useful for protocols in which the client speaks first.
+	 *
+	 * @param timeout The maximum time to wait for data. Zero turns the
+	 *  			  feature off.
+	 * @return @em true on success, @em false on error or if not
+	 *  	   supported on this platform.
+	 */
+	bool defer_accept(const std::chrono::seconds& timeout);
+	#if defined(__linux__)
+	/**
+	 * Gets statistics for the listener queue.
+	 * The pending connection count and the maximum size of the queue come
+	 * from the TCP_INFO for this socket. The overflow and drop counters
+	 * come from the kernel's `ListenOverflows` and `ListenDrops` counters
+	 * in /proc/net/netstat.
+	 * @param st Gets the statistics.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool queue_stats(listen_stats& st);
+	#endif
+	#if defined(TCP_FASTOPEN)
+	/**
+	 * Enables TCP Fast Open on the listening socket.
+	 * This lets clients that hold a TFO cookie send data in the SYN, which
+	 * is delivered to the application as soon as the connection is
+	 * accepted, saving a round trip.
+	 *
+	 * On Linux the server side also needs to be enabled by the
+	 * `net.ipv4.tcp_fastopen` sysctl (bit value 2).
+	 *
+	 * @param qlen The maximum number of pending TFO requests, which have
+	 *  		   not yet completed the three-way handshake.
+	 * @return @em true on success, @em false on error
+	 */
+	bool fast_open(int qlen) {
+		return set_option(IPPROTO_TCP, TCP_FASTOPEN, &qlen, sizeof(int));
+	}
+	#endif
 	/**
 	 * Accepts an incoming TCP connection and gets the address of the client.
 	 * @param clientAddr Pointer to the variable that will get the
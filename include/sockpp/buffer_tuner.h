@@ -0,0 +1,270 @@
+/**
+ * @file buffer_tuner.h
+ *
+ * Sizes the buffers of TCP connections from their bandwidth-delay product.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_buffer_tuner_h
+#define __sockpp_buffer_tuner_h
+
+#include "sockpp/socket.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The buffer sizes of a connection, in bytes, as reported by the kernel.
+ */
+struct buffer_sizes
+{
+	/** The send buffer (SO_SNDBUF) */
+	size_t sndBuf;
+	/** The receive buffer (SO_RCVBUF) */
+	size_t rcvBuf;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sizes the send and receive buffers of TCP connections to match their
+ * bandwidth-delay product (BDP), within a memory budget for all of them.
+ *
+ * A fixed buffer size is wrong for almost every connection. Too small, and
+ * it caps a long, fast path at one buffer per round trip. Too large, and
+ * thousands of short-RTT connections pin memory they'll never use. The
+ * tuner instead samples each connection's TCP_INFO and sizes its buffers
+ * to what it needs:
+ *   @li The send buffer gets twice the larger of the BDP (delivery rate
+ *   	 times the smoothed RTT) and the congestion window, while the
+ *   	 connection is sending. If the sender was held back by its buffer
+ *   	 since the last sample, the buffer is doubled.
+ *   @li The receive buffer gets twice the BDP seen by the receiver (the
+ *   	 rate that data arrived since the last sample, times the receiver's
+ *   	 RTT estimate). If that fills most of the window the buffer allows,
+ *   	 it's doubled.
+ *
+ * Each buffer is kept between a minimum and a maximum. If the total would
+ * go over the budget, every connection's share above the minimum is scaled
+ * down by the same factor. Small changes are ignored, so that the sizes
+ * don't churn.
+ *
+ * The sizes, and the budget, are in terms of what the kernel reports for
+ * SO_SNDBUF and SO_RCVBUF, which is twice the value set, to allow for its
+ * overhead. Setting the sizes turns off the kernel's own buffer
+ * auto-tuning for the connection, and they can't go past the
+ * `net.core.wmem_max` and `net.core.rmem_max` sysctls.
+ *
+ * Like the @ref connection_tracker, this only remembers the handles of the
+ * sockets, so a socket must be removed before it's closed. The
+ * @ref buffer_tuner::guard takes care of that. The tuner doesn't run on
+ * its own; call @ref tune() periodically, every few hundred milliseconds
+ * or so, from a timer or a housekeeping thread.
+ */
+class buffer_tuner
+{
+	/** The clock for the sample times */
+	using clock = std::chrono::steady_clock;
+
+	/** The state of a connection */
+	struct conn {
+		/** The current buffer sizes */
+		buffer_sizes cur;
+		/** The sizes the connection wants, before the budget */
+		buffer_sizes want;
+		/** The bytes sent and acknowledged, at the last sample */
+		uint64_t bytesAcked;
+		/** The bytes received, at the last sample */
+		uint64_t bytesRecv;
+		/** The time limited by the send buffer, at the last sample */
+		uint64_t sndbufLimited;
+		/** The time of the last sample */
+		clock::time_point when;
+	};
+
+	/** Lock for the connections */
+	mutable std::mutex lock_;
+	/** The connections, by handle */
+	std::map<socket_t, conn> conns_;
+	/** The memory budget for all the buffers */
+	size_t budget_;
+	/** The smallest size for a buffer */
+	size_t minBuf_;
+	/** The largest size for a buffer */
+	size_t maxBuf_;
+
+	/** Works out what the connection wants, from its statistics */
+	void sample(socket_t h, conn& c, clock::time_point now);
+	/** Sets a buffer size, updating it to what the kernel reports */
+	static bool set_buffer(socket_t h, int opt, size_t& cur, size_t sz);
+
+	// Non-copyable
+	buffer_tuner(const buffer_tuner&) =delete;
+	buffer_tuner& operator=(const buffer_tuner&) =delete;
+
+public:
+	/** The default minimum buffer size */
+	static const size_t DFLT_MIN_BUF = 64*1024;
+	/** The default maximum buffer size */
+	static const size_t DFLT_MAX_BUF = 8*1024*1024;
+
+	/**
+	 * Scoped registration of a connection.
+	 *
+	 * This adds the socket to the tuner on construction and removes it on
+	 * destruction. It should be declared after the socket, so that it is
+	 * destroyed first.
+	 */
+	class guard
+	{
+		/** The tuner. Null if the socket was not added. */
+		buffer_tuner* tuner_;
+		/** The handle of the socket */
+		socket_t handle_;
+
+		// Non-copyable
+		guard(const guard&) =delete;
+		guard& operator=(const guard&) =delete;
+
+	public:
+		/**
+		 * Adds the socket to the tuner.
+		 * @param tuner The buffer tuner.
+		 * @param sock The connected socket.
+		 */
+		guard(buffer_tuner& tuner, const socket& sock)
+			: tuner_(tuner.add(sock) ? &tuner : nullptr),
+				handle_(sock.handle()) {}
+		/**
+		 * Removes the socket from the tuner.
+		 */
+		~guard() {
+			if (tuner_)
+				tuner_->remove(handle_);
+		}
+		/**
+		 * Determines if the socket was added to the tuner.
+		 * @return @em true if it was added, @em false if not.
+		 */
+		explicit operator bool() const { return tuner_ != nullptr; }
+	};
+
+	/**
+	 * Creates a tuner.
+	 * @param budget The most memory for the buffers of all the connections.
+	 *  			 Each connection gets at least the minimum for both its
+	 *  			 buffers, even if that goes over.
+	 * @param minBuf The smallest size for a buffer. This should be at
+	 *  			  least a few times the MSS, or a connection can stall
+	 *  			  on a zero window. On the loopback, the MSS is 64K.
+	 * @param maxBuf The largest size for a buffer.
+	 */
+	explicit buffer_tuner(size_t budget, size_t minBuf=DFLT_MIN_BUF,
+						  size_t maxBuf=DFLT_MAX_BUF);
+	/**
+	 * Adds a connection to the tuner.
+	 * Both of its buffers start out at the minimum size.
+	 * @param sock A connected TCP socket.
+	 * @return @em true if the connection was added, @em false if the
+	 *  	   socket isn't open, or its buffers couldn't be set.
+	 */
+	bool add(const socket& sock);
+	/**
+	 * Removes a connection from the tuner.
+	 * The connection keeps its current buffer sizes.
+	 * @param sock The connected socket.
+	 */
+	void remove(const socket& sock) { remove(sock.handle()); }
+	/**
+	 * Removes a connection from the tuner.
+	 * @param h The handle of the connected socket.
+	 */
+	void remove(socket_t h);
+	/**
+	 * Gets the number of connections being tuned.
+	 * @return The number of connections.
+	 */
+	size_t size() const;
+	/**
+	 * Gets the memory budget.
+	 * @return The budget for all the buffers, in bytes.
+	 */
+	size_t budget() const;
+	/**
+	 * Sets the memory budget.
+	 * This takes effect on the next call to @ref tune().
+	 * @param budget The budget for all the buffers, in bytes.
+	 */
+	void set_budget(size_t budget);
+	/**
+	 * Gets the total size of the buffers of all the connections.
+	 * @return The memory used for buffers, in bytes.
+	 */
+	size_t used() const;
+	/**
+	 * Gets the current buffer sizes of a connection.
+	 * @param sock The connected socket.
+	 * @param sz Gets the buffer sizes.
+	 * @return @em true if the connection is being tuned, @em false if not.
+	 */
+	bool get_sizes(const socket& sock, buffer_sizes& sz) const;
+	/**
+	 * Samples all the connections, and resizes their buffers.
+	 * @return The number of connections whose buffers were changed.
+	 */
+	size_t tune();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// __linux__
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_buffer_tuner_h
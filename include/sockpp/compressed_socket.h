@@ -0,0 +1,312 @@
+/**
+ * @file compressed_socket.h
+ *
+ * Streaming compression over a stream socket, with LZ4 or zstd.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_compressed_socket_h
+#define __sockpp_compressed_socket_h
+
+#include "sockpp/stream_socket.h"
+#include <memory>
+#include <vector>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A stream socket that compresses everything it sends and decompresses
+ * everything it receives.
+ *
+ * Data is run through a streaming LZ4 or zstd context as it is written, so
+ * there's no need to buffer up whole messages to compress them. Each call
+ * to @ref write() is a message boundary: the compressor is flushed, and
+ * everything written so far can be decoded by the peer as soon as it
+ * arrives. Calls to @ref write_more() add to the current message without
+ * flushing, which gives better compression for messages built up in
+ * pieces.
+ *
+ * The compression level can adapt to the connection. When a range of
+ * levels is set, the socket checks the kernel's send queue at message
+ * boundaries. A growing backlog means that the network is the bottleneck,
+ * so it's worth spending more CPU time to send fewer bytes, and the level
+ * is stepped up. An empty queue means that the network is keeping up, and
+ * the level is stepped down. Since a level can only be changed at the
+ * start of a compressed frame, this ends the current frame, and so is done
+ * at most once per @ref ADAPT_INTERVAL bytes of input.
+ *
+ * Both ends of the connection must use the same algorithm. The support for
+ * each one is optional, and determined when the library is built. Use
+ * @ref supported() to see what's available.
+ */
+class compressed_socket : public stream_socket
+{
+public:
+	/** The compression algorithms */
+	enum algorithm { LZ4, ZSTD };
+
+	/** The operation to finish a piece of compressed output */
+	enum class flush_mode { CONTINUE, FLUSH, END };
+
+	/** The interface to the compression library */
+	class codec;
+
+private:
+	/** The base class */
+	using base = stream_socket;
+
+	/** The compression library state */
+	std::unique_ptr<codec> codec_;
+	/** The current compression level */
+	int level_;
+	/** The lowest level for adaptive compression */
+	int minLevel_;
+	/** The highest level for adaptive compression */
+	int maxLevel_;
+	/** At or below this many queued bytes, the level goes down */
+	size_t loBacklog_;
+	/** At or above this many queued bytes, the level goes up */
+	size_t hiBacklog_;
+	/** Input bytes since the level was last considered */
+	size_t sinceAdapt_;
+	/** Uncompressed bytes sent */
+	uint64_t rawSent_;
+	/** Compressed bytes sent */
+	uint64_t wireSent_;
+	/** Compressed output waiting to be sent */
+	std::vector<uint8_t> outBuf_;
+	/** The number of bytes in the output buffer */
+	size_t outLen_;
+	/** Compressed input from the socket */
+	std::vector<uint8_t> inBuf_;
+	/** The position of the unread input */
+	size_t inPos_;
+	/** The number of bytes in the input buffer */
+	size_t inLen_;
+	/** Whether the decompressor may be holding output */
+	bool inPending_;
+
+	/** Compresses data into the output buffer */
+	bool compress(const void* buf, size_t n, flush_mode mode);
+	/** Sends and clears the output buffer */
+	bool send_output();
+	/** Picks the mode for the end of a message, adapting the level */
+	flush_mode message_end(size_t n);
+
+	// Non-copyable
+	compressed_socket(const compressed_socket&) =delete;
+	compressed_socket& operator=(const compressed_socket&) =delete;
+
+public:
+	/**
+	 * Input bytes between adjustments of the compression level.
+	 */
+	static const size_t ADAPT_INTERVAL = 1024*1024;
+	/**
+	 * The default send queue size at which the level goes down.
+	 */
+	static const size_t DFLT_LO_BACKLOG = 16*1024;
+	/**
+	 * The default send queue size at which the level goes up.
+	 */
+	static const size_t DFLT_HI_BACKLOG = 256*1024;
+	/**
+	 * The size of the buffer for compressed input.
+	 */
+	static const size_t READ_BUF_SIZE = 64*1024;
+	/**
+	 * Determines if an algorithm was built into the library.
+	 * @param alg The compression algorithm.
+	 * @return @em true if it is available, @em false if not.
+	 */
+	static bool supported(algorithm alg);
+	/**
+	 * Gets the default compression level for an algorithm.
+	 * @param alg The compression algorithm.
+	 * @return The library's default level.
+	 */
+	static int default_level(algorithm alg);
+	/**
+	 * Gets the highest compression level for an algorithm.
+	 * @param alg The compression algorithm.
+	 * @return The highest level.
+	 */
+	static int max_level(algorithm alg);
+	/**
+	 * Creates an unconnected compressed socket.
+	 */
+	compressed_socket();
+	/**
+	 * Wraps a connected socket with compression.
+	 * If the algorithm is not supported, the socket is left in an error
+	 * state with EPROTONOSUPPORT.
+	 * @param sock The connected socket. This takes ownership of it.
+	 * @param alg The compression algorithm.
+	 * @param level The compression level.
+	 */
+	compressed_socket(stream_socket&& sock, algorithm alg, int level);
+	/**
+	 * Wraps a connected socket, using the algorithm's default level.
+	 * @param sock The connected socket. This takes ownership of it.
+	 * @param alg The compression algorithm.
+	 */
+	compressed_socket(stream_socket&& sock, algorithm alg)
+		: compressed_socket(std::move(sock), alg, default_level(alg)) {}
+	/**
+	 * Move constructor.
+	 * @param sock The other socket.
+	 */
+	compressed_socket(compressed_socket&& sock);
+	/**
+	 * Move assignment.
+	 * @param rhs The other socket.
+	 * @return A reference to this one.
+	 */
+	compressed_socket& operator=(compressed_socket&& rhs);
+	/**
+	 * Destructor.
+	 */
+	~compressed_socket() override;
+	/**
+	 * Gets the current compression level.
+	 * @return The current compression level.
+	 */
+	int level() const { return level_; }
+	/**
+	 * Lets the compression level adapt to the send backlog.
+	 * The level is kept within the range, and starts at the low end. A
+	 * range of a single level turns adaptation off.
+	 * @param minLevel The lowest level.
+	 * @param maxLevel The highest level.
+	 */
+	void set_level_range(int minLevel, int maxLevel);
+	/**
+	 * Sets the send queue sizes that move the compression level.
+	 * @param lo At or below this many queued bytes, the level goes down.
+	 * @param hi At or above this many queued bytes, the level goes up.
+	 */
+	void set_backlog_thresholds(size_t lo, size_t hi) {
+		loBacklog_ = lo;
+		hiBacklog_ = hi;
+	}
+	/**
+	 * Gets the number of uncompressed bytes sent.
+	 * @return The number of bytes written by the application.
+	 */
+	uint64_t raw_bytes_sent() const { return rawSent_; }
+	/**
+	 * Gets the number of compressed bytes sent.
+	 * @return The number of bytes written to the socket.
+	 */
+	uint64_t wire_bytes_sent() const { return wireSent_; }
+	/**
+	 * Ends the current compressed frame.
+	 * This sends the frame trailer, and should be called after the last
+	 * message so that the peer sees a complete stream.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool finish();
+
+	using base::write;
+
+	/**
+	 * Reads and decompresses data from the socket.
+	 * @param buf Buffer to get the uncompressed data.
+	 * @param n The number of bytes to try to read.
+	 * @return The number of bytes read on success, 0 at the end of the
+	 *  	   stream, or @em -1 on error. A corrupt stream is reported as
+	 *  	   EPROTO.
+	 */
+	ssize_t read(void *buf, size_t n) override;
+	/**
+	 * Reads and decompresses data, spinning for a while before blocking.
+	 * Data left over from the last read is returned right away. Otherwise
+	 * this spins until more compressed data arrives, then reads it
+	 * normally.
+	 * @param buf Buffer to get the uncompressed data.
+	 * @param n The number of bytes to try to read.
+	 * @param spin The maximum time to spin before blocking.
+	 * @return The number of bytes read on success, 0 at the end of the
+	 *  	   stream, or @em -1 on error.
+	 */
+	ssize_t read_spin(void *buf, size_t n,
+					  const std::chrono::microseconds& spin) override;
+	/**
+	 * Compresses and sends a message.
+	 * The compressor is flushed, so the peer can decode everything sent
+	 * so far.
+	 * @param buf The data to send.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written (all of them) on success, or
+	 *  	   @em -1 on error.
+	 */
+	ssize_t write(const void *buf, size_t n) override;
+	/**
+	 * Compresses and sends a message gathered from several buffers.
+	 * @param ranges The buffers to send.
+	 * @return The number of bytes written on success, or @em -1 on error.
+	 */
+	ssize_t write(const std::vector<iovec>& ranges) override;
+	/**
+	 * Compresses data as part of a larger message, without flushing.
+	 * Some or all of the compressed data may be held back until the end of
+	 * the message is written with @ref write().
+	 * @param buf The data to send.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written (all of them) on success, or
+	 *  	   @em -1 on error.
+	 */
+	ssize_t write_more(const void *buf, size_t n) override;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_compressed_socket_h
@@ -0,0 +1,215 @@
+/**
+ * @file connection_tracker.h
+ *
+ * Tracking of live server connections for a graceful shutdown.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_connection_tracker_h
+#define __sockpp_connection_tracker_h
+
+#include "sockpp/acceptor.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The outcome of draining the connections of a server.
+ */
+struct drain_stats
+{
+	/** Connections that closed on their own before the deadline */
+	size_t drained;
+	/** Connections that were still open at the deadline, and cut off */
+	size_t forced;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Keeps track of the live connections of a server so that they can be
+ * drained for a graceful shutdown.
+ *
+ * Each connection handler registers its socket when it starts and removes
+ * it when it is done, typically with a @ref connection_tracker::guard. The
+ * tracker does not own the sockets; it just remembers their handles.
+ *
+ * A call to @ref drain() then:
+ *   @li Stops the acceptor, if one is given, which wakes up a thread
+ *   	 blocked in accept() with an error.
+ *   @li Shuts down the read side of each live connection. A handler that
+ *   	 is blocked waiting for the next request sees end-of-file, while one
+ *   	 in the middle of sending a response can still finish it.
+ *   @li Waits, up to a deadline, for the handlers to close their
+ *   	 connections.
+ *   @li Shuts down both directions of any connections still open, which
+ *   	 forces their handlers to give up.
+ *
+ * If a handler sets the linger timeout to zero on its socket, a forced
+ * close resets the connection rather than waiting to send any unsent data.
+ *
+ * Since the handles are only looked up and shut down, never closed, by the
+ * tracker, a handler must remove its socket @em before closing it. Otherwise
+ * the handle number might be reused by an unrelated socket.
+ */
+class connection_tracker
+{
+	/** Lock for the set of connections */
+	mutable std::mutex lock_;
+	/** Signaled when a connection is removed */
+	std::condition_variable cv_;
+	/** The handles of the live connections */
+	std::set<socket_t> conns_;
+	/** Whether a drain was started */
+	bool draining_;
+
+	// Non-copyable
+	connection_tracker(const connection_tracker&) =delete;
+	connection_tracker& operator=(const connection_tracker&) =delete;
+
+public:
+	/**
+	 * Scoped registration of a connection.
+	 *
+	 * This adds the socket to the tracker on construction and removes it on
+	 * destruction. It should be declared after the socket, so that it is
+	 * destroyed first.
+	 */
+	class guard
+	{
+		/** The tracker. Null if the socket was not added. */
+		connection_tracker* tracker_;
+		/** The handle of the socket */
+		socket_t handle_;
+
+		// Non-copyable
+		guard(const guard&) =delete;
+		guard& operator=(const guard&) =delete;
+
+	public:
+		/**
+		 * Adds the socket to the tracker.
+		 * @param tracker The connection tracker.
+		 * @param sock The connected socket.
+		 */
+		guard(connection_tracker& tracker, const socket& sock)
+			: tracker_(tracker.add(sock) ? &tracker : nullptr),
+				handle_(sock.handle()) {}
+		/**
+		 * Removes the socket from the tracker.
+		 */
+		~guard() {
+			if (tracker_)
+				tracker_->remove(handle_);
+		}
+		/**
+		 * Determines if the socket was added to the tracker.
+		 * @return @em false if the tracker was already draining, in which
+		 *  	   case the connection should be closed right away.
+		 */
+		explicit operator bool() const { return tracker_ != nullptr; }
+	};
+
+	/**
+	 * Creates an empty tracker.
+	 */
+	connection_tracker() : draining_(false) {}
+	/**
+	 * Adds a connection to the tracker.
+	 * @param sock The connected socket.
+	 * @return @em true if the connection was added, @em false if the
+	 *  	   tracker is draining, or the socket is not open. In either
+	 *  	   case the connection should be closed.
+	 */
+	bool add(const socket& sock);
+	/**
+	 * Removes a connection from the tracker.
+	 * @param sock The connected socket.
+	 */
+	void remove(const socket& sock) { remove(sock.handle()); }
+	/**
+	 * Removes a connection from the tracker.
+	 * @param h The handle of the connected socket.
+	 */
+	void remove(socket_t h);
+	/**
+	 * Gets the number of live connections.
+	 * @return The number of live connections.
+	 */
+	size_t size() const;
+	/**
+	 * Determines if a drain was started.
+	 * An acceptor loop can use this to tell if an accept() failed because
+	 * the server is shutting down.
+	 * @return @em true if the tracker is draining, @em false otherwise.
+	 */
+	bool draining() const;
+	/**
+	 * Drains the live connections.
+	 * @param timeout The maximum time to wait for the connections to close
+	 *  			  on their own.
+	 * @return The number of connections that were drained cleanly, and the
+	 *  	   number that were forced.
+	 */
+	drain_stats drain(const std::chrono::milliseconds& timeout);
+	/**
+	 * Stops the acceptor, then drains the live connections.
+	 * @param acc The server's acceptor. It is shut down, but not closed,
+	 *  		  so that a thread blocked in accept() can safely return.
+	 * @param timeout The maximum time to wait for the connections to close
+	 *  			  on their own.
+	 * @return The number of connections that were drained cleanly, and the
+	 *  	   number that were forced.
+	 */
+	drain_stats drain(acceptor& acc, const std::chrono::milliseconds& timeout);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_connection_tracker_h
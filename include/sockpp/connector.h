@@ -128,6 +128,47 @@ public:
 	bool connect(const sock_address_ref& addr) {
 		return connect(addr.sockaddr_ptr(), addr.size());
 	}
+	/**
+	 * Connects to the specified server with TCP Fast Open, sending the
+	 * initial data along with the connection request.
+	 *
+	 * Where supported, this uses `sendto()` with the MSG_FASTOPEN flag.
+	 * If the client has a TFO cookie for the server, the data goes out in
+	 * the SYN and the server can act on it without waiting for a full
+	 * round trip. Otherwise the kernel falls back to a regular handshake,
+	 * requests a cookie for next time, and sends the data once connected.
+	 * Either way, the caller sees a connected socket with the data sent.
+	 * Use @ref used_fast_open() afterwards to find out which happened.
+	 *
+	 * On platforms without MSG_FASTOPEN, this does a plain connect()
+	 * followed by write_n().
+	 *
+	 * If the socket is currently connected, this will close the current
+	 * connection and open the new one.
+	 *
+	 * @param addr The remote server address.
+	 * @param len The length of the address structure in bytes
+	 * @param buf The initial data to send.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes of the initial data sent, which should
+	 *  	   be 'n' on success, or @em -1 on error.
+	 */
+	ssize_t connect_fast_open(const sockaddr* addr, socklen_t len,
+							  const void* buf, size_t n);
+	/**
+	 * Connects to the specified server with TCP Fast Open, sending the
+	 * initial data along with the connection request.
+	 * @sa connect_fast_open(const sockaddr*, socklen_t, const void*, size_t)
+	 * @param addr The remote server address.
+	 * @param buf The initial data to send.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes of the initial data sent, or @em -1 on
+	 *  	   error.
+	 */
+	ssize_t connect_fast_open(const sock_address_ref& addr,
+							  const void* buf, size_t n) {
+		return connect_fast_open(addr.sockaddr_ptr(), addr.size(), buf, n);
+	}
 };
 
 /////////////////////////////////////////////////////////////////////////////
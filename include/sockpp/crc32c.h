@@ -0,0 +1,190 @@
+/**
+ * @file crc32c.h
+ *
+ * CRC32C checksums, and integrity-checked framing over stream sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_crc32c_h
+#define __sockpp_crc32c_h
+
+#include "sockpp/stream_socket.h"
+#include <string>
+#include <vector>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The implementations of the CRC32C calculation.
+ */
+enum class crc32c_impl {
+	TABLE,		///< Portable, table-driven, eight bytes at a time
+	SSE42,		///< The SSE 4.2 crc32 instruction
+	PCLMUL		///< Three interleaved crc32 streams, combined with PCLMULQDQ
+};
+
+/**
+ * Gets the fastest CRC32C implementation supported by this CPU.
+ * @return The fastest CRC32C implementation supported by this CPU.
+ */
+crc32c_impl crc32c_best();
+/**
+ * Determines if a CRC32C implementation can be used on this CPU.
+ * @param impl The implementation.
+ * @return @em true if the CPU supports it, @em false if not.
+ */
+bool crc32c_supported(crc32c_impl impl);
+/**
+ * Computes the CRC32C (Castagnoli) checksum of a block of data.
+ *
+ * This uses the fastest implementation for the CPU, chosen the first time
+ * it's called. A checksum can be computed in pieces by passing the result
+ * for the earlier data as the starting value for the next.
+ *
+ * @param buf The data.
+ * @param n The number of bytes.
+ * @param crc The checksum of any preceding data, or zero to start.
+ * @return The checksum.
+ */
+uint32_t crc32c(const void* buf, size_t n, uint32_t crc=0);
+/**
+ * Computes the CRC32C checksum with a specific implementation.
+ * This is mainly for testing and benchmarks.
+ * @param impl The implementation. If the CPU doesn't support it, the
+ *  		   table-driven one is used.
+ * @param buf The data.
+ * @param n The number of bytes.
+ * @param crc The checksum of any preceding data, or zero to start.
+ * @return The checksum.
+ */
+uint32_t crc32c(crc32c_impl impl, const void* buf, size_t n, uint32_t crc=0);
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sends and receives checksummed frames over a stream socket.
+ *
+ * Each frame is an 8-byte header, followed by the payload. The header
+ * holds the payload length and a CRC32C of the length and payload, both
+ * as 32-bit big-endian values. So a damaged length is caught as well as
+ * damaged data.
+ *
+ * A frame is sent with a single gather write, straight from the caller's
+ * buffers, and received directly into the caller's buffer, where it is
+ * checked in place. The data is never copied within the process.
+ *
+ * An empty frame reads as zero, the same as the end of the stream, so a
+ * protocol that needs to tell them apart should not send empty frames.
+ *
+ * A bad checksum fails the read with EBADMSG, and a frame that's too large
+ * fails with EMSGSIZE, through the socket's @ref socket::last_error(). In
+ * either case the stream can no longer be trusted, and the connection
+ * should be dropped.
+ *
+ * The framer does not own the socket. The socket must outlive it.
+ */
+class crc_framer
+{
+	/** The socket */
+	stream_socket& sock_;
+	/** The largest frame payload we'll accept */
+	size_t maxFrame_;
+
+	/** Reads and checks a frame header, returning the payload length */
+	ssize_t read_header(uint32_t& crc, uint32_t& expected, size_t maxn);
+	/** Reads a payload and verifies its checksum */
+	ssize_t read_payload(void* buf, size_t len, uint32_t crc, uint32_t expected);
+
+public:
+	/** The size of a frame header */
+	static const size_t HEADER_SIZE = 8;
+	/** The default maximum frame payload */
+	static const size_t DFLT_MAX_FRAME = 64*1024*1024;
+
+	/**
+	 * Creates a framer for a socket.
+	 * @param sock The socket. It must outlive the framer.
+	 * @param maxFrame The largest frame payload to accept.
+	 */
+	explicit crc_framer(stream_socket& sock, size_t maxFrame=DFLT_MAX_FRAME)
+		: sock_(sock), maxFrame_(maxFrame) {}
+	/**
+	 * Sends a frame.
+	 * @param buf The payload.
+	 * @param n The size of the payload.
+	 * @return The size of the payload on success, @em -1 on error.
+	 */
+	ssize_t write_frame(const void* buf, size_t n);
+	/**
+	 * Sends a frame gathered from several buffers.
+	 * @param ranges The pieces of the payload.
+	 * @return The size of the payload on success, @em -1 on error.
+	 */
+	ssize_t write_frame(const std::vector<iovec>& ranges);
+	/**
+	 * Receives a frame into a buffer.
+	 * @param buf The buffer to get the payload.
+	 * @param n The size of the buffer. A larger frame is an error.
+	 * @return The size of the payload, @em 0 if the peer closed the
+	 *  	   connection cleanly before the frame, or @em -1 on error.
+	 */
+	ssize_t read_frame(void* buf, size_t n);
+	/**
+	 * Receives a frame into a string.
+	 * @param data Gets the payload. It is resized to fit.
+	 * @return The size of the payload, @em 0 if the peer closed the
+	 *  	   connection cleanly before the frame, or @em -1 on error.
+	 */
+	ssize_t read_frame(std::string& data);
+};
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_crc32c_h
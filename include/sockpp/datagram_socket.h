@@ -177,6 +177,78 @@ public:
 	int	recv(void* buf, size_t n, int flags=0) {
 		return check_ret(::recv(handle(), buf, n, flags));
 	}
+	/**
+	 * Receives a UDP packet, spinning for a while before blocking.
+	 * This first polls the socket with non-blocking receives for up to the
+	 * spin time, then falls back to a normal receive.
+	 * @sa stream_socket::read_spin
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to read.
+	 * @param spin The maximum time to spin before blocking.
+	 * @param flags The flags for the final, normal, receive.
+	 * @return The number of bytes read or @em -1 on error.
+	 */
+	int recv_spin(void* buf, size_t n, const std::chrono::microseconds& spin,
+				  int flags=0);
+
+	#if defined(__linux__)
+	/**
+	 * Sends a batch of UDP packets with a single system call.
+	 * Each message can have its own destination, or none, if the socket
+	 * is connected. On return, the msg_len field of each message that was
+	 * sent holds the number of bytes sent for it.
+	 * @param msgs The messages to send.
+	 * @param n The number of messages.
+	 * @param flags The flags for the send.
+	 * @return The number of messages sent, which may be fewer than
+	 *  	   requested, or @em -1 on error.
+	 */
+	int sendmmsg(mmsghdr* msgs, unsigned n, int flags=0) {
+		return check_ret(::sendmmsg(handle(), msgs, n, flags));
+	}
+	/**
+	 * Receives a batch of UDP packets with a single system call.
+	 * On return, the msg_len field of each message that was received holds
+	 * its size.
+	 * @param msgs The buffers for the incoming messages.
+	 * @param n The most messages to receive.
+	 * @param flags The flags for the receive. With MSG_WAITFORONE, this
+	 *  			blocks for the first packet, then takes whatever else
+	 *  			is waiting.
+	 * @return The number of messages received, or @em -1 on error.
+	 */
+	int recvmmsg(mmsghdr* msgs, unsigned n, int flags=0) {
+		return check_ret(::recvmmsg(handle(), msgs, n, flags, nullptr));
+	}
+	#endif
+	#if defined(SO_TXTIME)
+	/**
+	 * Sends a UDP packet, to leave at a specific time.
+	 * Transmit times must first be enabled on the socket with txtime(). The
+	 * socket should be connected.
+	 * @param buf The data to send.
+	 * @param n The number of bytes in the data buffer.
+	 * @param txTime The time for the packet to leave, in nanoseconds, on the
+	 *  			 clock that was given to txtime().
+	 * @param flags The flags for the send.
+	 * @return The number of bytes sent, or @em -1 on failure.
+	 */
+	int send_at(const void* buf, size_t n, uint64_t txTime, int flags=0);
+	#endif
+	#if defined(SO_TIMESTAMPNS)
+	/**
+	 * Receives a UDP packet, along with the time that it arrived.
+	 * Receive timestamps must first be enabled on the socket with
+	 * rx_timestamps().
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to read.
+	 * @param ts Gets the (real time) clock when the packet arrived, or zero
+	 *  		 if it didn't come with a timestamp.
+	 * @param flags The flags for the receive.
+	 * @return The number of bytes read or @em -1 on error.
+	 */
+	int recv_timestamped(void* buf, size_t n, timespec& ts, int flags=0);
+	#endif
 };
 
 #endif	// !WIN32
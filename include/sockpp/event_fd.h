@@ -0,0 +1,136 @@
+/**
+ * @file event_fd.h
+ *
+ * Class for an event counter that can be polled like a socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_event_fd_h
+#define __sockpp_event_fd_h
+
+#include "sockpp/socket.h"
+
+#if defined(__linux__)
+	#include <sys/eventfd.h>
+#endif
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An event counter, in the form of a file descriptor (eventfd).
+ *
+ * Each notify() adds to the counter, and a read() takes the whole count,
+ * resetting it to zero, so any number of notifications between reads
+ * cost the reader a single wakeup. The handle is readable whenever the
+ * count is non-zero, so it can wake up a thread that is waiting on a
+ * poller, or poll(), along with its sockets.
+ *
+ * This has the same handle, error, and move semantics as a socket. The
+ * socket-specific calls, like the socket options and shutdown(), don't
+ * apply to it.
+ */
+class event_fd : public socket
+{
+	/** The base class */
+	using base = socket;
+
+public:
+	/**
+	 * Creates an event counter.
+	 * Check the object with is_open(), or last_error(), for failure.
+	 * @param initVal The initial value of the counter.
+	 * @param flags The flags for the counter, such as EFD_NONBLOCK, or
+	 *  			EFD_SEMAPHORE, to make each read take just one from the
+	 *  			count.
+	 */
+	explicit event_fd(unsigned initVal=0, int flags=EFD_CLOEXEC);
+	/**
+	 * Move constructor.
+	 * @param evt The other counter.
+	 */
+	event_fd(event_fd&& evt) : base(std::move(evt)) {}
+	/**
+	 * Move assignment.
+	 * @param rhs The other counter.
+	 * @return A reference to this object.
+	 */
+	event_fd& operator=(event_fd&& rhs) {
+		base::operator=(std::move(rhs));
+		return *this;
+	}
+	/**
+	 * Adds to the counter, waking any reader.
+	 * @param n The amount to add.
+	 * @return @em true on success, @em false on failure. A non-blocking
+	 *  	   counter fails with EAGAIN if the count would overflow.
+	 */
+	bool notify(uint64_t n=1);
+	/**
+	 * Reads the counter.
+	 * This takes the whole count and resets it to zero, unless the counter
+	 * was created with EFD_SEMAPHORE, in which case it takes just one. If
+	 * the count is zero, this blocks, or, for a non-blocking counter,
+	 * fails with EAGAIN.
+	 * @param val Gets the count.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool read(uint64_t& val);
+	/**
+	 * Reads the counter, if it's set, without blocking.
+	 * For a blocking counter, this is only safe with a single reader, since
+	 * another could take the count between the check and the read.
+	 * @return The count, or zero if it wasn't set, or on an error.
+	 */
+	uint64_t try_read();
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_event_fd_h
@@ -0,0 +1,288 @@
+/**
+ * @file heartbeat_monitor.h
+ *
+ * Application-level heartbeats to detect and reap dead peers.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_heartbeat_monitor_h
+#define __sockpp_heartbeat_monitor_h
+
+#include "sockpp/socket.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Counts of the connections that were dropped because their peers died.
+ */
+struct reap_stats
+{
+	/** Connections reaped by the monitor, for missing their heartbeats */
+	size_t heartbeat;
+	/**
+	 * Connections that the kernel timed out, with keepalive probes or the
+	 * user timeout, as reported when they were removed.
+	 */
+	size_t kernel;
+
+	/**
+	 * Gets the total number of connections reaped.
+	 * @return The total number of connections reaped.
+	 */
+	size_t total() const { return heartbeat + kernel; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Detects dead peers with application-level heartbeats, and reaps their
+ * connections.
+ *
+ * A peer that crashes, or loses its network, without closing its
+ * connections leaves them half-open. On an idle connection the server
+ * never notices, and holds the socket, its buffers, and the handler's
+ * state forever. Keepalive probes and the TCP user timeout (see
+ * @ref socket::detect_dead_peer()) catch this in the kernel, but only
+ * that the peer's TCP stack is gone; a peer that's alive but hung still
+ * answers them. Heartbeats in the application's own protocol check the
+ * whole path, and can use a much shorter interval.
+ *
+ * Each connection is registered with a function that sends a ping frame,
+ * and the handler calls @ref received() whenever anything arrives from the
+ * peer, including its replies to the pings. Then, on each @ref tick():
+ *   @li A connection that's received nothing for an interval is pinged.
+ *   	 The ping function is called from the thread calling tick(), so it
+ *   	 must be safe to write to the socket from there. It must not block:
+ *   	 a peer that's alive but hung stops reading, and once its send
+ *   	 buffer fills, a blocking write would stall tick(), and with it the
+ *   	 reaping of every connection. Send with MSG_DONTWAIT, or push the
+ *   	 ping onto a write_queue.
+ *   @li A connection that's received nothing for the number of missed
+ *   	 intervals is reaped. Each ping that fails since the peer was last
+ *   	 heard from counts as another missed interval. The socket is shut
+ *   	 down, which wakes the handler with end-of-file or an error, so
+ *   	 that it cleans up and closes the connection.
+ *
+ * So a dead peer is reaped within the missed intervals, plus the time
+ * between ticks.
+ *
+ * Like the @ref connection_tracker, the monitor only remembers the handles
+ * of the sockets, so a socket must be removed before it's closed. The
+ * @ref heartbeat_monitor::guard takes care of that. Removing a connection
+ * waits for a ping that's being sent on it to return, so that once it's
+ * removed, whatever the ping function refers to can be destroyed.
+ */
+class heartbeat_monitor
+{
+public:
+	/**
+	 * The function to send a ping to the peer.
+	 * It returns @em false if the ping couldn't be sent. It must not block
+	 * or throw.
+	 */
+	using ping_func = std::function<bool()>;
+
+private:
+	/** The clock for the activity times */
+	using clock = std::chrono::steady_clock;
+
+	/** The state of a connection */
+	struct conn {
+		/** Sends a ping on the connection */
+		ping_func ping;
+		/** The last time anything came from the peer */
+		clock::time_point lastRecv;
+		/** The last time we pinged the peer */
+		clock::time_point lastPing;
+		/** The number of pings that failed since the last receive */
+		unsigned failed;
+		/** Whether tick() is calling the ping function */
+		bool pinging;
+		/** Whether the connection has been reaped */
+		bool reaped;
+	};
+
+	/** Lock for the connections */
+	mutable std::mutex lock_;
+	/** Signaled when a ping returns */
+	std::condition_variable pingDone_;
+	/** The connections, by handle */
+	std::map<socket_t, conn> conns_;
+	/** The thread running tick(), while it sends the pings */
+	std::thread::id ticker_;
+	/** The time between heartbeats */
+	clock::duration interval_;
+	/** The number of intervals without hearing from the peer to reap it */
+	unsigned maxMissed_;
+	/** The counts of reaped connections */
+	reap_stats stats_;
+
+	// Non-copyable
+	heartbeat_monitor(const heartbeat_monitor&) =delete;
+	heartbeat_monitor& operator=(const heartbeat_monitor&) =delete;
+
+public:
+	/**
+	 * Scoped registration of a connection.
+	 *
+	 * This adds the socket to the monitor on construction and removes it
+	 * on destruction. It should be declared after the socket, so that it is
+	 * destroyed first.
+	 */
+	class guard
+	{
+		/** The monitor. Null if the socket was not added. */
+		heartbeat_monitor* mon_;
+		/** The handle of the socket */
+		socket_t handle_;
+		/** The error that ended the connection, if any */
+		int err_;
+
+		// Non-copyable
+		guard(const guard&) =delete;
+		guard& operator=(const guard&) =delete;
+
+	public:
+		/**
+		 * Adds the socket to the monitor.
+		 * @param mon The heartbeat monitor.
+		 * @param sock The connected socket.
+		 * @param ping The function to send a ping to the peer.
+		 */
+		guard(heartbeat_monitor& mon, const socket& sock, ping_func ping)
+			: mon_(mon.add(sock, std::move(ping)) ? &mon : nullptr),
+				handle_(sock.handle()), err_(0) {}
+		/**
+		 * Removes the socket from the monitor.
+		 */
+		~guard() {
+			if (mon_)
+				mon_->remove(handle_, err_);
+		}
+		/**
+		 * Determines if the socket was added to the monitor.
+		 * @return @em true if it was added, @em false if not.
+		 */
+		explicit operator bool() const { return mon_ != nullptr; }
+		/**
+		 * Records the error that ended the connection.
+		 * This is reported to the monitor on removal.
+		 * @param err The error code, such as the socket's last_error().
+		 */
+		void set_error(int err) { err_ = err; }
+	};
+
+	/** The default number of missed intervals to reap a connection */
+	static const unsigned DFLT_MAX_MISSED = 3;
+
+	/**
+	 * Creates a heartbeat monitor.
+	 * @param interval The time between heartbeats.
+	 * @param maxMissed The number of intervals without hearing from the
+	 *  				peer before its connection is reaped.
+	 */
+	explicit heartbeat_monitor(const std::chrono::milliseconds& interval,
+							   unsigned maxMissed=DFLT_MAX_MISSED);
+	/**
+	 * Adds a connection to the monitor.
+	 * @param sock The connected socket.
+	 * @param ping The function to send a ping to the peer.
+	 * @return @em true if the connection was added, @em false if the
+	 *  	   socket is not open.
+	 */
+	bool add(const socket& sock, ping_func ping);
+	/**
+	 * Removes a connection from the monitor.
+	 * @param sock The connected socket.
+	 * @param err The error that ended the connection, if any. A timeout
+	 *  		  (ETIMEDOUT) from the kernel counts as a reaped connection.
+	 */
+	void remove(const socket& sock, int err=0) { remove(sock.handle(), err); }
+	/**
+	 * Removes a connection from the monitor.
+	 * If tick() is sending a ping on the connection from another thread,
+	 * this waits for it to return.
+	 * @param h The handle of the connected socket.
+	 * @param err The error that ended the connection, if any.
+	 */
+	void remove(socket_t h, int err=0);
+	/**
+	 * Notes that something arrived from the peer.
+	 * @param sock The connected socket.
+	 */
+	void received(const socket& sock) { received(sock.handle()); }
+	/**
+	 * Notes that something arrived from the peer.
+	 * @param h The handle of the connected socket.
+	 */
+	void received(socket_t h);
+	/**
+	 * Pings the idle connections, and reaps the dead ones.
+	 * This should be called regularly, at least a few times per interval.
+	 * @return The number of connections reaped.
+	 */
+	size_t tick();
+	/**
+	 * Gets the number of connections being monitored.
+	 * @return The number of connections.
+	 */
+	size_t size() const;
+	/**
+	 * Gets the counts of the connections reaped so far.
+	 * @return The counts of reaped connections.
+	 */
+	reap_stats stats() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_heartbeat_monitor_h
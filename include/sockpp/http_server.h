@@ -0,0 +1,340 @@
+/**
+ * @file http_server.h
+ *
+ * A small HTTP/1.1 server engine.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_http_server_h
+#define __sockpp_http_server_h
+
+#include "sockpp/acceptor.h"
+#include "sockpp/connection_tracker.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A non-owning reference to a string inside a request buffer.
+ */
+struct http_str
+{
+	/** The start of the string. Not null-terminated. */
+	const char* data;
+	/** The length of the string */
+	size_t size;
+
+	/** Creates an empty string reference */
+	http_str() : data(nullptr), size(0) {}
+	/** Creates a reference to a piece of a buffer */
+	http_str(const char* p, size_t n) : data(p), size(n) {}
+	/**
+	 * Determines if the string is empty.
+	 * @return @em true if the string is empty.
+	 */
+	bool empty() const { return size == 0; }
+	/**
+	 * Makes a copy of the string.
+	 * @return A copy of the string.
+	 */
+	std::string str() const { return data ? std::string(data, size) : std::string(); }
+	/**
+	 * Compares to a C string, ignoring case.
+	 * @param s A null-terminated string.
+	 * @return @em true if the strings match, ignoring case.
+	 */
+	bool iequals(const char* s) const;
+	/**
+	 * Compares to a C string, exactly.
+	 * @param s A null-terminated string.
+	 * @return @em true if the strings match.
+	 */
+	bool operator==(const char* s) const;
+};
+
+/**
+ * A request header field.
+ */
+struct http_header
+{
+	/** The field name */
+	http_str name;
+	/** The field value, without surrounding whitespace */
+	http_str value;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A parsed HTTP request.
+ *
+ * The strings refer directly into the connection's read buffer, so they
+ * are only valid until the handler returns.
+ */
+struct http_request
+{
+	/** The method, such as "GET" */
+	http_str method;
+	/** The request target, such as "/metrics?fmt=text" */
+	http_str target;
+	/** The minor HTTP version: 0 or 1 */
+	int minor_version;
+	/** Whether the connection stays open after this request */
+	bool keep_alive;
+	/** The header fields, in the order received */
+	std::vector<http_header> headers;
+	/** The request body, if any */
+	http_str body;
+
+	/** Creates an empty request */
+	http_request() : minor_version(1), keep_alive(true) {}
+	/**
+	 * Looks up a header field.
+	 * @param name The field name. This is matched ignoring case.
+	 * @return The value of the first field with the name, or an empty
+	 *  	   string if it isn't present.
+	 */
+	http_str header(const char* name) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An incremental, zero-copy HTTP/1.x request parser.
+ *
+ * The parser is fed the unconsumed data at the front of the connection's
+ * read buffer. It remembers how far it has already scanned for the end of
+ * the request head, so that a request arriving in many small pieces isn't
+ * scanned over and over. The scan uses SSE2 or AVX2, when available.
+ *
+ * Between calls, the caller may move the unconsumed data, such as to
+ * compact its buffer, so long as it stays in order and is passed in again
+ * from the start.
+ *
+ * Only bodies with a Content-Length are supported. A request with any
+ * other Transfer-Encoding is rejected as malformed.
+ */
+class http_parser
+{
+	/** The offset to resume scanning for the end of the head */
+	size_t scanned_;
+	/** The full size of the current request, once the head is parsed */
+	size_t need_;
+
+public:
+	/**
+	 * Creates a parser, ready for the start of a request.
+	 */
+	http_parser() : scanned_(0), need_(0) {}
+	/**
+	 * Resets the parser for the start of a new request.
+	 */
+	void reset() { scanned_ = need_ = 0; }
+	/**
+	 * Tries to parse a complete request from the front of the buffer.
+	 * @param buf The unconsumed data.
+	 * @param n The number of bytes of data.
+	 * @param req Gets the request, if complete.
+	 * @return The size of the complete request, head and body, @em 0 if
+	 *  	   more data is needed, or @em -1 if it is malformed. After a
+	 *  	   complete request, the parser is ready for the next one.
+	 */
+	ssize_t parse(const char* buf, size_t n, http_request& req);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An HTTP response, filled in by a request handler.
+ */
+class http_response
+{
+	/** The status code */
+	int status_;
+	/** The extra header lines */
+	std::string headers_;
+	/** The body */
+	std::string body_;
+	/** Whether to close the connection after this response */
+	bool close_;
+	/** Whether this answers a HEAD request, so the body isn't sent */
+	bool headOnly_;
+
+	friend class http_server;
+
+	/** Gets the status line and headers, ready to send */
+	std::string head() const;
+
+public:
+	/**
+	 * Creates a response of "200 OK" with an empty body.
+	 */
+	http_response() : status_(200), close_(false), headOnly_(false) {}
+	/**
+	 * Gets the status code.
+	 * @return The status code.
+	 */
+	int status() const { return status_; }
+	/**
+	 * Sets the status code.
+	 * @param code The status code.
+	 */
+	void set_status(int code) { status_ = code; }
+	/**
+	 * Adds a header field.
+	 * The Content-Length and Connection fields are added automatically.
+	 * @param name The field name.
+	 * @param value The field value.
+	 */
+	void add_header(const std::string& name, const std::string& value);
+	/**
+	 * Gets the body.
+	 * @return The body.
+	 */
+	const std::string& body() const { return body_; }
+	/**
+	 * Sets the body.
+	 * @param body The body.
+	 */
+	void set_body(std::string body) { body_ = std::move(body); }
+	/**
+	 * Requests that the connection be closed after this response.
+	 */
+	void set_close() { close_ = true; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A small HTTP/1.1 server engine.
+ *
+ * Each connection is served by its own thread, reading into a buffer that
+ * may hold any number of pipelined requests. Every complete request in the
+ * buffer is parsed in place and passed to the handler, and the responses
+ * are then sent together in a single gather write. So a client that
+ * pipelines its requests gets its responses for about one system call
+ * each way per batch.
+ *
+ * Connections are kept alive unless the client asks otherwise, or uses
+ * HTTP/1.0 without asking for keep-alive.
+ */
+class http_server
+{
+public:
+	/** The request handler */
+	using handler = std::function<void(const http_request&, http_response&)>;
+
+	/** The initial size of a connection's read buffer */
+	static const size_t READ_BUF_SIZE = 16*1024;
+	/** The default limit on the size of a request */
+	static const size_t DFLT_MAX_REQUEST = 1024*1024;
+
+private:
+	/** The request handler */
+	handler handler_;
+	/** The largest request we'll accept */
+	size_t maxReq_;
+	/** The live connections */
+	connection_tracker conns_;
+	/** The acceptor being run, if any */
+	acceptor* acc_;
+	/** Lock for the acceptor and thread count */
+	std::mutex lock_;
+	/** Signaled when a connection thread exits */
+	std::condition_variable cv_;
+	/** The number of running connection threads */
+	size_t nthreads_;
+
+	/** Sends a batch of responses */
+	static bool send_responses(stream_socket& sock, const std::vector<http_response>& resps);
+
+	// Non-copyable
+	http_server(const http_server&) =delete;
+	http_server& operator=(const http_server&) =delete;
+
+public:
+	/**
+	 * Creates a server.
+	 * @param h The request handler. It may be called from many threads at
+	 *  		once.
+	 * @param maxRequestSize The largest request, head and body, to accept.
+	 */
+	explicit http_server(handler h, size_t maxRequestSize=DFLT_MAX_REQUEST);
+	/**
+	 * Serves a single connection in the calling thread.
+	 * @param sock The connected socket.
+	 * @return The number of requests served before the connection closed.
+	 */
+	size_t serve(stream_socket& sock);
+	/**
+	 * Accepts connections and serves each in a new thread.
+	 * This returns after @ref shutdown() is called, or the acceptor fails,
+	 * once all the connection threads are done.
+	 * @param acc The listening acceptor.
+	 */
+	void run(acceptor& acc);
+	/**
+	 * Stops the server.
+	 * This stops accepting connections and drains the open ones, letting
+	 * any requests in progress complete.
+	 * @param timeout The maximum time to wait for the connections to close.
+	 * @return The number of connections closed cleanly and forcibly.
+	 */
+	drain_stats shutdown(const std::chrono::milliseconds& timeout);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_http_server_h
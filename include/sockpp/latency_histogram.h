@@ -0,0 +1,378 @@
+/**
+ * @file latency_histogram.h
+ *
+ * Fixed-size, log-linear histograms for recording latencies.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_latency_histogram_h
+#define __sockpp_latency_histogram_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A histogram of latencies, in nanoseconds.
+ *
+ * The buckets are log-linear, in the style of HdrHistogram: each power of
+ * two is split into @ref SUB_BUCKET_HALF equal sub-buckets, so every value
+ * is kept to within 1/64 (about 1.6%) of its true size, from a nanosecond
+ * up to the full range of a 64-bit count. The number of buckets is fixed,
+ * so the memory never grows, no matter how many values are recorded or how
+ * widely they are spread.
+ *
+ * This class is not thread safe. It's meant for recording from a single
+ * thread, and for holding the snapshots taken from a @ref latency_recorder.
+ * Histograms from several threads or runs can be merged, and then queried
+ * for percentiles and printed in a common format.
+ */
+class latency_histogram
+{
+public:
+	/** The bits of precision within each power of two */
+	static const int SUB_BUCKET_BITS = 7;
+	/** The number of linear sub-buckets at the bottom of the range */
+	static const size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+	/** The number of sub-buckets in each power of two above that */
+	static const size_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+	/** The total number of buckets */
+	static const size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 2) * SUB_BUCKET_HALF;
+
+private:
+	/** The count for each bucket */
+	std::vector<uint64_t> counts_;
+	/** The total number of values */
+	uint64_t count_;
+	/** The sum of the values, for the mean */
+	uint64_t sum_;
+	/** The smallest value */
+	uint64_t min_;
+	/** The largest value */
+	uint64_t max_;
+
+	friend class latency_recorder;
+
+public:
+	/**
+	 * Gets the bucket for a value.
+	 * This is branch-free: a bit scan, two shifts, and an add.
+	 * @param v The value.
+	 * @return The index of the bucket that holds the value.
+	 */
+	static size_t bucket_index(uint64_t v) {
+		// Setting the low bits keeps the scan out of the linear range
+		#if defined(_MSC_VER)
+			unsigned long msb;
+			_BitScanReverse64(&msb, v | (SUB_BUCKET_COUNT - 1));
+		#else
+			int msb = 63 - __builtin_clzll(v | (SUB_BUCKET_COUNT - 1));
+		#endif
+		int shift = int(msb) - (SUB_BUCKET_BITS - 1);
+		return (size_t(shift) << (SUB_BUCKET_BITS - 1)) + size_t(v >> shift);
+	}
+	/**
+	 * Gets the smallest value that lands in a bucket.
+	 * @param idx The index of the bucket.
+	 * @return The smallest value that lands in the bucket.
+	 */
+	static uint64_t bucket_lowest(size_t idx);
+	/**
+	 * Gets the largest value that lands in a bucket.
+	 * @param idx The index of the bucket.
+	 * @return The largest value that lands in the bucket.
+	 */
+	static uint64_t bucket_highest(size_t idx);
+	/**
+	 * Creates an empty histogram.
+	 */
+	latency_histogram();
+	/**
+	 * Records a value.
+	 * @param ns The value, in nanoseconds.
+	 * @param n The number of times to record it.
+	 */
+	void record(uint64_t ns, uint64_t n=1) {
+		counts_[bucket_index(ns)] += n;
+		count_ += n;
+		sum_ += ns * n;
+		if (ns < min_) min_ = ns;
+		if (ns > max_) max_ = ns;
+	}
+	/**
+	 * Records a duration.
+	 * Negative durations are recorded as zero.
+	 * @param d The duration.
+	 */
+	template <typename Rep, typename Period>
+	void record(const std::chrono::duration<Rep, Period>& d) {
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+		record(ns < 0 ? uint64_t(0) : uint64_t(ns));
+	}
+	/**
+	 * Adds the values from another histogram to this one.
+	 * @param other The other histogram.
+	 * @return A reference to this histogram.
+	 */
+	latency_histogram& merge(const latency_histogram& other);
+	/**
+	 * Adds the values from another histogram to this one.
+	 * @param rhs The other histogram.
+	 * @return A reference to this histogram.
+	 */
+	latency_histogram& operator+=(const latency_histogram& rhs) {
+		return merge(rhs);
+	}
+	/**
+	 * Removes all the values.
+	 */
+	void reset();
+	/**
+	 * Gets the number of values recorded.
+	 * @return The number of values recorded.
+	 */
+	uint64_t count() const { return count_; }
+	/**
+	 * Determines if the histogram is empty.
+	 * @return @em true if no values were recorded, @em false otherwise.
+	 */
+	bool empty() const { return count_ == 0; }
+	/**
+	 * Gets the smallest value recorded.
+	 * @return The smallest value, exactly, or zero if empty.
+	 */
+	uint64_t min() const { return count_ ? min_ : 0; }
+	/**
+	 * Gets the largest value recorded.
+	 * @return The largest value, exactly, or zero if empty.
+	 */
+	uint64_t max() const { return max_; }
+	/**
+	 * Gets the mean of the values.
+	 * @return The mean of the values, or zero if empty.
+	 */
+	double mean() const { return count_ ? double(sum_) / count_ : 0.0; }
+	/**
+	 * Gets the number of values in a bucket.
+	 * @param idx The index of the bucket.
+	 * @return The number of values in the bucket.
+	 */
+	uint64_t count_at_index(size_t idx) const { return counts_[idx]; }
+	/**
+	 * Gets the value at a percentile.
+	 * This is the largest value in the bucket that holds the percentile,
+	 * so the result is never below the true value, and is never outside
+	 * the range of values actually recorded. The zero percentile is the
+	 * smallest value.
+	 * @param pct The percentile, from 0 to 100.
+	 * @return The value at the percentile, or zero if empty.
+	 */
+	uint64_t value_at_percentile(double pct) const;
+	/**
+	 * Prints the values at a standard set of percentiles, in microseconds.
+	 * @param os The output stream.
+	 * @param title A line to print above the values.
+	 */
+	void print_summary(std::ostream& os, const std::string& title) const;
+	/**
+	 * Prints a detailed percentile spectrum, in the format of HdrHistogram.
+	 * The steps get finer as they approach 100, halving the distance to it
+	 * every @a ticksPerHalf lines.
+	 * @param os The output stream.
+	 * @param title A line to print above the values.
+	 * @param ticksPerHalf The number of lines for each halving.
+	 */
+	void print_spectrum(std::ostream& os, const std::string& title,
+						int ticksPerHalf=5) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Records latencies from one thread, while other threads can read them.
+ *
+ * The counts are atomic, but since only one thread ever writes them, each
+ * is updated with a relaxed load and store rather than a locked
+ * read-modify-write. Recording a value is a handful of ordinary
+ * instructions, with no locks, fences, or contended cache lines, so it can
+ * be left in the hot path of a read or write loop.
+ *
+ * Any thread can take a @ref snapshot() at any time, and the snapshots from
+ * the recorders of several threads can be merged to get the whole picture.
+ * A snapshot taken while values are being recorded may miss the latest
+ * few, but never sees a torn count.
+ */
+class latency_recorder
+{
+	/** The count for each bucket */
+	std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+	/** The sum of the values, for the mean */
+	std::atomic<uint64_t> sum_;
+	/** The smallest value */
+	std::atomic<uint64_t> min_;
+	/** The largest value */
+	std::atomic<uint64_t> max_;
+
+	/** Adds to a counter that only this thread writes */
+	static void add(std::atomic<uint64_t>& a, uint64_t n) {
+		a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	// Non-copyable
+	latency_recorder(const latency_recorder&) =delete;
+	latency_recorder& operator=(const latency_recorder&) =delete;
+
+public:
+	/**
+	 * Creates an empty recorder.
+	 */
+	latency_recorder();
+	/**
+	 * Records a value.
+	 * This must only be called from the thread that owns the recorder.
+	 * @param ns The value, in nanoseconds.
+	 */
+	void record(uint64_t ns) {
+		add(counts_[latency_histogram::bucket_index(ns)], 1);
+		add(sum_, ns);
+		if (ns < min_.load(std::memory_order_relaxed))
+			min_.store(ns, std::memory_order_relaxed);
+		if (ns > max_.load(std::memory_order_relaxed))
+			max_.store(ns, std::memory_order_relaxed);
+	}
+	/**
+	 * Records a duration.
+	 * Negative durations are recorded as zero.
+	 * @param d The duration.
+	 */
+	template <typename Rep, typename Period>
+	void record(const std::chrono::duration<Rep, Period>& d) {
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+		record(ns < 0 ? uint64_t(0) : uint64_t(ns));
+	}
+	/**
+	 * Gets a copy of the values recorded so far.
+	 * This can be called from any thread.
+	 * @return A histogram of the values recorded so far.
+	 */
+	latency_histogram snapshot() const;
+	/**
+	 * Removes all the values.
+	 * This must only be called from the thread that owns the recorder.
+	 */
+	void reset();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Times a scope, such as a socket call, and records how long it took.
+ *
+ * @code
+ * {
+ *     sockpp::latency_timer t(readLatency);
+ *     n = sock.read(buf, sizeof(buf));
+ * }
+ * @endcode
+ *
+ * @tparam Recorder A @ref latency_recorder or @ref latency_histogram.
+ */
+template <typename Recorder>
+class basic_latency_timer
+{
+	/** The clock */
+	using clock = std::chrono::steady_clock;
+
+	/** Where the time is recorded */
+	Recorder& rec_;
+	/** The start of the timed scope */
+	clock::time_point start_;
+
+public:
+	/**
+	 * Starts timing.
+	 * @param rec Where to record the time when the timer is destroyed.
+	 */
+	explicit basic_latency_timer(Recorder& rec) : rec_(rec), start_(clock::now()) {}
+	/**
+	 * Stops timing and records the elapsed time.
+	 */
+	~basic_latency_timer() { rec_.record(clock::now() - start_); }
+};
+
+/** A timer that records to a thread's recorder */
+using latency_timer = basic_latency_timer<latency_recorder>;
+
+/**
+ * Times an operation, such as a socket call, and records how long it took.
+ *
+ * @code
+ * ssize_t n = sockpp::timed(writeLatency, [&] { return sock.write(buf, len); });
+ * @endcode
+ *
+ * @param rec Where to record the time.
+ * @param fn The operation.
+ * @return Whatever the operation returns.
+ */
+template <typename Recorder, typename Func>
+auto timed(Recorder& rec, Func&& fn) -> decltype(fn()) {
+	basic_latency_timer<Recorder> t(rec);
+	return fn();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_latency_histogram_h
@@ -0,0 +1,279 @@
+/**
+ * @file link_address.h
+ *
+ * Class for a link-layer (AF_PACKET) socket address.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_link_addr_h
+#define __sockpp_link_addr_h
+
+#include "sockpp/platform.h"
+#include "sockpp/sock_address.h"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+#if defined(__linux__)
+	#include <linux/if_packet.h>
+	#include <net/ethernet.h>
+#endif
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Class that represents a link-layer address, for packet sockets.
+ * This inherits from the Linux form of a link-layer address,
+ * @em sockaddr_ll.
+ *
+ * As a local address, it names the interface and the protocol to capture
+ * on. As the address of a received packet, it also has the sender's
+ * hardware address, and the type of the packet: whether it was addressed
+ * to this host, was a broadcast, or was outgoing, and so on.
+ */
+class link_address : public sockaddr_ll
+{
+	// NOTE: This class makes heavy use of the fact that it is completely
+	// binary compatible with a sockaddr_ll, and the same size as one.
+	// Do not add any other member variables, without going through the
+	// whole of the class to fixup!
+
+	/**
+	 * Sets the contents of this object to all zero.
+	 */
+	void zero() {
+		std::memset(this, 0, sizeof(link_address));
+		sll_family = ADDRESS_FAMILY;
+	}
+
+public:
+	/** The address family for this type of address */
+	static constexpr sa_family_t ADDRESS_FAMILY = AF_PACKET;
+
+	/**
+	 * Constructs an empty address.
+	 * The address is initialized to all zeroes. Bound to a packet socket,
+	 * this captures on all interfaces.
+	 */
+	link_address() { zero(); }
+	/**
+	 * Constructs an address for an interface, by index.
+	 * @param ifindex The index of the interface, or zero for all of them.
+	 * @param proto The Ethernet protocol, like ETH_P_IP, in host byte
+	 *  			order. ETH_P_ALL is every protocol.
+	 */
+	explicit link_address(int ifindex, uint16_t proto=ETH_P_ALL) {
+		zero();
+		sll_ifindex = ifindex;
+		sll_protocol = htons(proto);
+	}
+	/**
+	 * Constructs an address for an interface, by name.
+	 * @param ifname The name of the interface, like "eth0".
+	 * @param proto The Ethernet protocol, like ETH_P_IP, in host byte
+	 *  			order. ETH_P_ALL is every protocol.
+	 * @throws sys_error if there's no interface with the name.
+	 */
+	explicit link_address(const std::string& ifname, uint16_t proto=ETH_P_ALL);
+	/**
+	 * Constructs the address by copying the specified structure.
+	 * @param addr The generic address
+	 * @throws std::invalid_argument if the address is not a link-layer
+	 *  	   address (i.e. family is not AF_PACKET)
+	 */
+	explicit link_address(const sockaddr& addr);
+	/**
+	 * Constructs the address by copying the specified structure.
+	 * @param addr The other address
+	 */
+	link_address(const sock_address& addr) {
+		zero();
+		std::memcpy(sockaddr_ptr(), addr.sockaddr_ptr(),
+					std::min<size_t>(addr.size(), sizeof(sockaddr_ll)));
+	}
+	/**
+	 * Constructs the address by copying the specified structure.
+	 * @param addr The other address
+	 * @throws std::invalid_argument if the address is not properly
+	 *  	   initialized as a link-layer address (i.e. family is not
+	 *  	   AF_PACKET)
+	 */
+	link_address(const sockaddr_ll& addr);
+	/**
+	 * Checks if the address is set to some value.
+	 * @return @em true if the address names an interface, @em false
+	 *  	   otherwise.
+	 */
+	bool is_set() const { return sll_ifindex != 0; }
+	/**
+	 * Gets the index of the interface.
+	 * @return The index of the interface, or zero for any interface.
+	 */
+	int ifindex() const { return sll_ifindex; }
+	/**
+	 * Gets the name of the interface.
+	 * @return The name of the interface, or an empty string if it's not
+	 *  	   set or no longer exists.
+	 */
+	std::string ifname() const;
+	/**
+	 * Gets the Ethernet protocol.
+	 * @return The protocol, like ETH_P_IP, in host byte order.
+	 */
+	uint16_t protocol() const { return ntohs(sll_protocol); }
+	/**
+	 * Gets the type of the packet, for the address of a received one.
+	 * @return The packet type, like PACKET_HOST or PACKET_OUTGOING.
+	 */
+	unsigned char pkttype() const { return sll_pkttype; }
+	/**
+	 * Gets the ARP hardware type of the interface.
+	 * @return The hardware type, like ARPHRD_ETHER.
+	 */
+	unsigned short hatype() const { return sll_hatype; }
+	/**
+	 * Gets the hardware address.
+	 * @return The hardware address, as colon-separated hex bytes, like
+	 *  	   "00:1b:21:3a:4f:0c".
+	 */
+	std::string hw_address() const;
+	/**
+	 * Gets the size of the address structure.
+	 * @return The size of the address structure.
+	 */
+	socklen_t size() const { return (socklen_t) sizeof(sockaddr_ll); }
+	/**
+	 * Gets a pointer to this object cast to a const @em sockaddr.
+	 * @return A pointer to this object cast to a const @em sockaddr.
+	 */
+	const sockaddr* sockaddr_ptr() const {
+		return reinterpret_cast<const sockaddr*>(this);
+	}
+	/**
+	 * Gets a pointer to this object cast to a @em sockaddr.
+	 * @return A pointer to this object cast to a @em sockaddr.
+	 */
+	sockaddr* sockaddr_ptr() {
+		return reinterpret_cast<sockaddr*>(this);
+	}
+	/**
+	 * Gets this address as a sock_address.
+	 * @return This address as a sock_address.
+	 */
+	sock_address to_sock_address() const {
+		return sock_address(sockaddr_ptr(), size());
+	}
+	/**
+	 * Gets a const pointer to this object cast to a @em sockaddr_ll.
+	 * @return const sockaddr_ll pointer to this object.
+	 */
+	const sockaddr_ll* sockaddr_ll_ptr() const {
+		return static_cast<const sockaddr_ll*>(this);
+	}
+	/**
+	 * Gets a pointer to this object cast to a @em sockaddr_ll.
+	 * @return sockaddr_ll pointer to this object.
+	 */
+	sockaddr_ll* sockaddr_ll_ptr() {
+		return static_cast<sockaddr_ll*>(this);
+	}
+	/**
+	 * Implicit conversion to an address reference.
+	 * @return Reference to the address.
+	 */
+	operator sock_address_ref() const {
+		return sock_address_ref(reinterpret_cast<const sockaddr*>(this),
+								sizeof(sockaddr_ll));
+	}
+	/**
+	 * Gets a printable string for the address.
+	 * @return A string representation of the address in the form
+	 *  	   'link:<ifname>', or 'link:*' for any interface.
+	 */
+	std::string to_string() const;
+};
+
+// --------------------------------------------------------------------------
+
+/**
+ * Equality comparator.
+ * This does a bitwise comparison.
+ * @param lhs The first address to compare.
+ * @param rhs The second address to compare.
+ * @return @em true if they are binary equivalent, @em false if not.
+ */
+inline bool operator==(const link_address& lhs, const link_address& rhs) {
+	return (&lhs == &rhs) || (std::memcmp(&lhs, &rhs, sizeof(link_address)) == 0);
+}
+
+/**
+ * Inequality comparator.
+ * This does a bitwise comparison.
+ * @param lhs The first address to compare.
+ * @param rhs The second address to compare.
+ * @return @em true if they are binary different, @em false if they are
+ *  	   equivalent.
+ */
+inline bool operator!=(const link_address& lhs, const link_address& rhs) {
+	return !operator==(lhs, rhs);
+}
+
+/**
+ * Stream inserter for the address.
+ * @param os The output stream
+ * @param addr The address
+ * @return A reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const link_address& addr);
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// __linux__
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_link_addr_h
@@ -0,0 +1,310 @@
+/**
+ * @file mem_socket.h
+ *
+ * In-process, in-memory stream sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_mem_socket_h
+#define __sockpp_mem_socket_h
+
+#include "sockpp/stream_socket.h"
+#include <memory>
+#include <tuple>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * One end of a connected pair of in-memory stream sockets.
+ *
+ * A pair of these behaves like a connected stream socket pair, but the
+ * data never goes near the kernel. Each direction is a lock-free,
+ * single-producer, single-consumer ring buffer, so a pair can be used from
+ * two threads, one on each end, or from a single thread, as long as it
+ * never blocks waiting on itself. A blocked reader or writer spins briefly
+ * and then sleeps until the other end makes progress.
+ *
+ * This is meant for testing and benchmarking protocol code, such as
+ * framing and parsing, in isolation from the network stack. Since there
+ * are no file descriptors, a test can create thousands of connections
+ * cheaply. To shake out code that assumes whole reads and writes, each
+ * end can limit the size of every read and write, optionally to a random
+ * size under the limit.
+ *
+ * The virtual read and write calls are overridden, so code that takes a
+ * @ref stream_socket and only reads and writes it, with read(),
+ * read_spin(), read_n(), write(), write_n(), write_more() and the
+ * timeouts, works on a mem_socket too. Nothing else does:
+ *
+ * @li @ref close(), @ref shutdown(), @ref set_non_blocking() and
+ *  	@ref send_queue_size() hide the ones in the base class, and have to
+ *  	be called on the mem_socket itself.
+ * @li The base class sees a socket with no handle, and so considers it
+ *  	closed; use the mem_socket's own @ref is_connected() or boolean
+ *  	operator.
+ * @li Anything else that works on the handle fails with EBADF. This
+ *  	includes the socket options and the calls built on them, such as
+ *  	cork(), cork_guard, keepalive() and busy_poll(), as well as
+ *  	address(), peer_address() and used_fast_open().
+ */
+class mem_socket : public stream_socket
+{
+	/** The base class */
+	using base = stream_socket;
+
+	/** One direction of a connection */
+	struct pipe;
+
+	/** The pipe we read from */
+	std::shared_ptr<pipe> rx_;
+	/** The pipe we write to */
+	std::shared_ptr<pipe> tx_;
+	/** Whether reads and writes fail instead of blocking */
+	bool nonBlocking_;
+	/** The largest single read (0 for no limit) */
+	size_t rdLimit_;
+	/** The largest single write (0 for no limit) */
+	size_t wrLimit_;
+	/** Whether reads are a random size up to the limit */
+	bool rdRandom_;
+	/** Whether writes are a random size up to the limit */
+	bool wrRandom_;
+	/** State for the random sizes */
+	uint64_t rand_;
+	/** How long a read can block (0 for no limit) */
+	std::chrono::microseconds rdTimeout_;
+	/** How long a write can block (0 for no limit) */
+	std::chrono::microseconds wrTimeout_;
+
+	/** Applies a read or write size limit */
+	size_t limit(size_t n, size_t lim, bool random);
+	/** Writes as much of the buffers as there's room for */
+	ssize_t write_ranges(const iovec* iov, size_t n);
+
+	// Non-copyable
+	mem_socket(const mem_socket&) =delete;
+	mem_socket& operator=(const mem_socket&) =delete;
+
+public:
+	/**
+	 * The default buffer size for each direction.
+	 */
+	static const size_t DFLT_CAPACITY = 64*1024;
+	/**
+	 * Creates a connected pair of in-memory sockets.
+	 * @param capacity The size of the buffer in each direction, rounded up
+	 *  			   to a power of two.
+	 * @return A pair of connected sockets.
+	 */
+	static std::tuple<mem_socket, mem_socket> pair(size_t capacity=DFLT_CAPACITY);
+	/**
+	 * Creates an unconnected socket.
+	 */
+	mem_socket();
+	/**
+	 * Move constructor.
+	 * @param sock The other socket.
+	 */
+	mem_socket(mem_socket&& sock);
+	/**
+	 * Move assignment.
+	 * This closes the connection that was here before.
+	 * @param rhs The other socket.
+	 * @return A reference to this one.
+	 */
+	mem_socket& operator=(mem_socket&& rhs);
+	/**
+	 * Destructor.
+	 * Closes the connection, so the peer sees the end of the stream.
+	 */
+	~mem_socket() override;
+	/**
+	 * Determines if the socket is connected to a peer.
+	 * @return @em true if the socket is connected, even if the peer has
+	 *  	   since closed its end, @em false if not.
+	 */
+	bool is_connected() const { return bool(rx_); }
+	/**
+	 * Determines if the socket is connected and has no error.
+	 * @return @em true if the socket is connected and has no error.
+	 */
+	explicit operator bool() const { return is_connected() && last_error() == 0; }
+	/**
+	 * Shuts down one or both directions of the connection.
+	 * After the write side is shut down, the peer reads the end of the
+	 * stream once it has drained what was sent. After the read side is
+	 * shut down, reads return zero, and the peer's writes fail with EPIPE.
+	 * @param how SHUT_RD, SHUT_WR, or SHUT_RDWR.
+	 * @return @em true on success, @em false if not connected.
+	 */
+	bool shutdown(int how=SHUT_RDWR);
+	/**
+	 * Closes the connection.
+	 */
+	void close();
+	/**
+	 * Sets the socket to fail with EAGAIN instead of blocking.
+	 * @param on Whether to turn non-blocking mode on or off.
+	 * @return @em true
+	 */
+	bool set_non_blocking(bool on=true) {
+		nonBlocking_ = on;
+		return true;
+	}
+	/**
+	 * Limits the size of each read, to simulate partial reads.
+	 * @param n The most to return from a single read, or zero for no
+	 *  		limit.
+	 * @param random If @em true, each read returns a random size between
+	 *  			 one and the limit.
+	 */
+	void set_read_limit(size_t n, bool random=false) {
+		rdLimit_ = n;
+		rdRandom_ = random;
+	}
+	/**
+	 * Limits the size of each write, to simulate partial writes.
+	 * @param n The most to accept in a single write, or zero for no
+	 *  		limit.
+	 * @param random If @em true, each write accepts a random size between
+	 *  			 one and the limit.
+	 */
+	void set_write_limit(size_t n, bool random=false) {
+		wrLimit_ = n;
+		wrRandom_ = random;
+	}
+	/**
+	 * Gets the number of bytes that can be read without blocking.
+	 * @return The number of bytes waiting in the incoming buffer.
+	 */
+	size_t available() const;
+	/**
+	 * Gets the number of bytes written that the peer has not yet read.
+	 * @return The number of bytes waiting in the outgoing buffer.
+	 */
+	int send_queue_size() const;
+
+	using base::write;
+
+	/**
+	 * Reads from the socket.
+	 * This blocks until at least one byte is available, unless the socket
+	 * is non-blocking.
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to try to read.
+	 * @return The number of bytes read, zero at the end of the stream, or
+	 *  	   @em -1 on error. This is EAGAIN if the socket is non-blocking
+	 *  	   and empty, or a timeout expired.
+	 */
+	ssize_t read(void *buf, size_t n) override;
+	/**
+	 * Reads from the socket, spinning for a while before blocking.
+	 * This waits without sleeping for up to the spin time for the peer to
+	 * write something, then reads normally.
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to try to read.
+	 * @param spin The maximum time to spin before blocking.
+	 * @return The number of bytes read, zero at the end of the stream, or
+	 *  	   @em -1 on error.
+	 */
+	ssize_t read_spin(void *buf, size_t n,
+					  const std::chrono::microseconds& spin) override;
+	/**
+	 * Sets a timeout for read operations.
+	 * @param to The timeout. Zero means to block forever.
+	 * @return @em true
+	 */
+	bool read_timeout(const std::chrono::microseconds& to) override {
+		rdTimeout_ = to;
+		return true;
+	}
+	/**
+	 * Writes to the socket.
+	 * This blocks until there's room for at least one byte, unless the
+	 * socket is non-blocking.
+	 * @param buf The data to write.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written, or @em -1 on error. This is
+	 *  	   EPIPE if either side shut down the direction, or EAGAIN if
+	 *  	   the socket is non-blocking and the buffer is full, or a
+	 *  	   timeout expired.
+	 */
+	ssize_t write(const void *buf, size_t n) override;
+	/**
+	 * Writes a set of buffers to the socket.
+	 * @param ranges The buffers to write.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write(const std::vector<iovec>& ranges) override;
+	/**
+	 * Sets a timeout for write operations.
+	 * @param to The timeout. Zero means to block forever.
+	 * @return @em true
+	 */
+	bool write_timeout(const std::chrono::microseconds& to) override {
+		wrTimeout_ = to;
+		return true;
+	}
+	/**
+	 * Writes all of the buffer. There's no packet coalescing to hint at,
+	 * so this is the same as @ref write_n().
+	 * @param buf The data to write.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write_more(const void *buf, size_t n) override {
+		return write_n(buf, n);
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_mem_socket_h
@@ -0,0 +1,242 @@
+/**
+ * @file mirrored_ring.h
+ *
+ * A ring buffer mapped twice in a row, so that its contents are always
+ * contiguous in memory.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_mirrored_ring_h
+#define __sockpp_mirrored_ring_h
+
+#include "sockpp/stream_socket.h"
+#include <cstdint>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A byte ring buffer whose pages are mapped twice, back to back, in
+ * virtual memory.
+ *
+ * Writing past the end of the first mapping writes to the start of the
+ * ring, through the second one. So the data that can be read, and the
+ * space that can be written, are each always one contiguous span, no
+ * matter where they wrap. A parser can look at a whole message in place,
+ * even when it straddles the end of the ring, with no copy into a scratch
+ * buffer, and a socket can read into all of the free space with a single
+ * read(), rather than a readv() of two pieces.
+ *
+ * The memory comes from an anonymous memfd, so the capacity is rounded up
+ * to a whole number of pages.
+ *
+ * Objects of this class are moveable, but not copyable.
+ */
+class mirrored_ring
+{
+	/** The start of the first of the two mappings */
+	uint8_t* base_;
+	/** The size of the ring */
+	size_t cap_;
+	/** The offset of the data to read, in the first mapping */
+	size_t head_;
+	/** The number of bytes to read */
+	size_t size_;
+
+	// Non-copyable
+	mirrored_ring(const mirrored_ring&) =delete;
+	mirrored_ring& operator=(const mirrored_ring&) =delete;
+
+public:
+	/**
+	 * Creates an empty object, with no memory.
+	 */
+	mirrored_ring() : base_(nullptr), cap_(0), head_(0), size_(0) {}
+	/**
+	 * Creates a ring with at least the specified capacity.
+	 * @param minCapacity The least capacity of the ring. This is rounded
+	 *  				  up to a whole number of pages.
+	 * @throws sys_error if the memory can't be mapped.
+	 */
+	explicit mirrored_ring(size_t minCapacity);
+	/**
+	 * Move constructor.
+	 * @param ring The other ring.
+	 */
+	mirrored_ring(mirrored_ring&& ring) noexcept
+			: base_(ring.base_), cap_(ring.cap_), head_(ring.head_), size_(ring.size_) {
+		ring.base_ = nullptr;
+		ring.cap_ = ring.head_ = ring.size_ = 0;
+	}
+	/**
+	 * Destructor unmaps the memory.
+	 */
+	~mirrored_ring();
+	/**
+	 * Move assignment.
+	 * @param rhs The other ring.
+	 * @return A reference to this object.
+	 */
+	mirrored_ring& operator=(mirrored_ring&& rhs) noexcept;
+	/**
+	 * Determines if the ring has memory.
+	 * @return @em true if the ring has memory.
+	 */
+	bool is_valid() const { return base_ != nullptr; }
+	/**
+	 * Determines if the ring has memory.
+	 * @return @em true if the ring has memory.
+	 */
+	explicit operator bool() const { return base_ != nullptr; }
+	/**
+	 * Gets the capacity of the ring.
+	 * @return The most bytes that the ring can hold.
+	 */
+	size_t capacity() const { return cap_; }
+	/**
+	 * Gets the number of bytes waiting to be read.
+	 * @return The number of bytes waiting to be read.
+	 */
+	size_t size() const { return size_; }
+	/**
+	 * Gets the space available to write.
+	 * @return The number of bytes that can be written.
+	 */
+	size_t free_space() const { return cap_ - size_; }
+	/**
+	 * Determines if there is nothing to read.
+	 * @return @em true if there is nothing to read.
+	 */
+	bool empty() const { return size_ == 0; }
+	/**
+	 * Determines if there is no space to write.
+	 * @return @em true if the ring is full.
+	 */
+	bool full() const { return size_ == cap_; }
+	/**
+	 * Gets a pointer to the data to read.
+	 * All size() bytes of it are contiguous.
+	 * @return A pointer to the data to read.
+	 */
+	const uint8_t* data() const { return base_ + head_; }
+	/**
+	 * Gets a pointer to the space to write.
+	 * All free_space() bytes of it are contiguous. Once written, the data
+	 * must be added with commit().
+	 * @return A pointer to the space to write.
+	 */
+	uint8_t* write_ptr() { return base_ + head_ + size_; }
+	/**
+	 * Gets the data to read, as a memory range, for a gather write.
+	 * @return The data to read.
+	 */
+	iovec readable() const {
+		return iovec{ const_cast<uint8_t*>(data()), size_ };
+	}
+	/**
+	 * Gets the space to write, as a memory range, for a scatter read.
+	 * @return The space to write.
+	 */
+	iovec writable() { return iovec{ write_ptr(), free_space() }; }
+	/**
+	 * Adds data that was written into the space at write_ptr().
+	 * @param n The number of bytes written. This must not be more than the
+	 *  		free space.
+	 */
+	void commit(size_t n) { size_ += n; }
+	/**
+	 * Removes data that was read from data().
+	 * @param n The number of bytes to remove. This must not be more than
+	 *  		the size.
+	 */
+	void consume(size_t n) {
+		size_ -= n;
+		head_ += n;
+		if (head_ >= cap_)
+			head_ -= cap_;
+	}
+	/**
+	 * Removes all the data.
+	 */
+	void clear() { head_ = size_ = 0; }
+	/**
+	 * Copies data into the ring.
+	 * @param buf The data to copy.
+	 * @param n The number of bytes to copy.
+	 * @return The number of bytes copied, which is less than @em n if the
+	 *  	   ring fills up.
+	 */
+	size_t write(const void* buf, size_t n);
+	/**
+	 * Copies data out of the ring, and removes it.
+	 * @param buf The buffer to get the data.
+	 * @param n The most bytes to copy.
+	 * @return The number of bytes copied.
+	 */
+	size_t read(void* buf, size_t n);
+	/**
+	 * Reads from a socket into all of the free space, with a single call.
+	 * @param sock The socket to read.
+	 * @return The number of bytes read, zero if the socket was closed, or
+	 *  	   @em -1 on error. If the ring is full, this returns -1 with
+	 *  	   the socket's error set to ENOBUFS.
+	 */
+	ssize_t read_from(stream_socket& sock);
+	/**
+	 * Writes as much of the data as the socket takes, with a single call,
+	 * and removes what was written.
+	 * @param sock The socket to write.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write_to(stream_socket& sock);
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_mirrored_ring_h
@@ -0,0 +1,273 @@
+/**
+ * @file mux_client.h
+ *
+ * A client that multiplexes many requests over a single stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_mux_client_h
+#define __sockpp_mux_client_h
+
+#include "sockpp/stream_socket.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A request/response client that keeps many requests in flight over one
+ * connection.
+ *
+ * Each request is sent as a frame tagged with a stream ID, and the server
+ * tags its response with the same ID. The responses can come back in any
+ * order, and are matched up to their requests by the ID, so a single
+ * connection can carry thousands of outstanding requests. That saves the
+ * file descriptors, handshakes, and server-side memory of opening a
+ * connection for each concurrent request.
+ *
+ * A frame is an 8-byte header followed by the payload. The header holds
+ * the length of the payload and the stream ID, each as a 32-bit, big-endian
+ * integer. The static @ref read_frame() and @ref write_frame() functions
+ * can be used to implement the server side.
+ *
+ * Requests can be made from any number of threads. The client runs a
+ * thread to read the responses, and another to expire requests that pass
+ * their deadlines. The completion callbacks are called from these threads,
+ * so they should be quick, and must not destroy the client.
+ *
+ * A callback can make another request. One made from the reader thread is
+ * queued and written by the timer thread instead. If the reader wrote it
+ * and the socket's send buffer was full, it could block waiting for a
+ * server that's itself blocked sending responses that nobody is reading.
+ */
+class mux_client
+{
+public:
+	/**
+	 * The completion callback for a request.
+	 * The first argument is zero on success, or the error code if the
+	 * request failed: ETIMEDOUT if it passed its deadline, ECANCELED if the
+	 * client was closed, or the socket error if the connection was lost.
+	 * The second is the response payload.
+	 */
+	using callback = std::function<void(int, std::string&&)>;
+
+private:
+	/** The clock for deadlines */
+	using clock = std::chrono::steady_clock;
+	/** Pending requests, ordered by deadline */
+	using timer_map = std::multimap<clock::time_point, uint32_t>;
+
+	/** A request that is waiting for its response */
+	struct request {
+		/** The completion callback */
+		callback cb;
+		/** The request's entry in the deadline map, if it has one */
+		timer_map::iterator timer;
+		/** Whether there's a deadline */
+		bool hasDeadline;
+	};
+
+	/** The socket, used for writing */
+	stream_socket sock_;
+	/** A clone of the socket, used for reading */
+	stream_socket rdSock_;
+	/** The largest response payload we'll accept */
+	size_t maxFrame_;
+	/** Serializes the writes of the request frames */
+	std::mutex wrLock_;
+	/** Protects the request state, below */
+	std::mutex lock_;
+	/** Wakes the timer thread when the earliest deadline changes */
+	std::condition_variable timerCv_;
+	/** The requests waiting for responses, by stream ID */
+	std::unordered_map<uint32_t, request> pending_;
+	/** The deadlines of the pending requests */
+	timer_map timers_;
+	/** Requests made from the reader thread, for the timer thread to send */
+	std::vector<std::pair<uint32_t, std::string>> deferred_;
+	/** The next stream ID to try */
+	uint32_t nextId_;
+	/** The error that took the connection down, if any */
+	int err_;
+	/** Whether the client is shutting down */
+	bool closing_;
+	/** The thread that reads responses */
+	std::thread rdThr_;
+	/** The thread that expires requests */
+	std::thread timerThr_;
+
+	/** Reads and dispatches the responses */
+	void read_loop();
+	/** Fails requests that pass their deadlines, and sends deferred ones */
+	void timer_loop();
+	/** Takes the connection down after a write error */
+	void write_failed(int err);
+	/** Completes the request with the ID, if it's still pending */
+	void complete(uint32_t id, std::string&& resp);
+	/** Fails every pending request, and any new ones */
+	void fail_all(int err);
+
+	// Non-copyable
+	mux_client(const mux_client&) =delete;
+	mux_client& operator=(const mux_client&) =delete;
+
+public:
+	/** The size of a frame header */
+	static const size_t HEADER_SIZE = 8;
+	/** The default maximum frame payload */
+	static const size_t DFLT_MAX_FRAME = 16*1024*1024;
+	/**
+	 * The size of the buffer for incoming responses.
+	 */
+	static const size_t READ_BUF_SIZE = 64*1024;
+	/**
+	 * Reads a frame from a socket.
+	 * This is meant for the server side of the protocol.
+	 * @param sock The socket to read.
+	 * @param id Gets the stream ID of the frame.
+	 * @param payload Gets the payload of the frame.
+	 * @param maxFrame The largest payload to accept.
+	 * @return @em true if a frame was read, @em false on error or at the
+	 *  	   end of the stream. In the latter case, the socket's
+	 *  	   last_error() is zero. A frame that is too big is reported as
+	 *  	   EMSGSIZE, and one that is cut short as ECONNRESET.
+	 */
+	static bool read_frame(stream_socket& sock, uint32_t& id, std::string& payload,
+						   size_t maxFrame=DFLT_MAX_FRAME);
+	/**
+	 * Writes a frame to a socket.
+	 * @param sock The socket to write.
+	 * @param id The stream ID of the frame.
+	 * @param buf The payload.
+	 * @param n The size of the payload.
+	 * @return @em true on success, @em false on error.
+	 */
+	static bool write_frame(stream_socket& sock, uint32_t id, const void* buf, size_t n);
+	/**
+	 * Creates a client on a connected socket.
+	 * This starts the threads that read responses and expire requests.
+	 * @param sock The connected socket. This takes ownership of it.
+	 * @param maxFrame The largest response payload to accept.
+	 */
+	explicit mux_client(stream_socket&& sock, size_t maxFrame=DFLT_MAX_FRAME);
+	/**
+	 * Destructor.
+	 * Closes the client, failing any requests still in flight.
+	 */
+	~mux_client();
+	/**
+	 * Closes the connection and stops the client's threads.
+	 * Any requests still in flight are completed with ECANCELED. This must
+	 * not be called from a completion callback.
+	 */
+	void close();
+	/**
+	 * Determines if the connection is still usable.
+	 * @return @em true if the connection is up, @em false if it failed or
+	 *  	   was closed.
+	 */
+	bool is_connected();
+	/**
+	 * Gets the number of requests waiting for responses.
+	 * @return The number of requests in flight.
+	 */
+	size_t in_flight();
+	/**
+	 * Sends a request, without waiting for the response.
+	 * The callback is called exactly once, when the response arrives, the
+	 * deadline passes, or the connection fails. If the request can't be
+	 * sent, the callback is called before this returns.
+	 * @param buf The request payload.
+	 * @param n The size of the payload.
+	 * @param timeout How long to wait for the response. Zero means to wait
+	 *  			  forever.
+	 * @param cb The completion callback.
+	 * @return @em true if the request was sent, @em false if not.
+	 */
+	bool async_call(const void* buf, size_t n, const std::chrono::microseconds& timeout,
+					callback cb);
+	/**
+	 * Sends a request, without waiting for the response.
+	 * @param req The request payload.
+	 * @param timeout How long to wait for the response. Zero means to wait
+	 *  			  forever.
+	 * @param cb The completion callback.
+	 * @return @em true if the request was sent, @em false if not.
+	 */
+	bool async_call(const std::string& req, const std::chrono::microseconds& timeout,
+					callback cb) {
+		return async_call(req.data(), req.size(), timeout, std::move(cb));
+	}
+	/**
+	 * Sends a request and waits for the response.
+	 * Other threads can keep making requests while this one waits.
+	 * @param req The request payload.
+	 * @param resp Gets the response payload.
+	 * @param timeout How long to wait for the response. Zero means to wait
+	 *  			  forever.
+	 * @return Zero on success, or the error code, as passed to a
+	 *  	   @ref callback.
+	 */
+	int call(const std::string& req, std::string& resp,
+			 const std::chrono::microseconds& timeout);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_mux_client_h
@@ -0,0 +1,245 @@
+/**
+ * @file pacer.h
+ *
+ * A token-bucket pacer to spread out the sends on a socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_pacer_h
+#define __sockpp_pacer_h
+
+#include "sockpp/datagram_socket.h"
+#include "sockpp/stream_socket.h"
+#include <chrono>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Paces the data sent on a socket to a steady rate.
+ *
+ * A sender that writes as fast as it can goes out in bursts at line rate,
+ * which can overflow the buffers of switches and receivers, even when the
+ * average rate is well within what they can take. A pacer spaces the
+ * packets out, so that they leave at the target rate.
+ *
+ * The pacer is a token bucket. Tokens, in bytes, accumulate at the rate, up
+ * to the burst size, and a packet leaves when there are enough tokens for
+ * it. Each packet is given a departure time, with nanosecond resolution,
+ * on the monotonic clock.
+ *
+ * Packets can be held until their time in one of two ways:
+ *   - In user space, by sleeping until each departure. Packets due within
+ *     the timer slack of each other are sent together with a single
+ *     sendmmsg().
+ *   - In the kernel, by stamping each packet with its departure time as an
+ *     SO_TXTIME control message, and handing a whole batch to the kernel at
+ *     once. This needs the fq queuing discipline on the outgoing
+ *     interface. Without it, the packets go out immediately.
+ *
+ * If the interface uses fq, the simplest option of all is to have the
+ * kernel do the pacing with @ref socket::max_pacing_rate(). TCP paces to
+ * that rate even without fq.
+ *
+ * A pacer is not thread safe. Use one for each sending thread.
+ */
+class pacer
+{
+	/** The rate, in bytes per second */
+	uint64_t rate_;
+	/** The size of the bucket, in bytes */
+	size_t burst_;
+	/** The tokens in the bucket at the last departure, in bytes */
+	double tokens_;
+	/** The time of the last departure, in nanoseconds */
+	uint64_t last_;
+	/** Packets due within this many nanoseconds are sent together */
+	uint64_t slack_;
+	/** The time to spin, rather than sleep, before a departure */
+	uint64_t spin_;
+	/** Whether the packets are held by the kernel, using SO_TXTIME */
+	bool txtime_;
+
+public:
+	/** The default burst size */
+	static const size_t DFLT_BURST = 64*1024;
+	/** The default timer slack, in nanoseconds */
+	static const uint64_t DFLT_SLACK = 50000;
+	/** The most packets handed to the kernel with one call */
+	static const size_t BATCH_SIZE = 64;
+	/**
+	 * Creates a pacer.
+	 * @param bytesPerSec The rate, in bytes per second.
+	 * @param burst The most bytes that can go out back-to-back, after the
+	 *  			sender has been idle. For the smoothest pacing, make this
+	 *  			the size of a single packet.
+	 */
+	explicit pacer(uint64_t bytesPerSec, size_t burst=DFLT_BURST);
+	/**
+	 * Gets the current time, as used for the departure times.
+	 * @return The monotonic clock, in nanoseconds.
+	 */
+	static uint64_t now();
+	/**
+	 * Sleeps until the specified time.
+	 * @param t The time to wake, on the monotonic clock, in nanoseconds.
+	 * @param spin How long before the time to stop sleeping and spin
+	 *  		   instead, for better precision.
+	 */
+	static void sleep_until(uint64_t t, uint64_t spin=0);
+	/**
+	 * Gets the rate.
+	 * @return The rate, in bytes per second.
+	 */
+	uint64_t rate() const { return rate_; }
+	/**
+	 * Sets the rate.
+	 * This applies to the packets scheduled from now on.
+	 * @param bytesPerSec The rate, in bytes per second.
+	 */
+	void set_rate(uint64_t bytesPerSec) { rate_ = bytesPerSec ? bytesPerSec : 1; }
+	/**
+	 * Gets the burst size.
+	 * @return The size of the bucket, in bytes.
+	 */
+	size_t burst() const { return burst_; }
+	/**
+	 * Sets the burst size.
+	 * @param burst The size of the bucket, in bytes.
+	 */
+	void set_burst(size_t burst) { burst_ = burst ? burst : 1; }
+	/**
+	 * Sets how close together departures must be to go out in one batch.
+	 * This only applies when pacing in user space.
+	 * @param slack The timer slack.
+	 */
+	void set_slack(const std::chrono::nanoseconds& slack) {
+		slack_ = uint64_t(slack.count());
+	}
+	/**
+	 * Sets the time to spin, rather than sleep, before each departure.
+	 * This only applies when pacing in user space. Spinning gives more
+	 * precise gaps, at the cost of CPU time.
+	 * @param spin The time to spin.
+	 */
+	void set_spin(const std::chrono::nanoseconds& spin) {
+		spin_ = uint64_t(spin.count());
+	}
+	/**
+	 * Determines if the pacing is left to the kernel, using SO_TXTIME.
+	 * @return @em true if the kernel holds the packets until their times,
+	 *  	   @em false if the pacer sleeps until then.
+	 */
+	bool is_txtime() const { return txtime_; }
+	/**
+	 * Has the kernel hold the packets until their departure times.
+	 * This enables SO_TXTIME on the socket, using the monotonic clock.
+	 * @param sock The socket that will be used with the pacer.
+	 * @return @em true on success, @em false if the socket doesn't support
+	 *  	   transmit times, in which case the pacer keeps pacing in user
+	 *  	   space.
+	 */
+	bool use_txtime(datagram_socket& sock);
+	/**
+	 * Schedules a packet.
+	 * This takes the tokens for the packet from the bucket, and gets the
+	 * time at which it can leave. Departures are never earlier than those
+	 * already scheduled.
+	 * @param n The size of the packet.
+	 * @param t The current time, in nanoseconds.
+	 * @return The departure time for the packet, in nanoseconds.
+	 */
+	uint64_t schedule(size_t n, uint64_t t);
+	/**
+	 * Schedules a packet.
+	 * @param n The size of the packet.
+	 * @return The departure time for the packet, in nanoseconds.
+	 */
+	uint64_t schedule(size_t n) { return schedule(n, now()); }
+	/**
+	 * Schedules a packet, and waits until it can leave.
+	 * @param n The size of the packet.
+	 */
+	void wait(size_t n) { sleep_until(schedule(n), spin_); }
+	/**
+	 * Sends a single packet, at its departure time.
+	 * @param sock A connected datagram socket.
+	 * @param buf The packet.
+	 * @param n The size of the packet.
+	 * @return The number of bytes sent, or @em -1 on error.
+	 */
+	int send(datagram_socket& sock, const void* buf, size_t n);
+	/**
+	 * Sends a batch of packets, paced at the rate.
+	 * When pacing in user space, this returns after the last packet has
+	 * been sent. With SO_TXTIME, it returns once the packets have been
+	 * handed to the kernel, but doesn't run more than a batch ahead.
+	 * @param sock A connected datagram socket.
+	 * @param pkts The packets.
+	 * @param n The number of packets.
+	 * @return The number of packets sent, which is less than @em n only on
+	 *  	   error, or @em -1 if none were.
+	 */
+	int send(datagram_socket& sock, const iovec* pkts, size_t n);
+	/**
+	 * Writes data to a stream socket, paced at the rate.
+	 * The data is written in pieces no bigger than the burst size.
+	 * @param sock The stream socket.
+	 * @param buf The data.
+	 * @param n The number of bytes to write.
+	 * @return The number of bytes written, which is less than @em n only on
+	 *  	   error, or @em -1 if none were.
+	 */
+	ssize_t write(stream_socket& sock, const void* buf, size_t n);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// __linux__
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_pacer_h
@@ -0,0 +1,582 @@
+/**
+ * @file packet_socket.h
+ *
+ * Class for a link-layer (AF_PACKET) socket, with a memory-mapped receive
+ * ring.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_packet_socket_h
+#define __sockpp_packet_socket_h
+
+#include "sockpp/socket.h"
+#include "sockpp/link_address.h"
+#include <chrono>
+#include <iterator>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A view of a single packet in a block of a receive ring.
+ *
+ * This points directly into the memory shared with the kernel, so it is
+ * only valid as long as the @ref packet_block that it came from.
+ */
+class packet_frame
+{
+	/** The header of the frame in the ring */
+	const tpacket3_hdr* hdr_;
+
+	/** Gets a pointer at an offset from the start of the header */
+	const uint8_t* at(size_t off) const {
+		return reinterpret_cast<const uint8_t*>(hdr_) + off;
+	}
+
+public:
+	/**
+	 * Creates a view of the frame with the specified header.
+	 * @param hdr The header of the frame, in the ring.
+	 */
+	explicit packet_frame(const tpacket3_hdr* hdr) : hdr_(hdr) {}
+	/**
+	 * Gets the data of the packet, as captured.
+	 * For a SOCK_RAW socket, this starts at the link-layer header. For a
+	 * SOCK_DGRAM socket, it starts at the network header.
+	 * @return A pointer to the data of the packet.
+	 */
+	const uint8_t* data() const { return at(hdr_->tp_mac); }
+	/**
+	 * Gets the number of bytes captured.
+	 * @return The number of bytes captured. This is less than the size on
+	 *  	   the wire if the packet didn't fit in the block.
+	 */
+	size_t size() const { return hdr_->tp_snaplen; }
+	/**
+	 * Gets the size of the packet, as it was on the wire.
+	 * @return The size of the packet, as it was on the wire.
+	 */
+	size_t wire_size() const { return hdr_->tp_len; }
+	/**
+	 * Determines if the packet was cut short to fit in the block.
+	 * @return @em true if some of the packet is missing, @em false if it
+	 *  	   was all captured.
+	 */
+	bool truncated() const { return hdr_->tp_snaplen < hdr_->tp_len; }
+	/**
+	 * Gets the data of the packet, starting at the network header.
+	 * @return A pointer to the network header of the packet.
+	 */
+	const uint8_t* network_data() const { return at(hdr_->tp_net); }
+	/**
+	 * Gets the number of bytes captured, from the network header on.
+	 * @return The number of bytes captured, from the network header on.
+	 */
+	size_t network_size() const {
+		return hdr_->tp_snaplen - (hdr_->tp_net - hdr_->tp_mac);
+	}
+	/**
+	 * Gets the time that the packet was received.
+	 * @return The (real time) clock when the packet was received.
+	 */
+	timespec timestamp() const {
+		timespec ts;
+		ts.tv_sec = hdr_->tp_sec;
+		ts.tv_nsec = hdr_->tp_nsec;
+		return ts;
+	}
+	/**
+	 * Gets the link-layer information for the packet.
+	 * This has the interface that it came in on, the protocol, the
+	 * hardware address of the sender, and the type of packet.
+	 * @return The link-layer address of the packet.
+	 */
+	const sockaddr_ll& link_info() const {
+		return *reinterpret_cast<const sockaddr_ll*>(
+			at(TPACKET_ALIGN(sizeof(tpacket3_hdr))));
+	}
+	/**
+	 * Gets the link-layer address of the packet.
+	 * @return The link-layer address of the packet.
+	 */
+	link_address address() const { return link_address(link_info()); }
+	/**
+	 * Gets the type of the packet.
+	 * @return The packet type, like PACKET_HOST or PACKET_OUTGOING.
+	 */
+	unsigned char pkttype() const { return link_info().sll_pkttype; }
+	/**
+	 * Determines if the packet had a VLAN tag.
+	 * The kernel strips the tag from the data.
+	 * @return @em true if the packet had a VLAN tag.
+	 */
+	bool has_vlan() const { return (hdr_->tp_status & TP_STATUS_VLAN_VALID) != 0; }
+	/**
+	 * Gets the VLAN tag of the packet.
+	 * @return The VLAN tag control information of the packet, if it had
+	 *  	   one.
+	 */
+	uint16_t vlan_tci() const { return uint16_t(hdr_->hv1.tp_vlan_tci); }
+	/**
+	 * Gets the header of the frame, from the kernel.
+	 * @return The header of the frame.
+	 */
+	const tpacket3_hdr* header() const { return hdr_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A block of packets, taken from the receive ring of a packet socket.
+ *
+ * The block belongs to the application until it is released, at which
+ * point it goes back to the kernel to be filled again. This happens when
+ * the object is destroyed, so it should not be held any longer than it
+ * takes to process the packets. While blocks are held, the kernel has
+ * fewer in which to put new packets, and drops them when it runs out.
+ *
+ * The packets are read in place, with no copies, by iterating over the
+ * block:
+ * @code
+ *   auto blk = sock.next_block(timeout);
+ *   for (const auto& frame : blk)
+ *       process(frame.data(), frame.size());
+ * @endcode
+ *
+ * Objects of this class are moveable, but not copyable.
+ */
+class packet_block
+{
+	/** The descriptor at the start of the block */
+	tpacket_block_desc* desc_;
+
+	// Non-copyable
+	packet_block(const packet_block&) =delete;
+	packet_block& operator=(const packet_block&) =delete;
+
+public:
+	/** Iterator over the frames in a block */
+	class iterator
+	{
+		/** The header of the current frame */
+		const tpacket3_hdr* hdr_;
+		/** The number of frames left, including the current one */
+		uint32_t remaining_;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = packet_frame;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const packet_frame*;
+		using reference = packet_frame;
+
+		iterator(const tpacket3_hdr* hdr, uint32_t remaining)
+			: hdr_(hdr), remaining_(remaining) {}
+
+		packet_frame operator*() const { return packet_frame(hdr_); }
+
+		iterator& operator++() {
+			if (--remaining_ != 0)
+				hdr_ = reinterpret_cast<const tpacket3_hdr*>(
+					reinterpret_cast<const uint8_t*>(hdr_) + hdr_->tp_next_offset);
+			return *this;
+		}
+		iterator operator++(int) {
+			iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+		bool operator==(const iterator& rhs) const {
+			return remaining_ == rhs.remaining_;
+		}
+		bool operator!=(const iterator& rhs) const {
+			return remaining_ != rhs.remaining_;
+		}
+	};
+
+	/**
+	 * Creates an empty block.
+	 */
+	packet_block() : desc_(nullptr) {}
+	/**
+	 * Creates an object for a block that has been handed over from the
+	 * kernel.
+	 * @param desc The descriptor at the start of the block.
+	 */
+	explicit packet_block(tpacket_block_desc* desc) : desc_(desc) {}
+	/**
+	 * Move constructor.
+	 * @param blk The other block.
+	 */
+	packet_block(packet_block&& blk) noexcept : desc_(blk.desc_) {
+		blk.desc_ = nullptr;
+	}
+	/**
+	 * Destructor hands the block back to the kernel.
+	 */
+	~packet_block() { release(); }
+	/**
+	 * Move assignment.
+	 * This releases any block that this object holds.
+	 * @param rhs The other block.
+	 * @return A reference to this object.
+	 */
+	packet_block& operator=(packet_block&& rhs) noexcept {
+		if (&rhs != this) {
+			release();
+			desc_ = rhs.desc_;
+			rhs.desc_ = nullptr;
+		}
+		return *this;
+	}
+	/**
+	 * Hands the block back to the kernel, to be filled again.
+	 * Any frames taken from the block are invalid after this.
+	 */
+	void release() {
+		if (desc_) {
+			__atomic_store_n(&desc_->hdr.bh1.block_status, TP_STATUS_KERNEL,
+							 __ATOMIC_RELEASE);
+			desc_ = nullptr;
+		}
+	}
+	/**
+	 * Determines if this object holds a block.
+	 * @return @em true if this object holds a block.
+	 */
+	bool is_valid() const { return desc_ != nullptr; }
+	/**
+	 * Determines if this object holds a block.
+	 * @return @em true if this object holds a block.
+	 */
+	explicit operator bool() const { return desc_ != nullptr; }
+	/**
+	 * Gets the number of packets in the block.
+	 * @return The number of packets in the block.
+	 */
+	size_t num_packets() const { return desc_ ? desc_->hdr.bh1.num_pkts : 0; }
+	/**
+	 * Determines if the block is empty.
+	 * @return @em true if there are no packets in the block.
+	 */
+	bool empty() const { return num_packets() == 0; }
+	/**
+	 * Gets the sequence number of the block.
+	 * This counts up by one for each block that the kernel fills, so a
+	 * jump means that the application fell a whole ring behind.
+	 * @return The sequence number of the block.
+	 */
+	uint64_t seq_num() const { return desc_ ? desc_->hdr.bh1.seq_num : 0; }
+	/**
+	 * Determines if the kernel dropped packets for lack of space since the
+	 * last time statistics were read from the socket.
+	 * @return @em true if packets were dropped.
+	 */
+	bool losing() const {
+		return desc_ && (desc_->hdr.bh1.block_status & TP_STATUS_LOSING) != 0;
+	}
+	/**
+	 * Gets an iterator to the first frame in the block.
+	 * @return An iterator to the first frame in the block.
+	 */
+	iterator begin() const {
+		if (empty())
+			return end();
+		return iterator(reinterpret_cast<const tpacket3_hdr*>(
+			reinterpret_cast<const uint8_t*>(desc_) + desc_->hdr.bh1.offset_to_first_pkt),
+			desc_->hdr.bh1.num_pkts);
+	}
+	/**
+	 * Gets an iterator past the last frame in the block.
+	 * @return An iterator past the last frame in the block.
+	 */
+	iterator end() const { return iterator(nullptr, 0); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Counters for a packet socket, from the kernel.
+ */
+struct packet_stats
+{
+	/** The number of packets that were delivered to the socket, or dropped */
+	unsigned packets;
+	/** The number of packets dropped for lack of space */
+	unsigned drops;
+	/** The number of times the ring filled up, with every block held */
+	unsigned freezeCount;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A link-layer (AF_PACKET) socket, for capturing and injecting packets on
+ * an interface.
+ *
+ * Packets can be read one at a time, with recvfrom(), but that costs a
+ * system call and a copy for each one, which can't keep up with a busy
+ * link. For that, the socket can have a receive ring, set up with
+ * setup_rx_ring(). This is an area of memory shared with the kernel,
+ * divided into blocks (TPACKET_V3), into which the kernel copies packets
+ * as they arrive. The application takes the blocks that are full, or that
+ * have timed out, with next_block(), and reads the packets in place. This
+ * costs, at most, one poll() for each block.
+ *
+ * To spread the load of a capture across threads, or processes, each can
+ * open its own socket, and join them into a fanout group. The kernel then
+ * gives each packet to one socket in the group.
+ *
+ * Capturing packets requires the CAP_NET_RAW capability.
+ */
+class packet_socket : public socket
+{
+	/** The base class */
+	using base = socket;
+
+	/** The receive ring, if any */
+	uint8_t* ring_;
+	/** The size of the ring, in bytes */
+	size_t ringSize_;
+	/** The size of each block in the ring */
+	size_t blockSize_;
+	/** The number of blocks in the ring */
+	unsigned numBlocks_;
+	/** The next block to take from the kernel */
+	unsigned curBlock_;
+	/** The interface that the socket is bound to */
+	int ifindex_;
+
+	/** Unmaps the receive ring, if any */
+	void unmap_rx_ring();
+
+	// Non-copyable
+	packet_socket(const packet_socket&) =delete;
+	packet_socket& operator=(const packet_socket&) =delete;
+
+public:
+	/** The default size of a block in the ring */
+	static constexpr size_t DFLT_BLOCK_SIZE = 1 << 20;
+	/** The default number of blocks in the ring */
+	static constexpr unsigned DFLT_NUM_BLOCKS = 64;
+	/** The default size of the frame for each packet */
+	static constexpr size_t DFLT_FRAME_SIZE = 2048;
+	/** The default time after which a partly-filled block is retired */
+	static constexpr std::chrono::milliseconds DFLT_RETIRE_TIMEOUT {
+		std::chrono::milliseconds(50)
+	};
+
+	/**
+	 * Creates an unopened packet socket.
+	 */
+	packet_socket() : ring_(nullptr), ringSize_(0), blockSize_(0),
+						numBlocks_(0), curBlock_(0), ifindex_(0) {}
+	/**
+	 * Creates a packet socket and binds it to the interface and protocol
+	 * in the address.
+	 * Check the socket with is_open(), or last_error(), for failure.
+	 * @param addr The interface and protocol to capture. An address with
+	 *  		   no interface captures on all of them.
+	 * @param type SOCK_RAW to get the whole frame, including the link-layer
+	 *  		   header, or SOCK_DGRAM to get it from the network header
+	 *  		   on.
+	 */
+	explicit packet_socket(const link_address& addr, int type=SOCK_RAW)
+			: packet_socket() {
+		open(addr, type);
+	}
+	/**
+	 * Move constructor.
+	 * This takes the handle and the receive ring of the other socket.
+	 * @param sock The other socket.
+	 */
+	packet_socket(packet_socket&& sock) noexcept;
+	/**
+	 * Destructor unmaps the receive ring and closes the socket.
+	 */
+	~packet_socket() override { unmap_rx_ring(); }
+	/**
+	 * Move assignment.
+	 * @param rhs The other socket.
+	 * @return A reference to this object.
+	 */
+	packet_socket& operator=(packet_socket&& rhs) noexcept;
+	/**
+	 * Opens the socket and binds it to the interface and protocol in the
+	 * address.
+	 * Nothing is captured before it's bound, so that the socket doesn't
+	 * see packets from other interfaces.
+	 * @param addr The interface and protocol to capture. An address with
+	 *  		   no interface captures on all of them.
+	 * @param type SOCK_RAW to get the whole frame, including the link-layer
+	 *  		   header, or SOCK_DGRAM to get it from the network header
+	 *  		   on.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool open(const link_address& addr, int type=SOCK_RAW);
+	/**
+	 * Binds the socket to an interface and protocol.
+	 * @param addr The interface and protocol to capture.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool bind(const link_address& addr);
+	/**
+	 * Sets up a memory-mapped receive ring for the socket.
+	 * This can only be done once for a socket. The block size must be a
+	 * multiple of the page size, and the frame size, a multiple of 16.
+	 * Packets are packed into a block at their own size, so the frame size
+	 * only sets the nominal number of them that the ring can hold. A packet
+	 * that doesn't fit in a whole block is truncated.
+	 *
+	 * A block is handed to the application when it is full, or when the
+	 * retire timeout expires after the first packet went into it, so the
+	 * timeout bounds the latency of packets on a quiet link.
+	 * @param blockSize The size of each block, in bytes.
+	 * @param numBlocks The number of blocks in the ring.
+	 * @param frameSize The nominal space for one packet, including its
+	 *  				headers from the kernel.
+	 * @param retireTimeout The time after which a block that is not full
+	 *  					is handed over anyway.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool setup_rx_ring(size_t blockSize=DFLT_BLOCK_SIZE,
+					   unsigned numBlocks=DFLT_NUM_BLOCKS,
+					   size_t frameSize=DFLT_FRAME_SIZE,
+					   const std::chrono::milliseconds& retireTimeout=DFLT_RETIRE_TIMEOUT);
+	/**
+	 * Determines if the socket has a receive ring.
+	 * @return @em true if the socket has a receive ring.
+	 */
+	bool has_rx_ring() const { return ring_ != nullptr; }
+	/**
+	 * Gets the size of the receive ring.
+	 * @return The size of the receive ring, in bytes, or zero if there is
+	 *  	   none.
+	 */
+	size_t rx_ring_size() const { return ringSize_; }
+	/**
+	 * Gets the next block of packets from the receive ring.
+	 * This waits for the kernel to hand the block over, up to the timeout.
+	 * The blocks come in order, and the block must be released before the
+	 * kernel can fill it again.
+	 * @param timeout The most time to wait. A negative value waits
+	 *  			  forever.
+	 * @return The block of packets. On a timeout, the block is invalid and
+	 *  	   the last error is EAGAIN.
+	 */
+	packet_block next_block(const std::chrono::milliseconds& timeout);
+	/**
+	 * Joins the socket to a fanout group.
+	 * The kernel gives each packet that matches the group to only one of
+	 * the sockets in it. All the sockets in a group must be bound to the
+	 * same interface and protocol, and this must be done after the bind.
+	 * @param groupId The ID of the group, shared by all its sockets.
+	 * @param mode How packets are spread over the sockets, like
+	 *  		   PACKET_FANOUT_HASH, to keep each flow on one socket, or
+	 *  		   PACKET_FANOUT_LB, to take them in turns.
+	 * @param flags Any flags for the group, like PACKET_FANOUT_FLAG_DEFRAG.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool fanout(uint16_t groupId, uint16_t mode=PACKET_FANOUT_HASH,
+				uint16_t flags=0);
+	/**
+	 * Puts the interface that the socket is bound to in promiscuous mode,
+	 * or takes it out.
+	 * The kernel counts the requests, so this only lasts as long as the
+	 * socket.
+	 * @param on Whether to turn promiscuous mode on or off.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool promiscuous(bool on=true);
+	/**
+	 * Gets the counters for the socket.
+	 * The kernel resets the counters each time they are read.
+	 * @param st Gets the counters.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool get_stats(packet_stats& st);
+	/**
+	 * Receives a single packet, without the ring.
+	 * @param buf Buffer to get the packet.
+	 * @param n The size of the buffer.
+	 * @param flags The flags for the receive.
+	 * @param addr Gets the link-layer address of the packet.
+	 * @return The number of bytes read or @em -1 on error.
+	 */
+	int recvfrom(void* buf, size_t n, int flags, link_address& addr);
+	/**
+	 * Receives a single packet, without the ring.
+	 * @param buf Buffer to get the packet.
+	 * @param n The size of the buffer.
+	 * @param flags The flags for the receive.
+	 * @return The number of bytes read or @em -1 on error.
+	 */
+	int recv(void* buf, size_t n, int flags=0) {
+		return check_ret(::recv(handle(), buf, n, flags));
+	}
+	/**
+	 * Sends a packet out of an interface.
+	 * For a SOCK_RAW socket, the packet must have the link-layer header.
+	 * For a SOCK_DGRAM socket, the kernel adds it, using the hardware
+	 * address in @em addr as the destination.
+	 * @param buf The packet to send.
+	 * @param n The size of the packet.
+	 * @param addr The interface, protocol, and, for SOCK_DGRAM, destination
+	 *  		   of the packet.
+	 * @return The number of bytes sent or @em -1 on error.
+	 */
+	int sendto(const void* buf, size_t n, const link_address& addr) {
+		return check_ret(::sendto(handle(), buf, n, 0,
+								  addr.sockaddr_ptr(), addr.size()));
+	}
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_packet_socket_h
@@ -75,6 +75,12 @@
 
 	using sa_family_t = u_short;
 
+	#if !defined(SHUT_RD)
+		#define SHUT_RD		SD_RECEIVE
+		#define SHUT_WR		SD_SEND
+		#define SHUT_RDWR	SD_BOTH
+	#endif
+
 	#ifndef _SSIZE_T_DEFINED 
 		#define _SSIZE_T_DEFINED 
 		#undef ssize_t
@@ -88,10 +94,14 @@
 #else
 	#include <unistd.h>
 	#include <sys/socket.h>
+	#include <sys/uio.h>
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
 	#include <arpa/inet.h>
 	#include <netdb.h>
 	#include <signal.h>
 	#include <errno.h>
+	#include <time.h>
 #endif
 
 #endif
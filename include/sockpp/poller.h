@@ -0,0 +1,199 @@
+/**
+ * @file poller.h
+ *
+ * Class to wait for readiness on a set of sockets and other handles.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_poller_h
+#define __sockpp_poller_h
+
+#include "sockpp/socket.h"
+#include <chrono>
+#include <vector>
+
+#if defined(__linux__)
+	#include <sys/epoll.h>
+#endif
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A readiness loop for sockets, and the other handles that share the
+ * socket semantics, like event_fd, timer_fd, and signal_fd (epoll).
+ *
+ * Each handle is registered with the events to wait for, and a value that
+ * comes back with its events, to tell the caller which one it was. By
+ * default, this is the handle itself.
+ *
+ * The poller doesn't own the handles, which must be removed before they
+ * are closed. The kernel drops a closed handle on its own, but only once
+ * every copy of it is closed.
+ *
+ * This is itself a handle, which becomes readable when any of its handles
+ * is ready, so pollers can be nested.
+ */
+class poller : public socket
+{
+	/** The base class */
+	using base = socket;
+
+public:
+	/**
+	 * Creates a poller with no handles.
+	 * Check the object with is_open(), or last_error(), for failure.
+	 */
+	poller();
+	/**
+	 * Move constructor.
+	 * @param p The other poller.
+	 */
+	poller(poller&& p) : base(std::move(p)) {}
+	/**
+	 * Move assignment.
+	 * @param rhs The other poller.
+	 * @return A reference to this object.
+	 */
+	poller& operator=(poller&& rhs) {
+		base::operator=(std::move(rhs));
+		return *this;
+	}
+	/**
+	 * Adds a handle to wait on.
+	 * @param sock The socket or other handle.
+	 * @param events The events to wait for, like EPOLLIN or EPOLLOUT. Add
+	 *  			 EPOLLET for edge-triggered events, or EPOLLONESHOT to
+	 *  			 wait only for the next one.
+	 * @param data The value to return with the events.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool add(const socket& sock, uint32_t events, uint64_t data);
+	/**
+	 * Adds a handle to wait on, with the handle itself returned with its
+	 * events.
+	 * @param sock The socket or other handle.
+	 * @param events The events to wait for.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool add(const socket& sock, uint32_t events=EPOLLIN) {
+		return add(sock, events, uint64_t(sock.handle()));
+	}
+	/**
+	 * Changes the events to wait for on a handle.
+	 * This re-arms a handle that was added with EPOLLONESHOT.
+	 * @param sock The socket or other handle.
+	 * @param events The events to wait for.
+	 * @param data The value to return with the events.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool modify(const socket& sock, uint32_t events, uint64_t data);
+	/**
+	 * Changes the events to wait for on a handle, with the handle itself
+	 * returned with its events.
+	 * @param sock The socket or other handle.
+	 * @param events The events to wait for.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool modify(const socket& sock, uint32_t events) {
+		return modify(sock, events, uint64_t(sock.handle()));
+	}
+	/**
+	 * Removes a handle.
+	 * @param sock The socket or other handle.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool remove(const socket& sock);
+	/**
+	 * Sets up busy polling for the wait.
+	 *
+	 * With this set, a wait that finds nothing ready spins on the
+	 * receive queues of the network devices behind its sockets for up to
+	 * the specified time before sleeping (Linux 6.9 or later; on an older
+	 * kernel this fails with ENOTTY). This is the
+	 * poller's version of @ref socket::busy_poll, which only covers a
+	 * blocking call on the socket itself. It works best when all the
+	 * sockets are served by the same device queue.
+	 *
+	 * @param to The time to busy poll. Zero turns busy polling off.
+	 * @param budget The most packets to handle on each poll, or zero for
+	 *  			 the kernel's default. Raising it above the default
+	 *  			 requires the CAP_NET_ADMIN capability.
+	 * @param prefer Whether to prefer busy polling over interrupts, on a
+	 *  			 device configured to defer them.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool busy_poll(const std::chrono::microseconds& to, unsigned budget=0,
+				   bool prefer=false);
+	/**
+	 * Waits for events on any of the handles.
+	 * @param evts Gets the events, with the data value for each handle.
+	 * @param n The most events to get.
+	 * @param timeout The most time to wait. A negative value waits forever,
+	 *  			  and zero just checks.
+	 * @return The number of events, which is zero on a timeout, or if the
+	 *  	   wait was interrupted by a signal, or @em -1 on error.
+	 */
+	int wait(epoll_event* evts, size_t n, const std::chrono::milliseconds& timeout);
+	/**
+	 * Waits for events on any of the handles.
+	 * @param evts Gets the events. Its size is the most events to get.
+	 * @param timeout The most time to wait. A negative value waits forever,
+	 *  			  and zero just checks.
+	 * @return The number of events, which is zero on a timeout, or if the
+	 *  	   wait was interrupted by a signal, or @em -1 on error.
+	 */
+	int wait(std::vector<epoll_event>& evts, const std::chrono::milliseconds& timeout) {
+		return wait(evts.data(), evts.size(), timeout);
+	}
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_poller_h
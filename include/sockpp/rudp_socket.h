@@ -0,0 +1,362 @@
+/**
+ * @file rudp_socket.h
+ *
+ * Reliable messaging over UDP, with selective acknowledgements.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_rudp_socket_h
+#define __sockpp_rudp_socket_h
+
+#include "sockpp/datagram_socket.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A reliable, message-oriented transport over a connected UDP socket.
+ *
+ * Each message goes out in a single datagram with its own sequence number.
+ * The receiver acknowledges everything it has up to the first gap, along
+ * with selective acknowledgements (SACK) of the blocks that arrived beyond
+ * it. The sender retransmits a message when enough later ones have been
+ * SACK'ed, or when its retransmission timer expires. The timer is derived
+ * from a smoothed estimate of the round-trip time, as in TCP, but with a
+ * much lower floor, suited to a data center network.
+ *
+ * The number of messages in flight is limited by a congestion window,
+ * which grows in slow start and then linearly, and is halved once for each
+ * window with a loss, and by the receive window advertised by the peer,
+ * which shrinks as messages wait to be read by the application.
+ *
+ * Messages are normally delivered in order. With @ref set_ordered() turned
+ * off, each message sent is delivered as soon as it arrives, so a lost
+ * packet only delays itself, rather than everything behind it, as with
+ * the head-of-line blocking of TCP.
+ *
+ * The protocol runs in a background thread that receives and sends
+ * packets in batches, with `recvmmsg()` and `sendmmsg()`. The send and
+ * receive calls can be made from any threads.
+ *
+ * There is no handshake or teardown: both ends must be created on sockets
+ * connected to each other, and a peer that goes away is only noticed when
+ * its messages go unacknowledged for too long.
+ */
+class rudp_socket
+{
+public:
+	/** Counters for the protocol */
+	struct stats {
+		/** Messages sent by the application */
+		uint64_t msgsSent;
+		/** Messages delivered to the application */
+		uint64_t msgsRecv;
+		/** Data and ACK packets sent */
+		uint64_t pktsSent;
+		/** Data and ACK packets received */
+		uint64_t pktsRecv;
+		/** Data packets that were retransmitted */
+		uint64_t retransmits;
+		/** Retransmission timeouts */
+		uint64_t timeouts;
+		/** Duplicate data packets received */
+		uint64_t duplicates;
+		/** Outgoing packets discarded by the loss injection */
+		uint64_t injectedLoss;
+		/** The smoothed round-trip time, in microseconds */
+		double srttUs;
+		/** The congestion window, in messages */
+		double cwnd;
+	};
+
+private:
+	/** The clock for timers and RTT */
+	using clock = std::chrono::steady_clock;
+
+	/** A message sent, but not yet acknowledged */
+	struct out_msg {
+		std::string data;
+		clock::time_point sent;
+		unsigned xmits;
+		bool sacked;
+		bool retxQueued;
+		bool unordered;
+	};
+
+	/** A message received out of order */
+	struct in_msg {
+		std::string data;
+		bool delivered;
+	};
+
+	/** The UDP socket */
+	datagram_socket sock_;
+	/** Protects all the state below */
+	mutable std::mutex lock_;
+	/** Signals that messages are ready to read */
+	std::condition_variable rdCv_;
+	/** Signals room in the send buffer, or that everything was acked */
+	std::condition_variable wrCv_;
+	/** The protocol thread */
+	std::thread thr_;
+	/** Whether the socket is closing */
+	bool closing_;
+	/** The error that failed the transport, if any */
+	int err_;
+	/** The error from the last failed call */
+	int lastErr_;
+	/** Whether new messages are delivered in order */
+	bool ordered_;
+
+	// ----- Send side -----
+
+	/** Messages not yet acknowledged, starting at sndUna_ */
+	std::deque<out_msg> sndBuf_;
+	/** The sequence number of the oldest unacknowledged message */
+	uint64_t sndUna_;
+	/** The next sequence number to send for the first time */
+	uint64_t sndNext_;
+	/** The most messages to hold in the send buffer */
+	size_t sndBufMax_;
+	/** Messages to retransmit */
+	std::deque<uint64_t> retx_;
+	/** The highest message that was SACK'ed */
+	uint64_t highSacked_;
+	/** The congestion window, in messages */
+	double cwnd_;
+	/** The slow start threshold, in messages */
+	double ssthresh_;
+	/** The end of the current loss recovery */
+	uint64_t recover_;
+	/** The receive window of the peer, in messages */
+	uint32_t peerWnd_;
+	/** The smoothed RTT, in microseconds (0 before the first sample) */
+	double srtt_;
+	/** The RTT variation, in microseconds */
+	double rttvar_;
+	/** The retransmission timeout, in microseconds */
+	double rto_;
+	/** The lower bound for the RTO, in microseconds */
+	double minRto_;
+	/** Whether the retransmission timer is running */
+	bool timerOn_;
+	/** When the retransmission timer expires */
+	clock::time_point timer_;
+	/** Consecutive timeouts without progress */
+	unsigned backoffs_;
+
+	// ----- Receive side -----
+
+	/** The next message expected in order */
+	uint64_t rcvNext_;
+	/** Messages received beyond a gap */
+	std::map<uint64_t, in_msg> rcvOoo_;
+	/** Messages ready for the application */
+	std::deque<std::string> ready_;
+	/** The receive window, in messages */
+	uint32_t rcvWnd_;
+	/** Whether an ACK should be sent */
+	bool ackPending_;
+
+	// ----- Testing -----
+
+	/** The fraction of outgoing packets to discard */
+	double loss_;
+	/** State for the loss injection */
+	uint64_t rand_;
+	/** The counters */
+	stats stats_;
+
+	/** Runs the protocol */
+	void run();
+	/** Handles an incoming packet */
+	void on_packet(const uint8_t* p, size_t n, clock::time_point now);
+	/** Handles an incoming data packet */
+	void on_data(const uint8_t* p, size_t n);
+	/** Handles an incoming ACK */
+	void on_ack(const uint8_t* p, size_t n, clock::time_point now);
+	/** Handles the expiry of the retransmission timer */
+	void on_timeout(clock::time_point now);
+	/** Updates the RTT estimate with a new sample */
+	void rtt_sample(double us);
+	/** Sends retransmissions and whatever new data the windows allow */
+	void transmit(clock::time_point now, bool probe=false);
+	/** Sends an ACK */
+	void send_ack();
+	/** Decides whether the loss injection eats a packet */
+	bool drop_packet();
+	/** Gets the receive window to advertise */
+	uint32_t advertised_window() const;
+	/** Fails the transport */
+	void fail(int err);
+
+	// Non-copyable
+	rudp_socket(const rudp_socket&) =delete;
+	rudp_socket& operator=(const rudp_socket&) =delete;
+
+public:
+	/** The largest datagram sent or received */
+	static const size_t MAX_DATAGRAM = 16*1024;
+	/** The size of the header on a data packet */
+	static const size_t DATA_HEADER_SIZE = 8;
+	/** The largest message that can be sent */
+	static const size_t MAX_MESSAGE = MAX_DATAGRAM - DATA_HEADER_SIZE;
+	/** The most SACK blocks in an ACK */
+	static const size_t MAX_SACK_BLOCKS = 16;
+	/** The most packets sent or received in one system call */
+	static const size_t BATCH_SIZE = 32;
+	/** The default send buffer and receive window, in messages */
+	static const size_t DFLT_WINDOW = 1024;
+	/** The number of later messages SACK'ed that marks one as lost */
+	static const unsigned DUP_THRESH = 3;
+	/** The number of timeouts without progress that fails the transport */
+	static const unsigned MAX_BACKOFFS = 12;
+	/** The default lower bound for the retransmission timeout */
+	static constexpr std::chrono::microseconds DFLT_MIN_RTO { 1000 };
+	/** The upper bound for the retransmission timeout */
+	static constexpr std::chrono::microseconds MAX_RTO { 1000000 };
+	/** The retransmission timeout before the first RTT sample */
+	static constexpr std::chrono::microseconds INITIAL_RTO { 20000 };
+	/**
+	 * Creates a reliable transport over a UDP socket.
+	 * This starts the protocol thread. The socket should be connected to
+	 * the peer, which must be another rudp_socket.
+	 * @param sock The connected UDP socket. This takes ownership of it.
+	 * @param window The send buffer and receive window, in messages.
+	 */
+	explicit rudp_socket(datagram_socket&& sock, size_t window=DFLT_WINDOW);
+	/**
+	 * Destructor.
+	 * This closes the transport, without waiting for unacknowledged
+	 * messages. Use @ref flush() first to wait for them.
+	 */
+	~rudp_socket();
+	/**
+	 * Stops the protocol thread and closes the socket.
+	 */
+	void close();
+	/**
+	 * Determines if the transport is usable.
+	 * @return @em true if it is open and has not failed.
+	 */
+	explicit operator bool() const;
+	/**
+	 * Gets the error from the last failed call.
+	 * @return The error code from the last failed call.
+	 */
+	int last_error() const { return lastErr_; }
+	/**
+	 * Sets whether the messages sent from here on are delivered in order.
+	 * This is decided by the sender, for each message. Messages that are
+	 * sent unordered are delivered as soon as they arrive.
+	 * @param on @em true for in-order delivery, @em false for unordered.
+	 */
+	void set_ordered(bool on);
+	/**
+	 * Sets the lower bound for the retransmission timeout.
+	 * @param to The lower bound.
+	 */
+	void set_min_rto(const std::chrono::microseconds& to);
+	/**
+	 * Discards a random fraction of the outgoing packets, data and ACKs
+	 * alike, to test the recovery from loss.
+	 * @param rate The fraction of packets to discard, from 0 to 1.
+	 */
+	void set_loss(double rate);
+	/**
+	 * Sends a message.
+	 * This blocks while the send buffer is full.
+	 * @param buf The message.
+	 * @param n The size of the message, up to @ref MAX_MESSAGE.
+	 * @return @em true if the message was queued for sending, @em false on
+	 *  	   error. An oversized message is EMSGSIZE.
+	 */
+	bool send(const void* buf, size_t n);
+	/**
+	 * Sends a message.
+	 * @param msg The message.
+	 * @return @em true if the message was queued for sending, @em false on
+	 *  	   error.
+	 */
+	bool send(const std::string& msg) { return send(msg.data(), msg.size()); }
+	/**
+	 * Receives a message.
+	 * @param msg Gets the message.
+	 * @param timeout How long to wait for a message. Zero waits forever.
+	 * @return @em true if a message was received, @em false on error. A
+	 *  	   timeout is EAGAIN.
+	 */
+	bool recv(std::string& msg,
+			  const std::chrono::microseconds& timeout=std::chrono::microseconds(0));
+	/**
+	 * Waits for every message sent so far to be acknowledged.
+	 * @param timeout How long to wait. Zero waits forever.
+	 * @return @em true if everything was acknowledged, @em false on error
+	 *  	   or timeout (EAGAIN).
+	 */
+	bool flush(const std::chrono::microseconds& timeout=std::chrono::microseconds(0));
+	/**
+	 * Gets the protocol counters.
+	 * @return The protocol counters.
+	 */
+	stats get_stats();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// __linux__
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_rudp_socket_h
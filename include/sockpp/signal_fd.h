@@ -0,0 +1,173 @@
+/**
+ * @file signal_fd.h
+ *
+ * Class to receive signals through a handle that can be polled like a
+ * socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_signal_fd_h
+#define __sockpp_signal_fd_h
+
+#include "sockpp/socket.h"
+#include <initializer_list>
+#include <signal.h>
+
+#if defined(__linux__)
+	#include <sys/signalfd.h>
+#endif
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A handle from which to read signals (signalfd).
+ *
+ * Signals in the set are queued to the handle, which becomes readable, so
+ * they can be handled in an event loop along with sockets, in the normal
+ * flow of the program, rather than in an asynchronous signal handler.
+ *
+ * The signals must also be blocked, in every thread, or they will still be
+ * delivered in the usual way. The simplest way to do that is to call
+ * block() in the main thread before any others are started, since new
+ * threads inherit the signal mask.
+ *
+ * This has the same handle, error, and move semantics as a socket. The
+ * socket-specific calls, like the socket options and shutdown(), don't
+ * apply to it.
+ */
+class signal_fd : public socket
+{
+	/** The base class */
+	using base = socket;
+
+	/** The signals received by the handle */
+	sigset_t mask_;
+
+public:
+	/**
+	 * Creates a handle to receive a set of signals.
+	 * Check the object with is_open(), or last_error(), for failure.
+	 * @param mask The signals to receive.
+	 * @param flags The flags for the handle, such as SFD_NONBLOCK.
+	 */
+	explicit signal_fd(const sigset_t& mask, int flags=SFD_CLOEXEC);
+	/**
+	 * Creates a handle to receive a list of signals.
+	 * Check the object with is_open(), or last_error(), for failure.
+	 * @param sigs The signals to receive, like { SIGINT, SIGTERM }.
+	 * @param flags The flags for the handle, such as SFD_NONBLOCK.
+	 */
+	explicit signal_fd(std::initializer_list<int> sigs, int flags=SFD_CLOEXEC)
+			: signal_fd(make_mask(sigs), flags) {}
+	/**
+	 * Move constructor.
+	 * @param sfd The other handle.
+	 */
+	signal_fd(signal_fd&& sfd) : base(std::move(sfd)), mask_(sfd.mask_) {}
+	/**
+	 * Move assignment.
+	 * @param rhs The other handle.
+	 * @return A reference to this object.
+	 */
+	signal_fd& operator=(signal_fd&& rhs) {
+		base::operator=(std::move(rhs));
+		mask_ = rhs.mask_;
+		return *this;
+	}
+	/**
+	 * Makes a signal set from a list of signals.
+	 * @param sigs The signals.
+	 * @return The set of signals.
+	 */
+	static sigset_t make_mask(std::initializer_list<int> sigs);
+	/**
+	 * Gets the signals received by the handle.
+	 * @return The signals received by the handle.
+	 */
+	const sigset_t& mask() const { return mask_; }
+	/**
+	 * Changes the signals received by the handle.
+	 * @param mask The signals to receive.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool set_mask(const sigset_t& mask);
+	/**
+	 * Blocks the signals of the handle in the calling thread, so that they
+	 * are only delivered through the handle.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool block();
+	/**
+	 * Unblocks the signals of the handle in the calling thread.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool unblock();
+	/**
+	 * Reads as many pending signals as will fit, in a single call.
+	 * If none are pending, this blocks, or, for a non-blocking handle,
+	 * fails with EAGAIN.
+	 * @param infos Gets the information about each signal.
+	 * @param n The most signals to read.
+	 * @return The number of signals read, or @em -1 on error.
+	 */
+	int read(signalfd_siginfo* infos, size_t n);
+	/**
+	 * Reads a single pending signal.
+	 * @param info Gets the information about the signal.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool read(signalfd_siginfo& info) {
+		return read(&info, 1) == 1;
+	}
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_signal_fd_h
@@ -48,6 +48,7 @@
 #define __sockpp_socket_h
 
 #include "sockpp/sock_address.h"
+#include "sockpp/tcp_info.h"
 #include <chrono>
 #include <string>
 
@@ -67,6 +68,55 @@ namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+ * The settings for TCP keepalive probes.
+ *
+ * After the connection has been idle for the idle time, the kernel probes
+ * the peer every interval. If it misses the given count of probes in a row,
+ * the connection is dropped, and any read on it fails with ETIMEDOUT. So a
+ * dead peer on an idle connection is detected within the @ref timeout().
+ */
+struct keepalive_profile
+{
+	/** How long the connection is idle before the first probe */
+	std::chrono::seconds idle;
+	/** The time between probes */
+	std::chrono::seconds interval;
+	/** The number of missed probes before the peer is declared dead */
+	int count;
+
+	/**
+	 * Gets the longest time for a dead peer to be detected on an idle
+	 * connection.
+	 * @return The idle time, plus the time for all the probes.
+	 */
+	std::chrono::seconds timeout() const { return idle + interval * count; }
+	/**
+	 * A profile for servers that must shed dead clients quickly: idle for
+	 * 10s, then 3 probes, 5s apart, for a timeout of 25s.
+	 */
+	static keepalive_profile fast() {
+		return { std::chrono::seconds(10), std::chrono::seconds(5), 3 };
+	}
+	/**
+	 * A general-purpose profile: idle for 60s, then 5 probes, 10s apart,
+	 * for a timeout of 110s.
+	 */
+	static keepalive_profile standard() {
+		return { std::chrono::seconds(60), std::chrono::seconds(10), 5 };
+	}
+	/**
+	 * A profile for long-lived, mostly-idle connections, such as over
+	 * mobile networks, where the probes cost power: idle for 10 minutes,
+	 * then 5 probes, 1 minute apart.
+	 */
+	static keepalive_profile relaxed() {
+		return { std::chrono::seconds(600), std::chrono::seconds(60), 5 };
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
 /**
  * Base class for socket objects.
  *
@@ -244,6 +294,47 @@ public:
 	 * @throw sys_error on error
 	 */
 	sock_address peer_address() const;
+	/**
+	 * Shuts down all or part of a full-duplex connection.
+	 *
+	 * Shutting down the write side (SHUT_WR) sends a FIN to the peer
+	 * once any pending data has gone out, while still allowing data to be
+	 * read. This is the proper way to signal the end of a request or
+	 * response. Shutting down the read side (SHUT_RD) causes reads to
+	 * return zero, including one that is blocked in another thread.
+	 *
+	 * Unlike close(), this affects the underlying connection, including
+	 * any clones of the socket, and the handle remains valid.
+	 *
+	 * @param how Which parts of the connection to shut down: SHUT_RD,
+	 *  		  SHUT_WR, or SHUT_RDWR.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool shutdown(int how=SHUT_RDWR);
+	/**
+	 * Sets how the socket behaves when closed with unsent data.
+	 *
+	 * This sets the SO_LINGER option. When on, with a non-zero timeout,
+	 * close() blocks until the data is sent or the timeout expires. When
+	 * on with a zero timeout, close() discards any unsent data and resets
+	 * the connection (RST) rather than doing the normal FIN handshake.
+	 * When off, the default, close() returns immediately and the kernel
+	 * tries to send the remaining data in the background.
+	 *
+	 * @param on Whether lingering is enabled.
+	 * @param timeout The maximum time to linger.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool linger(bool on, const std::chrono::seconds& timeout=std::chrono::seconds(0));
+	/**
+	 * Places the socket into or out of non-blocking mode.
+	 * When in non-blocking mode, a call that is not immediately ready to
+	 * complete (read, write, accept, etc) will return immediately with the
+	 * error EWOULDBLOCK.
+	 * @param on Whether to turn non-blocking mode on or off.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool set_non_blocking(bool on=true);
     /**
      * Gets the value of a socket option.
      *
@@ -275,6 +366,153 @@ public:
      *         occurred.
      */
     bool set_option(int level, int optname, void* optval, socklen_t optlen);
+	#if defined(SO_BUSY_POLL)
+	/**
+	 * Sets the time to busy poll the device on a blocking receive.
+	 *
+	 * With this set, a blocking read or poll on the socket spins on the
+	 * network device's receive queue for up to the specified time before
+	 * sleeping, trading CPU for lower and more consistent latency. Raising
+	 * the value above the `net.core.busy_read` sysctl requires the
+	 * CAP_NET_ADMIN capability.
+	 *
+	 * @param to The time to busy poll. Zero turns busy polling off.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool busy_poll(const std::chrono::microseconds& to);
+	#endif
+	#if defined(SO_PREFER_BUSY_POLL)
+	/**
+	 * Sets whether busy polling is preferred over interrupt-driven
+	 * processing for the socket's device queue.
+	 * This is only effective on a device configured to defer its
+	 * interrupts (Linux 5.11 or later).
+	 * @param on Whether to prefer busy polling.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool prefer_busy_poll(bool on=true) {
+		int val = on ? 1 : 0;
+		return set_option(SOL_SOCKET, SO_PREFER_BUSY_POLL, &val, sizeof(int));
+	}
+	#endif
+	#if defined(SO_BUSY_POLL_BUDGET)
+	/**
+	 * Sets the maximum number of packets handled by each busy poll.
+	 * @param budget The number of packets per poll.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool busy_poll_budget(int budget) {
+		return set_option(SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(int));
+	}
+	#endif
+	#if defined(SO_MAX_PACING_RATE)
+	/**
+	 * Caps the rate at which the kernel sends data on the socket.
+	 *
+	 * TCP paces itself to this rate (Linux 4.13 or later). For other
+	 * protocols, like UDP, the rate is enforced by the fq queuing
+	 * discipline, so it only takes effect on an interface that uses fq.
+	 *
+	 * @param bytesPerSec The maximum rate, in bytes per second. Zero removes
+	 *  				  the cap.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool max_pacing_rate(uint64_t bytesPerSec);
+	#endif
+	#if defined(SO_TXTIME)
+	/**
+	 * Enables per-packet transmit times on the socket.
+	 *
+	 * Once enabled, each packet can carry the time at which it should leave,
+	 * as an SCM_TXTIME control message. The fq queuing discipline holds
+	 * packets until their time, using the monotonic clock, while etf
+	 * requires CLOCK_TAI. On an interface without either, the times are
+	 * ignored and the packets go out right away.
+	 *
+	 * @param clk The clock for the transmit times.
+	 * @param flags Any of the SOF_TXTIME_ flags.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool txtime(clockid_t clk=CLOCK_MONOTONIC, unsigned flags=0);
+	#endif
+	#if defined(SO_TIMESTAMPNS)
+	/**
+	 * Turns on kernel receive timestamps, with nanosecond resolution.
+	 * Each incoming packet is then stamped with the (real time) clock when
+	 * it arrived, which can be read with
+	 * @ref datagram_socket::recv_timestamped(). The kernel switches
+	 * timestamping on lazily, so packets that arrive right after this call
+	 * may instead be stamped when they're read.
+	 * @param on Whether the timestamps are enabled.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool rx_timestamps(bool on=true) {
+		int val = on ? 1 : 0;
+		return set_option(SOL_SOCKET, SO_TIMESTAMPNS, &val, sizeof(int));
+	}
+	#endif
+	#if defined(__linux__)
+	/**
+	 * Gets the kernel's statistics for a TCP socket.
+	 * This reads the TCP_INFO socket option. Any fields not supported by
+	 * the running kernel are left as zero.
+	 * @param st Gets the statistics for the connection.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool get_tcp_stats(tcp_stats& st);
+	#endif
+	/**
+	 * Turns TCP keepalive probes on or off, with the system's default
+	 * timing. On Linux, that is idle for 2 hours before probing.
+	 * @param on Whether to send keepalive probes.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool keepalive(bool on=true) {
+		int val = on ? 1 : 0;
+		return set_option(SOL_SOCKET, SO_KEEPALIVE, &val, sizeof(int));
+	}
+	#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+	/**
+	 * Turns on TCP keepalive probes, with the specified timing.
+	 * When set on an acceptor, the settings are inherited by the accepted
+	 * connections.
+	 * @param prof The keepalive timing.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool keepalive(const keepalive_profile& prof);
+	#endif
+	#if defined(TCP_USER_TIMEOUT)
+	/**
+	 * Sets the longest time that sent data can go unacknowledged before
+	 * the connection is dropped.
+	 *
+	 * Keepalive probes are only sent on an idle connection. If the peer
+	 * dies while there's data in flight, or waiting on a zero window, the
+	 * kernel keeps retransmitting, with backoff, for up to 15 minutes or
+	 * more. This sets the TCP_USER_TIMEOUT option to bound that. When set
+	 * along with keepalive, it also overrides the probe count, so it should
+	 * be at least the profile's timeout. When set on an acceptor, it's
+	 * inherited by the accepted connections.
+	 *
+	 * @param to The timeout. Zero uses the system default.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool user_timeout(const std::chrono::milliseconds& to);
+	#endif
+	#if defined(TCP_KEEPIDLE) && defined(TCP_USER_TIMEOUT)
+	/**
+	 * Sets up the detection of a dead peer, whether the connection is idle
+	 * or not.
+	 * This turns on keepalive probes with the profile, and sets the user
+	 * timeout to the profile's timeout, so that a dead peer is detected in
+	 * about the same time either way.
+	 * @param prof The keepalive timing.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool detect_dead_peer(const keepalive_profile& prof) {
+		return keepalive(prof) && user_timeout(prof.timeout());
+	}
+	#endif
     /**
      * Gets a string describing the specified error.
      * This is typically the returned message from the system strerror().
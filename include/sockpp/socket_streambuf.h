@@ -0,0 +1,172 @@
+/**
+ * @file socket_streambuf.h
+ *
+ * Buffered iostream adapters for stream sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_socket_streambuf_h
+#define __sockpp_socket_streambuf_h
+
+#include "sockpp/stream_socket.h"
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A stream buffer that reads and writes a stream socket.
+ *
+ * This lets a socket be used with the standard iostreams, through
+ * @ref socket_iostream or any other stream. Input and output each have their
+ * own buffer, so that formatted, character-at-a-time I/O only makes a
+ * system call when a buffer runs dry or fills up.
+ *
+ * Large block transfers, such as from `istream::read()` or
+ * `ostream::write()`, skip the buffers. Once any buffered data is used up
+ * or sent, a request at least as large as the buffer is read or written
+ * directly to or from the caller's memory.
+ *
+ * Output is only sent when the buffer fills, or when the stream is flushed,
+ * such as with `std::flush` or `std::endl`. The buffer is also flushed when
+ * the streambuf is destroyed.
+ *
+ * The streambuf does not own the socket. The socket must outlive it.
+ */
+class socket_streambuf : public std::streambuf
+{
+	/** The socket */
+	stream_socket& sock_;
+	/** The input buffer */
+	std::vector<char> ibuf_;
+	/** The output buffer */
+	std::vector<char> obuf_;
+
+	/** Sends any buffered output. */
+	bool flush_output();
+
+	// Non-copyable
+	socket_streambuf(const socket_streambuf&) =delete;
+	socket_streambuf& operator=(const socket_streambuf&) =delete;
+
+protected:
+	int_type underflow() override;
+	std::streamsize xsgetn(char_type* s, std::streamsize n) override;
+	std::streamsize showmanyc() override;
+	int_type overflow(int_type c) override;
+	std::streamsize xsputn(const char_type* s, std::streamsize n) override;
+	int sync() override;
+
+public:
+	/**
+	 * The default size of each of the buffers.
+	 */
+	static const size_t DFLT_BUF_SIZE = 64*1024;
+	/**
+	 * Creates a stream buffer for the socket.
+	 * @param sock The socket. It must outlive the streambuf.
+	 * @param bufSize The size of each of the input and output buffers.
+	 */
+	explicit socket_streambuf(stream_socket& sock, size_t bufSize=DFLT_BUF_SIZE)
+		: socket_streambuf(sock, bufSize, bufSize) {}
+	/**
+	 * Creates a stream buffer for the socket.
+	 * @param sock The socket. It must outlive the streambuf.
+	 * @param inSize The size of the input buffer. This is at least one
+	 *  			 byte.
+	 * @param outSize The size of the output buffer. If this is zero, output
+	 *  			  is unbuffered.
+	 */
+	socket_streambuf(stream_socket& sock, size_t inSize, size_t outSize);
+	/**
+	 * Destructor.
+	 * This flushes any buffered output.
+	 */
+	~socket_streambuf() override;
+	/**
+	 * Gets a reference to the socket.
+	 * @return A reference to the socket.
+	 */
+	stream_socket& socket() { return sock_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An input/output stream over a stream socket.
+ */
+class socket_iostream : public std::iostream
+{
+	/** The stream buffer */
+	socket_streambuf buf_;
+
+public:
+	/**
+	 * Creates a stream for the socket.
+	 * @param sock The socket. It must outlive the stream.
+	 * @param bufSize The size of each of the input and output buffers.
+	 */
+	explicit socket_iostream(stream_socket& sock,
+							 size_t bufSize=socket_streambuf::DFLT_BUF_SIZE)
+		: std::iostream(nullptr), buf_(sock, bufSize) {
+		std::iostream::rdbuf(&buf_);
+	}
+	/**
+	 * Gets a pointer to the stream buffer.
+	 * @return A pointer to the stream buffer.
+	 */
+	socket_streambuf* rdbuf() { return &buf_; }
+	/**
+	 * Gets a reference to the socket.
+	 * @return A reference to the socket.
+	 */
+	stream_socket& socket() { return buf_.socket(); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_socket_streambuf_h
@@ -50,6 +50,8 @@
 #include "sockpp/socket.h"
 #include "sockpp/inet_address.h"
 #include "sockpp/inet6_address.h"
+#include <tuple>
+#include <vector>
 
 namespace sockpp {
 
@@ -72,6 +74,19 @@ protected:
 	static socket_t create(int domain=AF_INET) {
 		return (socket_t) ::socket(domain, SOCK_STREAM, 0);
 	}
+	#if !defined(WIN32)
+	/**
+	 * Spins until the socket has something to read, without reading it.
+	 * This is for subclasses that transform the data, and so can't take
+	 * bytes off the socket until they're ready to decode them. The end of
+	 * the stream and a pending error count as readable, since a read
+	 * would return right away.
+	 * @param spin The maximum time to spin.
+	 * @return @em true if the socket became readable, @em false if the
+	 *  	   time ran out.
+	 */
+	bool spin_readable(const std::chrono::microseconds& spin);
+	#endif
 
 public:
 	/**
@@ -89,6 +104,15 @@ public:
 	 * specified socket object and transfers ownership of the socket. 
 	 */
 	stream_socket(stream_socket&& sock) : socket(std::move(sock)) {}
+	/**
+	 * Move assignment.
+	 * @param rhs The other socket to move into this one.
+	 * @return A reference to this object.
+	 */
+	stream_socket& operator=(stream_socket&& rhs) {
+		socket::operator=(std::move(rhs));
+		return *this;
+	}
 
 	/**
 	 * Open the socket.
@@ -96,6 +120,23 @@ public:
 	 */
 	bool open();
 
+	#if !defined(WIN32)
+	/**
+	 * Creates a pair of connected stream sockets.
+	 *
+	 * This is a thin wrapper around the system `socketpair()` call, and is
+	 * mainly useful for communicating between threads in the same process
+	 * and for testing. On error, both of the returned sockets are invalid
+	 * and the error code is cached in each of them.
+	 *
+	 * @param domain The communications domain (normally AF_UNIX).
+	 * @param protocol The protocol to use, normally zero.
+	 * @return A pair of connected stream sockets.
+	 */
+	static std::tuple<stream_socket, stream_socket> pair(int domain=AF_UNIX,
+														 int protocol=0);
+	#endif
+
 	/**
 	 * Reads from the port
 	 * @param buf Buffer to get the incoming data.
@@ -103,6 +144,28 @@ public:
 	 * @return The number of bytes read on success, or @em -1 on error.
 	 */
 	virtual ssize_t read(void *buf, size_t n);
+	#if !defined(WIN32)
+	/**
+	 * Reads from the socket, spinning for a while before blocking.
+	 *
+	 * This first polls the socket with non-blocking reads for up to the
+	 * spin time. If no data arrives in that time, it falls back to a
+	 * normal read, which blocks if the socket is in blocking mode. For
+	 * latency-critical connections this avoids the cost and jitter of
+	 * being put to sleep and woken up when the data is expected shortly,
+	 * at the cost of a busy CPU while spinning. It pairs well with
+	 * @ref socket::busy_poll.
+	 *
+	 * Subclasses that override @ref read() override this too, so the
+	 * spin sees the same data as a read would.
+	 *
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to try to read.
+	 * @param spin The maximum time to spin before blocking.
+	 * @return The number of bytes read on success, or @em -1 on error.
+	 */
+	virtual ssize_t read_spin(void *buf, size_t n, const std::chrono::microseconds& spin);
+	#endif
 	/**
 	 * Best effort attempts to read the specified number of bytes.
 	 * This will make repeated read attempts until all the bytes are read in
@@ -147,6 +210,16 @@ public:
 	 *  	   successful, the number of bytes written should always be 'n'.
 	 */
 	virtual ssize_t write_n(const void *buf, size_t n);
+	#if !defined(WIN32)
+	/**
+	 * Writes multiple buffers to the socket in a single call.
+	 * This is a "gather" write using the system `writev()` call. As with
+	 * the single-buffer write(), this may send less than all of the data.
+	 * @param ranges The vector of memory ranges to write.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	virtual ssize_t write(const std::vector<iovec>& ranges);
+	#endif
 	/**
 	 * Best effort attempt to write a string to the socket.
 	 * @param s The string to write.
@@ -176,7 +249,105 @@ public:
 	bool write_timeout(const std::chrono::duration<Rep,Period>& to) {
 		return write_timeout(std::chrono::duration_cast<std::chrono::microseconds>(to));
 	}
+	/**
+	 * Best effort attempt to write the whole buffer, hinting that more
+	 * data will follow immediately.
+	 * This sends with the MSG_MORE flag, where supported, so that the
+	 * kernel holds a partial segment back until the rest of the data
+	 * arrives. The final piece of a message should be sent with a regular
+	 * write() to push everything out.
+	 * @param buf The buffer to write
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	virtual ssize_t write_more(const void *buf, size_t n);
+	#if defined(TCP_CORK) || defined(TCP_NOPUSH)
+	/**
+	 * Corks or uncorks a TCP socket.
+	 * While corked, the kernel only sends full-sized segments, holding
+	 * back any partial one. Uncorking sends out whatever is pending.
+	 * This uses TCP_CORK on Linux, or TCP_NOPUSH on the BSD's.
+	 * @sa cork_guard
+	 * @param on Whether to cork (true) or uncork (false) the socket.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool cork(bool on=true);
+	#endif
+	#if defined(TCP_NOTSENT_LOWAT)
+	/**
+	 * Limits the amount of unsent data the kernel will hold for a TCP
+	 * socket.
+	 * This sets the TCP_NOTSENT_LOWAT option. Once set, the socket only
+	 * polls as writable when the amount of data in the send buffer that
+	 * has not yet gone out on the wire drops below the limit. This keeps
+	 * the kernel queue short for slow peers, leaving the backlog in user
+	 * space where the application can react to it, and reduces the
+	 * latency of fresh data.
+	 * @param n The maximum number of unsent bytes.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool notsent_lowat(unsigned n) {
+		return set_option(IPPROTO_TCP, TCP_NOTSENT_LOWAT, &n, sizeof(n));
+	}
+	#endif
+	#if defined(__linux__)
+	/**
+	 * Determines if the connection was set up with TCP Fast Open.
+	 * On the client side, this means that the server acknowledged data
+	 * that was sent in the SYN. On the server side, it means that data
+	 * was received in the SYN.
+	 * @return @em true if data was carried in the SYN, @em false if not or
+	 *  	   on error.
+	 */
+	bool used_fast_open();
+	#endif
+	#if !defined(WIN32)
+	/**
+	 * Gets the number of bytes in the socket's kernel send queue.
+	 * These are bytes that were written but not yet acknowledged by the
+	 * peer.
+	 * @return The number of bytes in the send queue, or @em -1 on error.
+	 */
+	int send_queue_size() const;
+	#endif
+};
+
+#if defined(TCP_CORK) || defined(TCP_NOPUSH)
+/**
+ * RAII class to cork a stream socket for the duration of a scope.
+ *
+ * This is useful when a response is assembled from several writes. The
+ * socket is corked on construction and uncorked when the guard goes out
+ * of scope, so the pieces leave as full-sized segments rather than one
+ * small segment per write.
+ *
+ *     {
+ *         sockpp::cork_guard cork(sock);
+ *         sock.write(hdr);
+ *         sock.write(body);
+ *     }   // <- sent here
+ */
+class cork_guard
+{
+	/** The socket that we corked */
+	stream_socket& sock_;
+
+	// Non-copyable
+	cork_guard(const cork_guard&) =delete;
+	cork_guard& operator=(const cork_guard&) =delete;
+
+public:
+	/**
+	 * Corks the socket.
+	 * @param sock The socket to cork.
+	 */
+	explicit cork_guard(stream_socket& sock) : sock_(sock) { sock_.cork(true); }
+	/**
+	 * Uncorks the socket, sending any pending data.
+	 */
+	~cork_guard() { sock_.cork(false); }
 };
+#endif
 
 /**
  * Socket for IPv4 stream.
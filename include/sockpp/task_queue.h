@@ -0,0 +1,215 @@
+/**
+ * @file task_queue.h
+ *
+ * Queue to post tasks from any thread to the thread running an event loop.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_task_queue_h
+#define __sockpp_task_queue_h
+
+#include "sockpp/event_fd.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A queue of tasks, posted from any number of threads, to be run by the
+ * single thread that owns an event loop, and its sockets.
+ *
+ * Posting is lock-free: each task is linked into an intrusive list with a
+ * single atomic exchange (a Vyukov MPSC queue). The loop thread takes them
+ * off the other end, in batches, with no atomic read-modify-writes.
+ *
+ * The loop is woken through an event_fd, which it can wait on in a poller
+ * along with its sockets. Only a post to a loop that is about to sleep,
+ * or sleeping, writes to it. While the loop is running, posts just go on
+ * the queue, and are picked up on its next pass, so a busy loop sees no
+ * system calls from the producers at all. A loop uses it like this:
+ *
+ * @code
+ *   poller p;
+ *   p.add(q.event(), EPOLLIN, WAKEUP);
+ *   p.add(sock, EPOLLIN, ...);
+ *
+ *   while (running) {
+ *       q.run_pending();
+ *       // ...handle the sockets
+ *       if (q.prepare_wait())
+ *           n = p.wait(evts, timeout);
+ *       else
+ *           n = p.wait(evts, milliseconds(0));
+ *   }
+ * @endcode
+ *
+ * Only the loop thread may call the methods other than post().
+ */
+class task_queue
+{
+public:
+	/** A task to run */
+	using task = std::function<void()>;
+
+	/** The default for the most tasks to run in one batch */
+	static const size_t DFLT_BATCH_SIZE = 256;
+
+private:
+	/** A node in the list */
+	struct node {
+		std::atomic<node*> next;
+		task fn;
+	};
+
+	/** The size of a cache line, to keep the two ends apart */
+	static const size_t CACHE_LINE = 64;
+
+	/** The end that producers push onto */
+	std::atomic<node*> head_;
+	char pad0_[CACHE_LINE - sizeof(std::atomic<node*>)];
+	/** Whether the loop needs a wakeup for the next post */
+	std::atomic<bool> needWake_;
+	/** The number of wakeups written */
+	std::atomic<uint64_t> nwakeups_;
+	char pad1_[CACHE_LINE - sizeof(std::atomic<uint64_t>)*2];
+	/** The end that the loop takes from (loop thread only) */
+	node* tail_;
+	/** The placeholder for an empty list */
+	node stub_;
+	/** Whether the loop armed a wakeup (loop thread only) */
+	bool armed_;
+	/** Wakeups that were written, but not yet read (loop thread only) */
+	uint64_t unread_;
+	/** The counter to wake the loop */
+	event_fd evt_;
+
+	/** Links a node onto the head of the list */
+	void push(node* n);
+	/** Takes the next node from the tail, if there is one */
+	node* pop();
+	/** Clears the wakeup, if the loop had armed one */
+	void disarm();
+
+	// Non-copyable
+	task_queue(const task_queue&) =delete;
+	task_queue& operator=(const task_queue&) =delete;
+
+public:
+	/**
+	 * Creates an empty queue.
+	 * Check the object, or the event_fd, for failure.
+	 */
+	task_queue();
+	/**
+	 * Destructor discards any tasks that weren't run.
+	 */
+	~task_queue();
+	/**
+	 * Determines if the queue was created properly.
+	 * @return @em true if the wakeup counter was created.
+	 */
+	explicit operator bool() const { return bool(evt_); }
+	/**
+	 * Gets the counter that wakes the loop, to add to its poller.
+	 * The loop should not read it directly.
+	 * @return The counter that wakes the loop.
+	 */
+	const event_fd& event() const { return evt_; }
+	/**
+	 * Posts a task to the loop.
+	 * This may be called from any thread.
+	 * @param fn The task to run.
+	 */
+	void post(task fn);
+	/**
+	 * Runs the tasks that are waiting, in the order they were posted.
+	 * This includes any that are posted while these run, up to the most
+	 * for the batch, so that a flood of tasks can't starve the sockets.
+	 * @param maxTasks The most tasks to run.
+	 * @return The number of tasks that were run.
+	 */
+	size_t run_pending(size_t maxTasks=DFLT_BATCH_SIZE);
+	/**
+	 * Arms the wakeup, before the loop waits.
+	 * From here on, the next post writes to the event counter.
+	 * @return @em true if the loop can wait, @em false if a task is already
+	 *  	   waiting, in which case it should not block.
+	 */
+	bool prepare_wait();
+	/**
+	 * Runs the tasks that are waiting, or waits for some to be posted, in a
+	 * loop that has nothing else to wait on.
+	 * @param timeout The most time to wait for a task. A negative value
+	 *  			  waits forever.
+	 * @param maxTasks The most tasks to run.
+	 * @return The number of tasks that were run.
+	 */
+	size_t run(const std::chrono::milliseconds& timeout,
+			   size_t maxTasks=DFLT_BATCH_SIZE);
+	/**
+	 * Determines if there are no tasks waiting.
+	 * A task in the middle of being posted may be missed.
+	 * @return @em true if there are no tasks waiting.
+	 */
+	bool empty() const {
+		return tail_ == &stub_ && stub_.next.load(std::memory_order_acquire) == nullptr
+			&& head_.load() == &stub_;
+	}
+	/**
+	 * Gets the number of times that a post had to wake the loop.
+	 * @return The number of wakeups written to the event counter.
+	 */
+	uint64_t num_wakeups() const { return nwakeups_.load(std::memory_order_relaxed); }
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_task_queue_h
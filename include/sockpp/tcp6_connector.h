@@ -105,6 +105,19 @@ public:
 	bool connect(const inet6_address& addr) {
 		return base::connect(addr);
 	}
+	/**
+	 * Connects to the specified server with TCP Fast Open, sending the
+	 * initial data along with the connection request.
+	 * @sa connector::connect_fast_open
+	 * @param addr The remote server address.
+	 * @param buf The initial data to send.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes of the initial data sent, or @em -1 on
+	 *  	   error.
+	 */
+	ssize_t connect_fast_open(const inet6_address& addr, const void* buf, size_t n) {
+		return base::connect_fast_open(addr, buf, n);
+	}
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,161 @@
+/**
+ * @file timer_fd.h
+ *
+ * Class for a timer that can be polled like a socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_timer_fd_h
+#define __sockpp_timer_fd_h
+
+#include "sockpp/socket.h"
+#include <chrono>
+
+#if defined(__linux__)
+	#include <sys/timerfd.h>
+#endif
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A timer, in the form of a file descriptor (timerfd).
+ *
+ * The handle becomes readable when the timer expires, so timers can be
+ * waited on in a poller, or with poll(), along with sockets, rather than
+ * needing a thread to sleep on them. A periodic timer keeps counting the
+ * expirations until they are read, so a reader that falls behind gets
+ * them all at once, in a single read, rather than losing them.
+ *
+ * This has the same handle, error, and move semantics as a socket. The
+ * socket-specific calls, like the socket options and shutdown(), don't
+ * apply to it.
+ */
+class timer_fd : public socket
+{
+	/** The base class */
+	using base = socket;
+
+	/** Converts a duration to a timespec */
+	static timespec to_timespec(const std::chrono::nanoseconds& d);
+
+public:
+	/**
+	 * Creates a timer, which is not yet armed.
+	 * Check the object with is_open(), or last_error(), for failure.
+	 * @param clk The clock for the timer. The default, CLOCK_MONOTONIC, is
+	 *  		  the one used by std::chrono::steady_clock.
+	 * @param flags The flags for the timer, such as TFD_NONBLOCK.
+	 */
+	explicit timer_fd(clockid_t clk=CLOCK_MONOTONIC, int flags=TFD_CLOEXEC);
+	/**
+	 * Move constructor.
+	 * @param tmr The other timer.
+	 */
+	timer_fd(timer_fd&& tmr) : base(std::move(tmr)) {}
+	/**
+	 * Move assignment.
+	 * @param rhs The other timer.
+	 * @return A reference to this object.
+	 */
+	timer_fd& operator=(timer_fd&& rhs) {
+		base::operator=(std::move(rhs));
+		return *this;
+	}
+	/**
+	 * Arms the timer to expire after a delay, and then, optionally, at a
+	 * fixed interval.
+	 * This replaces any previous setting, and clears the count of
+	 * expirations.
+	 * @param initial The time until the first expiration. A zero delay
+	 *  			  expires right away.
+	 * @param interval The time between later expirations, or zero for a
+	 *  			   one-shot timer.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool set(const std::chrono::nanoseconds& initial,
+			 const std::chrono::nanoseconds& interval=std::chrono::nanoseconds::zero());
+	/**
+	 * Arms the timer to expire at a point in time, and then, optionally, at
+	 * a fixed interval.
+	 * Unlike a relative delay, this doesn't drift with the time it takes
+	 * to compute it. The timer must be on the CLOCK_MONOTONIC clock.
+	 * @param tp The time of the first expiration. A time in the past
+	 *  		 expires right away.
+	 * @param interval The time between later expirations, or zero for a
+	 *  			   one-shot timer.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool set_at(const std::chrono::steady_clock::time_point& tp,
+				const std::chrono::nanoseconds& interval=std::chrono::nanoseconds::zero());
+	/**
+	 * Disarms the timer.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool cancel();
+	/**
+	 * Gets the time until the timer next expires.
+	 * @param left Gets the time left, or zero if the timer isn't armed.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool remaining(std::chrono::nanoseconds& left);
+	/**
+	 * Reads the number of times that the timer expired since the last
+	 * read, and resets the count.
+	 * If the timer hasn't expired, this blocks, or, for a non-blocking
+	 * timer, fails with EAGAIN.
+	 * @param n Gets the number of expirations.
+	 * @return @em true on success, @em false on failure.
+	 */
+	bool read(uint64_t& n);
+};
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_timer_fd_h
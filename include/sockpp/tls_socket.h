@@ -0,0 +1,368 @@
+/**
+ * @file tls_socket.h
+ *
+ * TLS stream sockets, using OpenSSL, with kernel TLS offload.
+ *
+ * This is only available when the library is built with OpenSSL
+ * (SOCKPP_WITH_OPENSSL).
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tls_socket_h
+#define __sockpp_tls_socket_h
+
+#include "sockpp/stream_socket.h"
+#include <openssl/ssl.h>
+#include <string>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The shared configuration for a set of TLS connections.
+ *
+ * This wraps an OpenSSL context, which holds the certificates, keys, and
+ * verification settings for the connections made from it. The context
+ * only allows TLS 1.2 and later, and by default asks OpenSSL to move the
+ * record layer into the kernel (kTLS) after each handshake, when the
+ * kernel and the negotiated cipher support it.
+ *
+ * A client context verifies the server's certificate against the system's
+ * trusted certificates, unless told otherwise.
+ */
+class tls_context
+{
+public:
+	/** The side of the connections */
+	enum role { CLIENT, SERVER };
+
+private:
+	/** The OpenSSL context */
+	SSL_CTX* ctx_;
+	/** Our side of the connections */
+	role role_;
+	/** The last OpenSSL error */
+	unsigned long lastErr_;
+
+	/** Captures the OpenSSL error if the return value is a failure */
+	bool check_ret_bool(int ret);
+
+	// Non-copyable
+	tls_context(const tls_context&) =delete;
+	tls_context& operator=(const tls_context&) =delete;
+
+public:
+	/**
+	 * Creates a TLS context.
+	 * @param r Whether connections made from this context are the client
+	 *  		or the server side.
+	 */
+	explicit tls_context(role r);
+	/**
+	 * Destructor.
+	 * The OpenSSL context is freed once the last connection made from it
+	 * is done with it.
+	 */
+	~tls_context();
+	/**
+	 * Determines if the context is valid, with no errors.
+	 * @return @em true if the context is usable.
+	 */
+	explicit operator bool() const { return ctx_ && lastErr_ == 0; }
+	/**
+	 * Gets the underlying OpenSSL context.
+	 * This can be used for any settings not otherwise supported here.
+	 * @return The OpenSSL context.
+	 */
+	SSL_CTX* handle() { return ctx_; }
+	/**
+	 * Determines if this is a server context.
+	 * @return @em true for a server context, @em false for a client.
+	 */
+	bool is_server() const { return role_ == SERVER; }
+	/**
+	 * Loads the certificate chain and private key from PEM files.
+	 * @param certFile The certificate chain file.
+	 * @param keyFile The private key file.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool use_certificate_file(const std::string& certFile, const std::string& keyFile);
+	/**
+	 * Sets the certificate and private key from PEM text.
+	 * @param certPem The certificate.
+	 * @param keyPem The private key.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool use_certificate(const std::string& certPem, const std::string& keyPem);
+	/**
+	 * Loads trusted CA certificates from a PEM file.
+	 * @param caFile The file of CA certificates.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool load_verify_file(const std::string& caFile);
+	/**
+	 * Adds a trusted CA certificate from PEM text.
+	 * @param certPem The CA certificate.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool add_ca_certificate(const std::string& certPem);
+	/**
+	 * Sets whether the peer's certificate is verified.
+	 * This is on by default for clients, and off for servers.
+	 * @param on Whether to require and verify the peer's certificate.
+	 */
+	void set_verify(bool on);
+	/**
+	 * Sets whether to use kernel TLS for the record layer, when possible.
+	 * This is on by default.
+	 * @param on Whether to use kernel TLS.
+	 */
+	void enable_ktls(bool on=true);
+	/**
+	 * Gets the last OpenSSL error.
+	 * @return The OpenSSL error code, or zero if none.
+	 */
+	unsigned long last_error() const { return lastErr_; }
+	/**
+	 * Gets a description of the last OpenSSL error.
+	 * @return A description of the last error.
+	 */
+	std::string last_error_str() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A TLS connection over a stream socket.
+ *
+ * This takes over a connected socket and runs the TLS handshake on it with
+ * OpenSSL. If the context allows kernel TLS, OpenSSL then installs the
+ * session keys into the kernel with the TCP_ULP "tls" option. After that,
+ * writes go straight to the socket as plain system calls, with the kernel
+ * doing the encryption, and files can be sent with @ref sendfile() without
+ * being copied into user space. Reads still go through OpenSSL, so that
+ * any non-data records, like alerts or session tickets, are handled, but
+ * with kernel TLS that is little more than a receive call.
+ *
+ * When kernel TLS isn't available, due to the kernel, the cipher, or the
+ * protocol version, everything falls back to the usual user-space records,
+ * and @ref sendfile() reads the file through a buffer.
+ *
+ * Errors from the socket are reported through @ref last_error() as usual.
+ * A TLS protocol failure shows up there as EPROTO, with the OpenSSL error
+ * available from @ref ssl_error(). A peer that closes without sending a
+ * close_notify alert is treated as a normal end of stream.
+ */
+class tls_socket : public stream_socket
+{
+	/** The base class */
+	using base = stream_socket;
+
+	/** The OpenSSL connection */
+	SSL* ssl_;
+	/** The last OpenSSL error */
+	unsigned long sslErr_;
+	/** Whether the kernel is doing the TX record layer */
+	bool ktlsSend_;
+	/** Whether the kernel is doing the RX record layer */
+	bool ktlsRecv_;
+
+	/** Sets the errors from a failed OpenSSL call, returning 0 or -1 */
+	int check_ssl(int ret);
+
+	// Non-copyable
+	tls_socket(const tls_socket&) =delete;
+	tls_socket& operator=(const tls_socket&) =delete;
+
+public:
+	/**
+	 * Creates an unconnected TLS socket.
+	 */
+	tls_socket() : ssl_(nullptr), sslErr_(0), ktlsSend_(false), ktlsRecv_(false) {}
+	/**
+	 * Creates a TLS connection on an open socket.
+	 * The handshake is not done until @ref handshake() is called.
+	 * @param ctx The TLS context.
+	 * @param sock A connected stream socket. This takes ownership of it.
+	 */
+	tls_socket(tls_context& ctx, stream_socket&& sock);
+	/**
+	 * Move constructor.
+	 * @param sock The other socket to move into this one.
+	 */
+	tls_socket(tls_socket&& sock);
+	/**
+	 * Move assignment.
+	 * @param rhs The other socket to move into this one.
+	 * @return A reference to this object.
+	 */
+	tls_socket& operator=(tls_socket&& rhs);
+	/**
+	 * Destructor.
+	 * This frees the TLS state and closes the socket, without sending a
+	 * close_notify alert.
+	 */
+	~tls_socket() override;
+	/**
+	 * Sets the server name for a client connection.
+	 * This is sent to the server in the SNI extension, and is the name the
+	 * server's certificate is verified against. Call it before the
+	 * handshake.
+	 * @param host The server's host name.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool set_host(const std::string& host);
+	/**
+	 * Runs the TLS handshake.
+	 * On a non-blocking socket this fails with EWOULDBLOCK until the
+	 * handshake is complete, and should be called again when the socket is
+	 * ready.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool handshake();
+	/**
+	 * Sends a close_notify alert to end the TLS session.
+	 * The socket stays open.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool close_notify();
+	/**
+	 * Determines if the kernel is encrypting outgoing records.
+	 * @return @em true if kernel TLS is in use for sending.
+	 */
+	bool ktls_send() const { return ktlsSend_; }
+	/**
+	 * Determines if the kernel is decrypting incoming records.
+	 * @return @em true if kernel TLS is in use for receiving.
+	 */
+	bool ktls_recv() const { return ktlsRecv_; }
+	/**
+	 * Gets the negotiated protocol version, like "TLSv1.3".
+	 * @return The protocol version.
+	 */
+	std::string version() const;
+	/**
+	 * Gets the negotiated cipher suite.
+	 * @return The name of the cipher suite.
+	 */
+	std::string cipher() const;
+	/**
+	 * Gets the last OpenSSL error.
+	 * @return The OpenSSL error code, or zero if none.
+	 */
+	unsigned long ssl_error() const { return sslErr_; }
+	/**
+	 * Gets the underlying OpenSSL connection.
+	 * @return The OpenSSL connection.
+	 */
+	SSL* ssl() { return ssl_; }
+
+	using base::write;
+
+	/**
+	 * Reads decrypted data from the connection.
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to try to read.
+	 * @return The number of bytes read, @em 0 at the end of the stream, or
+	 *  	   @em -1 on error.
+	 */
+	ssize_t read(void *buf, size_t n) override;
+	/**
+	 * Reads decrypted data, spinning for a while before blocking.
+	 * Data already decrypted is returned right away. Otherwise this spins
+	 * until some of the next record arrives, then reads it normally.
+	 * @param buf Buffer to get the incoming data.
+	 * @param n The number of bytes to try to read.
+	 * @param spin The maximum time to spin before blocking.
+	 * @return The number of bytes read, @em 0 at the end of the stream, or
+	 *  	   @em -1 on error.
+	 */
+	ssize_t read_spin(void *buf, size_t n,
+					  const std::chrono::microseconds& spin) override;
+	/**
+	 * Writes data to the connection, encrypted.
+	 * @param buf The buffer to write
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write(const void *buf, size_t n) override;
+	/**
+	 * Writes a set of buffers to the connection.
+	 * Each buffer is written in full, in order.
+	 * @param ranges The buffers to write.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write(const std::vector<iovec>& ranges) override;
+	/**
+	 * Writes data with more to follow.
+	 * With kernel TLS, this lets the kernel fill a record from several
+	 * writes. Otherwise it is the same as write_n().
+	 * @param buf The buffer to write
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes written, or @em -1 on error.
+	 */
+	ssize_t write_more(const void *buf, size_t n) override;
+	/**
+	 * Sends part of a file over the connection.
+	 * With kernel TLS, this uses the sendfile() system call, and the data
+	 * is never copied into user space. Otherwise the file is read through a
+	 * buffer and written with OpenSSL.
+	 * @param fd An open file descriptor.
+	 * @param offset The offset in the file to start sending.
+	 * @param n The number of bytes to send.
+	 * @return The number of bytes sent, which is less than @p n if the end
+	 *  	   of the file is reached, or @em -1 on error.
+	 */
+	ssize_t sendfile(int fd, off_t offset, size_t n);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_tls_socket_h
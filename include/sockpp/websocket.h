@@ -0,0 +1,370 @@
+/**
+ * @file websocket.h
+ *
+ * WebSocket (RFC 6455) framing over a stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_websocket_h
+#define __sockpp_websocket_h
+
+#include "sockpp/stream_socket.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * WebSocket frame opcodes.
+ */
+enum class ws_opcode : uint8_t {
+	CONTINUATION = 0x0,
+	TEXT = 0x1,
+	BINARY = 0x2,
+	CLOSE = 0x8,
+	PING = 0x9,
+	PONG = 0xA
+};
+
+/**
+ * The implementations of WebSocket payload masking.
+ */
+enum class ws_mask_impl {
+	SCALAR,		///< Portable, a word at a time
+	SSE2,		///< 16 bytes at a time
+	AVX2,		///< 32 bytes at a time
+	AVX512		///< 64 bytes at a time
+};
+
+/**
+ * Gets the fastest masking implementation supported by this CPU.
+ * @return The fastest masking implementation supported by this CPU.
+ */
+ws_mask_impl ws_mask_best();
+/**
+ * Determines if a masking implementation can be used on this CPU.
+ * @param impl The implementation.
+ * @return @em true if the CPU supports it, @em false if not.
+ */
+bool ws_mask_supported(ws_mask_impl impl);
+/**
+ * Masks or unmasks a WebSocket payload, in place.
+ *
+ * This XOR's the data with the 4-byte masking key, repeated. Since that's
+ * its own inverse, the same call masks or unmasks. It uses the fastest
+ * implementation for the CPU, chosen the first time it's called.
+ *
+ * @param buf The payload data.
+ * @param n The number of bytes to mask.
+ * @param key The 4-byte masking key, as it appears on the wire.
+ * @param pos The offset of the data within the payload. This lets a large
+ *  		  payload be masked in pieces.
+ */
+void ws_mask(void* buf, size_t n, const uint8_t key[4], size_t pos=0);
+/**
+ * Masks or unmasks a WebSocket payload, in place, with a specific
+ * implementation.
+ * This is mainly for testing and benchmarks.
+ * @param impl The implementation. If the CPU doesn't support it, the
+ *  		   scalar one is used.
+ * @param buf The payload data.
+ * @param n The number of bytes to mask.
+ * @param key The 4-byte masking key, as it appears on the wire.
+ * @param pos The offset of the data within the payload.
+ */
+void ws_mask(ws_mask_impl impl, void* buf, size_t n, const uint8_t key[4],
+			 size_t pos=0);
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The header of a WebSocket frame.
+ */
+struct ws_frame_header
+{
+	/** The maximum size of an encoded header, in bytes */
+	static const size_t MAX_SIZE = 14;
+
+	/** Whether this is the final frame of a message */
+	bool fin;
+	/** The three reserved bits, for extensions, in the low bits */
+	uint8_t rsv;
+	/** The frame opcode */
+	ws_opcode opcode;
+	/** Whether the payload is masked */
+	bool masked;
+	/** The masking key, if masked */
+	uint8_t mask_key[4];
+	/** The length of the payload */
+	uint64_t payload_len;
+
+	/**
+	 * Creates a header for a final, unmasked frame with no payload.
+	 */
+	ws_frame_header(ws_opcode op=ws_opcode::BINARY, uint64_t len=0)
+		: fin(true), rsv(0), opcode(op), masked(false), mask_key{},
+			payload_len(len) {}
+	/**
+	 * Determines if this is a control frame (close, ping, or pong).
+	 * @return @em true if this is a control frame.
+	 */
+	bool is_control() const { return (uint8_t(opcode) & 0x08) != 0; }
+	/**
+	 * Gets the size of the header when encoded.
+	 * @return The size of the header when encoded, in bytes.
+	 */
+	size_t size() const;
+	/**
+	 * Encodes the header.
+	 * @param buf The buffer to receive the header. It must hold at least
+	 *  		  @ref MAX_SIZE bytes.
+	 * @return The number of bytes written to the buffer.
+	 */
+	size_t encode(void* buf) const;
+	/**
+	 * Parses a header from the start of a buffer.
+	 * @param buf The received data.
+	 * @param n The number of bytes in the buffer.
+	 * @param hdr Gets the parsed header.
+	 * @return The size of the header in bytes, @em 0 if the buffer does not
+	 *  	   yet hold the whole header, or @em -1 if it is invalid.
+	 */
+	static ssize_t parse(const void* buf, size_t n, ws_frame_header& hdr);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A complete WebSocket message, or a close notice.
+ */
+struct ws_message
+{
+	/** TEXT, BINARY, or CLOSE */
+	ws_opcode opcode;
+	/** The payload. For a close, this is the reason, if any. */
+	std::string data;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A WebSocket endpoint on an open connection.
+ *
+ * This handles the framing protocol once the opening HTTP handshake is
+ * done. Received messages are reassembled from their fragments, with any
+ * control frames in between handled along the way: a ping is answered
+ * with a pong, and a pong is dropped. A close frame is answered with a
+ * close, if we didn't start the close ourselves, and is then returned to
+ * the application.
+ *
+ * Incoming data goes through a read buffer so that small frames don't
+ * cost a system call each, but large payloads are read straight into the
+ * message. Payloads are unmasked in place with the fastest SIMD masking
+ * available.
+ *
+ * On a protocol error, such as a client frame that isn't masked, a close
+ * frame with the matching status is sent, and @ref recv() fails. The
+ * status is then available from @ref close_code(). Text messages are not
+ * checked to be valid UTF-8.
+ *
+ * A client masks each frame with a fresh key from the operating system's
+ * secure random source, as RFC 6455 requires, so that the frames can't be
+ * predicted by script running in the client.
+ *
+ * The object does not own the socket. The socket must outlive it. One
+ * thread can receive while others send. The sends, including the pongs
+ * and close replies sent from @ref recv(), take a lock so that their
+ * frames don't interleave. A fragmented message should still be sent from
+ * a single thread, since another sender's message could land between its
+ * frames.
+ */
+class websocket
+{
+public:
+	/** The role of this endpoint. Clients mask the frames they send. */
+	enum role { CLIENT, SERVER };
+
+	/** Normal closure */
+	static const uint16_t CLOSE_NORMAL = 1000;
+	/** The endpoint is going away */
+	static const uint16_t CLOSE_GOING_AWAY = 1001;
+	/** A protocol error */
+	static const uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+	/** A close frame had no status code */
+	static const uint16_t CLOSE_NO_STATUS = 1005;
+	/** The connection dropped without a close frame */
+	static const uint16_t CLOSE_ABNORMAL = 1006;
+	/** A message was too big to process */
+	static const uint16_t CLOSE_TOO_BIG = 1009;
+
+	/** The default maximum size of a received message */
+	static const size_t DFLT_MAX_MESSAGE = 16*1024*1024;
+	/** The size of the read buffer */
+	static const size_t READ_BUF_SIZE = 64*1024;
+
+private:
+	/** The socket */
+	stream_socket& sock_;
+	/** Our role */
+	role role_;
+	/** The largest message we'll accept */
+	size_t maxMsg_;
+	/** The read buffer */
+	std::vector<uint8_t> rbuf_;
+	/** The start of unread data in the read buffer */
+	size_t rpos_;
+	/** The end of unread data in the read buffer */
+	size_t rend_;
+	/** Lock for sending, which guards the send buffer and the keys */
+	std::mutex wrLock_;
+	/** Scratch buffer for outgoing frames */
+	std::vector<uint8_t> sbuf_;
+	/** Random bytes for the masking keys */
+	uint8_t keys_[256];
+	/** The next unused byte of the masking keys */
+	size_t keyPos_;
+	/** Whether we sent a close frame */
+	std::atomic<bool> closeSent_;
+	/** Whether we received a close frame */
+	std::atomic<bool> closeRecvd_;
+	/** The close status code */
+	uint16_t closeCode_;
+
+	/** Reads more data into the read buffer */
+	bool fill();
+	/** Reads part of a payload, from the buffer, then the socket */
+	bool read_payload(uint8_t* p, size_t n);
+	/** Sends a close for a protocol violation and fails */
+	bool fail(uint16_t code);
+	/** Gets the next masking key. Called with the send lock held. */
+	bool next_mask_key(uint8_t key[4]);
+
+	// Non-copyable
+	websocket(const websocket&) =delete;
+	websocket& operator=(const websocket&) =delete;
+
+public:
+	/**
+	 * Creates a WebSocket endpoint on a connected socket.
+	 * @param sock The socket, after the opening handshake is complete. It
+	 *  		   must outlive this object.
+	 * @param r Whether we are the client or the server.
+	 * @param maxMsgSize The largest message to accept.
+	 */
+	websocket(stream_socket& sock, role r, size_t maxMsgSize=DFLT_MAX_MESSAGE);
+	/**
+	 * Sends a single frame.
+	 *
+	 * To send a fragmented message, send the first frame with the TEXT or
+	 * BINARY opcode and @p fin false, then the rest as CONTINUATION frames,
+	 * with @p fin true on the last one.
+	 *
+	 * @param op The frame opcode.
+	 * @param buf The payload.
+	 * @param n The size of the payload.
+	 * @param fin Whether this is the last frame of the message.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool send(ws_opcode op, const void* buf, size_t n, bool fin=true);
+	/**
+	 * Sends a text message in a single frame.
+	 * @param s The text.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool send_text(const std::string& s) {
+		return send(ws_opcode::TEXT, s.data(), s.size());
+	}
+	/**
+	 * Sends a binary message in a single frame.
+	 * @param buf The data.
+	 * @param n The size of the data.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool send_binary(const void* buf, size_t n) {
+		return send(ws_opcode::BINARY, buf, n);
+	}
+	/**
+	 * Sends a ping.
+	 * @param payload Application data, up to 125 bytes.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool ping(const std::string& payload=std::string()) {
+		return send(ws_opcode::PING, payload.data(), payload.size());
+	}
+	/**
+	 * Starts, or completes, the closing handshake.
+	 * @param code The status code.
+	 * @param reason A short explanation, up to 123 bytes.
+	 * @return @em true on success, @em false on error.
+	 */
+	bool close(uint16_t code=CLOSE_NORMAL, const std::string& reason=std::string());
+	/**
+	 * Receives the next complete message.
+	 * @param msg Gets the message. If the peer closed, the opcode is CLOSE,
+	 *  		  the data is the reason, and the status is available from
+	 *  		  @ref close_code().
+	 * @return @em true if a message or close was received, @em false on a
+	 *  	   socket or protocol error, or if the connection was dropped.
+	 */
+	bool recv(ws_message& msg);
+	/**
+	 * Gets the close status.
+	 * @return The status code of the close frame that was received, or the
+	 *  	   error that caused us to close, or zero if not closed.
+	 */
+	uint16_t close_code() const { return closeCode_; }
+	/**
+	 * Determines if the closing handshake is done, in both directions.
+	 * @return @em true if a close was both sent and received.
+	 */
+	bool is_closed() const { return closeSent_ && closeRecvd_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
+
+#endif		// __sockpp_websocket_h
@@ -0,0 +1,245 @@
+/**
+ * @file write_queue.h
+ *
+ * Lock-free, multi-producer queue for writing to a stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_write_queue_h
+#define __sockpp_write_queue_h
+
+#include "sockpp/stream_socket.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A per-connection queue for submitting writes from multiple threads.
+ *
+ * Any number of producer threads can push buffers into the queue without
+ * taking a lock. A single owner thread then calls @ref flush() to send
+ * everything that is pending, coalescing the buffers into gather writes
+ * with `writev()`. Since only the owner thread ever writes to the socket,
+ * each submitted buffer goes out contiguously, and message framing is
+ * never corrupted by interleaved partial writes.
+ *
+ * The queue keeps a running count of the bytes that were submitted but not
+ * yet written. When this goes over the high watermark, producers are
+ * expected to back off until the owner catches up. Once the owner has
+ * drained the queue down to the low watermark, it fires the "writable"
+ * callback, which an application or event loop can use to resume the
+ * producers.
+ *
+ * When used with a non-blocking TCP socket, it's a good idea to also limit
+ * the kernel's unsent queue with @ref stream_socket::notsent_lowat, so
+ * that the backlog of a slow peer is held here, where it is counted,
+ * rather than in the kernel.
+ *
+ * The queue does not own the socket. The socket must outlive the queue.
+ */
+class write_queue
+{
+	/** A node in the intrusive MPSC list */
+	struct node {
+		std::atomic<node*> next;
+		std::string data;
+
+		node() : next(nullptr) {}
+		explicit node(std::string&& s) : next(nullptr), data(std::move(s)) {}
+	};
+
+	/** The socket we write to */
+	stream_socket& sock_;
+	/** The last node pushed. Producers swap themselves in here. */
+	std::atomic<node*> head_;
+	/** The next node to consume. Only touched by the owner. */
+	node* tail_;
+	/** Placeholder node to keep the list non-empty */
+	node stub_;
+	/** Bytes submitted that have not yet been written */
+	std::atomic<size_t> queued_;
+	/** The high watermark for backpressure, in bytes */
+	size_t hiWater_;
+	/** The low watermark to resume writing, in bytes */
+	size_t loWater_;
+	/** Set by a producer whose push crossed the high watermark */
+	std::atomic<bool> crossed_;
+	/** Whether the owner saw the queue over the high watermark */
+	bool congested_;
+	/** Callback for when the queue drops back to the low watermark */
+	std::function<void()> writableCb_;
+	/** Nodes taken off the list, waiting to be written (owner only) */
+	std::deque<node*> pending_;
+	/** Bytes of the front pending node that were already written */
+	size_t offset_;
+	/** Scratch I/O vector, reused for each batch (owner only) */
+	std::vector<iovec> iov_;
+
+	/** Pushes a node onto the list (any thread) */
+	void push(node* n);
+	/** Removes the next node from the list, if any (owner only) */
+	node* pop();
+
+	// Non-copyable
+	write_queue(const write_queue&) =delete;
+	write_queue& operator=(const write_queue&) =delete;
+
+public:
+	/**
+	 * The default high watermark.
+	 */
+	static const size_t DFLT_HI_WATER = 1024*1024;
+	/**
+	 * The maximum number of buffers gathered into a single write.
+	 */
+	static const size_t MAX_BATCH = 64;
+	/**
+	 * Creates a write queue for the specified socket.
+	 * The low watermark is set to half of the high one.
+	 * @param sock The socket to write. It must outlive the queue.
+	 * @param hiWater The high watermark, in bytes, for backpressure.
+	 */
+	explicit write_queue(stream_socket& sock, size_t hiWater=DFLT_HI_WATER);
+	/**
+	 * Destructor.
+	 * Any data that has not been written is discarded.
+	 */
+	~write_queue();
+	/**
+	 * Submits a buffer to be written.
+	 * This can be called from any thread. The data is copied into the
+	 * queue.
+	 * @param buf The data to write.
+	 * @param n The number of bytes in the buffer.
+	 * @return The number of bytes queued after this submission.
+	 */
+	size_t push(const void* buf, size_t n) {
+		return push(std::string(static_cast<const char*>(buf), n));
+	}
+	/**
+	 * Submits a buffer to be written.
+	 * This can be called from any thread. The string is moved into the
+	 * queue without a copy.
+	 * @param s The data to write.
+	 * @return The number of bytes queued after this submission.
+	 */
+	size_t push(std::string s);
+	/**
+	 * Writes out as much of the queued data as possible.
+	 *
+	 * This must only be called from a single, owner, thread at a time.
+	 * With a blocking socket, it keeps going until the queue is empty or
+	 * an error occurs. With a non-blocking socket, it also stops when the
+	 * socket would block, leaving the remaining data queued.
+	 *
+	 * @return The number of bytes written, or @em -1 on error. If nothing
+	 *  	   was written because the socket would block, this is zero.
+	 */
+	ssize_t flush();
+	/**
+	 * Gets the number of bytes submitted but not yet written.
+	 * @return The number of bytes queued.
+	 */
+	size_t size() const { return queued_.load(std::memory_order_relaxed); }
+	/**
+	 * Determines if there is any data waiting to be written.
+	 * @return @em true if the queue is empty, @em false if not.
+	 */
+	bool empty() const { return size() == 0; }
+	/**
+	 * Gets the high watermark.
+	 * @return The high watermark, in bytes.
+	 */
+	size_t high_watermark() const { return hiWater_; }
+	/**
+	 * Gets the low watermark.
+	 * @return The low watermark, in bytes.
+	 */
+	size_t low_watermark() const { return loWater_; }
+	/**
+	 * Sets the high and low watermarks.
+	 * This should be done before the queue is put into use.
+	 * @param hiWater The high watermark, in bytes.
+	 * @param loWater The low watermark, in bytes. This should be less
+	 *  			  than the high watermark.
+	 */
+	void set_watermarks(size_t hiWater, size_t loWater) {
+		hiWater_ = hiWater;
+		loWater_ = loWater;
+	}
+	/**
+	 * Sets a callback for when the queue becomes writable again.
+	 *
+	 * The callback fires once each time the owner drains the queue down to
+	 * the low watermark after having seen it at or over the high watermark.
+	 * It is called from the owner thread, inside of @ref flush(), so it
+	 * should be quick, such as notifying a condition variable or waking an
+	 * event loop.
+	 *
+	 * This should be set before the queue is put into use.
+	 * @param cb The callback function.
+	 */
+	void on_writable(std::function<void()> cb) { writableCb_ = std::move(cb); }
+	/**
+	 * Determines if producers should back off.
+	 * @return @em true if the amount of queued data is at or above the
+	 *  	   high watermark.
+	 */
+	bool over_watermark() const { return size() >= hiWater_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+#endif	// !WIN32
+
+// end namespace sockpp
+}
+
+#endif		// __sockpp_write_queue_h
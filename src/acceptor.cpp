@@ -35,6 +35,9 @@
 // --------------------------------------------------------------------------
 
 #include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include "sockpp/acceptor.h"
 
 using namespace std;
@@ -43,6 +46,28 @@ namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
+const int acceptor::AUTO_QUE_SIZE;
+const int acceptor::DFLT_QUE_SIZE;
+
+// --------------------------------------------------------------------------
+// The somaxconn value can't change without a reboot or an admin changing
+// the sysctl, so it's only read once.
+
+int acceptor::max_que_size()
+{
+	#if defined(__linux__)
+		static const int maxQue = [] {
+			int n = 0;
+			std::ifstream fin("/proc/sys/net/core/somaxconn");
+			return (fin >> n && n > 0) ? n : int(SOMAXCONN);
+		}();
+		return maxQue;
+	#else
+		return SOMAXCONN;
+	#endif
+}
+
+// --------------------------------------------------------------------------
 // Binds the socket to the specified address.
 
 bool acceptor::bind(const sockaddr* addr, socklen_t len)
@@ -102,10 +127,71 @@ bool acceptor::open(const sockaddr* addr, socklen_t len, int queSize /*=DFLT_QUE
 
 // --------------------------------------------------------------------------
 
+bool acceptor::defer_accept(const std::chrono::seconds& timeout)
+{
+	#if defined(TCP_DEFER_ACCEPT)
+		int secs = int(timeout.count());
+		return set_option(IPPROTO_TCP, TCP_DEFER_ACCEPT, &secs, sizeof(int));
+	#elif defined(SO_ACCEPTFILTER)
+		if (timeout.count() == 0)
+			return set_option(SOL_SOCKET, SO_ACCEPTFILTER, nullptr, 0);
+
+		accept_filter_arg afa;
+		std::memset(&afa, 0, sizeof(afa));
+		std::strcpy(afa.af_name, "dataready");
+		return set_option(SOL_SOCKET, SO_ACCEPTFILTER, &afa, sizeof(afa));
+	#else
+		(void) timeout;
+		return false;
+	#endif
+}
+
+// --------------------------------------------------------------------------
+// For a listening socket, Linux reports the current accept queue length
+// in tcpi_unacked and the backlog in tcpi_sacked. The overflow counters
+// are in /proc/net/netstat as a pair of lines, one with the names of the
+// TcpExt counters and the next with their values.
+
+#if defined(__linux__)
+bool acceptor::queue_stats(listen_stats& st)
+{
+	std::memset(&st, 0, sizeof(listen_stats));
+
+	tcp_stats ti;
+	if (!get_tcp_stats(ti))
+		return false;
+
+	st.pending = ti.tcpi_unacked;
+	st.max_pending = ti.tcpi_sacked;
+
+	std::ifstream fin("/proc/net/netstat");
+	std::string names, vals;
+
+	while (std::getline(fin, names) && std::getline(fin, vals)) {
+		if (names.compare(0, 7, "TcpExt:") != 0)
+			continue;
+
+		std::istringstream nss(names), vss(vals);
+		std::string name, val;
+
+		while (nss >> name && vss >> val) {
+			if (name == "ListenOverflows")
+				st.overflows = std::stoull(val);
+			else if (name == "ListenDrops")
+				st.drops = std::stoull(val);
+		}
+		break;
+	}
+	return true;
+}
+#endif
+
+// --------------------------------------------------------------------------
+
 stream_socket acceptor::accept(sock_address* clientAddr /*=nullptr*/)
 {
     sockaddr_storage addr;
-    socklen_t len;
+    socklen_t len = sizeof(addr);
 
     auto paddr = reinterpret_cast <sockaddr*>(&addr);
     socket_t s = check_ret(::accept(handle(), paddr, &len));
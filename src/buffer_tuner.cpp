@@ -0,0 +1,274 @@
+// buffer_tuner.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/buffer_tuner.h"
+#include "sockpp/tcp_info.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+const size_t buffer_tuner::DFLT_MIN_BUF;
+const size_t buffer_tuner::DFLT_MAX_BUF;
+
+namespace {
+
+bool get_stats(socket_t h, tcp_stats& st)
+{
+	std::memset(&st, 0, sizeof(tcp_stats));
+	socklen_t len = sizeof(tcp_stats);
+	return ::getsockopt(h, IPPROTO_TCP, TCP_INFO, &st, &len) == 0;
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//							buffer_tuner
+/////////////////////////////////////////////////////////////////////////////
+
+buffer_tuner::buffer_tuner(size_t budget, size_t minBuf /*=DFLT_MIN_BUF*/,
+						   size_t maxBuf /*=DFLT_MAX_BUF*/)
+		: budget_(budget), minBuf_(minBuf), maxBuf_(std::max(minBuf, maxBuf))
+{
+}
+
+// The kernel doubles the size that's set, so we ask for half of what we
+// want. It reports back what it actually used, which might be capped.
+
+bool buffer_tuner::set_buffer(socket_t h, int opt, size_t& cur, size_t sz)
+{
+	int val = int(std::min<size_t>(sz / 2, INT_MAX));
+	if (::setsockopt(h, SOL_SOCKET, opt, &val, sizeof(int)) != 0)
+		return false;
+
+	socklen_t len = sizeof(int);
+	if (::getsockopt(h, SOL_SOCKET, opt, &val, &len) != 0)
+		return false;
+
+	bool changed = size_t(val) != cur;
+	cur = size_t(val);
+	return changed;
+}
+
+// --------------------------------------------------------------------------
+
+bool buffer_tuner::add(const socket& sock)
+{
+	if (!sock)
+		return false;
+
+	socket_t h = sock.handle();
+	conn c {};
+
+	tcp_stats st;
+	if (!get_stats(h, st))
+		return false;
+
+	set_buffer(h, SO_SNDBUF, c.cur.sndBuf, minBuf_);
+	set_buffer(h, SO_RCVBUF, c.cur.rcvBuf, minBuf_);
+	if (c.cur.sndBuf == 0 || c.cur.rcvBuf == 0)
+		return false;
+
+	c.want = c.cur;
+	c.bytesAcked = st.tcpi_bytes_acked;
+	c.bytesRecv = st.tcpi_bytes_received;
+	c.sndbufLimited = st.tcpi_sndbuf_limited;
+	c.when = clock::now();
+
+	std::lock_guard<std::mutex> lk(lock_);
+	conns_[h] = c;
+	return true;
+}
+
+void buffer_tuner::remove(socket_t h)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	conns_.erase(h);
+}
+
+// --------------------------------------------------------------------------
+
+size_t buffer_tuner::size() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return conns_.size();
+}
+
+size_t buffer_tuner::budget() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return budget_;
+}
+
+void buffer_tuner::set_budget(size_t budget)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	budget_ = budget;
+}
+
+size_t buffer_tuner::used() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+
+	size_t n = 0;
+	for (const auto& c : conns_)
+		n += c.second.cur.sndBuf + c.second.cur.rcvBuf;
+	return n;
+}
+
+bool buffer_tuner::get_sizes(const socket& sock, buffer_sizes& sz) const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+
+	auto p = conns_.find(sock.handle());
+	if (p == conns_.end())
+		return false;
+
+	sz = p->second.cur;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+// A connection that isn't sending only needs the minimum send buffer,
+// whatever its congestion window. A buffer that looks full is doubled,
+// since the rate we see is capped by the buffer itself, and would never
+// show that more is needed. The usable receive window is only part of the
+// receive buffer, so it counts as full well before the BDP reaches the
+// whole size.
+
+void buffer_tuner::sample(socket_t h, conn& c, clock::time_point now)
+{
+	tcp_stats st;
+	if (!get_stats(h, st)) {
+		c.want = c.cur;
+		return;
+	}
+
+	double dt = duration<double>(now - c.when).count();
+
+	uint64_t snd = 0;
+	if (st.tcpi_bytes_acked > c.bytesAcked || st.tcpi_unacked > 0) {
+		uint64_t bdp = st.tcpi_delivery_rate * st.tcpi_rtt / 1000000;
+		uint64_t inflight = uint64_t(st.tcpi_snd_cwnd) * st.tcpi_snd_mss;
+		snd = 2 * std::max(bdp, inflight);
+	}
+
+	if (st.tcpi_sndbuf_limited > c.sndbufLimited)
+		snd = std::max<uint64_t>(snd, 2 * c.cur.sndBuf);
+
+	uint32_t rtt = st.tcpi_rcv_rtt ? st.tcpi_rcv_rtt : st.tcpi_rtt;
+	uint64_t nrecv = st.tcpi_bytes_received - c.bytesRecv;
+	uint64_t rcvBdp = (dt > 0) ? uint64_t(nrecv / dt * rtt / 1.0e6) : 0;
+	uint64_t rcv = 2 * rcvBdp;
+
+	if (rcvBdp >= c.cur.rcvBuf * 3 / 8)
+		rcv = std::max<uint64_t>(rcv, 2 * c.cur.rcvBuf);
+
+	c.want.sndBuf = size_t(std::min<uint64_t>(std::max<uint64_t>(snd, minBuf_), maxBuf_));
+	c.want.rcvBuf = size_t(std::min<uint64_t>(std::max<uint64_t>(rcv, minBuf_), maxBuf_));
+
+	c.bytesAcked = st.tcpi_bytes_acked;
+	c.bytesRecv = st.tcpi_bytes_received;
+	c.sndbufLimited = st.tcpi_sndbuf_limited;
+	c.when = now;
+}
+
+// Over the budget, everyone's share above the minimum shrinks by the same
+// factor. A buffer grows once it's wanted an eighth bigger, but only
+// shrinks to half, unless holding on to it would put the total over the
+// budget.
+
+size_t buffer_tuner::tune()
+{
+	std::lock_guard<std::mutex> lk(lock_);
+
+	auto now = clock::now();
+	size_t total = 0;
+
+	for (auto& c : conns_) {
+		sample(c.first, c.second, now);
+		total += c.second.want.sndBuf + c.second.want.rcvBuf;
+	}
+
+	size_t floor = 2 * minBuf_ * conns_.size();
+	double f = 1.0;
+
+	if (total > budget_ && total > floor)
+		f = (budget_ > floor) ? double(budget_ - floor) / double(total - floor) : 0.0;
+
+	auto target = [this, f](size_t want) {
+		return minBuf_ + size_t(double(want - minBuf_) * f);
+	};
+	auto keep = [](size_t cur, size_t sz) {
+		return sz <= cur + cur/8 && sz >= cur/2;
+	};
+
+	size_t after = 0;
+	for (auto& c : conns_) {
+		size_t snd = target(c.second.want.sndBuf), rcv = target(c.second.want.rcvBuf);
+		after += keep(c.second.cur.sndBuf, snd) ? c.second.cur.sndBuf : snd;
+		after += keep(c.second.cur.rcvBuf, rcv) ? c.second.cur.rcvBuf : rcv;
+	}
+	bool strict = after > budget_;
+
+	auto resize = [&](socket_t h, int opt, size_t& cur, size_t want) {
+		size_t sz = target(want);
+		if (!keep(cur, sz) || (strict && sz < cur))
+			return set_buffer(h, opt, cur, sz);
+		return false;
+	};
+
+	size_t n = 0;
+	for (auto& c : conns_) {
+		bool snd = resize(c.first, SO_SNDBUF, c.second.cur.sndBuf, c.second.want.sndBuf);
+		bool rcv = resize(c.first, SO_RCVBUF, c.second.cur.rcvBuf, c.second.want.rcvBuf);
+		if (snd || rcv)
+			++n;
+	}
+	return n;
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
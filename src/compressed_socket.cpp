@@ -0,0 +1,553 @@
+// compressed_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/compressed_socket.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(SOCKPP_WITH_LZ4)
+	#include <lz4frame.h>
+#endif
+
+#if defined(SOCKPP_WITH_ZSTD)
+	#include <zstd.h>
+#endif
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+// The common interface to the compression libraries. Output is appended to
+// a buffer that only ever grows, so that after the first few messages
+// there's no allocation.
+
+class compressed_socket::codec
+{
+public:
+	virtual ~codec() {}
+	/** Compresses data, appending to the buffer at 'len' */
+	virtual bool compress(const void* buf, size_t n, std::vector<uint8_t>& out,
+						  size_t& len, flush_mode mode) =0;
+	/** Sets the level. Only called between frames. */
+	virtual bool set_level(int level) =0;
+	/** Decompresses. On return 'nin' and 'nout' are the bytes used. */
+	virtual bool decompress(const uint8_t* in, size_t& nin,
+							void* out, size_t& nout) =0;
+};
+
+namespace {
+
+inline void ensure_space(std::vector<uint8_t>& out, size_t len, size_t n)
+{
+	if (out.size() < len + n)
+		out.resize(std::max(len + n, 2*out.size()));
+}
+
+#if defined(SOCKPP_WITH_LZ4)
+
+// --------------------------------------------------------------------------
+// LZ4 frames, with linked blocks so that each block can refer back to the
+// ones before it. A flush closes off the current block.
+
+class lz4_codec : public compressed_socket::codec
+{
+	using flush_mode = compressed_socket::flush_mode;
+
+	/** Input is compressed in pieces no larger than this */
+	static const size_t CHUNK_SIZE = 64*1024;
+
+	LZ4F_cctx* cctx_;
+	LZ4F_dctx* dctx_;
+	LZ4F_preferences_t prefs_;
+	bool inFrame_;
+
+public:
+	explicit lz4_codec(int level) : cctx_(nullptr), dctx_(nullptr), inFrame_(false) {
+		std::memset(&prefs_, 0, sizeof(prefs_));
+		prefs_.frameInfo.blockSizeID = LZ4F_max64KB;
+		prefs_.frameInfo.blockMode = LZ4F_blockLinked;
+		prefs_.compressionLevel = level;
+		LZ4F_createCompressionContext(&cctx_, LZ4F_VERSION);
+		LZ4F_createDecompressionContext(&dctx_, LZ4F_VERSION);
+	}
+
+	~lz4_codec() override {
+		LZ4F_freeCompressionContext(cctx_);
+		LZ4F_freeDecompressionContext(dctx_);
+	}
+
+	explicit operator bool() const { return cctx_ && dctx_; }
+
+	bool compress(const void* buf, size_t n, std::vector<uint8_t>& out,
+				  size_t& len, flush_mode mode) override {
+		if (!inFrame_) {
+			ensure_space(out, len, LZ4F_HEADER_SIZE_MAX);
+			size_t ret = LZ4F_compressBegin(cctx_, out.data()+len,
+											out.size()-len, &prefs_);
+			if (LZ4F_isError(ret))
+				return false;
+			len += ret;
+			inFrame_ = true;
+		}
+
+		auto p = static_cast<const uint8_t*>(buf);
+		while (n > 0) {
+			size_t nc = std::min(n, CHUNK_SIZE);
+			ensure_space(out, len, LZ4F_compressBound(nc, &prefs_));
+			size_t ret = LZ4F_compressUpdate(cctx_, out.data()+len,
+											 out.size()-len, p, nc, nullptr);
+			if (LZ4F_isError(ret))
+				return false;
+			len += ret;
+			p += nc;
+			n -= nc;
+		}
+
+		if (mode == flush_mode::CONTINUE)
+			return true;
+
+		ensure_space(out, len, LZ4F_compressBound(0, &prefs_));
+		size_t ret = (mode == flush_mode::END)
+			? LZ4F_compressEnd(cctx_, out.data()+len, out.size()-len, nullptr)
+			: LZ4F_flush(cctx_, out.data()+len, out.size()-len, nullptr);
+		if (LZ4F_isError(ret))
+			return false;
+
+		len += ret;
+		if (mode == flush_mode::END)
+			inFrame_ = false;
+		return true;
+	}
+
+	bool set_level(int level) override {
+		prefs_.compressionLevel = level;
+		return true;
+	}
+
+	bool decompress(const uint8_t* in, size_t& nin, void* out, size_t& nout) override {
+		size_t ret = LZ4F_decompress(dctx_, out, &nout, in, &nin, nullptr);
+		return !LZ4F_isError(ret);
+	}
+};
+
+const size_t lz4_codec::CHUNK_SIZE;
+
+#endif	// SOCKPP_WITH_LZ4
+
+#if defined(SOCKPP_WITH_ZSTD)
+
+// --------------------------------------------------------------------------
+// zstd streaming. The decompressor reads back-to-back frames on its own,
+// so ending a frame to change the level is invisible to the peer.
+
+class zstd_codec : public compressed_socket::codec
+{
+	using flush_mode = compressed_socket::flush_mode;
+
+	ZSTD_CCtx* cctx_;
+	ZSTD_DCtx* dctx_;
+
+public:
+	explicit zstd_codec(int level) : cctx_(ZSTD_createCCtx()), dctx_(ZSTD_createDCtx()) {
+		if (cctx_)
+			ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, level);
+	}
+
+	~zstd_codec() override {
+		ZSTD_freeCCtx(cctx_);
+		ZSTD_freeDCtx(dctx_);
+	}
+
+	explicit operator bool() const { return cctx_ && dctx_; }
+
+	bool compress(const void* buf, size_t n, std::vector<uint8_t>& out,
+				  size_t& len, flush_mode mode) override {
+		ZSTD_EndDirective op = (mode == flush_mode::END) ? ZSTD_e_end
+			: (mode == flush_mode::FLUSH) ? ZSTD_e_flush : ZSTD_e_continue;
+
+		ZSTD_inBuffer ib { buf, n, 0 };
+
+		while (true) {
+			ensure_space(out, len, std::max(ZSTD_compressBound(n - ib.pos),
+											ZSTD_CStreamOutSize()));
+			ZSTD_outBuffer ob { out.data(), out.size(), len };
+			size_t rem = ZSTD_compressStream2(cctx_, &ob, &ib, op);
+			len = ob.pos;
+
+			if (ZSTD_isError(rem))
+				return false;
+
+			if ((op == ZSTD_e_continue) ? (ib.pos == ib.size) : (rem == 0))
+				return true;
+		}
+	}
+
+	bool set_level(int level) override {
+		return !ZSTD_isError(ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, level));
+	}
+
+	bool decompress(const uint8_t* in, size_t& nin, void* out, size_t& nout) override {
+		ZSTD_inBuffer ib { in, nin, 0 };
+		ZSTD_outBuffer ob { out, nout, 0 };
+		size_t ret = ZSTD_decompressStream(dctx_, &ob, &ib);
+		nin = ib.pos;
+		nout = ob.pos;
+		return !ZSTD_isError(ret);
+	}
+};
+
+#endif	// SOCKPP_WITH_ZSTD
+
+}	// anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//							compressed_socket
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t compressed_socket::ADAPT_INTERVAL;
+const size_t compressed_socket::DFLT_LO_BACKLOG;
+const size_t compressed_socket::DFLT_HI_BACKLOG;
+const size_t compressed_socket::READ_BUF_SIZE;
+
+// --------------------------------------------------------------------------
+
+bool compressed_socket::supported(algorithm alg)
+{
+	switch (alg) {
+		#if defined(SOCKPP_WITH_LZ4)
+			case LZ4:	return true;
+		#endif
+		#if defined(SOCKPP_WITH_ZSTD)
+			case ZSTD:	return true;
+		#endif
+		default:		return false;
+	}
+}
+
+int compressed_socket::default_level(algorithm alg)
+{
+	switch (alg) {
+		#if defined(SOCKPP_WITH_ZSTD)
+			case ZSTD:	return ZSTD_CLEVEL_DEFAULT;
+		#endif
+		default:		return 0;
+	}
+}
+
+int compressed_socket::max_level(algorithm alg)
+{
+	switch (alg) {
+		#if defined(SOCKPP_WITH_LZ4)
+			case LZ4:	return LZ4F_compressionLevel_max();
+		#endif
+		#if defined(SOCKPP_WITH_ZSTD)
+			case ZSTD:	return ZSTD_maxCLevel();
+		#endif
+		default:		return 0;
+	}
+}
+
+// --------------------------------------------------------------------------
+
+compressed_socket::compressed_socket()
+		: level_(0), minLevel_(0), maxLevel_(0),
+			loBacklog_(DFLT_LO_BACKLOG), hiBacklog_(DFLT_HI_BACKLOG),
+			sinceAdapt_(0), rawSent_(0), wireSent_(0), outLen_(0),
+			inPos_(0), inLen_(0), inPending_(false)
+{
+}
+
+compressed_socket::compressed_socket(stream_socket&& sock, algorithm alg, int level)
+		: base(std::move(sock)), level_(level), minLevel_(level), maxLevel_(level),
+			loBacklog_(DFLT_LO_BACKLOG), hiBacklog_(DFLT_HI_BACKLOG),
+			sinceAdapt_(0), rawSent_(0), wireSent_(0), outLen_(0),
+			inPos_(0), inLen_(0), inPending_(false)
+{
+	switch (alg) {
+		#if defined(SOCKPP_WITH_LZ4)
+			case LZ4: {
+				std::unique_ptr<lz4_codec> c(new lz4_codec(level));
+				if (*c)
+					codec_ = std::move(c);
+				break;
+			}
+		#endif
+		#if defined(SOCKPP_WITH_ZSTD)
+			case ZSTD: {
+				std::unique_ptr<zstd_codec> c(new zstd_codec(level));
+				if (*c)
+					codec_ = std::move(c);
+				break;
+			}
+		#endif
+		default:
+			clear(EPROTONOSUPPORT);
+			return;
+	}
+
+	if (!codec_)
+		clear(ENOMEM);
+}
+
+compressed_socket::compressed_socket(compressed_socket&& sock) =default;
+
+compressed_socket& compressed_socket::operator=(compressed_socket&& rhs) =default;
+
+compressed_socket::~compressed_socket()
+{
+}
+
+// --------------------------------------------------------------------------
+
+void compressed_socket::set_level_range(int minLevel, int maxLevel)
+{
+	minLevel_ = minLevel;
+	maxLevel_ = std::max(minLevel, maxLevel);
+
+	if (level_ == minLevel_ || !codec_)
+		return;
+
+	// Once data has gone out, it takes a new frame
+	level_ = minLevel_;
+	if (rawSent_ == 0 || finish())
+		codec_->set_level(level_);
+	sinceAdapt_ = 0;
+}
+
+// --------------------------------------------------------------------------
+
+bool compressed_socket::compress(const void* buf, size_t n, flush_mode mode)
+{
+	if (!codec_) {
+		clear(EPROTONOSUPPORT);
+		return false;
+	}
+
+	if (!codec_->compress(buf, n, outBuf_, outLen_, mode)) {
+		clear(EPROTO);
+		return false;
+	}
+
+	rawSent_ += n;
+	sinceAdapt_ += n;
+	return true;
+}
+
+// This can't use write_n(), which would come back around through our own
+// write() to compress the data again.
+
+bool compressed_socket::send_output()
+{
+	const uint8_t* p = outBuf_.data();
+	size_t n = outLen_;
+
+	while (n > 0) {
+		ssize_t ret = base::write(p, n);
+		if (ret < 0 && last_error() == EINTR)
+			continue;
+		if (ret <= 0)
+			return false;
+		p += ret;
+		n -= size_t(ret);
+	}
+
+	wireSent_ += outLen_;
+	outLen_ = 0;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// At a message boundary, once enough data has gone by, we look at how much
+// is sitting in the kernel's send queue and decide whether to move the
+// level. A change requires ending the frame, so it's returned as END, and
+// the caller sets the new level once the frame is out.
+
+compressed_socket::flush_mode compressed_socket::message_end(size_t n)
+{
+	if (minLevel_ == maxLevel_ || sinceAdapt_ + n < ADAPT_INTERVAL)
+		return flush_mode::FLUSH;
+
+	sinceAdapt_ = 0;
+
+	int nq = send_queue_size();
+	if (nq < 0)
+		return flush_mode::FLUSH;
+
+	int level = level_;
+	if (size_t(nq) >= hiBacklog_) {
+		if (level < maxLevel_)
+			++level;
+	}
+	else if (size_t(nq) <= loBacklog_ && level > minLevel_)
+		--level;
+
+	if (level == level_)
+		return flush_mode::FLUSH;
+
+	level_ = level;
+	return flush_mode::END;
+}
+
+// --------------------------------------------------------------------------
+
+bool compressed_socket::finish()
+{
+	return compress(nullptr, 0, flush_mode::END) && send_output();
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t compressed_socket::write(const void *buf, size_t n)
+{
+	flush_mode mode = message_end(n);
+
+	if (!compress(buf, n, mode) || !send_output())
+		return -1;
+
+	if (mode == flush_mode::END)
+		codec_->set_level(level_);
+
+	return ssize_t(n);
+}
+
+ssize_t compressed_socket::write(const std::vector<iovec>& ranges)
+{
+	if (ranges.empty())
+		return 0;
+
+	size_t n = 0;
+	for (const auto& r : ranges)
+		n += r.iov_len;
+
+	flush_mode mode = message_end(n);
+
+	for (size_t i=0; i<ranges.size(); ++i) {
+		auto m = (i+1 == ranges.size()) ? mode : flush_mode::CONTINUE;
+		if (!compress(ranges[i].iov_base, ranges[i].iov_len, m))
+			return -1;
+	}
+
+	if (!send_output())
+		return -1;
+
+	if (mode == flush_mode::END)
+		codec_->set_level(level_);
+
+	return ssize_t(n);
+}
+
+ssize_t compressed_socket::write_more(const void *buf, size_t n)
+{
+	if (!compress(buf, n, flush_mode::CONTINUE) || !send_output())
+		return -1;
+	return ssize_t(n);
+}
+
+// --------------------------------------------------------------------------
+// The decompressor may hold on to output when the caller's buffer is too
+// small to take it all, so after filling the buffer, the next read tries
+// it again before going back to the socket.
+//
+// Both decompressors stop at the end of a frame, so decoding just the tail
+// of one gives no output even though the next frame may already be in the
+// buffer. The socket is only read once the input is used up, and anything
+// the decompressor couldn't take yet is kept at the front of the buffer.
+
+ssize_t compressed_socket::read(void *buf, size_t n)
+{
+	if (!codec_) {
+		clear(EPROTONOSUPPORT);
+		return -1;
+	}
+
+	if (n == 0)
+		return 0;
+
+	if (inBuf_.empty())
+		inBuf_.resize(READ_BUF_SIZE);
+
+	while (true) {
+		if (inPos_ < inLen_ || inPending_) {
+			size_t nin = inLen_ - inPos_, nout = n;
+
+			if (!codec_->decompress(inBuf_.data()+inPos_, nin, buf, nout)) {
+				clear(EPROTO);
+				return -1;
+			}
+
+			inPos_ += nin;
+			inPending_ = (nout == n);
+
+			if (nout > 0)
+				return ssize_t(nout);
+			if (nin > 0 && inPos_ < inLen_)
+				continue;
+		}
+
+		if (inPos_ > 0) {
+			std::memmove(inBuf_.data(), inBuf_.data()+inPos_, inLen_-inPos_);
+			inLen_ -= inPos_;
+			inPos_ = 0;
+		}
+
+		// A decoder that won't take a whole buffer of input is stuck
+		if (inLen_ == inBuf_.size()) {
+			clear(EPROTO);
+			return -1;
+		}
+
+		ssize_t ret = base::read(inBuf_.data()+inLen_, inBuf_.size()-inLen_);
+		if (ret <= 0)
+			return ret;
+
+		inLen_ += size_t(ret);
+	}
+}
+
+ssize_t compressed_socket::read_spin(void *buf, size_t n,
+									 const std::chrono::microseconds& spin)
+{
+	if (codec_ && inPos_ == inLen_ && !inPending_)
+		spin_readable(spin);
+	return read(buf, n);
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,121 @@
+// connection_tracker.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/connection_tracker.h"
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+//							connection_tracker
+/////////////////////////////////////////////////////////////////////////////
+
+bool connection_tracker::add(const socket& sock)
+{
+	if (!sock)
+		return false;
+
+	std::lock_guard<std::mutex> lk(lock_);
+	if (draining_)
+		return false;
+
+	conns_.insert(sock.handle());
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+void connection_tracker::remove(socket_t h)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	if (conns_.erase(h) != 0 && conns_.empty())
+		cv_.notify_all();
+}
+
+// --------------------------------------------------------------------------
+
+size_t connection_tracker::size() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return conns_.size();
+}
+
+bool connection_tracker::draining() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return draining_;
+}
+
+// --------------------------------------------------------------------------
+// The shutdowns are done on the raw handles while holding the lock. A
+// handler can't remove (and then close) its socket until we let go, so the
+// handles can't be closed and reused out from under us.
+
+drain_stats connection_tracker::drain(const milliseconds& timeout)
+{
+	std::unique_lock<std::mutex> lk(lock_);
+	draining_ = true;
+
+	size_t n = conns_.size();
+	for (auto h : conns_)
+		::shutdown(h, SHUT_RD);
+
+	cv_.wait_for(lk, timeout, [this]{ return conns_.empty(); });
+
+	drain_stats st;
+	st.forced = conns_.size();
+	st.drained = n - st.forced;
+
+	for (auto h : conns_)
+		::shutdown(h, SHUT_RDWR);
+
+	return st;
+}
+
+drain_stats connection_tracker::drain(acceptor& acc, const milliseconds& timeout)
+{
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		draining_ = true;
+	}
+	acc.shutdown();
+	return drain(timeout);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -65,6 +65,51 @@ bool connector::connect(const sockaddr* addr, socklen_t len)
 	return true;
 }
 
+// --------------------------------------------------------------------------
+// With MSG_FASTOPEN, sendto() on an unconnected TCP socket does the
+// connect and the first send in one call. It may send less than the full
+// buffer, so the rest goes out as a normal write. If client-side TFO is
+// disabled on the host, the call fails with EOPNOTSUPP, and we fall back
+// to a plain connect.
+
+ssize_t connector::connect_fast_open(const sockaddr* addr, socklen_t len,
+									 const void* buf, size_t n)
+{
+	#if defined(MSG_FASTOPEN)
+		if (len < sizeof(sa_family_t))
+			return -1;
+
+		sa_family_t domain = *(reinterpret_cast<const sa_family_t*>(addr));
+		socket_t h = create(domain);
+
+		if (h == INVALID_SOCKET) {
+			set_last_error();
+			return -1;
+		}
+
+		reset(h);
+		ssize_t ret = check_ret(::sendto(h, buf, n, MSG_FASTOPEN, addr, len));
+
+		if (ret < 0) {
+			close();
+			if (last_error() != EOPNOTSUPP)
+				return -1;
+		}
+		else {
+			if (size_t(ret) < n) {
+				ssize_t nx = write_n(static_cast<const char*>(buf) + ret, n - ret);
+				if (nx > 0)
+					ret += nx;
+			}
+			return ret;
+		}
+	#endif
+
+	if (!connect(addr, len))
+		return -1;
+	return write_n(buf, n);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // end namespace sockpp
 }
@@ -0,0 +1,417 @@
+// crc32c.cpp
+//
+// CRC32C checksums, with hardware versions chosen at run time.
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/crc32c.h"
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+	#define SOCKPP_X86_CRC
+	#include <immintrin.h>
+#endif
+
+namespace sockpp {
+
+namespace {
+
+// The Castagnoli polynomial, bit-reflected
+const uint32_t POLY = 0x82F63B78;
+
+using crc_fn = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+// --------------------------------------------------------------------------
+// The kernels all work on the raw CRC state, without the inversions at the
+// start and end.
+//
+// The portable version is "slicing-by-8": eight tables, so that each 64-bit
+// word takes eight lookups, but no serial dependency between its bytes.
+
+struct crc_tables {
+	uint32_t t[8][256];
+
+	crc_tables() {
+		for (uint32_t i=0; i<256; ++i) {
+			uint32_t c = i;
+			for (int k=0; k<8; ++k)
+				c = (c & 1) ? ((c >> 1) ^ POLY) : (c >> 1);
+			t[0][i] = c;
+		}
+		for (uint32_t i=0; i<256; ++i) {
+			for (int j=1; j<8; ++j)
+				t[j][i] = (t[j-1][i] >> 8) ^ t[0][t[j-1][i] & 0xFF];
+		}
+	}
+};
+
+uint32_t crc_table(uint32_t crc, const uint8_t* p, size_t n)
+{
+	static const crc_tables tbl;
+	const auto& t = tbl.t;
+
+	for (; n >= 8; p += 8, n -= 8) {
+		uint32_t lo = crc ^ (uint32_t(p[0]) | (uint32_t(p[1]) << 8)
+							 | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+		crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF]
+			^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+			^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+	}
+
+	while (n--)
+		crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+
+	return crc;
+}
+
+#if defined(SOCKPP_X86_CRC)
+
+__attribute__((target("sse4.2")))
+uint32_t crc_sse42(uint32_t crc, const uint8_t* p, size_t n)
+{
+	uint64_t c = crc;
+
+	for (; n >= 8; p += 8, n -= 8) {
+		uint64_t w;
+		std::memcpy(&w, p, 8);
+		c = _mm_crc32_u64(c, w);
+	}
+
+	crc = uint32_t(c);
+	while (n--)
+		crc = _mm_crc32_u8(crc, *p++);
+
+	return crc;
+}
+
+// --------------------------------------------------------------------------
+// The crc32 instruction has a latency of three cycles, but can start one
+// every cycle. So large blocks are split into three streams that run side
+// by side, and the three results are then combined.
+//
+// Combining needs the CRC of one stream shifted past the data of the
+// streams that follow it: multiplied by x^(8L) mod P for a stream length
+// of L bytes. A carry-less multiply by a precomputed constant does that,
+// and a crc32 of the 64-bit product reduces it back to 32 bits. That
+// reduction multiplies by x^32, and the reflected product carries one
+// more factor of x, so the constant is x^(8L-33) mod P.
+
+uint32_t xpow_mod(unsigned e)
+{
+	uint32_t v = 0x80000000;	// x^0, reflected
+	while (e--)
+		v = (v & 1) ? ((v >> 1) ^ POLY) : (v >> 1);
+	return v;
+}
+
+template <size_t L>
+struct stream_consts {
+	uint64_t k1, k2;	// shifts by L and 2L bytes
+	stream_consts() : k1(xpow_mod(8*L - 33)), k2(xpow_mod(16*L - 33)) {}
+};
+
+template <size_t L>
+__attribute__((target("sse4.2,pclmul")))
+inline uint32_t crc_3way(uint32_t crc, const uint8_t*& p, size_t& n)
+{
+	if (n < 3*L)
+		return crc;
+
+	static const stream_consts<L> k;
+	const __m128i kk = _mm_set_epi64x(int64_t(k.k2), int64_t(k.k1));
+
+	while (n >= 3*L) {
+		uint64_t c0 = crc, c1 = 0, c2 = 0;
+
+		for (size_t i=0; i<L; i+=8) {
+			uint64_t w0, w1, w2;
+			std::memcpy(&w0, p+i, 8);
+			std::memcpy(&w1, p+L+i, 8);
+			std::memcpy(&w2, p+2*L+i, 8);
+			c0 = _mm_crc32_u64(c0, w0);
+			c1 = _mm_crc32_u64(c1, w1);
+			c2 = _mm_crc32_u64(c2, w2);
+		}
+
+		__m128i v0 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(c0)), kk, 0x10);
+		__m128i v1 = _mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(c1)), kk, 0x00);
+		uint64_t prod = uint64_t(_mm_cvtsi128_si64(_mm_xor_si128(v0, v1)));
+
+		crc = uint32_t(_mm_crc32_u64(0, prod) ^ c2);
+		p += 3*L;
+		n -= 3*L;
+	}
+	return crc;
+}
+
+__attribute__((target("sse4.2,pclmul")))
+uint32_t crc_pclmul(uint32_t crc, const uint8_t* p, size_t n)
+{
+	crc = crc_3way<4096>(crc, p, n);
+	crc = crc_3way<256>(crc, p, n);
+	return crc_sse42(crc, p, n);
+}
+
+#endif	// SOCKPP_X86_CRC
+
+// --------------------------------------------------------------------------
+
+crc_fn crc_function(crc32c_impl impl)
+{
+	if (!crc32c_supported(impl))
+		return crc_table;
+
+	switch (impl) {
+		#if defined(SOCKPP_X86_CRC)
+			case crc32c_impl::SSE42:	return crc_sse42;
+			case crc32c_impl::PCLMUL:	return crc_pclmul;
+		#endif
+		default:
+			return crc_table;
+	}
+}
+
+}	// anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool crc32c_supported(crc32c_impl impl)
+{
+	#if defined(SOCKPP_X86_CRC)
+		__builtin_cpu_init();
+		switch (impl) {
+			case crc32c_impl::TABLE:	return true;
+			case crc32c_impl::SSE42:	return __builtin_cpu_supports("sse4.2") != 0;
+			case crc32c_impl::PCLMUL:	return __builtin_cpu_supports("sse4.2") != 0
+											&& __builtin_cpu_supports("pclmul") != 0;
+		}
+		return false;
+	#else
+		return impl == crc32c_impl::TABLE;
+	#endif
+}
+
+crc32c_impl crc32c_best()
+{
+	static const crc32c_impl best = [] {
+		for (auto impl : { crc32c_impl::PCLMUL, crc32c_impl::SSE42 }) {
+			if (crc32c_supported(impl))
+				return impl;
+		}
+		return crc32c_impl::TABLE;
+	}();
+	return best;
+}
+
+// --------------------------------------------------------------------------
+
+uint32_t crc32c(const void* buf, size_t n, uint32_t crc /*=0*/)
+{
+	static const crc_fn fn = crc_function(crc32c_best());
+	return ~fn(~crc, static_cast<const uint8_t*>(buf), n);
+}
+
+uint32_t crc32c(crc32c_impl impl, const void* buf, size_t n, uint32_t crc /*=0*/)
+{
+	return ~crc_function(impl)(~crc, static_cast<const uint8_t*>(buf), n);
+}
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+//								crc_framer
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t crc_framer::HEADER_SIZE;
+const size_t crc_framer::DFLT_MAX_FRAME;
+
+namespace {
+
+inline void put_be32(uint8_t* p, uint32_t v)
+{
+	p[0] = uint8_t(v >> 24);
+	p[1] = uint8_t(v >> 16);
+	p[2] = uint8_t(v >> 8);
+	p[3] = uint8_t(v);
+}
+
+inline uint32_t get_be32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16)
+		| (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t crc_framer::write_frame(const void* buf, size_t n)
+{
+	return write_frame(std::vector<iovec>{ iovec{ const_cast<void*>(buf), n } });
+}
+
+// The header goes out in the same gather write as the payload. A short
+// write just continues from wherever it left off.
+
+ssize_t crc_framer::write_frame(const std::vector<iovec>& ranges)
+{
+	size_t len = 0;
+	for (const auto& r : ranges)
+		len += r.iov_len;
+
+	if (len > 0xFFFFFFFF) {
+		sock_.clear(EMSGSIZE);
+		return -1;
+	}
+
+	uint8_t hdr[HEADER_SIZE];
+	put_be32(hdr, uint32_t(len));
+
+	uint32_t crc = crc32c(hdr, 4);
+	for (const auto& r : ranges)
+		crc = crc32c(r.iov_base, r.iov_len, crc);
+	put_be32(hdr+4, crc);
+
+	std::vector<iovec> iov;
+	iov.reserve(ranges.size() + 1);
+	iov.push_back(iovec{ hdr, HEADER_SIZE });
+	for (const auto& r : ranges) {
+		if (r.iov_len > 0)
+			iov.push_back(r);
+	}
+
+	size_t i = 0;
+	while (i < iov.size()) {
+		ssize_t n = sock_.write(iov);
+		if (n < 0 && sock_.last_error() == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+
+		size_t nw = size_t(n);
+		while (i < iov.size() && nw >= iov[i].iov_len)
+			nw -= iov[i++].iov_len;
+
+		if (nw > 0) {
+			iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + nw;
+			iov[i].iov_len -= nw;
+		}
+		iov.erase(iov.begin(), iov.begin()+i);
+		i = 0;
+	}
+	return ssize_t(len);
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t crc_framer::read_header(uint32_t& crc, uint32_t& expected, size_t maxn)
+{
+	uint8_t hdr[HEADER_SIZE];
+
+	ssize_t n = sock_.read_n(hdr, HEADER_SIZE);
+	if (n <= 0)
+		return n;
+
+	if (size_t(n) < HEADER_SIZE) {
+		sock_.clear(ECONNRESET);
+		return -1;
+	}
+
+	size_t len = get_be32(hdr);
+	if (len > maxn || len > maxFrame_) {
+		sock_.clear(EMSGSIZE);
+		return -1;
+	}
+
+	crc = crc32c(hdr, 4);
+	expected = get_be32(hdr+4);
+	return ssize_t(len);
+}
+
+// The payload is checked where it landed, continuing the checksum that
+// was started over the length.
+
+ssize_t crc_framer::read_payload(void* buf, size_t len, uint32_t crc,
+								 uint32_t expected)
+{
+	if (len > 0) {
+		ssize_t n = sock_.read_n(buf, len);
+		if (n < 0)
+			return -1;
+
+		if (size_t(n) < len) {
+			sock_.clear(ECONNRESET);
+			return -1;
+		}
+		crc = crc32c(buf, len, crc);
+	}
+
+	if (crc != expected) {
+		sock_.clear(EBADMSG);
+		return -1;
+	}
+	return ssize_t(len);
+}
+
+// The header is left unread at the end of the stream. An empty frame has
+// a non-zero checksum, since the length is covered by it.
+
+ssize_t crc_framer::read_frame(void* buf, size_t n)
+{
+	uint32_t crc = 0, expected = 0;
+	ssize_t len = read_header(crc, expected, n);
+	if (len < 0 || (len == 0 && crc == 0 && expected == 0))
+		return len;
+
+	return read_payload(buf, size_t(len), crc, expected);
+}
+
+ssize_t crc_framer::read_frame(std::string& data)
+{
+	uint32_t crc = 0, expected = 0;
+	ssize_t len = read_header(crc, expected, maxFrame_);
+	data.clear();
+	if (len < 0 || (len == 0 && crc == 0 && expected == 0))
+		return len;
+
+	data.resize(size_t(len));
+	return read_payload(&data[0], size_t(len), crc, expected);
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
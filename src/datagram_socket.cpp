@@ -37,6 +37,7 @@
 #include "sockpp/datagram_socket.h"
 #include "sockpp/exception.h"
 #include <algorithm>
+#include <cstring>
 
 using namespace std::chrono;
 
@@ -89,6 +90,78 @@ int datagram_socket::recvfrom(void* buf, size_t n, int flags, sock_address& addr
 	return ret;
 }
 
+// --------------------------------------------------------------------------
+
+int datagram_socket::recv_spin(void* buf, size_t n, const microseconds& spin,
+							   int flags /*=0*/)
+{
+	auto deadline = steady_clock::now() + spin;
+
+	do {
+		for (int i=0; i<16; ++i) {
+			ssize_t ret = ::recv(handle(), buf, n, flags | MSG_DONTWAIT);
+			if (ret >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+				return check_ret(int(ret));
+		}
+	}
+	while (steady_clock::now() < deadline);
+
+	return recv(buf, n, flags);
+}
+
+// --------------------------------------------------------------------------
+
+#if defined(SO_TXTIME)
+int datagram_socket::send_at(const void* buf, size_t n, uint64_t txTime,
+							 int flags /*=0*/)
+{
+	iovec iov { const_cast<void*>(buf), n };
+	alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(uint64_t))] = {};
+
+	msghdr msg {};
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+
+	cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+	cm->cmsg_level = SOL_SOCKET;
+	cm->cmsg_type = SCM_TXTIME;
+	cm->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+	std::memcpy(CMSG_DATA(cm), &txTime, sizeof(uint64_t));
+
+	return check_ret(int(::sendmsg(handle(), &msg, flags)));
+}
+#endif
+
+#if defined(SO_TIMESTAMPNS)
+int datagram_socket::recv_timestamped(void* buf, size_t n, timespec& ts,
+									  int flags /*=0*/)
+{
+	iovec iov { buf, n };
+	alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(timespec))];
+
+	msghdr msg {};
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+
+	int ret = check_ret(int(::recvmsg(handle(), &msg, flags)));
+
+	ts = timespec {};
+	if (ret >= 0) {
+		for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+			if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_TIMESTAMPNS) {
+				std::memcpy(&ts, CMSG_DATA(cm), sizeof(timespec));
+				break;
+			}
+		}
+	}
+	return ret;
+}
+#endif
+
 #endif
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,86 @@
+// event_fd.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/event_fd.h"
+#include <poll.h>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+event_fd::event_fd(unsigned initVal /*=0*/, int flags /*=EFD_CLOEXEC*/)
+		: base((socket_t) ::eventfd(initVal, flags))
+{
+	if (!is_open())
+		set_last_error();
+}
+
+bool event_fd::notify(uint64_t n /*=1*/)
+{
+	ssize_t ret;
+	while ((ret = ::write(handle(), &n, sizeof(n))) < 0 && errno == EINTR)
+		;
+	return check_ret_bool(int(ret));
+}
+
+bool event_fd::read(uint64_t& val)
+{
+	ssize_t ret;
+	while ((ret = ::read(handle(), &val, sizeof(val))) < 0 && errno == EINTR)
+		;
+	return check_ret_bool(int(ret));
+}
+
+// A blocking counter can't be read with a flag to keep it from blocking,
+// so it's checked first.
+
+uint64_t event_fd::try_read()
+{
+	pollfd pfd { handle(), POLLIN, 0 };
+	if (::poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN))
+		return 0;
+
+	uint64_t val = 0;
+	return read(val) ? val : 0;
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
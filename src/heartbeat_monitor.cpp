@@ -0,0 +1,198 @@
+// heartbeat_monitor.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/heartbeat_monitor.h"
+#include <vector>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+const unsigned heartbeat_monitor::DFLT_MAX_MISSED;
+
+/////////////////////////////////////////////////////////////////////////////
+//							heartbeat_monitor
+/////////////////////////////////////////////////////////////////////////////
+
+heartbeat_monitor::heartbeat_monitor(const milliseconds& interval,
+									 unsigned maxMissed /*=DFLT_MAX_MISSED*/)
+		: interval_(interval), maxMissed_(maxMissed ? maxMissed : 1), stats_{0, 0}
+{
+}
+
+bool heartbeat_monitor::add(const socket& sock, ping_func ping)
+{
+	if (!sock)
+		return false;
+
+	auto now = clock::now();
+
+	std::lock_guard<std::mutex> lk(lock_);
+	conns_[sock.handle()] = conn{ std::move(ping), now, now, 0, false, false };
+	return true;
+}
+
+// A connection that we already reaped was counted then, whatever error the
+// handler saw when it went down.
+//
+// The caller may destroy what the ping function refers to as soon as this
+// returns, so it has to wait out a ping in progress. A ping that removes
+// its own connection, from the thread running tick(), can't wait for
+// itself.
+
+void heartbeat_monitor::remove(socket_t h, int err /*=0*/)
+{
+	std::unique_lock<std::mutex> lk(lock_);
+
+	auto p = conns_.find(h);
+	if (p == conns_.end())
+		return;
+
+	if (p->second.pinging && ticker_ != std::this_thread::get_id()) {
+		pingDone_.wait(lk, [this, h] {
+			auto q = conns_.find(h);
+			return q == conns_.end() || !q->second.pinging;
+		});
+		if ((p = conns_.find(h)) == conns_.end())
+			return;
+	}
+
+	if (!p->second.reaped && err == ETIMEDOUT)
+		++stats_.kernel;
+	conns_.erase(p);
+}
+
+void heartbeat_monitor::received(socket_t h)
+{
+	auto now = clock::now();
+
+	std::lock_guard<std::mutex> lk(lock_);
+	auto p = conns_.find(h);
+	if (p != conns_.end()) {
+		p->second.lastRecv = now;
+		p->second.failed = 0;
+	}
+}
+
+// --------------------------------------------------------------------------
+
+// The pings are sent outside the lock, since they write to the sockets,
+// and might call back into the monitor. Each connection is looked up again
+// just before its ping, in case it was removed in the meantime, and stays
+// marked only while its own ping runs, which holds off its removal from
+// other threads until the ping returns. The function is copied all the
+// same, in case the ping removes its own connection.
+
+size_t heartbeat_monitor::tick()
+{
+	std::vector<socket_t> pings;
+	size_t nreaped = 0;
+	auto now = clock::now();
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+
+		for (auto& c : conns_) {
+			conn& cn = c.second;
+			if (cn.reaped)
+				continue;
+
+			auto idle = now - cn.lastRecv + interval_ * cn.failed;
+			if (idle >= interval_ * maxMissed_) {
+				// The handle stays valid until the handler removes it
+				::shutdown(c.first, SHUT_RDWR);
+				cn.reaped = true;
+				++stats_.heartbeat;
+				++nreaped;
+			}
+			else if (idle >= interval_ && now - cn.lastPing >= interval_) {
+				cn.lastPing = now;
+				if (cn.ping)
+					pings.push_back(c.first);
+			}
+		}
+
+		if (!pings.empty())
+			ticker_ = std::this_thread::get_id();
+	}
+
+	for (auto h : pings) {
+		ping_func ping;
+		{
+			std::lock_guard<std::mutex> lk(lock_);
+			auto p = conns_.find(h);
+			if (p == conns_.end() || p->second.reaped || !p->second.ping)
+				continue;
+
+			p->second.pinging = true;
+			ping = p->second.ping;
+		}
+
+		bool ok = ping();
+
+		std::lock_guard<std::mutex> lk(lock_);
+		auto p = conns_.find(h);
+		if (p != conns_.end() && p->second.pinging) {
+			p->second.pinging = false;
+			if (!ok)
+				++p->second.failed;
+		}
+		pingDone_.notify_all();
+	}
+
+	if (!pings.empty()) {
+		std::lock_guard<std::mutex> lk(lock_);
+		ticker_ = std::thread::id();
+	}
+	return nreaped;
+}
+
+// --------------------------------------------------------------------------
+
+size_t heartbeat_monitor::size() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return conns_.size();
+}
+
+reap_stats heartbeat_monitor::stats() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return stats_;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
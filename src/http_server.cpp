@@ -0,0 +1,585 @@
+// http_server.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/http_server.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <thread>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#define SOCKPP_X86_SIMD
+	#include <immintrin.h>
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+namespace {
+
+// --------------------------------------------------------------------------
+// Scanning for the end of the request head: the "\r\n\r\n" that ends the
+// header block. Each returns the offset just past it, or zero if it's not
+// in the buffer, starting the search at offset 'from'.
+
+size_t find_head_end_scalar(const char* p, size_t n, size_t from)
+{
+	const char *s = p + from,
+			   *e = p + n;
+
+	while (e - s >= 4) {
+		s = static_cast<const char*>(std::memchr(s, '\r', size_t(e - s) - 3));
+		if (!s)
+			break;
+		if (s[1] == '\n' && s[2] == '\r' && s[3] == '\n')
+			return size_t(s - p) + 4;
+		++s;
+	}
+	return 0;
+}
+
+#if defined(SOCKPP_X86_SIMD)
+
+// The vector versions compare four overlapping loads against the four
+// delimiter bytes, so that the AND of the results has a bit set only where
+// the whole sequence starts.
+
+__attribute__((target("sse2")))
+size_t find_head_end_sse2(const char* p, size_t n, size_t from)
+{
+	const __m128i cr = _mm_set1_epi8('\r'),
+				  lf = _mm_set1_epi8('\n');
+	size_t i = from;
+
+	for (; i + 16 + 3 <= n; i += 16) {
+		const char* s = p + i;
+		__m128i m = _mm_and_si128(
+			_mm_and_si128(
+				_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), cr),
+				_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+1)), lf)),
+			_mm_and_si128(
+				_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+2)), cr),
+				_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+3)), lf)));
+
+		unsigned bits = unsigned(_mm_movemask_epi8(m));
+		if (bits)
+			return i + unsigned(__builtin_ctz(bits)) + 4;
+	}
+	return find_head_end_scalar(p, n, i);
+}
+
+__attribute__((target("avx2")))
+size_t find_head_end_avx2(const char* p, size_t n, size_t from)
+{
+	const __m256i cr = _mm256_set1_epi8('\r'),
+				  lf = _mm256_set1_epi8('\n');
+	size_t i = from;
+
+	for (; i + 32 + 3 <= n; i += 32) {
+		const char* s = p + i;
+		__m256i m = _mm256_and_si256(
+			_mm256_and_si256(
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)), cr),
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+1)), lf)),
+			_mm256_and_si256(
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+2)), cr),
+				_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+3)), lf)));
+
+		unsigned bits = unsigned(_mm256_movemask_epi8(m));
+		if (bits)
+			return i + unsigned(__builtin_ctz(bits)) + 4;
+	}
+	return find_head_end_sse2(p, n, i);
+}
+
+#endif	// SOCKPP_X86_SIMD
+
+size_t find_head_end(const char* p, size_t n, size_t from)
+{
+	using find_fn = size_t (*)(const char*, size_t, size_t);
+
+	static const find_fn fn = [] {
+		#if defined(SOCKPP_X86_SIMD)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+				return find_fn(find_head_end_avx2);
+			if (__builtin_cpu_supports("sse2"))
+				return find_fn(find_head_end_sse2);
+		#endif
+		return find_fn(find_head_end_scalar);
+	}();
+
+	return fn(p, n, from);
+}
+
+// --------------------------------------------------------------------------
+
+inline bool is_ows(char c) { return c == ' ' || c == '\t'; }
+
+// Case-insensitive search for a token in a header value, like "close" in
+// "Connection: keep-alive, close".
+
+bool has_token(const http_str& val, const char* tok)
+{
+	size_t n = std::strlen(tok);
+	for (size_t i=0; i+n <= val.size; ++i) {
+		if (http_str(val.data+i, n).iequals(tok))
+			return true;
+	}
+	return false;
+}
+
+// Parses the request line and header fields. The head includes the final
+// empty line.
+
+bool parse_head(const char* buf, size_t len, http_request& req)
+{
+	const char *p = buf,
+			   *end = buf + len;
+
+	req.headers.clear();
+
+	// Request line: method SP target SP HTTP-version CRLF
+
+	auto nl = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+	if (!nl || nl == p || nl[-1] != '\r')
+		return false;
+
+	const char* eol = nl - 1;
+	auto sp1 = static_cast<const char*>(std::memchr(p, ' ', size_t(eol - p)));
+	if (!sp1 || sp1 == p)
+		return false;
+
+	auto sp2 = static_cast<const char*>(std::memchr(sp1+1, ' ', size_t(eol - sp1 - 1)));
+	if (!sp2 || sp2 == sp1+1)
+		return false;
+
+	if (eol - sp2 - 1 != 8 || std::memcmp(sp2+1, "HTTP/1.", 7) != 0
+			|| (sp2[8] != '0' && sp2[8] != '1'))
+		return false;
+
+	req.method = http_str(p, size_t(sp1 - p));
+	req.target = http_str(sp1+1, size_t(sp2 - sp1 - 1));
+	req.minor_version = sp2[8] - '0';
+
+	// Header fields: name ":" OWS value OWS CRLF
+
+	for (p = nl + 1; p < end; p = nl + 1) {
+		nl = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+		if (!nl || nl[-1] != '\r')
+			return false;
+
+		eol = nl - 1;
+		if (eol == p)
+			break;
+
+		auto colon = static_cast<const char*>(std::memchr(p, ':', size_t(eol - p)));
+		if (!colon || colon == p || is_ows(p[0]) || is_ows(colon[-1]))
+			return false;
+
+		const char *v = colon + 1,
+				   *ve = eol;
+		while (v < ve && is_ows(*v))
+			++v;
+		while (ve > v && is_ows(ve[-1]))
+			--ve;
+
+		req.headers.push_back(http_header{ http_str(p, size_t(colon - p)),
+										   http_str(v, size_t(ve - v)) });
+	}
+
+	http_str conn = req.header("Connection");
+	req.keep_alive = (req.minor_version == 1) ? !has_token(conn, "close")
+											  : has_token(conn, "keep-alive");
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+const char* reason_phrase(int status)
+{
+	switch (status) {
+		case 100: return "Continue";
+		case 200: return "OK";
+		case 201: return "Created";
+		case 202: return "Accepted";
+		case 204: return "No Content";
+		case 301: return "Moved Permanently";
+		case 302: return "Found";
+		case 304: return "Not Modified";
+		case 400: return "Bad Request";
+		case 401: return "Unauthorized";
+		case 403: return "Forbidden";
+		case 404: return "Not Found";
+		case 405: return "Method Not Allowed";
+		case 413: return "Content Too Large";
+		case 500: return "Internal Server Error";
+		case 501: return "Not Implemented";
+		case 503: return "Service Unavailable";
+	}
+	return "Unknown";
+}
+
+// The most buffers we hand to a single writev(), well under IOV_MAX.
+const size_t MAX_IOV = 512;
+
+}	// anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								http_str
+/////////////////////////////////////////////////////////////////////////////
+
+bool http_str::iequals(const char* s) const
+{
+	size_t n = std::strlen(s);
+	if (n != size)
+		return false;
+
+	for (size_t i=0; i<n; ++i) {
+		if (std::tolower(static_cast<unsigned char>(data[i]))
+				!= std::tolower(static_cast<unsigned char>(s[i])))
+			return false;
+	}
+	return true;
+}
+
+bool http_str::operator==(const char* s) const
+{
+	size_t n = std::strlen(s);
+	return n == size && (n == 0 || std::memcmp(data, s, n) == 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								http_request
+/////////////////////////////////////////////////////////////////////////////
+
+http_str http_request::header(const char* name) const
+{
+	for (const auto& hdr : headers) {
+		if (hdr.name.iequals(name))
+			return hdr.value;
+	}
+	return http_str();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								http_parser
+/////////////////////////////////////////////////////////////////////////////
+
+// Once the head is found, but the body is still incomplete, 'scanned_'
+// holds the size of the head and 'need_' the size of the whole request.
+// The head is parsed again when the body is complete, since the caller
+// may have moved the buffer in the meantime.
+
+ssize_t http_parser::parse(const char* buf, size_t n, http_request& req)
+{
+	size_t headLen;
+
+	if (need_ != 0) {
+		if (n < need_)
+			return 0;
+		headLen = scanned_;
+	}
+	else if ((headLen = find_head_end(buf, n, scanned_)) == 0) {
+		scanned_ = (n > 3) ? (n - 3) : 0;
+		return 0;
+	}
+
+	if (!parse_head(buf, headLen, req) || !req.header("Transfer-Encoding").empty()) {
+		reset();
+		return -1;
+	}
+
+	size_t clen = 0;
+	http_str cl = req.header("Content-Length");
+	if (!cl.empty()) {
+		for (size_t i=0; i<cl.size; ++i) {
+			char c = cl.data[i];
+			if (c < '0' || c > '9' || clen > (SIZE_MAX - 9) / 10) {
+				reset();
+				return -1;
+			}
+			clen = clen * 10 + size_t(c - '0');
+		}
+	}
+
+	size_t total = headLen + clen;
+	if (total < headLen) {
+		reset();
+		return -1;
+	}
+
+	if (n < total) {
+		scanned_ = headLen;
+		need_ = total;
+		return 0;
+	}
+
+	req.body = http_str(buf + headLen, clen);
+	reset();
+	return ssize_t(total);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								http_response
+/////////////////////////////////////////////////////////////////////////////
+
+void http_response::add_header(const std::string& name, const std::string& value)
+{
+	headers_.append(name);
+	headers_.append(": ");
+	headers_.append(value);
+	headers_.append("\r\n");
+}
+
+std::string http_response::head() const
+{
+	std::string s;
+	s.reserve(64 + headers_.size());
+
+	s.append("HTTP/1.1 ");
+	s.append(std::to_string(status_));
+	s.push_back(' ');
+	s.append(reason_phrase(status_));
+	s.append("\r\n");
+	s.append(headers_);
+	s.append("Content-Length: ");
+	s.append(std::to_string(body_.size()));
+	s.append("\r\n");
+	if (close_)
+		s.append("Connection: close\r\n");
+	s.append("\r\n");
+	return s;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								http_server
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t http_server::READ_BUF_SIZE;
+const size_t http_server::DFLT_MAX_REQUEST;
+
+// --------------------------------------------------------------------------
+
+http_server::http_server(handler h, size_t maxRequestSize /*=DFLT_MAX_REQUEST*/)
+		: handler_(std::move(h)), maxReq_(maxRequestSize), acc_(nullptr),
+			nthreads_(0)
+{
+}
+
+// --------------------------------------------------------------------------
+// Sends the head and body of each response, gathering as many as possible
+// into each writev(). A response to HEAD keeps the Content-Length of the
+// body it would have sent, but not the body itself (RFC 9110, 9.3.2).
+
+bool http_server::send_responses(stream_socket& sock,
+								 const std::vector<http_response>& resps)
+{
+	std::vector<std::string> heads;
+	std::vector<iovec> iov, batch;
+
+	heads.reserve(resps.size());
+	iov.reserve(2*resps.size());
+
+	for (const auto& rsp : resps) {
+		heads.push_back(rsp.head());
+		iov.push_back(iovec{ const_cast<char*>(heads.back().data()), heads.back().size() });
+		if (!rsp.body_.empty() && !rsp.headOnly_)
+			iov.push_back(iovec{ const_cast<char*>(rsp.body_.data()), rsp.body_.size() });
+	}
+
+	size_t i = 0;
+	while (i < iov.size()) {
+		size_t nb = std::min(iov.size() - i, MAX_IOV);
+		batch.assign(iov.begin()+i, iov.begin()+i+nb);
+
+		ssize_t n = sock.write(batch);
+		if (n < 0 && sock.last_error() == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+
+		size_t nw = size_t(n);
+		while (i < iov.size() && nw >= iov[i].iov_len)
+			nw -= iov[i++].iov_len;
+
+		if (nw > 0) {
+			iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + nw;
+			iov[i].iov_len -= nw;
+		}
+	}
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// The read buffer holds unconsumed data in [beg, end). All the complete
+// requests in it are handled before the batch of responses is sent and
+// more data is read. The buffer is only compacted or grown when it fills.
+
+size_t http_server::serve(stream_socket& sock)
+{
+	connection_tracker::guard g(conns_, sock);
+	if (!g)
+		return 0;
+
+	std::vector<char> buf(std::min(READ_BUF_SIZE, maxReq_));
+	size_t beg = 0, end = 0, nreq = 0;
+	bool open = true;
+
+	http_parser parser;
+	http_request req;
+	std::vector<http_response> resps;
+
+	while (open) {
+		resps.clear();
+
+		ssize_t n;
+		while (open && (n = parser.parse(buf.data()+beg, end-beg, req)) != 0) {
+			resps.emplace_back();
+			http_response& rsp = resps.back();
+
+			if (n < 0) {
+				rsp.set_status(400);
+				rsp.set_close();
+				open = false;
+				break;
+			}
+
+			beg += size_t(n);
+			handler_(req, rsp);
+			rsp.headOnly_ = (req.method == "HEAD");
+			++nreq;
+
+			if (!req.keep_alive)
+				rsp.set_close();
+			if (rsp.close_)
+				open = false;
+		}
+
+		if (!resps.empty() && !send_responses(sock, resps))
+			break;
+
+		if (!open)
+			break;
+
+		if (beg == end)
+			beg = end = 0;
+
+		if (end == buf.size()) {
+			if (beg > 0) {
+				std::memmove(buf.data(), buf.data()+beg, end-beg);
+				end -= beg;
+				beg = 0;
+			}
+			else if (buf.size() < maxReq_)
+				buf.resize(std::min(2*buf.size(), maxReq_));
+			else {
+				resps.clear();
+				resps.emplace_back();
+				resps.back().set_status(413);
+				resps.back().set_close();
+				send_responses(sock, resps);
+				break;
+			}
+		}
+
+		ssize_t nr = sock.read(buf.data()+end, buf.size()-end);
+		if (nr < 0 && sock.last_error() == EINTR)
+			continue;
+		if (nr <= 0)
+			break;
+		end += size_t(nr);
+	}
+
+	return nreq;
+}
+
+// --------------------------------------------------------------------------
+
+void http_server::run(acceptor& acc)
+{
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		acc_ = &acc;
+	}
+
+	while (!conns_.draining()) {
+		stream_socket sock = acc.accept();
+		if (!sock) {
+			int err = acc.last_error();
+			if (err == EINTR || err == ECONNABORTED)
+				continue;
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lk(lock_);
+			++nthreads_;
+		}
+
+		std::thread([this](stream_socket sock) {
+			serve(sock);
+			sock.close();
+
+			std::lock_guard<std::mutex> lk(lock_);
+			if (--nthreads_ == 0)
+				cv_.notify_all();
+		}, std::move(sock)).detach();
+	}
+
+	std::unique_lock<std::mutex> lk(lock_);
+	cv_.wait(lk, [this]{ return nthreads_ == 0; });
+	acc_ = nullptr;
+}
+
+drain_stats http_server::shutdown(const milliseconds& timeout)
+{
+	acceptor* acc;
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		acc = acc_;
+	}
+	return acc ? conns_.drain(*acc, timeout) : conns_.drain(timeout);
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
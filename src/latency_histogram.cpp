@@ -0,0 +1,225 @@
+// latency_histogram.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace sockpp {
+
+const int latency_histogram::SUB_BUCKET_BITS;
+const size_t latency_histogram::SUB_BUCKET_COUNT;
+const size_t latency_histogram::SUB_BUCKET_HALF;
+const size_t latency_histogram::NUM_BUCKETS;
+
+namespace {
+	const uint64_t NO_MIN = std::numeric_limits<uint64_t>::max();
+
+	// The number of values at or below a percentile, at least one.
+	uint64_t percentile_rank(double pct, uint64_t n)
+	{
+		auto rank = uint64_t(std::ceil(pct / 100.0 * n));
+		return std::min(std::max<uint64_t>(rank, 1), n);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								latency_histogram
+/////////////////////////////////////////////////////////////////////////////
+
+// Bucket 'idx' is sub-bucket 'idx - shift*half' of the values with the
+// low 'shift' bits dropped. The buckets below SUB_BUCKET_COUNT are exact.
+
+uint64_t latency_histogram::bucket_lowest(size_t idx)
+{
+	int shift = int(idx >> (SUB_BUCKET_BITS - 1)) - 1;
+	if (shift <= 0)
+		return uint64_t(idx);
+	return uint64_t(idx - (size_t(shift) << (SUB_BUCKET_BITS - 1))) << shift;
+}
+
+uint64_t latency_histogram::bucket_highest(size_t idx)
+{
+	int shift = std::max(int(idx >> (SUB_BUCKET_BITS - 1)) - 1, 0);
+	return bucket_lowest(idx) + ((uint64_t(1) << shift) - 1);
+}
+
+latency_histogram::latency_histogram()
+		: counts_(NUM_BUCKETS), count_(0), sum_(0), min_(NO_MIN), max_(0)
+{
+}
+
+latency_histogram& latency_histogram::merge(const latency_histogram& other)
+{
+	for (size_t i=0; i<NUM_BUCKETS; ++i)
+		counts_[i] += other.counts_[i];
+
+	count_ += other.count_;
+	sum_ += other.sum_;
+	min_ = std::min(min_, other.min_);
+	max_ = std::max(max_, other.max_);
+	return *this;
+}
+
+void latency_histogram::reset()
+{
+	std::fill(counts_.begin(), counts_.end(), 0);
+	count_ = sum_ = max_ = 0;
+	min_ = NO_MIN;
+}
+
+uint64_t latency_histogram::value_at_percentile(double pct) const
+{
+	if (count_ == 0)
+		return 0;
+
+	if (pct <= 0.0)
+		return min_;
+
+	uint64_t rank = percentile_rank(pct, count_), n = 0;
+
+	for (size_t i=0; i<NUM_BUCKETS; ++i) {
+		n += counts_[i];
+		if (n >= rank)
+			return std::max(min_, std::min(bucket_highest(i), max_));
+	}
+	return max_;
+}
+
+void latency_histogram::print_summary(std::ostream& os, const std::string& title) const
+{
+	auto flags = os.flags();
+	auto prec = os.precision();
+
+	os << title << "\n";
+	for (double p : { 50.0, 75.0, 90.0, 99.0, 99.9, 99.99, 99.999, 100.0 }) {
+		os << std::setw(10) << std::fixed << std::setprecision(3) << p << "%"
+			<< std::setw(14) << std::setprecision(1)
+			<< (value_at_percentile(p) / 1000.0) << " us\n";
+	}
+	os << std::setw(11) << "mean" << std::setw(14) << (mean() / 1000.0) << " us\n"
+		<< std::endl;
+
+	os.flags(flags);
+	os.precision(prec);
+}
+
+void latency_histogram::print_spectrum(std::ostream& os, const std::string& title,
+									   int ticksPerHalf) const
+{
+	auto flags = os.flags();
+	auto prec = os.precision();
+
+	os << title << "\n"
+		<< std::setw(14) << "Value (us)" << std::setw(14) << "Percentile"
+		<< std::setw(12) << "TotalCount" << "  1/(1-Percentile)\n\n";
+
+	uint64_t n = count_;
+	double pct = 0.0;
+
+	while (n > 0) {
+		uint64_t cnt = percentile_rank(pct, n);
+
+		os << std::setw(14) << std::fixed << std::setprecision(3)
+			<< (value_at_percentile(pct) / 1000.0)
+			<< std::setw(14) << std::setprecision(6) << (cnt == n ? 1.0 : pct / 100.0)
+			<< std::setw(12) << cnt;
+		if (cnt < n)
+			os << std::setw(17) << std::setprecision(2) << (100.0 / (100.0 - pct));
+		os << "\n";
+
+		if (cnt == n)
+			break;
+
+		double halves = std::floor(std::log2(100.0 / (100.0 - pct))) + 1;
+		pct += 100.0 / (ticksPerHalf * std::pow(2.0, halves));
+
+		// Past the resolution of the sample, jump to the end
+		if (100.0 - pct < 100.0 / n)
+			pct = 100.0;
+	}
+	os << "#[Mean = " << std::setprecision(3) << (mean() / 1000.0)
+		<< " us, Max = " << (max() / 1000.0) << " us, Total count = "
+		<< n << "]\n" << std::endl;
+
+	os.flags(flags);
+	os.precision(prec);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								latency_recorder
+/////////////////////////////////////////////////////////////////////////////
+
+latency_recorder::latency_recorder()
+		: counts_(new std::atomic<uint64_t>[latency_histogram::NUM_BUCKETS]),
+			sum_(0), min_(NO_MIN), max_(0)
+{
+	for (size_t i=0; i<latency_histogram::NUM_BUCKETS; ++i)
+		counts_[i].store(0, std::memory_order_relaxed);
+}
+
+latency_histogram latency_recorder::snapshot() const
+{
+	latency_histogram h;
+
+	for (size_t i=0; i<latency_histogram::NUM_BUCKETS; ++i) {
+		uint64_t n = counts_[i].load(std::memory_order_relaxed);
+		h.counts_[i] = n;
+		h.count_ += n;
+	}
+
+	h.sum_ = sum_.load(std::memory_order_relaxed);
+	h.min_ = min_.load(std::memory_order_relaxed);
+	h.max_ = max_.load(std::memory_order_relaxed);
+	return h;
+}
+
+void latency_recorder::reset()
+{
+	for (size_t i=0; i<latency_histogram::NUM_BUCKETS; ++i)
+		counts_[i].store(0, std::memory_order_relaxed);
+
+	sum_.store(0, std::memory_order_relaxed);
+	min_.store(NO_MIN, std::memory_order_relaxed);
+	max_.store(0, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// end namespace sockpp
+}
@@ -0,0 +1,124 @@
+// link_address.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/link_address.h"
+#include "sockpp/exception.h"
+#include <cstdio>
+#include <stdexcept>
+#include <net/if.h>
+
+using namespace std;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+constexpr sa_family_t link_address::ADDRESS_FAMILY;
+
+// --------------------------------------------------------------------------
+
+link_address::link_address(const string& ifname, uint16_t proto /*=ETH_P_ALL*/)
+{
+	zero();
+	sll_protocol = htons(proto);
+	sll_ifindex = int(::if_nametoindex(ifname.c_str()));
+
+	if (sll_ifindex == 0)
+		throw sys_error();
+}
+
+link_address::link_address(const sockaddr& addr)
+{
+	if (addr.sa_family != AF_PACKET)
+		throw std::invalid_argument("Not a link-layer address");
+
+	// A sockaddr is smaller than a sockaddr_ll, so we can only trust the
+	// caller that the rest of it is there.
+	std::memcpy(sockaddr_ptr(), &addr, sizeof(sockaddr_ll));
+}
+
+link_address::link_address(const sockaddr_ll& addr)
+{
+	if (addr.sll_family != AF_PACKET)
+		throw std::invalid_argument("Not initialized as a link-layer address");
+
+	std::memcpy(sockaddr_ll_ptr(), &addr, sizeof(sockaddr_ll));
+}
+
+// --------------------------------------------------------------------------
+
+string link_address::ifname() const
+{
+	char buf[IF_NAMESIZE];
+	if (sll_ifindex == 0 || !::if_indextoname(unsigned(sll_ifindex), buf))
+		return string();
+	return string(buf);
+}
+
+string link_address::hw_address() const
+{
+	string s;
+	char buf[4];
+
+	for (unsigned i=0; i<sll_halen && i<sizeof(sll_addr); ++i) {
+		snprintf(buf, sizeof(buf), i ? ":%02x" : "%02x", unsigned(sll_addr[i]));
+		s += buf;
+	}
+	return s;
+}
+
+string link_address::to_string() const
+{
+	if (sll_ifindex == 0)
+		return string("link:*");
+
+	string name = ifname();
+	return string("link:") + (name.empty() ? ("#" + std::to_string(sll_ifindex)) : name);
+}
+
+ostream& operator<<(ostream& os, const link_address& addr)
+{
+	os << addr.to_string();
+	return os;
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
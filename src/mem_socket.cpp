@@ -0,0 +1,414 @@
+// mem_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/mem_socket.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#include <immintrin.h>
+	#define SOCKPP_CPU_RELAX() _mm_pause()
+#else
+	#define SOCKPP_CPU_RELAX()
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+// A single direction of a connection: a ring buffer with one writer and
+// one reader. The positions only ever increase, and are masked to index the
+// buffer, so a full ring is told apart from an empty one by the difference.
+//
+// Each side keeps its position on its own cache line. The reader and
+// writer only ever touch the mutex and condition variable when one of them
+// has to sleep: a sleeper raises its flag, then re-checks the ring under
+// the lock before waiting. The other side publishes its position, then
+// checks the flag. With sequentially-consistent operations on both sides,
+// at least one of them is guaranteed to see the other's update, so a
+// wakeup can't be lost.
+
+struct mem_socket::pipe
+{
+	/** Spins before going to sleep */
+	static const int SPIN_COUNT = 256;
+
+	std::atomic<size_t> head;		// Read position, updated by the reader
+	char pad1_[64 - sizeof(size_t)];
+	std::atomic<size_t> tail;		// Write position, updated by the writer
+	char pad2_[64 - sizeof(size_t)];
+
+	std::atomic<bool> rdClosed;		// The reader shut down
+	std::atomic<bool> wrClosed;		// The writer shut down
+	std::atomic<bool> rdWaiting;	// The reader is asleep
+	std::atomic<bool> wrWaiting;	// The writer is asleep
+
+	std::mutex mut;
+	std::condition_variable cv;
+
+	const size_t cap;
+	const size_t mask;
+	std::unique_ptr<char[]> buf;
+
+	explicit pipe(size_t n)
+		: head(0), tail(0), rdClosed(false), wrClosed(false),
+			rdWaiting(false), wrWaiting(false), cap(n), mask(n-1),
+			buf(new char[n]) {}
+
+	/** Wakes the other side, if it's asleep */
+	void wake(const std::atomic<bool>& waiting) {
+		if (waiting.load()) {
+			std::lock_guard<std::mutex> lk(mut);
+			cv.notify_all();
+		}
+	}
+
+	/** Wakes both sides, such as after a shutdown */
+	void wake_all() {
+		std::lock_guard<std::mutex> lk(mut);
+		cv.notify_all();
+	}
+
+	/**
+	 * Waits for the predicate to be true.
+	 * Returns false on timeout.
+	 */
+	template <typename Pred>
+	bool wait(std::atomic<bool>& waiting, const microseconds& timeout, Pred ready) {
+		for (int i=0; i<SPIN_COUNT; ++i) {
+			if (ready())
+				return true;
+			SOCKPP_CPU_RELAX();
+		}
+
+		std::unique_lock<std::mutex> lk(mut);
+		waiting.store(true);
+
+		bool ok = true;
+		if (timeout.count() > 0)
+			ok = cv.wait_for(lk, timeout, ready);
+		else
+			cv.wait(lk, ready);
+
+		waiting.store(false);
+		return ok;
+	}
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t mem_socket::DFLT_CAPACITY;
+
+// --------------------------------------------------------------------------
+
+mem_socket::mem_socket()
+		: nonBlocking_(false), rdLimit_(0), wrLimit_(0),
+			rdRandom_(false), wrRandom_(false), rand_(0x9E3779B97F4A7C15ULL),
+			rdTimeout_(0), wrTimeout_(0)
+{
+}
+
+mem_socket::mem_socket(mem_socket&& sock)
+		: base(std::move(sock)), rx_(std::move(sock.rx_)), tx_(std::move(sock.tx_)),
+			nonBlocking_(sock.nonBlocking_), rdLimit_(sock.rdLimit_),
+			wrLimit_(sock.wrLimit_), rdRandom_(sock.rdRandom_),
+			wrRandom_(sock.wrRandom_), rand_(sock.rand_),
+			rdTimeout_(sock.rdTimeout_), wrTimeout_(sock.wrTimeout_)
+{
+}
+
+mem_socket& mem_socket::operator=(mem_socket&& rhs)
+{
+	if (&rhs != this) {
+		close();
+		base::operator=(std::move(rhs));
+		rx_ = std::move(rhs.rx_);
+		tx_ = std::move(rhs.tx_);
+		nonBlocking_ = rhs.nonBlocking_;
+		rdLimit_ = rhs.rdLimit_;
+		wrLimit_ = rhs.wrLimit_;
+		rdRandom_ = rhs.rdRandom_;
+		wrRandom_ = rhs.wrRandom_;
+		rand_ = rhs.rand_;
+		rdTimeout_ = rhs.rdTimeout_;
+		wrTimeout_ = rhs.wrTimeout_;
+	}
+	return *this;
+}
+
+mem_socket::~mem_socket()
+{
+	close();
+}
+
+// --------------------------------------------------------------------------
+
+std::tuple<mem_socket, mem_socket> mem_socket::pair(size_t capacity /*=DFLT_CAPACITY*/)
+{
+	size_t n = 64;
+	while (n < capacity)
+		n <<= 1;
+
+	auto p0 = std::make_shared<pipe>(n),
+		 p1 = std::make_shared<pipe>(n);
+
+	mem_socket s0, s1;
+	s0.rx_ = s1.tx_ = p0;
+	s1.rx_ = s0.tx_ = p1;
+
+	// Different random sequences for each end
+	s1.rand_ = ~s0.rand_;
+
+	return std::make_tuple(std::move(s0), std::move(s1));
+}
+
+// --------------------------------------------------------------------------
+
+bool mem_socket::shutdown(int how /*=SHUT_RDWR*/)
+{
+	if (!rx_) {
+		clear(ENOTCONN);
+		return false;
+	}
+
+	if (how == SHUT_RD || how == SHUT_RDWR) {
+		rx_->rdClosed.store(true);
+		rx_->wake_all();
+	}
+	if (how == SHUT_WR || how == SHUT_RDWR) {
+		tx_->wrClosed.store(true);
+		tx_->wake_all();
+	}
+	return true;
+}
+
+void mem_socket::close()
+{
+	if (rx_) {
+		shutdown(SHUT_RDWR);
+		rx_.reset();
+		tx_.reset();
+	}
+}
+
+// --------------------------------------------------------------------------
+
+size_t mem_socket::available() const
+{
+	if (!rx_)
+		return 0;
+	return rx_->tail.load(std::memory_order_acquire)
+		- rx_->head.load(std::memory_order_relaxed);
+}
+
+int mem_socket::send_queue_size() const
+{
+	if (!tx_)
+		return -1;
+	return int(tx_->tail.load(std::memory_order_relaxed)
+			   - tx_->head.load(std::memory_order_acquire));
+}
+
+// --------------------------------------------------------------------------
+
+size_t mem_socket::limit(size_t n, size_t lim, bool random)
+{
+	if (lim == 0)
+		return n;
+
+	if (random) {
+		// xorshift64
+		rand_ ^= rand_ << 13;
+		rand_ ^= rand_ >> 7;
+		rand_ ^= rand_ << 17;
+		lim = 1 + size_t(rand_ % lim);
+	}
+	return std::min(n, lim);
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t mem_socket::read(void *buf, size_t n)
+{
+	if (!rx_) {
+		clear(ENOTCONN);
+		return -1;
+	}
+
+	pipe& p = *rx_;
+	size_t head = p.head.load(std::memory_order_relaxed);
+
+	auto ready = [&p, head] {
+		return p.tail.load() != head || p.wrClosed.load() || p.rdClosed.load();
+	};
+
+	if (n == 0 || p.rdClosed.load())
+		return 0;
+
+	if (!ready()) {
+		if (nonBlocking_ || !p.wait(p.rdWaiting, rdTimeout_, ready)) {
+			clear(EAGAIN);
+			return -1;
+		}
+	}
+
+	clear();
+
+	// Anything still there is read, even after the writer shut down
+	size_t nr = std::min(limit(n, rdLimit_, rdRandom_), p.tail.load() - head);
+	if (nr == 0)
+		return 0;
+
+	size_t off = head & p.mask,
+		   n1 = std::min(nr, p.cap - off);
+
+	std::memcpy(buf, p.buf.get()+off, n1);
+	std::memcpy(static_cast<char*>(buf)+n1, p.buf.get(), nr-n1);
+
+	p.head.store(head + nr);
+	p.wake(p.wrWaiting);
+	return ssize_t(nr);
+}
+
+// The clock is only checked every few polls, like the base class.
+
+ssize_t mem_socket::read_spin(void *buf, size_t n, const microseconds& spin)
+{
+	if (rx_) {
+		const pipe& p = *rx_;
+		size_t head = p.head.load(std::memory_order_relaxed);
+		auto deadline = steady_clock::now() + spin;
+
+		do {
+			for (int i=0; i<16; ++i) {
+				if (p.tail.load() != head || p.wrClosed.load() || p.rdClosed.load())
+					return read(buf, n);
+			}
+		}
+		while (steady_clock::now() < deadline);
+	}
+	return read(buf, n);
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t mem_socket::write_ranges(const iovec* iov, size_t niov)
+{
+	if (!tx_) {
+		clear(ENOTCONN);
+		return -1;
+	}
+
+	size_t n = 0;
+	for (size_t i=0; i<niov; ++i)
+		n += iov[i].iov_len;
+
+	pipe& p = *tx_;
+	size_t tail = p.tail.load(std::memory_order_relaxed);
+
+	if (p.wrClosed.load() || p.rdClosed.load()) {
+		clear(EPIPE);
+		return -1;
+	}
+
+	if (n == 0)
+		return 0;
+
+	auto ready = [&p, tail] {
+		return tail - p.head.load() < p.cap || p.rdClosed.load() || p.wrClosed.load();
+	};
+
+	if (!ready()) {
+		if (nonBlocking_ || !p.wait(p.wrWaiting, wrTimeout_, ready)) {
+			clear(EAGAIN);
+			return -1;
+		}
+	}
+
+	if (p.wrClosed.load() || p.rdClosed.load()) {
+		clear(EPIPE);
+		return -1;
+	}
+
+	size_t room = p.cap - (tail - p.head.load()),
+		   nw = std::min(limit(n, wrLimit_, wrRandom_), room);
+
+	// Copy from the buffers in order, wrapping around the ring as needed
+	size_t pos = tail, left = nw;
+	for (size_t i=0; i<niov && left > 0; ++i) {
+		const char* src = static_cast<const char*>(iov[i].iov_base);
+		size_t len = std::min(iov[i].iov_len, left);
+		left -= len;
+
+		while (len > 0) {
+			size_t off = pos & p.mask,
+				   nc = std::min(len, p.cap - off);
+			std::memcpy(p.buf.get()+off, src, nc);
+			src += nc;
+			pos += nc;
+			len -= nc;
+		}
+	}
+
+	p.tail.store(tail + nw);
+	p.wake(p.rdWaiting);
+
+	clear();
+	return ssize_t(nw);
+}
+
+ssize_t mem_socket::write(const void *buf, size_t n)
+{
+	iovec iov { const_cast<void*>(buf), n };
+	return write_ranges(&iov, 1);
+}
+
+ssize_t mem_socket::write(const std::vector<iovec>& ranges)
+{
+	return write_ranges(ranges.data(), ranges.size());
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,160 @@
+// mirrored_ring.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/mirrored_ring.h"
+#include "sockpp/exception.h"
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+// The address space for both copies is reserved first, so that nothing
+// else can be mapped in between them. Then the memfd is mapped over each
+// half. The mappings keep the memory alive once the memfd is closed.
+
+mirrored_ring::mirrored_ring(size_t minCapacity) : mirrored_ring()
+{
+	size_t pg = size_t(::sysconf(_SC_PAGESIZE));
+	size_t cap = std::max<size_t>((minCapacity + pg - 1) / pg * pg, pg);
+
+	int fd = ::memfd_create("sockpp-ring", MFD_CLOEXEC);
+	if (fd < 0)
+		throw sys_error();
+
+	if (::ftruncate(fd, off_t(cap)) < 0) {
+		int err = errno;
+		::close(fd);
+		throw sys_error(err);
+	}
+
+	void* p = ::mmap(nullptr, 2*cap, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) {
+		int err = errno;
+		::close(fd);
+		throw sys_error(err);
+	}
+
+	uint8_t* base = static_cast<uint8_t*>(p);
+
+	if (::mmap(base, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+			|| ::mmap(base+cap, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+		int err = errno;
+		::munmap(base, 2*cap);
+		::close(fd);
+		throw sys_error(err);
+	}
+
+	::close(fd);
+	base_ = base;
+	cap_ = cap;
+}
+
+mirrored_ring::~mirrored_ring()
+{
+	if (base_)
+		::munmap(base_, 2*cap_);
+}
+
+mirrored_ring& mirrored_ring::operator=(mirrored_ring&& rhs) noexcept
+{
+	if (&rhs != this) {
+		if (base_)
+			::munmap(base_, 2*cap_);
+
+		base_ = rhs.base_;
+		cap_ = rhs.cap_;
+		head_ = rhs.head_;
+		size_ = rhs.size_;
+
+		rhs.base_ = nullptr;
+		rhs.cap_ = rhs.head_ = rhs.size_ = 0;
+	}
+	return *this;
+}
+
+// --------------------------------------------------------------------------
+
+size_t mirrored_ring::write(const void* buf, size_t n)
+{
+	n = std::min(n, free_space());
+	std::memcpy(write_ptr(), buf, n);
+	commit(n);
+	return n;
+}
+
+size_t mirrored_ring::read(void* buf, size_t n)
+{
+	n = std::min(n, size_);
+	std::memcpy(buf, data(), n);
+	consume(n);
+	return n;
+}
+
+ssize_t mirrored_ring::read_from(stream_socket& sock)
+{
+	if (full()) {
+		sock.clear(ENOBUFS);
+		return -1;
+	}
+
+	ssize_t n = sock.read(write_ptr(), free_space());
+	if (n > 0)
+		commit(size_t(n));
+	return n;
+}
+
+ssize_t mirrored_ring::write_to(stream_socket& sock)
+{
+	if (empty())
+		return 0;
+
+	ssize_t n = sock.write(data(), size_);
+	if (n > 0)
+		consume(size_t(n));
+	return n;
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,448 @@
+// mux_client.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/mux_client.h"
+#include <cstring>
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+const size_t mux_client::HEADER_SIZE;
+const size_t mux_client::DFLT_MAX_FRAME;
+const size_t mux_client::READ_BUF_SIZE;
+
+namespace {
+
+inline void put_be32(uint8_t* p, uint32_t v)
+{
+	p[0] = uint8_t(v >> 24);
+	p[1] = uint8_t(v >> 16);
+	p[2] = uint8_t(v >> 8);
+	p[3] = uint8_t(v);
+}
+
+inline uint32_t get_be32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16)
+		| (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Framing
+
+bool mux_client::read_frame(stream_socket& sock, uint32_t& id, std::string& payload,
+							size_t maxFrame)
+{
+	uint8_t hdr[HEADER_SIZE];
+
+	payload.clear();
+	ssize_t n = sock.read_n(hdr, HEADER_SIZE);
+	if (n <= 0)
+		return false;
+
+	if (size_t(n) < HEADER_SIZE) {
+		sock.clear(ECONNRESET);
+		return false;
+	}
+
+	size_t len = get_be32(hdr);
+	if (len > maxFrame) {
+		sock.clear(EMSGSIZE);
+		return false;
+	}
+	id = get_be32(hdr+4);
+
+	if (len > 0) {
+		payload.resize(len);
+		n = sock.read_n(&payload[0], len);
+		if (n < 0)
+			return false;
+
+		if (size_t(n) < len) {
+			sock.clear(ECONNRESET);
+			return false;
+		}
+	}
+	return true;
+}
+
+// The header and payload go out in one gather write. A short write just
+// continues from wherever it left off.
+
+bool mux_client::write_frame(stream_socket& sock, uint32_t id, const void* buf, size_t n)
+{
+	if (n > 0xFFFFFFFF) {
+		sock.clear(EMSGSIZE);
+		return false;
+	}
+
+	uint8_t hdr[HEADER_SIZE];
+	put_be32(hdr, uint32_t(n));
+	put_be32(hdr+4, id);
+
+	std::vector<iovec> iov { iovec{ hdr, HEADER_SIZE } };
+	if (n > 0)
+		iov.push_back(iovec{ const_cast<void*>(buf), n });
+
+	while (!iov.empty()) {
+		ssize_t nw = sock.write(iov);
+		if (nw < 0 && sock.last_error() == EINTR)
+			continue;
+		if (nw <= 0)
+			return false;
+
+		size_t i = 0, rem = size_t(nw);
+		while (i < iov.size() && rem >= iov[i].iov_len)
+			rem -= iov[i++].iov_len;
+
+		if (rem > 0) {
+			iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + rem;
+			iov[i].iov_len -= rem;
+		}
+		iov.erase(iov.begin(), iov.begin()+i);
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// The client
+
+// The reader thread gets its own handle to the socket, so that its errors
+// don't race with those of the writers.
+
+mux_client::mux_client(stream_socket&& sock, size_t maxFrame)
+		: sock_(std::move(sock)), maxFrame_(maxFrame),
+			nextId_(1), err_(0), closing_(false)
+{
+	if (!sock_) {
+		err_ = sock_.last_error() ? sock_.last_error() : ENOTCONN;
+		return;
+	}
+
+	rdSock_ = stream_socket(sock_.clone().release());
+	if (!rdSock_) {
+		err_ = rdSock_.last_error();
+		return;
+	}
+
+	rdThr_ = std::thread(&mux_client::read_loop, this);
+	timerThr_ = std::thread(&mux_client::timer_loop, this);
+}
+
+mux_client::~mux_client()
+{
+	close();
+}
+
+void mux_client::close()
+{
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		closing_ = true;
+	}
+	timerCv_.notify_all();
+
+	// Shutting down the socket wakes the reader
+	sock_.shutdown(SHUT_RDWR);
+
+	if (rdThr_.joinable())
+		rdThr_.join();
+	if (timerThr_.joinable())
+		timerThr_.join();
+
+	fail_all(ECANCELED);
+	rdSock_.close();
+	sock_.close();
+}
+
+bool mux_client::is_connected()
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return err_ == 0 && !closing_;
+}
+
+size_t mux_client::in_flight()
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return pending_.size();
+}
+
+// --------------------------------------------------------------------------
+
+// The request is registered before it's sent, since the response can
+// arrive before the write returns. The IDs wrap around, skipping any that
+// are still in flight.
+//
+// A request from a callback on the reader thread isn't written here, since
+// the reader must never block on the socket. The reader's ID is set before
+// any other thread can use the client, so it's safe to read.
+
+bool mux_client::async_call(const void* buf, size_t n,
+							const std::chrono::microseconds& timeout, callback cb)
+{
+	uint32_t id;
+	{
+		std::unique_lock<std::mutex> lk(lock_);
+		if (err_ != 0 || closing_) {
+			int err = err_ ? err_ : ECANCELED;
+			lk.unlock();
+			cb(err, std::string());
+			return false;
+		}
+
+		do {
+			id = nextId_++;
+		} while (pending_.count(id) != 0);
+
+		request& req = pending_[id];
+		req.cb = std::move(cb);
+		req.hasDeadline = timeout.count() > 0;
+
+		if (req.hasDeadline) {
+			req.timer = timers_.emplace(clock::now() + timeout, id);
+			if (req.timer == timers_.begin())
+				timerCv_.notify_one();
+		}
+
+		if (std::this_thread::get_id() == rdThr_.get_id()) {
+			deferred_.emplace_back(id, std::string(static_cast<const char*>(buf), n));
+			timerCv_.notify_one();
+			return true;
+		}
+	}
+
+	bool ok;
+	int err = 0;
+	{
+		std::lock_guard<std::mutex> lk(wrLock_);
+		ok = write_frame(sock_, id, buf, n);
+		if (!ok)
+			err = sock_.last_error();
+	}
+
+	if (!ok)
+		write_failed(err);
+	return ok;
+}
+
+// The stream may be cut off mid-frame, so the whole connection is failed.
+
+void mux_client::write_failed(int err)
+{
+	fail_all(err ? err : EIO);
+	sock_.shutdown(SHUT_RDWR);
+}
+
+int mux_client::call(const std::string& req, std::string& resp,
+					 const std::chrono::microseconds& timeout)
+{
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool done = false;
+	int ret = 0;
+
+	async_call(req, timeout, [&](int err, std::string&& r) {
+		std::lock_guard<std::mutex> lk(mtx);
+		ret = err;
+		resp = std::move(r);
+		done = true;
+		cv.notify_one();
+	});
+
+	std::unique_lock<std::mutex> lk(mtx);
+	cv.wait(lk, [&done] { return done; });
+	return ret;
+}
+
+// --------------------------------------------------------------------------
+
+void mux_client::complete(uint32_t id, std::string&& resp)
+{
+	callback cb;
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		auto p = pending_.find(id);
+		if (p == pending_.end())
+			return;		// Late, after its deadline
+
+		cb = std::move(p->second.cb);
+		if (p->second.hasDeadline)
+			timers_.erase(p->second.timer);
+		pending_.erase(p);
+	}
+	cb(0, std::move(resp));
+}
+
+void mux_client::fail_all(int err)
+{
+	std::unordered_map<uint32_t, request> reqs;
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		if (err_ == 0)
+			err_ = err;
+		err = err_;
+		reqs.swap(pending_);
+		timers_.clear();
+	}
+
+	for (auto& r : reqs)
+		r.second.cb(err, std::string());
+}
+
+// The responses are parsed out of a buffer, so that a burst of small ones
+// takes a single read.
+
+void mux_client::read_loop()
+{
+	std::vector<uint8_t> buf(READ_BUF_SIZE);
+	size_t pos = 0, len = 0;
+	int err = 0;
+
+	while (true) {
+		while (len - pos >= HEADER_SIZE) {
+			size_t plen = get_be32(&buf[pos]);
+			if (plen > maxFrame_) {
+				err = EMSGSIZE;
+				break;
+			}
+			if (len - pos < HEADER_SIZE + plen)
+				break;
+
+			uint32_t id = get_be32(&buf[pos+4]);
+			const char* p = reinterpret_cast<const char*>(&buf[pos+HEADER_SIZE]);
+			complete(id, std::string(p, plen));
+			pos += HEADER_SIZE + plen;
+		}
+		if (err)
+			break;
+
+		// Make room for the rest of the frame
+		if (pos > 0) {
+			std::memmove(buf.data(), &buf[pos], len - pos);
+			len -= pos;
+			pos = 0;
+		}
+		if (len >= HEADER_SIZE) {
+			size_t need = HEADER_SIZE + get_be32(buf.data());
+			if (need > buf.size())
+				buf.resize(need);
+		}
+
+		ssize_t n = rdSock_.read(&buf[len], buf.size() - len);
+		if (n < 0 && rdSock_.last_error() == EINTR)
+			continue;
+		if (n <= 0) {
+			err = (n == 0) ? ECONNRESET : rdSock_.last_error();
+			break;
+		}
+		len += size_t(n);
+	}
+
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		if (closing_)
+			err = ECANCELED;
+	}
+	fail_all(err);
+	timerCv_.notify_all();
+}
+
+// The timer thread also sends the requests deferred by the reader. It may
+// block doing so, which holds up the deadlines, but not the reader, which
+// keeps draining the responses, so the server can make progress.
+
+void mux_client::timer_loop()
+{
+	std::vector<callback> expired;
+	std::vector<std::pair<uint32_t, std::string>> reqs;
+	std::unique_lock<std::mutex> lk(lock_);
+
+	while (!closing_) {
+		if (!deferred_.empty()) {
+			reqs.swap(deferred_);
+			lk.unlock();
+
+			bool ok = true;
+			int err = 0;
+			{
+				std::lock_guard<std::mutex> wlk(wrLock_);
+				for (auto& r : reqs) {
+					ok = write_frame(sock_, r.first, r.second.data(), r.second.size());
+					if (!ok) {
+						err = sock_.last_error();
+						break;
+					}
+				}
+			}
+
+			if (!ok)
+				write_failed(err);
+			reqs.clear();
+			lk.lock();
+			continue;
+		}
+
+		if (timers_.empty())
+			timerCv_.wait(lk);
+		else
+			timerCv_.wait_until(lk, timers_.begin()->first);
+
+		auto now = clock::now();
+		while (!timers_.empty() && timers_.begin()->first <= now) {
+			auto p = pending_.find(timers_.begin()->second);
+			expired.push_back(std::move(p->second.cb));
+			pending_.erase(p);
+			timers_.erase(timers_.begin());
+		}
+
+		if (!expired.empty()) {
+			lk.unlock();
+			for (auto& cb : expired)
+				cb(ETIMEDOUT, std::string());
+			expired.clear();
+			lk.lock();
+		}
+	}
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,219 @@
+// pacer.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/pacer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+const size_t pacer::DFLT_BURST;
+const uint64_t pacer::DFLT_SLACK;
+const size_t pacer::BATCH_SIZE;
+
+/////////////////////////////////////////////////////////////////////////////
+
+// The bucket starts out full.
+
+pacer::pacer(uint64_t bytesPerSec, size_t burst /*=DFLT_BURST*/)
+		: rate_(bytesPerSec ? bytesPerSec : 1), burst_(burst ? burst : 1),
+			tokens_(double(burst_)), last_(0), slack_(DFLT_SLACK), spin_(0),
+			txtime_(false)
+{
+}
+
+uint64_t pacer::now()
+{
+	timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+void pacer::sleep_until(uint64_t t, uint64_t spin /*=0*/)
+{
+	if (t > spin) {
+		uint64_t wake = t - spin;
+		timespec ts { time_t(wake / 1000000000), long(wake % 1000000000) };
+		while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+			;
+	}
+
+	while (spin != 0 && now() < t)
+		;
+}
+
+bool pacer::use_txtime(datagram_socket& sock)
+{
+	txtime_ = sock.txtime(CLOCK_MONOTONIC);
+	return txtime_;
+}
+
+// --------------------------------------------------------------------------
+
+// A packet bigger than the bucket waits for a full bucket, and then leaves
+// it in debt.
+
+uint64_t pacer::schedule(size_t n, uint64_t t)
+{
+	if (t < last_)
+		t = last_;
+
+	double tok = std::min(double(burst_), tokens_ + double(t - last_) * rate_ / 1.0e9);
+	double need = double(std::min(n, burst_));
+
+	if (tok < need) {
+		t += uint64_t(std::ceil((need - tok) * 1.0e9 / rate_));
+		tok = need;
+	}
+
+	tokens_ = tok - double(n);
+	last_ = t;
+	return t;
+}
+
+// --------------------------------------------------------------------------
+
+int pacer::send(datagram_socket& sock, const void* buf, size_t n)
+{
+	uint64_t t = schedule(n);
+
+	if (txtime_)
+		return sock.send_at(buf, n, t);
+
+	sleep_until(t, spin_);
+	return sock.send(buf, n);
+}
+
+// Each batch goes out when its first packet is due. In user space, it takes
+// the packets due within the timer slack of that one. With SO_TXTIME, it
+// takes a full batch, and the kernel holds each packet until its time.
+
+int pacer::send(datagram_socket& sock, const iovec* pkts, size_t n)
+{
+	const size_t CTRL_SIZE = CMSG_SPACE(sizeof(uint64_t));
+
+	std::vector<mmsghdr> msgs(std::min(n, BATCH_SIZE));
+	std::vector<char> ctrl(txtime_ ? msgs.size() * CTRL_SIZE : 0);
+
+	size_t nsent = 0;
+	uint64_t next = 0;
+	bool haveNext = false;
+
+	while (nsent < n) {
+		size_t nb = 0;
+		uint64_t first = 0;
+
+		while (nsent + nb < n && nb < msgs.size()) {
+			const iovec& pkt = pkts[nsent+nb];
+			uint64_t t = haveNext ? next : schedule(pkt.iov_len);
+			haveNext = false;
+
+			if (nb == 0)
+				first = t;
+			else if (!txtime_ && t > first + slack_) {
+				next = t;
+				haveNext = true;
+				break;
+			}
+
+			mmsghdr& m = msgs[nb];
+			std::memset(&m, 0, sizeof(mmsghdr));
+			m.msg_hdr.msg_iov = const_cast<iovec*>(&pkt);
+			m.msg_hdr.msg_iovlen = 1;
+
+			if (txtime_) {
+				char* c = &ctrl[nb * CTRL_SIZE];
+				std::memset(c, 0, CTRL_SIZE);
+				m.msg_hdr.msg_control = c;
+				m.msg_hdr.msg_controllen = CTRL_SIZE;
+
+				cmsghdr* cm = CMSG_FIRSTHDR(&m.msg_hdr);
+				cm->cmsg_level = SOL_SOCKET;
+				cm->cmsg_type = SCM_TXTIME;
+				cm->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+				std::memcpy(CMSG_DATA(cm), &t, sizeof(uint64_t));
+			}
+			++nb;
+		}
+
+		sleep_until(first, txtime_ ? 0 : spin_);
+
+		size_t i = 0;
+		while (i < nb) {
+			int ret = sock.sendmmsg(&msgs[i], unsigned(nb - i));
+			if (ret < 0) {
+				if (sock.last_error() == EINTR)
+					continue;
+				return nsent ? int(nsent) : -1;
+			}
+			i += size_t(ret);
+			nsent += size_t(ret);
+		}
+	}
+	return int(nsent);
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t pacer::write(stream_socket& sock, const void* buf, size_t n)
+{
+	const char* p = static_cast<const char*>(buf);
+	size_t nw = 0;
+
+	while (nw < n) {
+		size_t len = std::min(n - nw, burst_);
+		wait(len);
+
+		ssize_t ret = sock.write_n(p + nw, len);
+		if (ret < 0)
+			return nw ? ssize_t(nw) : -1;
+
+		nw += size_t(ret);
+		if (size_t(ret) < len)
+			break;
+	}
+	return ssize_t(nw);
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,287 @@
+// packet_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/packet_socket.h"
+#include <poll.h>
+#include <sys/mman.h>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+constexpr size_t packet_socket::DFLT_BLOCK_SIZE;
+constexpr unsigned packet_socket::DFLT_NUM_BLOCKS;
+constexpr size_t packet_socket::DFLT_FRAME_SIZE;
+constexpr milliseconds packet_socket::DFLT_RETIRE_TIMEOUT;
+
+// --------------------------------------------------------------------------
+
+packet_socket::packet_socket(packet_socket&& sock) noexcept
+		: base(std::move(sock)), ring_(sock.ring_), ringSize_(sock.ringSize_),
+			blockSize_(sock.blockSize_), numBlocks_(sock.numBlocks_),
+			curBlock_(sock.curBlock_), ifindex_(sock.ifindex_)
+{
+	sock.ring_ = nullptr;
+	sock.ringSize_ = 0;
+}
+
+packet_socket& packet_socket::operator=(packet_socket&& rhs) noexcept
+{
+	if (&rhs != this) {
+		unmap_rx_ring();
+		base::operator=(std::move(rhs));
+
+		ring_ = rhs.ring_;
+		ringSize_ = rhs.ringSize_;
+		blockSize_ = rhs.blockSize_;
+		numBlocks_ = rhs.numBlocks_;
+		curBlock_ = rhs.curBlock_;
+		ifindex_ = rhs.ifindex_;
+
+		rhs.ring_ = nullptr;
+		rhs.ringSize_ = 0;
+	}
+	return *this;
+}
+
+void packet_socket::unmap_rx_ring()
+{
+	if (ring_) {
+		::munmap(ring_, ringSize_);
+		ring_ = nullptr;
+		ringSize_ = 0;
+	}
+}
+
+// --------------------------------------------------------------------------
+
+// The socket is created with no protocol, so that it receives nothing until
+// the bind gives it both the protocol and the interface.
+
+bool packet_socket::open(const link_address& addr, int type /*=SOCK_RAW*/)
+{
+	if (is_open())
+		return true;
+
+	socket_t h = (socket_t) ::socket(AF_PACKET, type, 0);
+	if (!check_ret_bool(h))
+		return false;
+
+	reset(h);
+
+	if (!bind(addr)) {
+		int err = last_error();
+		close();
+		clear(err);
+		return false;
+	}
+	return true;
+}
+
+bool packet_socket::bind(const link_address& addr)
+{
+	if (!check_ret_bool(::bind(handle(), addr.sockaddr_ptr(), addr.size())))
+		return false;
+
+	ifindex_ = addr.ifindex();
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+bool packet_socket::setup_rx_ring(size_t blockSize, unsigned numBlocks,
+								  size_t frameSize, const milliseconds& retireTimeout)
+{
+	if (ring_) {
+		clear(EBUSY);
+		return false;
+	}
+
+	if (blockSize == 0 || numBlocks == 0 || frameSize == 0
+			|| blockSize > UINT32_MAX || frameSize > blockSize) {
+		clear(EINVAL);
+		return false;
+	}
+
+	int ver = TPACKET_V3;
+	if (!set_option(SOL_PACKET, PACKET_VERSION, &ver, sizeof(int)))
+		return false;
+
+	tpacket_req3 req {};
+	req.tp_block_size = unsigned(blockSize);
+	req.tp_block_nr = numBlocks;
+	req.tp_frame_size = unsigned(frameSize);
+	req.tp_frame_nr = unsigned((blockSize / frameSize) * numBlocks);
+	req.tp_retire_blk_tov = unsigned(retireTimeout.count());
+
+	if (!set_option(SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)))
+		return false;
+
+	size_t sz = blockSize * numBlocks;
+	void* p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE,
+					 MAP_SHARED | MAP_LOCKED | MAP_POPULATE, handle(), 0);
+
+	// Locking the ring can fail under a low memlock limit, so fall back
+	// to letting it be paged.
+	if (p == MAP_FAILED)
+		p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, handle(), 0);
+
+	if (p == MAP_FAILED) {
+		set_last_error();
+
+		// Take the ring back out of the socket
+		tpacket_req3 none {};
+		set_option(SOL_PACKET, PACKET_RX_RING, &none, sizeof(none));
+		return false;
+	}
+
+	ring_ = static_cast<uint8_t*>(p);
+	ringSize_ = sz;
+	blockSize_ = blockSize;
+	numBlocks_ = numBlocks;
+	curBlock_ = 0;
+	return true;
+}
+
+// The kernel fills the blocks in order. A block is ours once its status has
+// the user bit, and the acquire load makes sure that we then see all the
+// packets that the kernel wrote into it. A wakeup from poll() doesn't
+// guarantee that the block is ready, so it is checked again after each one.
+
+packet_block packet_socket::next_block(const milliseconds& timeout)
+{
+	if (!ring_) {
+		clear(EINVAL);
+		return packet_block();
+	}
+
+	auto desc = reinterpret_cast<tpacket_block_desc*>(ring_ + curBlock_*blockSize_);
+	auto ready = [desc] {
+		return (__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE)
+					& TP_STATUS_USER) != 0;
+	};
+
+	auto deadline = steady_clock::now() + timeout;
+
+	while (!ready()) {
+		int ms = -1;
+		if (timeout.count() >= 0) {
+			auto left = duration_cast<milliseconds>(deadline - steady_clock::now());
+			if (left.count() <= 0) {
+				clear(EAGAIN);
+				return packet_block();
+			}
+			ms = int(left.count());
+		}
+
+		pollfd pfd { handle(), POLLIN | POLLERR, 0 };
+		int ret = ::poll(&pfd, 1, ms);
+
+		if (ret < 0 && errno != EINTR) {
+			set_last_error();
+			return packet_block();
+		}
+	}
+
+	curBlock_ = (curBlock_ + 1) % numBlocks_;
+	clear();
+	return packet_block(desc);
+}
+
+// --------------------------------------------------------------------------
+
+bool packet_socket::fanout(uint16_t groupId, uint16_t mode /*=PACKET_FANOUT_HASH*/,
+						   uint16_t flags /*=0*/)
+{
+	int val = int(groupId) | (int(mode | flags) << 16);
+	return set_option(SOL_PACKET, PACKET_FANOUT, &val, sizeof(int));
+}
+
+bool packet_socket::promiscuous(bool on /*=true*/)
+{
+	if (ifindex_ == 0) {
+		clear(EINVAL);
+		return false;
+	}
+
+	packet_mreq mreq {};
+	mreq.mr_ifindex = ifindex_;
+	mreq.mr_type = PACKET_MR_PROMISC;
+
+	return set_option(SOL_PACKET, on ? PACKET_ADD_MEMBERSHIP : PACKET_DROP_MEMBERSHIP,
+					  &mreq, sizeof(mreq));
+}
+
+// Without a V3 ring, the kernel fills in only the first two fields.
+
+bool packet_socket::get_stats(packet_stats& st)
+{
+	tpacket_stats_v3 kst {};
+	socklen_t len = sizeof(kst);
+
+	if (!get_option(SOL_PACKET, PACKET_STATISTICS, &kst, &len))
+		return false;
+
+	st.packets = kst.tp_packets;
+	st.drops = kst.tp_drops;
+	st.freezeCount = kst.tp_freeze_q_cnt;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+int packet_socket::recvfrom(void* buf, size_t n, int flags, link_address& addr)
+{
+	sockaddr_ll sll {};
+	socklen_t len = sizeof(sll);
+
+	int ret = check_ret(int(::recvfrom(handle(), buf, n, flags,
+									   reinterpret_cast<sockaddr*>(&sll), &len)));
+	if (ret >= 0)
+		addr = link_address(sll);
+
+	return ret;
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
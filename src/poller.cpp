@@ -0,0 +1,140 @@
+// poller.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/poller.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+#if defined(__linux__)
+	#include <sys/ioctl.h>
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+// The epoll busy-poll parameters, from linux/eventpoll.h, for a C library
+// that's older than the kernel feature (glibc before 2.40). That header
+// can't be included along with sys/epoll.h.
+
+#if !defined(EPIOCSPARAMS)
+namespace {
+
+struct epoll_params {
+	uint32_t busy_poll_usecs;
+	uint16_t busy_poll_budget;
+	uint8_t prefer_busy_poll;
+	uint8_t pad;
+};
+
+}
+
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+
+poller::poller() : base((socket_t) ::epoll_create1(EPOLL_CLOEXEC))
+{
+	if (!is_open())
+		set_last_error();
+}
+
+bool poller::add(const socket& sock, uint32_t events, uint64_t data)
+{
+	epoll_event ev {};
+	ev.events = events;
+	ev.data.u64 = data;
+	return check_ret_bool(::epoll_ctl(handle(), EPOLL_CTL_ADD, sock.handle(), &ev));
+}
+
+bool poller::modify(const socket& sock, uint32_t events, uint64_t data)
+{
+	epoll_event ev {};
+	ev.events = events;
+	ev.data.u64 = data;
+	return check_ret_bool(::epoll_ctl(handle(), EPOLL_CTL_MOD, sock.handle(), &ev));
+}
+
+bool poller::remove(const socket& sock)
+{
+	epoll_event ev {};
+	return check_ret_bool(::epoll_ctl(handle(), EPOLL_CTL_DEL, sock.handle(), &ev));
+}
+
+// --------------------------------------------------------------------------
+
+bool poller::busy_poll(const microseconds& to, unsigned budget /*=0*/,
+					   bool prefer /*=false*/)
+{
+	if (to.count() < 0 || to.count() > INT32_MAX || budget > UINT16_MAX) {
+		clear(EINVAL);
+		return false;
+	}
+
+	epoll_params params {};
+	params.busy_poll_usecs = uint32_t(to.count());
+	params.busy_poll_budget = uint16_t(budget);
+	params.prefer_busy_poll = prefer ? 1 : 0;
+	return check_ret_bool(::ioctl(handle(), EPIOCSPARAMS, &params));
+}
+
+// --------------------------------------------------------------------------
+// A signal that interrupts the wait just looks like a timeout, so an event
+// loop can go around again, and check a signal_fd, or a flag.
+
+int poller::wait(epoll_event* evts, size_t n, const milliseconds& timeout)
+{
+	int ms = -1;
+	if (timeout.count() >= 0)
+		ms = int(std::min<milliseconds::rep>(timeout.count(), INT_MAX));
+
+	int ret = ::epoll_wait(handle(), evts, int(std::min<size_t>(n, INT_MAX)), ms);
+	if (ret < 0 && errno == EINTR) {
+		clear();
+		return 0;
+	}
+	return check_ret(ret);
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
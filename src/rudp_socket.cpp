@@ -0,0 +1,677 @@
+// rudp_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/rudp_socket.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <poll.h>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+const size_t rudp_socket::MAX_DATAGRAM;
+const size_t rudp_socket::DATA_HEADER_SIZE;
+const size_t rudp_socket::MAX_MESSAGE;
+const size_t rudp_socket::MAX_SACK_BLOCKS;
+const size_t rudp_socket::BATCH_SIZE;
+const size_t rudp_socket::DFLT_WINDOW;
+const unsigned rudp_socket::DUP_THRESH;
+const unsigned rudp_socket::MAX_BACKOFFS;
+constexpr microseconds rudp_socket::DFLT_MIN_RTO;
+constexpr microseconds rudp_socket::MAX_RTO;
+constexpr microseconds rudp_socket::INITIAL_RTO;
+
+// The packet formats. All fields are big-endian.
+//
+//   DATA:  type(1) flags(1) reserved(2) seq(4) payload
+//   ACK:   type(1) nblocks(1) reserved(2) cum_ack(4) window(4)
+//          { start(4) end(4) } * nblocks
+//
+// The cumulative ACK is the next sequence number expected in order, and
+// each SACK block covers [start, end) beyond it. Sequence numbers are
+// 64-bit internally, and the low 32 bits go on the wire. They are extended
+// back to 64 bits relative to a nearby value on the other side.
+
+namespace {
+
+const uint8_t PKT_DATA = 1;
+const uint8_t PKT_ACK = 2;
+
+const uint8_t FLAG_UNORDERED = 0x01;
+
+const size_t ACK_HEADER_SIZE = 12;
+
+inline void put_be32(uint8_t* p, uint32_t v)
+{
+	p[0] = uint8_t(v >> 24);
+	p[1] = uint8_t(v >> 16);
+	p[2] = uint8_t(v >> 8);
+	p[3] = uint8_t(v);
+}
+
+inline uint32_t get_be32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16)
+		| (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+// Extends a 32-bit sequence number to the 64-bit one nearest to 'ref'.
+inline uint64_t extend_seq(uint32_t seq, uint64_t ref)
+{
+	int64_t delta = int32_t(seq - uint32_t(ref));
+	return (delta < 0 && uint64_t(-delta) > ref) ? 0 : uint64_t(int64_t(ref) + delta);
+}
+
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+rudp_socket::rudp_socket(datagram_socket&& sock, size_t window)
+		: sock_(std::move(sock)), closing_(false), err_(0), lastErr_(0),
+			ordered_(true), sndUna_(0), sndNext_(0), sndBufMax_(window),
+			highSacked_(0), cwnd_(10.0),
+			ssthresh_(std::numeric_limits<double>::max()), recover_(0),
+			peerWnd_(uint32_t(window)), srtt_(0.0), rttvar_(0.0),
+			rto_(double(INITIAL_RTO.count())), minRto_(double(DFLT_MIN_RTO.count())),
+			timerOn_(false), backoffs_(0), rcvNext_(0), rcvWnd_(uint32_t(window)),
+			ackPending_(false), loss_(0.0),
+			rand_(uint64_t(clock::now().time_since_epoch().count()) | 1),
+			stats_()
+{
+	if (!sock_) {
+		err_ = lastErr_ = sock_.last_error() ? sock_.last_error() : EBADF;
+		return;
+	}
+	thr_ = std::thread(&rudp_socket::run, this);
+}
+
+rudp_socket::~rudp_socket()
+{
+	close();
+}
+
+// Shutting down the socket wakes the thread from its poll.
+
+void rudp_socket::close()
+{
+	{
+		std::lock_guard<std::mutex> lk(lock_);
+		closing_ = true;
+	}
+	rdCv_.notify_all();
+	wrCv_.notify_all();
+
+	sock_.shutdown(SHUT_RDWR);
+	if (thr_.joinable())
+		thr_.join();
+	sock_.close();
+}
+
+rudp_socket::operator bool() const
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	return !closing_ && err_ == 0;
+}
+
+void rudp_socket::set_ordered(bool on)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	ordered_ = on;
+}
+
+void rudp_socket::set_min_rto(const microseconds& to)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	minRto_ = double(to.count());
+}
+
+void rudp_socket::set_loss(double rate)
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	loss_ = rate;
+}
+
+rudp_socket::stats rudp_socket::get_stats()
+{
+	std::lock_guard<std::mutex> lk(lock_);
+	stats st = stats_;
+	st.srttUs = srtt_;
+	st.cwnd = cwnd_;
+	return st;
+}
+
+// --------------------------------------------------------------------------
+// The application side
+
+bool rudp_socket::send(const void* buf, size_t n)
+{
+	if (n > MAX_MESSAGE) {
+		lastErr_ = EMSGSIZE;
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lk(lock_);
+	wrCv_.wait(lk, [this] {
+		return sndBuf_.size() < sndBufMax_ || closing_ || err_ != 0;
+	});
+
+	if (closing_ || err_ != 0) {
+		lastErr_ = err_ ? err_ : EPIPE;
+		return false;
+	}
+
+	sndBuf_.push_back(out_msg{ std::string(static_cast<const char*>(buf), n),
+							   clock::time_point(), 0, false, false, !ordered_ });
+	++stats_.msgsSent;
+	transmit(clock::now());
+	return true;
+}
+
+// If the application had let the window close, it tells the peer right
+// away when it opens again, rather than waiting for a probe.
+
+bool rudp_socket::recv(std::string& msg, const microseconds& timeout)
+{
+	std::unique_lock<std::mutex> lk(lock_);
+	auto ready = [this] { return !ready_.empty() || closing_ || err_ != 0; };
+
+	if (timeout.count() > 0) {
+		if (!rdCv_.wait_for(lk, timeout, ready)) {
+			lastErr_ = EAGAIN;
+			return false;
+		}
+	}
+	else
+		rdCv_.wait(lk, ready);
+
+	if (ready_.empty()) {
+		lastErr_ = err_ ? err_ : EPIPE;
+		return false;
+	}
+
+	bool wasClosed = advertised_window() == 0;
+
+	msg = std::move(ready_.front());
+	ready_.pop_front();
+	++stats_.msgsRecv;
+
+	if (wasClosed)
+		send_ack();
+	return true;
+}
+
+bool rudp_socket::flush(const microseconds& timeout)
+{
+	std::unique_lock<std::mutex> lk(lock_);
+	auto done = [this] { return sndBuf_.empty() || closing_ || err_ != 0; };
+
+	if (timeout.count() > 0) {
+		if (!wrCv_.wait_for(lk, timeout, done)) {
+			lastErr_ = EAGAIN;
+			return false;
+		}
+	}
+	else
+		wrCv_.wait(lk, done);
+
+	if (!sndBuf_.empty()) {
+		lastErr_ = err_ ? err_ : EPIPE;
+		return false;
+	}
+	return true;
+}
+
+// --------------------------------------------------------------------------
+// The protocol thread
+
+// Each pass waits for packets or the retransmission timer, then handles
+// a whole batch of packets before acknowledging them all at once.
+
+void rudp_socket::run()
+{
+	std::vector<uint8_t> bufs(BATCH_SIZE * MAX_DATAGRAM);
+	std::vector<iovec> iov(BATCH_SIZE);
+	std::vector<mmsghdr> msgs(BATCH_SIZE);
+
+	while (true) {
+		timespec ts { 0, 10000000 };	// Check for closing at least this often
+		{
+			std::lock_guard<std::mutex> lk(lock_);
+			if (closing_ || err_ != 0)
+				break;
+
+			if (timerOn_) {
+				auto left = duration_cast<nanoseconds>(timer_ - clock::now()).count();
+				if (left < ts.tv_nsec)
+					ts.tv_nsec = std::max<long>(long(left), 0);
+			}
+		}
+
+		pollfd pfd { sock_.handle(), POLLIN, 0 };
+		int rc = ::ppoll(&pfd, 1, &ts, nullptr);
+
+		if (rc > 0) {
+			for (size_t i=0; i<BATCH_SIZE; ++i) {
+				iov[i] = iovec{ &bufs[i * MAX_DATAGRAM], MAX_DATAGRAM };
+				std::memset(&msgs[i], 0, sizeof(mmsghdr));
+				msgs[i].msg_hdr.msg_iov = &iov[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			int n = sock_.recvmmsg(msgs.data(), unsigned(BATCH_SIZE), MSG_DONTWAIT);
+
+			std::lock_guard<std::mutex> lk(lock_);
+			auto now = clock::now();
+			for (int i=0; i<n; ++i)
+				on_packet(&bufs[i * MAX_DATAGRAM], msgs[i].msg_len, now);
+
+			if (n > 0) {
+				stats_.pktsRecv += unsigned(n);
+				if (ackPending_)
+					send_ack();
+				transmit(now);
+			}
+			else if (n < 0 && sock_.last_error() != EAGAIN
+						&& sock_.last_error() != EINTR
+						&& sock_.last_error() != ECONNREFUSED) {
+				if (!closing_)
+					fail(sock_.last_error());
+			}
+		}
+
+		std::lock_guard<std::mutex> lk(lock_);
+		auto now = clock::now();
+		if (timerOn_ && now >= timer_)
+			on_timeout(now);
+	}
+}
+
+void rudp_socket::on_packet(const uint8_t* p, size_t n, clock::time_point now)
+{
+	if (n >= DATA_HEADER_SIZE && p[0] == PKT_DATA)
+		on_data(p, n);
+	else if (n >= ACK_HEADER_SIZE && p[0] == PKT_ACK)
+		on_ack(p, n, now);
+}
+
+// In-order messages are held until the gap before them is filled.
+// Unordered ones are delivered right away, leaving a marker behind so
+// that a retransmitted copy is recognized as a duplicate.
+
+void rudp_socket::on_data(const uint8_t* p, size_t n)
+{
+	ackPending_ = true;
+
+	uint64_t seq = extend_seq(get_be32(p+4), rcvNext_);
+	if (seq < rcvNext_ || rcvOoo_.count(seq) != 0) {
+		++stats_.duplicates;
+		return;
+	}
+	if (seq >= rcvNext_ + rcvWnd_)
+		return;
+
+	std::string data(reinterpret_cast<const char*>(p + DATA_HEADER_SIZE),
+					 n - DATA_HEADER_SIZE);
+	bool unordered = (p[1] & FLAG_UNORDERED) != 0;
+	size_t nready = ready_.size();
+
+	if (seq == rcvNext_) {
+		ready_.push_back(std::move(data));
+		++rcvNext_;
+
+		auto it = rcvOoo_.begin();
+		while (it != rcvOoo_.end() && it->first == rcvNext_) {
+			if (!it->second.delivered)
+				ready_.push_back(std::move(it->second.data));
+			it = rcvOoo_.erase(it);
+			++rcvNext_;
+		}
+	}
+	else if (unordered) {
+		ready_.push_back(std::move(data));
+		rcvOoo_.emplace(seq, in_msg{ std::string(), true });
+	}
+	else
+		rcvOoo_.emplace(seq, in_msg{ std::move(data), false });
+
+	if (ready_.size() != nready)
+		rdCv_.notify_all();
+}
+
+// The ACK moves the window forward, marks the SACK'ed messages, and then
+// looks for holes with enough SACK'ed messages above them to call them
+// lost. The RTT is only sampled from messages sent once (Karn's rule).
+
+void rudp_socket::on_ack(const uint8_t* p, size_t n, clock::time_point now)
+{
+	size_t nblocks = std::min<size_t>(p[1], (n - ACK_HEADER_SIZE) / 8);
+	uint64_t cum = std::min(std::max(extend_seq(get_be32(p+4), sndUna_), sndUna_), sndNext_);
+	peerWnd_ = get_be32(p+8);
+
+	double sample = -1.0;
+	size_t nacked = 0;
+
+	auto acked = [&](out_msg& m) {
+		if (!m.sacked) {
+			++nacked;
+			if (m.xmits == 1)
+				sample = double(duration_cast<microseconds>(now - m.sent).count());
+		}
+	};
+
+	bool progress = cum > sndUna_;
+	while (sndUna_ < cum) {
+		acked(sndBuf_.front());
+		sndBuf_.pop_front();
+		++sndUna_;
+	}
+
+	for (size_t i=0; i<nblocks; ++i) {
+		const uint8_t* b = p + ACK_HEADER_SIZE + 8*i;
+		uint64_t start = std::max(extend_seq(get_be32(b), sndUna_), sndUna_),
+				 end = std::min(extend_seq(get_be32(b+4), sndUna_), sndNext_);
+
+		for (uint64_t seq = start; seq < end; ++seq) {
+			out_msg& m = sndBuf_[size_t(seq - sndUna_)];
+			acked(m);
+			m.sacked = true;
+		}
+		if (end > start)
+			highSacked_ = std::max(highSacked_, end - 1);
+	}
+
+	if (sample >= 0.0)
+		rtt_sample(sample);
+
+	// Grow the congestion window for the newly acknowledged messages
+	for (size_t i=0; i<nacked; ++i)
+		cwnd_ += (cwnd_ < ssthresh_) ? 1.0 : 1.0 / cwnd_;
+
+	// Anything with enough SACK'ed messages above it is lost, unless it
+	// was already retransmitted within the last RTT.
+	if (highSacked_ >= sndUna_ + DUP_THRESH) {
+		auto minAge = microseconds(int64_t(srtt_));
+		uint64_t last = std::min(highSacked_ - DUP_THRESH + 1, sndNext_);
+
+		for (uint64_t seq = sndUna_; seq < last; ++seq) {
+			out_msg& m = sndBuf_[size_t(seq - sndUna_)];
+			if (m.sacked || m.retxQueued || (m.xmits > 1 && now - m.sent < minAge))
+				continue;
+
+			if (seq >= recover_) {
+				cwnd_ = ssthresh_ = std::max(cwnd_ / 2.0, 2.0);
+				recover_ = sndNext_;
+			}
+			m.retxQueued = true;
+			retx_.push_back(seq);
+		}
+	}
+
+	// The backed-off RTO is kept until there's a clean RTT sample
+	if (progress || nacked > 0)
+		backoffs_ = 0;
+
+	if (sndNext_ > sndUna_) {
+		if (progress || !timerOn_) {
+			timerOn_ = true;
+			timer_ = now + microseconds(int64_t(rto_));
+		}
+	}
+	else if (!sndBuf_.empty() && peerWnd_ == 0) {
+		if (!timerOn_) {
+			timerOn_ = true;
+			timer_ = now + microseconds(int64_t(rto_));
+		}
+	}
+	else
+		timerOn_ = false;
+
+	if (progress)
+		wrCv_.notify_all();
+}
+
+// On a timeout, everything in flight that wasn't SACK'ed is sent again,
+// and the congestion window drops to one message. With nothing in flight,
+// the timer is probing a closed receive window.
+
+void rudp_socket::on_timeout(clock::time_point now)
+{
+	if (++backoffs_ > MAX_BACKOFFS) {
+		fail(ETIMEDOUT);
+		return;
+	}
+
+	++stats_.timeouts;
+	rto_ = std::min(rto_ * 2.0, double(MAX_RTO.count()));
+	timer_ = now + microseconds(int64_t(rto_));
+
+	if (sndNext_ > sndUna_) {
+		ssthresh_ = std::max(double(sndNext_ - sndUna_) / 2.0, 2.0);
+		cwnd_ = 1.0;
+		recover_ = sndNext_;
+
+		for (uint64_t seq = sndUna_; seq < sndNext_; ++seq) {
+			out_msg& m = sndBuf_[size_t(seq - sndUna_)];
+			if (!m.sacked && !m.retxQueued) {
+				m.retxQueued = true;
+				retx_.push_back(seq);
+			}
+		}
+		transmit(now);
+	}
+	else if (!sndBuf_.empty())
+		transmit(now, true);
+	else
+		timerOn_ = false;
+}
+
+// RFC 6298
+
+void rudp_socket::rtt_sample(double us)
+{
+	if (srtt_ == 0.0) {
+		srtt_ = std::max(us, 1.0);
+		rttvar_ = us / 2.0;
+	}
+	else {
+		rttvar_ = 0.75*rttvar_ + 0.25*std::fabs(srtt_ - us);
+		srtt_ = 0.875*srtt_ + 0.125*us;
+	}
+	rto_ = std::min(std::max(srtt_ + 4.0*rttvar_, minRto_), double(MAX_RTO.count()));
+}
+
+// Retransmissions go first, and aren't held back by the windows. New
+// messages are limited by the smaller of the congestion window and the
+// peer's receive window, except for a single probe of a closed window.
+// Everything goes out in batches with sendmmsg().
+
+void rudp_socket::transmit(clock::time_point now, bool probe)
+{
+	uint8_t hdrs[BATCH_SIZE][DATA_HEADER_SIZE];
+	iovec iov[BATCH_SIZE][2];
+	mmsghdr msgs[BATCH_SIZE];
+	size_t n = 0;
+
+	auto flush = [&] {
+		size_t i = 0;
+		while (i < n) {
+			int ret = sock_.sendmmsg(&msgs[i], unsigned(n - i));
+			if (ret <= 0) {
+				int err = sock_.last_error();
+				if (err != EAGAIN && err != ENOBUFS && err != ECONNREFUSED && err != EINTR)
+					fail(err);
+				break;
+			}
+			i += size_t(ret);
+		}
+		stats_.pktsSent += n;
+		n = 0;
+	};
+
+	auto add = [&](uint64_t seq, out_msg& m) {
+		m.sent = now;
+		++m.xmits;
+		if (drop_packet())
+			return;
+
+		uint8_t* h = hdrs[n];
+		h[0] = PKT_DATA;
+		h[1] = m.unordered ? FLAG_UNORDERED : 0;
+		h[2] = h[3] = 0;
+		put_be32(h+4, uint32_t(seq));
+
+		iov[n][0] = iovec{ h, DATA_HEADER_SIZE };
+		iov[n][1] = iovec{ const_cast<char*>(m.data.data()), m.data.size() };
+		std::memset(&msgs[n], 0, sizeof(mmsghdr));
+		msgs[n].msg_hdr.msg_iov = iov[n];
+		msgs[n].msg_hdr.msg_iovlen = 2;
+
+		if (++n == BATCH_SIZE)
+			flush();
+	};
+
+	while (!retx_.empty()) {
+		uint64_t seq = retx_.front();
+		retx_.pop_front();
+		if (seq < sndUna_ || seq >= sndNext_)
+			continue;
+
+		out_msg& m = sndBuf_[size_t(seq - sndUna_)];
+		m.retxQueued = false;
+		if (!m.sacked) {
+			++stats_.retransmits;
+			add(seq, m);
+		}
+	}
+
+	uint64_t wnd = std::min(uint64_t(cwnd_), uint64_t(peerWnd_));
+	if (probe && sndNext_ == sndUna_)
+		wnd = 1;
+
+	uint64_t end = sndUna_ + sndBuf_.size();
+	while (sndNext_ < end && sndNext_ - sndUna_ < wnd) {
+		add(sndNext_, sndBuf_[size_t(sndNext_ - sndUna_)]);
+		++sndNext_;
+	}
+
+	if (n > 0)
+		flush();
+
+	if (sndNext_ > sndUna_ && !timerOn_) {
+		timerOn_ = true;
+		timer_ = now + microseconds(int64_t(rto_));
+	}
+	else if (sndNext_ == sndUna_ && !sndBuf_.empty() && peerWnd_ == 0 && !timerOn_) {
+		timerOn_ = true;
+		timer_ = now + microseconds(int64_t(rto_));
+	}
+}
+
+// The SACK blocks are the runs of messages held beyond the first gap,
+// lowest first.
+
+void rudp_socket::send_ack()
+{
+	ackPending_ = false;
+
+	uint8_t pkt[ACK_HEADER_SIZE + 8*MAX_SACK_BLOCKS];
+	size_t nblocks = 0;
+
+	auto it = rcvOoo_.begin();
+	while (it != rcvOoo_.end() && nblocks < MAX_SACK_BLOCKS) {
+		uint64_t start = it->first, end = start + 1;
+		while (++it != rcvOoo_.end() && it->first == end)
+			++end;
+
+		uint8_t* b = pkt + ACK_HEADER_SIZE + 8*nblocks++;
+		put_be32(b, uint32_t(start));
+		put_be32(b+4, uint32_t(end));
+	}
+
+	pkt[0] = PKT_ACK;
+	pkt[1] = uint8_t(nblocks);
+	pkt[2] = pkt[3] = 0;
+	put_be32(pkt+4, uint32_t(rcvNext_));
+	put_be32(pkt+8, advertised_window());
+
+	++stats_.pktsSent;
+	if (!drop_packet())
+		sock_.send(pkt, ACK_HEADER_SIZE + 8*nblocks);
+}
+
+// xorshift64
+
+bool rudp_socket::drop_packet()
+{
+	if (loss_ <= 0.0)
+		return false;
+
+	rand_ ^= rand_ << 13;
+	rand_ ^= rand_ >> 7;
+	rand_ ^= rand_ << 17;
+
+	if (double(rand_ >> 11) / double(uint64_t(1) << 53) >= loss_)
+		return false;
+
+	++stats_.injectedLoss;
+	return true;
+}
+
+uint32_t rudp_socket::advertised_window() const
+{
+	size_t held = ready_.size();
+	return held < rcvWnd_ ? uint32_t(rcvWnd_ - held) : 0;
+}
+
+void rudp_socket::fail(int err)
+{
+	if (err_ == 0)
+		err_ = err;
+	timerOn_ = false;
+	rdCv_.notify_all();
+	wrCv_.notify_all();
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
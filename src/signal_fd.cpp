@@ -0,0 +1,103 @@
+// signal_fd.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/signal_fd.h"
+#include <pthread.h>
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+signal_fd::signal_fd(const sigset_t& mask, int flags /*=SFD_CLOEXEC*/)
+		: base((socket_t) ::signalfd(-1, &mask, flags)), mask_(mask)
+{
+	if (!is_open())
+		set_last_error();
+}
+
+sigset_t signal_fd::make_mask(std::initializer_list<int> sigs)
+{
+	sigset_t mask;
+	sigemptyset(&mask);
+	for (int sig : sigs)
+		sigaddset(&mask, sig);
+	return mask;
+}
+
+bool signal_fd::set_mask(const sigset_t& mask)
+{
+	if (!check_ret_bool(::signalfd(handle(), &mask, 0)))
+		return false;
+
+	mask_ = mask;
+	return true;
+}
+
+// pthread_sigmask() returns the error rather than setting errno.
+
+bool signal_fd::block()
+{
+	int err = ::pthread_sigmask(SIG_BLOCK, &mask_, nullptr);
+	clear(err);
+	return err == 0;
+}
+
+bool signal_fd::unblock()
+{
+	int err = ::pthread_sigmask(SIG_UNBLOCK, &mask_, nullptr);
+	clear(err);
+	return err == 0;
+}
+
+int signal_fd::read(signalfd_siginfo* infos, size_t n)
+{
+	ssize_t ret;
+	while ((ret = ::read(handle(), infos, n * sizeof(signalfd_siginfo))) < 0
+			&& errno == EINTR)
+		;
+
+	if (!check_ret_bool(int(ret)))
+		return -1;
+	return int(ret / sizeof(signalfd_siginfo));
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
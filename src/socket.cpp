@@ -39,6 +39,14 @@
 #include <algorithm>
 #include <cstring>
 
+#if !defined(WIN32)
+	#include <fcntl.h>
+#endif
+
+#if defined(__linux__)
+	#include <linux/net_tstamp.h>
+#endif
+
 // Used to explicitly ignore the returned value of a function call.
 #define ignore_result(x) if (x) {}
 
@@ -162,6 +170,42 @@ sock_address socket::peer_address() const
 
 // --------------------------------------------------------------------------
 
+bool socket::shutdown(int how /*=SHUT_RDWR*/)
+{
+	return check_ret_bool(::shutdown(handle_, how));
+}
+
+// --------------------------------------------------------------------------
+
+bool socket::linger(bool on, const seconds& timeout /*=seconds(0)*/)
+{
+	::linger lgr;
+	lgr.l_onoff = on ? 1 : 0;
+	lgr.l_linger = decltype(lgr.l_linger)(timeout.count());
+	return set_option(SOL_SOCKET, SO_LINGER, &lgr, sizeof(lgr));
+}
+// --------------------------------------------------------------------------
+
+bool socket::set_non_blocking(bool on /*=true*/)
+{
+	#if defined(WIN32)
+		unsigned long mode = on ? 1 : 0;
+		return check_ret_bool(::ioctlsocket(handle_, FIONBIO, &mode));
+	#else
+		int flags = ::fcntl(handle_, F_GETFL, 0);
+
+		if (flags == -1) {
+			set_last_error();
+			return false;
+		}
+		flags = on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+
+		return check_ret_bool(::fcntl(handle_, F_SETFL, flags));
+	#endif
+}
+
+// --------------------------------------------------------------------------
+
 bool socket::get_option(int level, int optname, void* optval, socklen_t* optlen)
 {
 	#if defined(WIN32)
@@ -187,6 +231,80 @@ bool socket::set_option(int level, int optname, void* optval, socklen_t optlen)
 	#endif
 }
 
+// --------------------------------------------------------------------------
+
+#if defined(SO_BUSY_POLL)
+bool socket::busy_poll(const microseconds& to)
+{
+	int usec = int(to.count());
+	return set_option(SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(int));
+}
+#endif
+
+// --------------------------------------------------------------------------
+
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+bool socket::keepalive(const keepalive_profile& prof)
+{
+	int idle = int(prof.idle.count()),
+		intvl = int(prof.interval.count()),
+		cnt = prof.count;
+
+	return keepalive(true)
+		&& set_option(IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(int))
+		&& set_option(IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(int))
+		&& set_option(IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(int));
+}
+#endif
+
+#if defined(TCP_USER_TIMEOUT)
+bool socket::user_timeout(const milliseconds& to)
+{
+	unsigned ms = unsigned(to.count());
+	return set_option(IPPROTO_TCP, TCP_USER_TIMEOUT, &ms, sizeof(unsigned));
+}
+#endif
+
+#if defined(SO_MAX_PACING_RATE)
+// Older kernels only take a 32-bit rate, where all ones means no limit.
+// Newer ones also accept 64 bits, and a larger rate falls back to no limit
+// on the older ones.
+
+bool socket::max_pacing_rate(uint64_t bytesPerSec)
+{
+	if (bytesPerSec != 0 && bytesPerSec < UINT32_MAX) {
+		uint32_t rate = uint32_t(bytesPerSec);
+		return set_option(SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(uint32_t));
+	}
+
+	if (bytesPerSec != 0 &&
+			set_option(SOL_SOCKET, SO_MAX_PACING_RATE, &bytesPerSec, sizeof(uint64_t)))
+		return true;
+
+	uint32_t rate = UINT32_MAX;
+	return set_option(SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(uint32_t));
+}
+#endif
+
+#if defined(SO_TXTIME)
+bool socket::txtime(clockid_t clk, unsigned flags)
+{
+	sock_txtime cfg;
+	cfg.clockid = clk;
+	cfg.flags = flags;
+	return set_option(SOL_SOCKET, SO_TXTIME, &cfg, sizeof(cfg));
+}
+#endif
+
+#if defined(__linux__)
+bool socket::get_tcp_stats(tcp_stats& st)
+{
+	std::memset(&st, 0, sizeof(tcp_stats));
+	socklen_t len = sizeof(tcp_stats);
+	return get_option(IPPROTO_TCP, TCP_INFO, &st, &len);
+}
+#endif
+
 // --------------------------------------------------------------------------
 // Gets a description of the last error encountered.
 
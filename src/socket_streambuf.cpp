@@ -0,0 +1,198 @@
+// socket_streambuf.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/socket_streambuf.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+//							socket_streambuf
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t socket_streambuf::DFLT_BUF_SIZE;
+
+// --------------------------------------------------------------------------
+
+socket_streambuf::socket_streambuf(stream_socket& sock, size_t inSize,
+								   size_t outSize)
+		: sock_(sock), ibuf_(std::max<size_t>(inSize, 1)), obuf_(outSize)
+{
+	char* p = ibuf_.data();
+	setg(p, p, p);
+
+	if (!obuf_.empty()) {
+		p = obuf_.data();
+		setp(p, p + obuf_.size());
+	}
+}
+
+socket_streambuf::~socket_streambuf()
+{
+	flush_output();
+}
+
+// --------------------------------------------------------------------------
+// Input
+
+socket_streambuf::int_type socket_streambuf::underflow()
+{
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+
+	char* p = ibuf_.data();
+	ssize_t n;
+
+	do {
+		n = sock_.read(p, ibuf_.size());
+	}
+	while (n < 0 && sock_.last_error() == EINTR);
+
+	if (n <= 0) {
+		setg(p, p, p);
+		return traits_type::eof();
+	}
+
+	setg(p, p, p+n);
+	return traits_type::to_int_type(*p);
+}
+
+// Copies out whatever is buffered, then reads directly into the caller's
+// memory when what's left is at least a buffer's worth. Smaller remainders
+// go through the buffer so that the next few small reads are free.
+
+std::streamsize socket_streambuf::xsgetn(char_type* s, std::streamsize n)
+{
+	std::streamsize nr = 0;
+
+	while (nr < n) {
+		std::streamsize navail = egptr() - gptr();
+		if (navail > 0) {
+			std::streamsize nx = std::min(navail, n - nr);
+			std::memcpy(s+nr, gptr(), size_t(nx));
+			gbump(int(nx));
+			nr += nx;
+		}
+		else if (size_t(n - nr) >= ibuf_.size()) {
+			ssize_t nx = sock_.read(s+nr, size_t(n - nr));
+			if (nx < 0 && sock_.last_error() == EINTR)
+				continue;
+			if (nx <= 0)
+				break;
+			nr += nx;
+		}
+		else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+			break;
+	}
+	return nr;
+}
+
+std::streamsize socket_streambuf::showmanyc()
+{
+	return (gptr() < egptr()) ? std::streamsize(egptr() - gptr()) : 0;
+}
+
+// --------------------------------------------------------------------------
+// Output
+
+bool socket_streambuf::flush_output()
+{
+	if (obuf_.empty())
+		return true;
+
+	size_t n = size_t(pptr() - pbase());
+	if (n == 0)
+		return true;
+
+	ssize_t nw = sock_.write_n(pbase(), n);
+
+	char* p = obuf_.data();
+	setp(p, p + obuf_.size());
+	return nw == ssize_t(n);
+}
+
+socket_streambuf::int_type socket_streambuf::overflow(int_type c)
+{
+	if (!flush_output())
+		return traits_type::eof();
+
+	if (traits_type::eq_int_type(c, traits_type::eof()))
+		return traits_type::not_eof(c);
+
+	char ch = traits_type::to_char_type(c);
+
+	if (obuf_.empty())
+		return (sock_.write_n(&ch, 1) == 1) ? c : traits_type::eof();
+
+	*pptr() = ch;
+	pbump(1);
+	return c;
+}
+
+// Small writes are appended to the buffer. Anything that doesn't fit is
+// sent after the buffered data, directly from the caller's memory if it's
+// at least a buffer's worth.
+
+std::streamsize socket_streambuf::xsputn(const char_type* s, std::streamsize n)
+{
+	if (n < epptr() - pptr()) {
+		std::memcpy(pptr(), s, size_t(n));
+		pbump(int(n));
+		return n;
+	}
+
+	if (!flush_output())
+		return 0;
+
+	if (size_t(n) >= obuf_.size()) {
+		ssize_t nw = sock_.write_n(s, size_t(n));
+		return (nw < 0) ? 0 : std::streamsize(nw);
+	}
+
+	std::memcpy(pptr(), s, size_t(n));
+	pbump(int(n));
+	return n;
+}
+
+int socket_streambuf::sync()
+{
+	return flush_output() ? 0 : -1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
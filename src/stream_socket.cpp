@@ -38,6 +38,10 @@
 #include "sockpp/exception.h"
 #include <algorithm>
 
+#if !defined(WIN32)
+	#include <sys/ioctl.h>
+#endif
+
 using namespace std::chrono;
 
 namespace sockpp {
@@ -62,6 +66,30 @@ bool stream_socket::open()
 	return is_open();
 }
 
+// --------------------------------------------------------------------------
+
+#if !defined(WIN32)
+std::tuple<stream_socket, stream_socket> stream_socket::pair(int domain,
+															 int protocol /*=0*/)
+{
+	stream_socket sock0, sock1;
+
+	int sv[2];
+	if (::socketpair(domain, SOCK_STREAM, protocol, sv) == 0) {
+		sock0.reset(sv[0]);
+		sock1.reset(sv[1]);
+	}
+	else {
+		int err = get_last_error();
+		sock0.clear(err);
+		sock1.clear(err);
+	}
+
+	return std::make_tuple<stream_socket, stream_socket>(std::move(sock0),
+														 std::move(sock1));
+}
+#endif
+
 // --------------------------------------------------------------------------
 // Reads from the socket. Note that we use ::recv() rather then ::read()
 // because many non-*nix operating systems make a distinction.
@@ -71,6 +99,48 @@ ssize_t stream_socket::read(void *buf, size_t n)
 	return check_ret(::recv(handle(), (char*) buf, n, 0));
 }
 
+// --------------------------------------------------------------------------
+// The clock is only checked every few polls, since the non-blocking recv()
+// is usually cheaper than reading the time.
+
+#if !defined(WIN32)
+ssize_t stream_socket::read_spin(void *buf, size_t n, const microseconds& spin)
+{
+	auto deadline = steady_clock::now() + spin;
+
+	do {
+		for (int i=0; i<16; ++i) {
+			ssize_t ret = ::recv(handle(), (char*) buf, n, MSG_DONTWAIT);
+			if (ret >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+				return check_ret(int(ret));
+		}
+	}
+	while (steady_clock::now() < deadline);
+
+	return read(buf, n);
+}
+
+// A peek at a single byte tells us if there's data, the end of the
+// stream, or an error, without disturbing any of them.
+
+bool stream_socket::spin_readable(const microseconds& spin)
+{
+	auto deadline = steady_clock::now() + spin;
+	char c;
+
+	do {
+		for (int i=0; i<16; ++i) {
+			ssize_t ret = ::recv(handle(), &c, 1, MSG_PEEK | MSG_DONTWAIT);
+			if (ret >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+				return true;
+		}
+	}
+	while (steady_clock::now() < deadline);
+
+	return false;
+}
+#endif
+
 // --------------------------------------------------------------------------
 // Attempts to read the requested number of bytes by repeatedly calling
 // read() until it has the data or an error occurs.
@@ -134,6 +204,56 @@ ssize_t stream_socket::write_n(const void *buf, size_t n)
 	return (nw == 0 && nx < 0) ? nx : ssize_t(nw);
 }
 
+// --------------------------------------------------------------------------
+// Like write_n(), but with the MSG_MORE flag on each send, so the kernel
+// will coalesce this with whatever is written next.
+
+ssize_t stream_socket::write_more(const void *buf, size_t n)
+{
+	#if defined(MSG_MORE)
+		const int flags = MSG_MORE;
+	#else
+		const int flags = 0;
+	#endif
+
+	size_t	nw = 0;
+	ssize_t	nx = 0;
+
+	const char *b = reinterpret_cast<const char*>(buf);
+
+	while (nw < n) {
+		if ((nx = check_ret(::send(handle(), b+nw, n-nw, flags))) <= 0)
+			break;
+
+		nw += nx;
+	}
+
+	return (nw == 0 && nx < 0) ? nx : ssize_t(nw);
+}
+
+// --------------------------------------------------------------------------
+
+#if defined(TCP_CORK) || defined(TCP_NOPUSH)
+bool stream_socket::cork(bool on /*=true*/)
+{
+	int val = on ? 1 : 0;
+	#if defined(TCP_CORK)
+		return set_option(IPPROTO_TCP, TCP_CORK, &val, sizeof(int));
+	#else
+		return set_option(IPPROTO_TCP, TCP_NOPUSH, &val, sizeof(int));
+	#endif
+}
+#endif
+
+// --------------------------------------------------------------------------
+
+#if !defined(WIN32)
+ssize_t stream_socket::write(const std::vector<iovec>& ranges)
+{
+	return check_ret(::writev(handle(), ranges.data(), int(ranges.size())));
+}
+#endif
+
 // --------------------------------------------------------------------------
 
 bool stream_socket::write_timeout(const microseconds& to)
@@ -147,6 +267,33 @@ bool stream_socket::write_timeout(const microseconds& to)
 	#endif
 }
 
+// --------------------------------------------------------------------------
+
+#if !defined(WIN32)
+int stream_socket::send_queue_size() const
+{
+	int n = 0;
+	#if defined(TIOCOUTQ)
+		if (check_ret(::ioctl(handle(), TIOCOUTQ, &n)) < 0)
+			return -1;
+	#else
+		if (check_ret(::ioctl(handle(), FIONWRITE, &n)) < 0)
+			return -1;
+	#endif
+	return n;
+}
+#endif
+
+// --------------------------------------------------------------------------
+
+#if defined(__linux__)
+bool stream_socket::used_fast_open()
+{
+	tcp_stats st;
+	return get_tcp_stats(st) && (st.tcpi_options & TCPI_OPT_SYN_DATA) != 0;
+}
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 // End namespace sockpp
 }
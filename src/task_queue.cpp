@@ -0,0 +1,200 @@
+// task_queue.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/task_queue.h"
+#include <algorithm>
+#include <memory>
+#include <poll.h>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t task_queue::DFLT_BATCH_SIZE;
+const size_t task_queue::CACHE_LINE;
+
+// --------------------------------------------------------------------------
+
+task_queue::task_queue() : head_(&stub_), needWake_(false), nwakeups_(0),
+		tail_(&stub_), armed_(false), unread_(0),
+		evt_(0, EFD_CLOEXEC | EFD_NONBLOCK)
+{
+	stub_.next.store(nullptr, std::memory_order_relaxed);
+}
+
+task_queue::~task_queue()
+{
+	node* n;
+	while ((n = pop()) != nullptr)
+		delete n;
+}
+
+// --------------------------------------------------------------------------
+
+// The exchange on the head is sequentially consistent, as is the load of
+// the wakeup flag after it. The loop stores the flag before it checks the
+// head, in prepare_wait(), so either the loop sees the new node and
+// doesn't sleep, or the producer sees the flag and wakes it.
+
+void task_queue::push(node* n)
+{
+	n->next.store(nullptr, std::memory_order_relaxed);
+	node* prev = head_.exchange(n);
+	prev->next.store(n, std::memory_order_release);
+}
+
+void task_queue::post(task fn)
+{
+	push(new node { {nullptr}, std::move(fn) });
+
+	// The flag is checked before the exchange, so that a running loop
+	// costs the producers nothing more than a shared read.
+	if (needWake_.load() && needWake_.exchange(false)) {
+		nwakeups_.fetch_add(1, std::memory_order_relaxed);
+		::eventfd_write(evt_.handle(), 1);
+	}
+}
+
+// A node is only returned once the one after it is linked, so the last
+// real node needs the stub pushed behind it. If a producer has swapped
+// the head, but not yet linked its node, the list looks empty for a
+// moment, and that node is picked up on the next pass.
+
+task_queue::node* task_queue::pop()
+{
+	node* tail = tail_;
+	node* next = tail->next.load(std::memory_order_acquire);
+
+	if (tail == &stub_) {
+		if (!next)
+			return nullptr;
+		tail_ = tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+
+	if (next) {
+		tail_ = next;
+		return tail;
+	}
+
+	if (tail != head_.load(std::memory_order_acquire))
+		return nullptr;
+
+	push(&stub_);
+	next = tail->next.load(std::memory_order_acquire);
+
+	if (next) {
+		tail_ = next;
+		return tail;
+	}
+	return nullptr;
+}
+
+// --------------------------------------------------------------------------
+
+// Each producer that takes the flag writes exactly one wakeup, so the loop
+// knows how many it is owed, and reads them back out, even if a write
+// lands after the loop has already woken up for some other reason.
+
+void task_queue::disarm()
+{
+	if (armed_) {
+		armed_ = false;
+		if (!needWake_.exchange(false))
+			++unread_;
+	}
+
+	if (unread_ > 0) {
+		eventfd_t val;
+		if (::eventfd_read(evt_.handle(), &val) == 0)
+			unread_ -= std::min<uint64_t>(val, unread_);
+	}
+}
+
+size_t task_queue::run_pending(size_t maxTasks /*=DFLT_BATCH_SIZE*/)
+{
+	disarm();
+
+	size_t n = 0;
+	while (n < maxTasks) {
+		std::unique_ptr<node> p(pop());
+		if (!p)
+			break;
+		++n;
+		p->fn();
+	}
+	return n;
+}
+
+bool task_queue::prepare_wait()
+{
+	if (!armed_) {
+		armed_ = true;
+		needWake_.store(true);
+	}
+
+	if (!empty()) {
+		disarm();
+		return false;
+	}
+	return true;
+}
+
+size_t task_queue::run(const milliseconds& timeout, size_t maxTasks /*=DFLT_BATCH_SIZE*/)
+{
+	size_t n = run_pending(maxTasks);
+	if (n > 0)
+		return n;
+
+	if (!prepare_wait())
+		return run_pending(maxTasks);
+
+	pollfd pfd { evt_.handle(), POLLIN, 0 };
+	int ms = (timeout.count() < 0) ? -1 : int(timeout.count());
+	::poll(&pfd, 1, ms);
+
+	return run_pending(maxTasks);
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,114 @@
+// timer_fd.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/timer_fd.h"
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+#if defined(__linux__)
+
+/////////////////////////////////////////////////////////////////////////////
+
+timespec timer_fd::to_timespec(const nanoseconds& d)
+{
+	timespec ts;
+	ts.tv_sec = time_t(d.count() / 1000000000);
+	ts.tv_nsec = long(d.count() % 1000000000);
+	return ts;
+}
+
+timer_fd::timer_fd(clockid_t clk /*=CLOCK_MONOTONIC*/, int flags /*=TFD_CLOEXEC*/)
+		: base((socket_t) ::timerfd_create(clk, flags))
+{
+	if (!is_open())
+		set_last_error();
+}
+
+// An initial value of zero would disarm the timer, so the shortest delay
+// is taken to be one nanosecond.
+
+bool timer_fd::set(const nanoseconds& initial, const nanoseconds& interval)
+{
+	itimerspec its;
+	its.it_value = to_timespec(std::max(initial, nanoseconds(1)));
+	its.it_interval = to_timespec(interval);
+
+	return check_ret_bool(::timerfd_settime(handle(), 0, &its, nullptr));
+}
+
+bool timer_fd::set_at(const steady_clock::time_point& tp, const nanoseconds& interval)
+{
+	auto t = duration_cast<nanoseconds>(tp.time_since_epoch());
+
+	itimerspec its;
+	its.it_value = to_timespec(std::max(t, nanoseconds(1)));
+	its.it_interval = to_timespec(interval);
+
+	return check_ret_bool(::timerfd_settime(handle(), TFD_TIMER_ABSTIME, &its, nullptr));
+}
+
+bool timer_fd::cancel()
+{
+	itimerspec its {};
+	return check_ret_bool(::timerfd_settime(handle(), 0, &its, nullptr));
+}
+
+bool timer_fd::remaining(nanoseconds& left)
+{
+	itimerspec its;
+	if (!check_ret_bool(::timerfd_gettime(handle(), &its)))
+		return false;
+
+	left = seconds(its.it_value.tv_sec) + nanoseconds(its.it_value.tv_nsec);
+	return true;
+}
+
+bool timer_fd::read(uint64_t& n)
+{
+	ssize_t ret;
+	while ((ret = ::read(handle(), &n, sizeof(n))) < 0 && errno == EINTR)
+		;
+	return check_ret_bool(int(ret));
+}
+
+#endif	// __linux__
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,448 @@
+// tls_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/tls_socket.h"
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <algorithm>
+#include <vector>
+#include <unistd.h>
+
+#if defined(__linux__)
+	#include <sys/sendfile.h>
+#endif
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_context
+/////////////////////////////////////////////////////////////////////////////
+
+tls_context::tls_context(role r)
+		: ctx_(SSL_CTX_new(r == SERVER ? TLS_server_method() : TLS_client_method())),
+			role_(r), lastErr_(0)
+{
+	if (!ctx_) {
+		lastErr_ = ERR_get_error();
+		return;
+	}
+
+	SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+
+	// Treat a peer that closes without a close_notify as a normal EOF,
+	// like a plain socket.
+	#if defined(SSL_OP_IGNORE_UNEXPECTED_EOF)
+		SSL_CTX_set_options(ctx_, SSL_OP_IGNORE_UNEXPECTED_EOF);
+	#endif
+
+	enable_ktls(true);
+
+	if (r == CLIENT) {
+		SSL_CTX_set_default_verify_paths(ctx_);
+		set_verify(true);
+	}
+}
+
+tls_context::~tls_context()
+{
+	SSL_CTX_free(ctx_);
+}
+
+// --------------------------------------------------------------------------
+
+bool tls_context::check_ret_bool(int ret)
+{
+	lastErr_ = (ret <= 0) ? ERR_get_error() : 0;
+	if (ret <= 0 && lastErr_ == 0)
+		lastErr_ = ERR_PACK(ERR_LIB_SSL, 0, ERR_R_INTERNAL_ERROR);
+	ERR_clear_error();
+	return ret > 0;
+}
+
+std::string tls_context::last_error_str() const
+{
+	char buf[256];
+	ERR_error_string_n(lastErr_, buf, sizeof(buf));
+	return std::string(buf);
+}
+
+// --------------------------------------------------------------------------
+
+bool tls_context::use_certificate_file(const std::string& certFile,
+									   const std::string& keyFile)
+{
+	return check_ret_bool(SSL_CTX_use_certificate_chain_file(ctx_, certFile.c_str()))
+		&& check_ret_bool(SSL_CTX_use_PrivateKey_file(ctx_, keyFile.c_str(), SSL_FILETYPE_PEM))
+		&& check_ret_bool(SSL_CTX_check_private_key(ctx_));
+}
+
+bool tls_context::use_certificate(const std::string& certPem, const std::string& keyPem)
+{
+	BIO* bio = BIO_new_mem_buf(certPem.data(), int(certPem.size()));
+	X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+	BIO_free(bio);
+
+	bio = BIO_new_mem_buf(keyPem.data(), int(keyPem.size()));
+	EVP_PKEY* key = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+	BIO_free(bio);
+
+	bool ok = check_ret_bool(cert && key)
+		&& check_ret_bool(SSL_CTX_use_certificate(ctx_, cert))
+		&& check_ret_bool(SSL_CTX_use_PrivateKey(ctx_, key))
+		&& check_ret_bool(SSL_CTX_check_private_key(ctx_));
+
+	X509_free(cert);
+	EVP_PKEY_free(key);
+	return ok;
+}
+
+bool tls_context::load_verify_file(const std::string& caFile)
+{
+	return check_ret_bool(SSL_CTX_load_verify_locations(ctx_, caFile.c_str(), nullptr));
+}
+
+bool tls_context::add_ca_certificate(const std::string& certPem)
+{
+	BIO* bio = BIO_new_mem_buf(certPem.data(), int(certPem.size()));
+	X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+	BIO_free(bio);
+
+	bool ok = check_ret_bool(cert != nullptr)
+		&& check_ret_bool(X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx_), cert));
+
+	X509_free(cert);
+	return ok;
+}
+
+void tls_context::set_verify(bool on)
+{
+	int mode = SSL_VERIFY_NONE;
+	if (on)
+		mode = SSL_VERIFY_PEER | ((role_ == SERVER) ? SSL_VERIFY_FAIL_IF_NO_PEER_CERT : 0);
+	SSL_CTX_set_verify(ctx_, mode, nullptr);
+}
+
+void tls_context::enable_ktls(bool on /*=true*/)
+{
+	#if defined(SSL_OP_ENABLE_KTLS)
+		if (on)
+			SSL_CTX_set_options(ctx_, SSL_OP_ENABLE_KTLS);
+		else
+			SSL_CTX_clear_options(ctx_, SSL_OP_ENABLE_KTLS);
+	#else
+		(void) on;
+	#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_socket
+/////////////////////////////////////////////////////////////////////////////
+
+tls_socket::tls_socket(tls_context& ctx, stream_socket&& sock)
+		: base(std::move(sock)), ssl_(SSL_new(ctx.handle())), sslErr_(0),
+			ktlsSend_(false), ktlsRecv_(false)
+{
+	if (!ssl_ || !SSL_set_fd(ssl_, int(handle()))) {
+		sslErr_ = ERR_get_error();
+		ERR_clear_error();
+		clear(EPROTO);
+		return;
+	}
+
+	if (ctx.is_server())
+		SSL_set_accept_state(ssl_);
+	else
+		SSL_set_connect_state(ssl_);
+}
+
+tls_socket::tls_socket(tls_socket&& sock)
+		: base(std::move(sock)), ssl_(sock.ssl_), sslErr_(sock.sslErr_),
+			ktlsSend_(sock.ktlsSend_), ktlsRecv_(sock.ktlsRecv_)
+{
+	sock.ssl_ = nullptr;
+	sock.ktlsSend_ = sock.ktlsRecv_ = false;
+}
+
+tls_socket& tls_socket::operator=(tls_socket&& rhs)
+{
+	if (&rhs != this) {
+		SSL_free(ssl_);
+		base::operator=(std::move(rhs));
+		ssl_ = rhs.ssl_;
+		sslErr_ = rhs.sslErr_;
+		ktlsSend_ = rhs.ktlsSend_;
+		ktlsRecv_ = rhs.ktlsRecv_;
+		rhs.ssl_ = nullptr;
+		rhs.ktlsSend_ = rhs.ktlsRecv_ = false;
+	}
+	return *this;
+}
+
+tls_socket::~tls_socket()
+{
+	SSL_free(ssl_);
+}
+
+// --------------------------------------------------------------------------
+// OpenSSL keeps a per-thread error queue, which has to be empty before each
+// call for SSL_get_error() to be reliable. So every failure drains it.
+
+int tls_socket::check_ssl(int ret)
+{
+	int err = SSL_get_error(ssl_, ret);
+
+	sslErr_ = ERR_get_error();
+	ERR_clear_error();
+
+	switch (err) {
+		case SSL_ERROR_ZERO_RETURN:
+			clear();
+			return 0;
+
+		case SSL_ERROR_WANT_READ:
+		case SSL_ERROR_WANT_WRITE:
+			clear(EWOULDBLOCK);
+			return -1;
+
+		case SSL_ERROR_SYSCALL:
+			if (errno == 0) {
+				clear();
+				return 0;
+			}
+			clear(errno);
+			return -1;
+
+		default:
+			clear(EPROTO);
+			return -1;
+	}
+}
+
+// --------------------------------------------------------------------------
+
+bool tls_socket::set_host(const std::string& host)
+{
+	if (!ssl_ || !SSL_set_tlsext_host_name(ssl_, host.c_str())
+			|| !SSL_set1_host(ssl_, host.c_str())) {
+		sslErr_ = ERR_get_error();
+		ERR_clear_error();
+		clear(EINVAL);
+		return false;
+	}
+	return true;
+}
+
+bool tls_socket::handshake()
+{
+	if (!ssl_) {
+		clear(ENOTCONN);
+		return false;
+	}
+
+	int ret = SSL_do_handshake(ssl_);
+	if (ret <= 0) {
+		if (check_ssl(ret) == 0)
+			clear(ECONNRESET);
+		return false;
+	}
+
+	#if defined(BIO_get_ktls_send)
+		ktlsSend_ = BIO_get_ktls_send(SSL_get_wbio(ssl_)) != 0;
+		ktlsRecv_ = BIO_get_ktls_recv(SSL_get_rbio(ssl_)) != 0;
+	#endif
+
+	clear();
+	return true;
+}
+
+bool tls_socket::close_notify()
+{
+	if (!ssl_) {
+		clear(ENOTCONN);
+		return false;
+	}
+
+	int ret = SSL_shutdown(ssl_);
+	if (ret < 0) {
+		check_ssl(ret);
+		return false;
+	}
+	clear();
+	return true;
+}
+
+std::string tls_socket::version() const
+{
+	return ssl_ ? std::string(SSL_get_version(ssl_)) : std::string();
+}
+
+std::string tls_socket::cipher() const
+{
+	return ssl_ ? std::string(SSL_get_cipher_name(ssl_)) : std::string();
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t tls_socket::read(void *buf, size_t n)
+{
+	if (!ssl_) {
+		clear(ENOTCONN);
+		return -1;
+	}
+
+	size_t nr = 0;
+	int ret = SSL_read_ex(ssl_, buf, n, &nr);
+	if (ret <= 0)
+		return check_ssl(ret);
+
+	clear();
+	return ssize_t(nr);
+}
+
+ssize_t tls_socket::read_spin(void *buf, size_t n,
+							  const std::chrono::microseconds& spin)
+{
+	if (ssl_ && SSL_pending(ssl_) == 0)
+		spin_readable(spin);
+	return read(buf, n);
+}
+
+// With kernel TLS, the socket itself takes plaintext, so a write is just a
+// send. This is what makes MSG_MORE and sendfile() work.
+
+ssize_t tls_socket::write(const void *buf, size_t n)
+{
+	if (ktlsSend_)
+		return base::write(buf, n);
+
+	if (!ssl_) {
+		clear(ENOTCONN);
+		return -1;
+	}
+
+	size_t nw = 0;
+	int ret = SSL_write_ex(ssl_, buf, n, &nw);
+	if (ret <= 0) {
+		if (check_ssl(ret) == 0)
+			clear(EPIPE);
+		return -1;
+	}
+
+	clear();
+	return ssize_t(nw);
+}
+
+ssize_t tls_socket::write(const std::vector<iovec>& ranges)
+{
+	if (ktlsSend_)
+		return base::write(ranges);
+
+	ssize_t nw = 0;
+	for (const auto& r : ranges) {
+		ssize_t n = write_n(r.iov_base, r.iov_len);
+		if (n < 0)
+			return (nw == 0) ? n : nw;
+		nw += n;
+		if (size_t(n) < r.iov_len)
+			break;
+	}
+	return nw;
+}
+
+ssize_t tls_socket::write_more(const void *buf, size_t n)
+{
+	return ktlsSend_ ? base::write_more(buf, n) : write_n(buf, n);
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t tls_socket::sendfile(int fd, off_t offset, size_t n)
+{
+	size_t nw = 0;
+
+	#if defined(__linux__)
+		if (ktlsSend_) {
+			while (nw < n) {
+				ssize_t nx = ::sendfile(handle(), fd, &offset, n - nw);
+				if (nx < 0 && errno == EINTR)
+					continue;
+				if (nx < 0) {
+					clear(errno);
+					return (nw == 0) ? -1 : ssize_t(nw);
+				}
+				if (nx == 0)
+					break;
+				nw += size_t(nx);
+			}
+			clear();
+			return ssize_t(nw);
+		}
+	#endif
+
+	// A record's worth at a time
+	std::vector<char> buf(16*1024);
+
+	while (nw < n) {
+		ssize_t nr = ::pread(fd, buf.data(), std::min(buf.size(), n - nw), offset);
+		if (nr < 0 && errno == EINTR)
+			continue;
+		if (nr < 0) {
+			clear(errno);
+			return (nw == 0) ? -1 : ssize_t(nw);
+		}
+		if (nr == 0)
+			break;
+
+		ssize_t nx = write_n(buf.data(), size_t(nr));
+		if (nx < 0)
+			return (nw == 0) ? -1 : ssize_t(nw);
+
+		nw += size_t(nx);
+		offset += nx;
+		if (nx < nr)
+			break;
+	}
+	return ssize_t(nw);
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,433 @@
+// websocket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/websocket.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+	#include <sys/random.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+	#include <cstdlib>
+#else
+	#include <random>
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+//								ws_frame_header
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t ws_frame_header::MAX_SIZE;
+
+// --------------------------------------------------------------------------
+
+size_t ws_frame_header::size() const
+{
+	size_t n = 2;
+
+	if (payload_len > 0xFFFF)
+		n += 8;
+	else if (payload_len >= 126)
+		n += 2;
+
+	return masked ? (n + 4) : n;
+}
+
+size_t ws_frame_header::encode(void* buf) const
+{
+	uint8_t* p = static_cast<uint8_t*>(buf);
+	size_t n = 2;
+
+	p[0] = uint8_t((fin ? 0x80 : 0) | ((rsv & 0x07) << 4) | (uint8_t(opcode) & 0x0F));
+	p[1] = masked ? 0x80 : 0;
+
+	if (payload_len > 0xFFFF) {
+		p[1] |= 127;
+		for (int i=0; i<8; ++i)
+			p[n++] = uint8_t(payload_len >> (56 - 8*i));
+	}
+	else if (payload_len >= 126) {
+		p[1] |= 126;
+		p[n++] = uint8_t(payload_len >> 8);
+		p[n++] = uint8_t(payload_len);
+	}
+	else
+		p[1] |= uint8_t(payload_len);
+
+	if (masked) {
+		std::memcpy(p+n, mask_key, 4);
+		n += 4;
+	}
+	return n;
+}
+
+// --------------------------------------------------------------------------
+
+ssize_t ws_frame_header::parse(const void* buf, size_t n, ws_frame_header& hdr)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(buf);
+
+	if (n < 2)
+		return 0;
+
+	uint8_t len7 = p[1] & 0x7F;
+	size_t nlen = (len7 == 127) ? 8 : ((len7 == 126) ? 2 : 0);
+	bool masked = (p[1] & 0x80) != 0;
+	size_t nh = 2 + nlen + (masked ? 4 : 0);
+
+	if (n < nh)
+		return 0;
+
+	hdr.fin = (p[0] & 0x80) != 0;
+	hdr.rsv = (p[0] >> 4) & 0x07;
+	hdr.opcode = ws_opcode(p[0] & 0x0F);
+	hdr.masked = masked;
+
+	if (nlen == 0)
+		hdr.payload_len = len7;
+	else {
+		hdr.payload_len = 0;
+		for (size_t i=0; i<nlen; ++i)
+			hdr.payload_len = (hdr.payload_len << 8) | p[2+i];
+
+		// The most significant bit of a 64-bit length must be zero
+		if (nlen == 8 && (p[2] & 0x80) != 0)
+			return -1;
+	}
+
+	if (masked)
+		std::memcpy(hdr.mask_key, p+2+nlen, 4);
+	else
+		std::memset(hdr.mask_key, 0, 4);
+
+	return ssize_t(nh);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								websocket
+/////////////////////////////////////////////////////////////////////////////
+
+const uint16_t websocket::CLOSE_NORMAL;
+const uint16_t websocket::CLOSE_GOING_AWAY;
+const uint16_t websocket::CLOSE_PROTOCOL_ERROR;
+const uint16_t websocket::CLOSE_NO_STATUS;
+const uint16_t websocket::CLOSE_ABNORMAL;
+const uint16_t websocket::CLOSE_TOO_BIG;
+const size_t websocket::DFLT_MAX_MESSAGE;
+const size_t websocket::READ_BUF_SIZE;
+
+// Frames with payloads up to this size are copied in with their header
+// and sent with a single write.
+static const size_t SMALL_FRAME_SIZE = 4096;
+
+// --------------------------------------------------------------------------
+
+websocket::websocket(stream_socket& sock, role r,
+					 size_t maxMsgSize /*=DFLT_MAX_MESSAGE*/)
+		: sock_(sock), role_(r), maxMsg_(maxMsgSize), rbuf_(READ_BUF_SIZE),
+			rpos_(0), rend_(0), keyPos_(sizeof(keys_)),
+			closeSent_(false), closeRecvd_(false), closeCode_(0)
+{
+}
+
+// --------------------------------------------------------------------------
+// Masking keys must not be predictable (RFC 6455, 10.3), so they come from
+// the OS's secure random source. That's a system call, so the keys are
+// fetched a batch at a time. Elsewhere, std::random_device is the best
+// portable choice; on Windows it uses the system's secure source too.
+
+bool websocket::next_mask_key(uint8_t key[4])
+{
+	if (keyPos_ + 4 > sizeof(keys_)) {
+		#if defined(__linux__)
+			size_t n = 0;
+			while (n < sizeof(keys_)) {
+				ssize_t ret = ::getrandom(keys_+n, sizeof(keys_)-n, 0);
+				if (ret < 0) {
+					if (errno == EINTR)
+						continue;
+					return false;
+				}
+				n += size_t(ret);
+			}
+		#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+			::arc4random_buf(keys_, sizeof(keys_));
+		#else
+			std::random_device rd;
+			for (size_t i=0; i<sizeof(keys_); i+=4) {
+				uint32_t x = uint32_t(rd());
+				std::memcpy(keys_+i, &x, 4);
+			}
+		#endif
+		keyPos_ = 0;
+	}
+
+	std::memcpy(key, keys_+keyPos_, 4);
+	keyPos_ += 4;
+	return true;
+}
+
+// --------------------------------------------------------------------------
+
+bool websocket::fill()
+{
+	if (rpos_ == rend_)
+		rpos_ = rend_ = 0;
+	else if (rpos_ > 0) {
+		std::memmove(rbuf_.data(), rbuf_.data()+rpos_, rend_-rpos_);
+		rend_ -= rpos_;
+		rpos_ = 0;
+	}
+
+	ssize_t n;
+	do {
+		n = sock_.read(rbuf_.data()+rend_, rbuf_.size()-rend_);
+	}
+	while (n < 0 && sock_.last_error() == EINTR);
+
+	if (n <= 0)
+		return false;
+
+	rend_ += size_t(n);
+	return true;
+}
+
+// Anything already buffered is copied out first. After that, a large
+// remainder is read straight into place, while a small one goes through
+// the buffer so that it can pick up the frames that follow.
+
+bool websocket::read_payload(uint8_t* p, size_t n)
+{
+	while (n > 0) {
+		size_t navail = rend_ - rpos_;
+		if (navail > 0) {
+			size_t nx = std::min(navail, n);
+			std::memcpy(p, rbuf_.data()+rpos_, nx);
+			rpos_ += nx;
+			p += nx;
+			n -= nx;
+		}
+		else if (n >= rbuf_.size()/2) {
+			ssize_t nx = sock_.read(p, n);
+			if (nx < 0 && sock_.last_error() == EINTR)
+				continue;
+			if (nx <= 0)
+				return false;
+			p += nx;
+			n -= size_t(nx);
+		}
+		else if (!fill())
+			return false;
+	}
+	return true;
+}
+
+bool websocket::fail(uint16_t code)
+{
+	closeCode_ = code;
+	if (!closeSent_)
+		close(code);
+	return false;
+}
+
+// --------------------------------------------------------------------------
+
+bool websocket::send(ws_opcode op, const void* buf, size_t n, bool fin /*=true*/)
+{
+	ws_frame_header hdr(op, n);
+	hdr.fin = fin;
+
+	if (hdr.is_control() && (n > 125 || !fin))
+		return false;
+
+	std::lock_guard<std::mutex> lk(wrLock_);
+
+	if (role_ == CLIENT) {
+		hdr.masked = true;
+		if (!next_mask_key(hdr.mask_key))
+			return false;
+	}
+
+	uint8_t h[ws_frame_header::MAX_SIZE];
+	size_t nh = hdr.encode(h);
+
+	if (hdr.masked || n <= SMALL_FRAME_SIZE) {
+		sbuf_.resize(nh + n);
+		std::memcpy(sbuf_.data(), h, nh);
+		if (n > 0)
+			std::memcpy(sbuf_.data()+nh, buf, n);
+		if (hdr.masked)
+			ws_mask(sbuf_.data()+nh, n, hdr.mask_key);
+		return sock_.write_n(sbuf_.data(), nh+n) == ssize_t(nh+n);
+	}
+
+	return sock_.write_more(h, nh) == ssize_t(nh)
+		&& sock_.write_n(buf, n) == ssize_t(n);
+}
+
+// --------------------------------------------------------------------------
+
+bool websocket::close(uint16_t code /*=CLOSE_NORMAL*/,
+					  const std::string& reason /*=std::string()*/)
+{
+	uint8_t buf[125];
+	size_t n = 0;
+
+	if (code != CLOSE_NO_STATUS) {
+		buf[0] = uint8_t(code >> 8);
+		buf[1] = uint8_t(code);
+		n = 2 + std::min<size_t>(reason.size(), sizeof(buf) - 2);
+		std::memcpy(buf+2, reason.data(), n-2);
+	}
+
+	closeSent_ = true;
+	return send(ws_opcode::CLOSE, buf, n);
+}
+
+// --------------------------------------------------------------------------
+
+bool websocket::recv(ws_message& msg)
+{
+	auto dropped = [this] {
+		if (closeCode_ == 0)
+			closeCode_ = CLOSE_ABNORMAL;
+		return false;
+	};
+
+	bool inMsg = false;
+	msg.data.clear();
+
+	while (true) {
+		ws_frame_header hdr;
+		ssize_t nh;
+
+		while ((nh = ws_frame_header::parse(rbuf_.data()+rpos_, rend_-rpos_, hdr)) == 0) {
+			if (!fill())
+				return dropped();
+		}
+
+		if (nh < 0)
+			return fail(CLOSE_PROTOCOL_ERROR);
+
+		rpos_ += size_t(nh);
+
+		// Clients must mask their frames, and servers must not
+		if (hdr.rsv != 0 || hdr.masked != (role_ == SERVER))
+			return fail(CLOSE_PROTOCOL_ERROR);
+
+		if (hdr.is_control()) {
+			if (!hdr.fin || hdr.payload_len > 125)
+				return fail(CLOSE_PROTOCOL_ERROR);
+
+			uint8_t buf[125];
+			size_t n = size_t(hdr.payload_len);
+
+			if (!read_payload(buf, n))
+				return dropped();
+			if (hdr.masked)
+				ws_mask(buf, n, hdr.mask_key);
+
+			switch (hdr.opcode) {
+				case ws_opcode::PING:
+					if (!closeSent_ && !send(ws_opcode::PONG, buf, n))
+						return false;
+					continue;
+
+				case ws_opcode::PONG:
+					continue;
+
+				case ws_opcode::CLOSE:
+					if (n == 1)
+						return fail(CLOSE_PROTOCOL_ERROR);
+
+					closeRecvd_ = true;
+					closeCode_ = (n >= 2) ? uint16_t((buf[0] << 8) | buf[1])
+										  : CLOSE_NO_STATUS;
+					if (!closeSent_)
+						close(closeCode_);
+
+					msg.opcode = ws_opcode::CLOSE;
+					msg.data.assign(reinterpret_cast<char*>(buf) + std::min<size_t>(n, 2),
+									reinterpret_cast<char*>(buf) + n);
+					return true;
+
+				default:
+					return fail(CLOSE_PROTOCOL_ERROR);
+			}
+		}
+
+		switch (hdr.opcode) {
+			case ws_opcode::CONTINUATION:
+				if (!inMsg)
+					return fail(CLOSE_PROTOCOL_ERROR);
+				break;
+
+			case ws_opcode::TEXT:
+			case ws_opcode::BINARY:
+				if (inMsg)
+					return fail(CLOSE_PROTOCOL_ERROR);
+				inMsg = true;
+				msg.opcode = hdr.opcode;
+				break;
+
+			default:
+				return fail(CLOSE_PROTOCOL_ERROR);
+		}
+
+		if (hdr.payload_len > maxMsg_ - msg.data.size())
+			return fail(CLOSE_TOO_BIG);
+
+		size_t off = msg.data.size(),
+			   n = size_t(hdr.payload_len);
+
+		msg.data.resize(off + n);
+		uint8_t* p = reinterpret_cast<uint8_t*>(&msg.data[0]) + off;
+
+		if (!read_payload(p, n))
+			return dropped();
+		if (hdr.masked)
+			ws_mask(p, n, hdr.mask_key);
+
+		if (hdr.fin)
+			return true;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
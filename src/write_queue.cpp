@@ -0,0 +1,214 @@
+// write_queue.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/write_queue.h"
+
+namespace sockpp {
+
+#if !defined(WIN32)
+
+/////////////////////////////////////////////////////////////////////////////
+//								write_queue
+/////////////////////////////////////////////////////////////////////////////
+
+const size_t write_queue::DFLT_HI_WATER;
+const size_t write_queue::MAX_BATCH;
+
+// --------------------------------------------------------------------------
+
+write_queue::write_queue(stream_socket& sock, size_t hiWater /*=DFLT_HI_WATER*/)
+		: sock_(sock), head_(&stub_), tail_(&stub_), queued_(0),
+			hiWater_(hiWater), loWater_(hiWater/2), crossed_(false),
+			congested_(false),
+			offset_(0)
+{
+	iov_.reserve(MAX_BATCH);
+}
+
+write_queue::~write_queue()
+{
+	node* n;
+	while ((n = pop()) != nullptr)
+		delete n;
+
+	for (auto p : pending_)
+		delete p;
+}
+
+// --------------------------------------------------------------------------
+// This is the intrusive MPSC list from Dmitry Vyukov. A producer swaps
+// itself in as the new head with a single atomic exchange, then links the
+// previous head to it. The consumer may briefly see the list as broken
+// between those two steps, in which case it treats the queue as empty and
+// picks up the node on the next flush.
+
+void write_queue::push(node* n)
+{
+	n->next.store(nullptr, std::memory_order_relaxed);
+	node* prev = head_.exchange(n, std::memory_order_acq_rel);
+	prev->next.store(n, std::memory_order_release);
+}
+
+write_queue::node* write_queue::pop()
+{
+	node* tail = tail_;
+	node* next = tail->next.load(std::memory_order_acquire);
+
+	if (tail == &stub_) {
+		if (!next)
+			return nullptr;
+		tail_ = tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+
+	if (next) {
+		tail_ = next;
+		return tail;
+	}
+
+	// A producer is in the middle of a push.
+	if (tail != head_.load(std::memory_order_acquire))
+		return nullptr;
+
+	// Put the stub back so that the last real node can be released.
+	push(&stub_);
+
+	next = tail->next.load(std::memory_order_acquire);
+	if (next) {
+		tail_ = next;
+		return tail;
+	}
+	return nullptr;
+}
+
+// --------------------------------------------------------------------------
+
+size_t write_queue::push(std::string s)
+{
+	size_t n = s.size();
+	if (n == 0)
+		return size();
+
+	// Count the bytes before they become visible to the owner, so that
+	// the owner can never subtract them first. Likewise, the flag for a
+	// push over the high watermark is raised before the node is linked,
+	// so a flush that writes the node is sure to see it.
+	size_t sz = queued_.fetch_add(n, std::memory_order_relaxed) + n;
+	if (sz >= hiWater_)
+		crossed_.store(true, std::memory_order_relaxed);
+	push(new node(std::move(s)));
+	return sz;
+}
+
+// --------------------------------------------------------------------------
+// Gathers up to MAX_BATCH pending buffers into a single writev(), then
+// releases whatever was fully written. A partially-written buffer stays at
+// the front of the pending list with offset_ marking the unsent part.
+//
+// The congestion flag is only touched here, by the owner. A producer can
+// push over the high watermark while a flush is running, and that same
+// flush may then write its data out. So the producers' flag is checked
+// again at the end, before deciding whether to fire the callback, or the
+// producer would wait for a wakeup that never comes.
+
+ssize_t write_queue::flush()
+{
+	size_t	nw = 0;
+	ssize_t	nx = 0;
+
+	if (crossed_.exchange(false, std::memory_order_acquire) || size() >= hiWater_)
+		congested_ = true;
+
+	while (true) {
+		node* n;
+		while (pending_.size() < MAX_BATCH && (n = pop()) != nullptr)
+			pending_.push_back(n);
+
+		if (pending_.empty())
+			break;
+
+		iov_.clear();
+		size_t off = offset_;
+		for (auto p : pending_) {
+			iov_.push_back(iovec{ const_cast<char*>(p->data.data()) + off,
+								  p->data.size() - off });
+			off = 0;
+		}
+
+		if ((nx = sock_.write(iov_)) <= 0) {
+			int err = sock_.last_error();
+			if (nx < 0 && err == EINTR)
+				continue;
+			if (nx < 0 && (err == EAGAIN || err == EWOULDBLOCK))
+				nx = 0;
+			break;
+		}
+
+		nw += nx;
+		queued_.fetch_sub(size_t(nx), std::memory_order_relaxed);
+
+		size_t nleft = size_t(nx);
+		while (nleft > 0) {
+			node* p = pending_.front();
+			size_t rem = p->data.size() - offset_;
+			if (nleft < rem) {
+				offset_ += nleft;
+				break;
+			}
+			nleft -= rem;
+			offset_ = 0;
+			pending_.pop_front();
+			delete p;
+		}
+	}
+
+	if (crossed_.exchange(false, std::memory_order_acquire))
+		congested_ = true;
+
+	if (congested_ && size() <= loWater_) {
+		congested_ = false;
+		if (writableCb_)
+			writableCb_();
+	}
+
+	return (nw == 0 && nx < 0) ? nx : ssize_t(nw);
+}
+
+#endif	// !WIN32
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
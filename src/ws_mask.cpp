@@ -0,0 +1,225 @@
+// ws_mask.cpp
+//
+// WebSocket payload masking, with SIMD kernels chosen at run time.
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/websocket.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#define SOCKPP_X86_SIMD
+	#include <immintrin.h>
+#endif
+
+namespace sockpp {
+
+namespace {
+
+using mask_fn = void (*)(uint8_t*, size_t, uint32_t);
+
+// --------------------------------------------------------------------------
+// The kernels all take the key as a 32-bit word, already rotated to the
+// starting position, and loaded in memory order. Since every vector width
+// is a multiple of four bytes, the pattern stays in step through the
+// vector loops, and only the scalar tail has to work a byte at a time.
+
+void mask_scalar(uint8_t* p, size_t n, uint32_t k32)
+{
+	uint64_t k64 = (uint64_t(k32) << 32) | k32;
+
+	for (; n >= 8; p += 8, n -= 8) {
+		uint64_t w;
+		std::memcpy(&w, p, 8);
+		w ^= k64;
+		std::memcpy(p, &w, 8);
+	}
+
+	uint8_t kb[4];
+	std::memcpy(kb, &k32, 4);
+	for (size_t i=0; i<n; ++i)
+		p[i] ^= kb[i & 3];
+}
+
+#if defined(SOCKPP_X86_SIMD)
+
+__attribute__((target("sse2")))
+void mask_sse2(uint8_t* p, size_t n, uint32_t k32)
+{
+	const __m128i k = _mm_set1_epi32(int(k32));
+
+	for (; n >= 64; p += 64, n -= 64) {
+		__m128i* v = reinterpret_cast<__m128i*>(p);
+		__m128i a = _mm_loadu_si128(v);
+		__m128i b = _mm_loadu_si128(v+1);
+		__m128i c = _mm_loadu_si128(v+2);
+		__m128i d = _mm_loadu_si128(v+3);
+		_mm_storeu_si128(v,   _mm_xor_si128(a, k));
+		_mm_storeu_si128(v+1, _mm_xor_si128(b, k));
+		_mm_storeu_si128(v+2, _mm_xor_si128(c, k));
+		_mm_storeu_si128(v+3, _mm_xor_si128(d, k));
+	}
+	for (; n >= 16; p += 16, n -= 16) {
+		__m128i* v = reinterpret_cast<__m128i*>(p);
+		_mm_storeu_si128(v, _mm_xor_si128(_mm_loadu_si128(v), k));
+	}
+	mask_scalar(p, n, k32);
+}
+
+__attribute__((target("avx2")))
+void mask_avx2(uint8_t* p, size_t n, uint32_t k32)
+{
+	const __m256i k = _mm256_set1_epi32(int(k32));
+
+	for (; n >= 128; p += 128, n -= 128) {
+		__m256i* v = reinterpret_cast<__m256i*>(p);
+		__m256i a = _mm256_loadu_si256(v);
+		__m256i b = _mm256_loadu_si256(v+1);
+		__m256i c = _mm256_loadu_si256(v+2);
+		__m256i d = _mm256_loadu_si256(v+3);
+		_mm256_storeu_si256(v,   _mm256_xor_si256(a, k));
+		_mm256_storeu_si256(v+1, _mm256_xor_si256(b, k));
+		_mm256_storeu_si256(v+2, _mm256_xor_si256(c, k));
+		_mm256_storeu_si256(v+3, _mm256_xor_si256(d, k));
+	}
+	for (; n >= 32; p += 32, n -= 32) {
+		__m256i* v = reinterpret_cast<__m256i*>(p);
+		_mm256_storeu_si256(v, _mm256_xor_si256(_mm256_loadu_si256(v), k));
+	}
+	mask_scalar(p, n, k32);
+}
+
+__attribute__((target("avx512f")))
+void mask_avx512(uint8_t* p, size_t n, uint32_t k32)
+{
+	const __m512i k = _mm512_set1_epi32(int(k32));
+
+	for (; n >= 256; p += 256, n -= 256) {
+		__m512i a = _mm512_loadu_si512(p);
+		__m512i b = _mm512_loadu_si512(p+64);
+		__m512i c = _mm512_loadu_si512(p+128);
+		__m512i d = _mm512_loadu_si512(p+192);
+		_mm512_storeu_si512(p,     _mm512_xor_si512(a, k));
+		_mm512_storeu_si512(p+64,  _mm512_xor_si512(b, k));
+		_mm512_storeu_si512(p+128, _mm512_xor_si512(c, k));
+		_mm512_storeu_si512(p+192, _mm512_xor_si512(d, k));
+	}
+	for (; n >= 64; p += 64, n -= 64)
+		_mm512_storeu_si512(p, _mm512_xor_si512(_mm512_loadu_si512(p), k));
+
+	mask_scalar(p, n, k32);
+}
+
+#endif	// SOCKPP_X86_SIMD
+
+// --------------------------------------------------------------------------
+
+mask_fn mask_function(ws_mask_impl impl)
+{
+	if (!ws_mask_supported(impl))
+		return mask_scalar;
+
+	switch (impl) {
+		#if defined(SOCKPP_X86_SIMD)
+			case ws_mask_impl::SSE2:	return mask_sse2;
+			case ws_mask_impl::AVX2:	return mask_avx2;
+			case ws_mask_impl::AVX512:	return mask_avx512;
+		#endif
+		default:
+			return mask_scalar;
+	}
+}
+
+inline uint32_t rotated_key(const uint8_t key[4], size_t pos)
+{
+	uint8_t kb[4];
+	for (size_t i=0; i<4; ++i)
+		kb[i] = key[(pos + i) & 3];
+
+	uint32_t k32;
+	std::memcpy(&k32, kb, 4);
+	return k32;
+}
+
+}	// anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool ws_mask_supported(ws_mask_impl impl)
+{
+	#if defined(SOCKPP_X86_SIMD)
+		__builtin_cpu_init();
+		switch (impl) {
+			case ws_mask_impl::SCALAR:	return true;
+			case ws_mask_impl::SSE2:	return __builtin_cpu_supports("sse2") != 0;
+			case ws_mask_impl::AVX2:	return __builtin_cpu_supports("avx2") != 0;
+			case ws_mask_impl::AVX512:	return __builtin_cpu_supports("avx512f") != 0;
+		}
+		return false;
+	#else
+		return impl == ws_mask_impl::SCALAR;
+	#endif
+}
+
+ws_mask_impl ws_mask_best()
+{
+	static const ws_mask_impl best = [] {
+		for (auto impl : { ws_mask_impl::AVX512, ws_mask_impl::AVX2,
+						   ws_mask_impl::SSE2 }) {
+			if (ws_mask_supported(impl))
+				return impl;
+		}
+		return ws_mask_impl::SCALAR;
+	}();
+	return best;
+}
+
+// --------------------------------------------------------------------------
+
+void ws_mask(void* buf, size_t n, const uint8_t key[4], size_t pos /*=0*/)
+{
+	static const mask_fn fn = mask_function(ws_mask_best());
+	fn(static_cast<uint8_t*>(buf), n, rotated_key(key, pos));
+}
+
+void ws_mask(ws_mask_impl impl, void* buf, size_t n, const uint8_t key[4],
+			 size_t pos /*=0*/)
+{
+	mask_function(impl)(static_cast<uint8_t*>(buf), n, rotated_key(key, pos));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// End namespace sockpp
+}
@@ -0,0 +1,103 @@
+// test_acceptor.cpp
+//
+// Unit tests for the `acceptor` class and its TCP subclasses.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+
+TEST_CASE("acceptor default queue size", "[acceptor]") {
+    REQUIRE(acceptor::DFLT_QUE_SIZE == acceptor::AUTO_QUE_SIZE);
+    REQUIRE(acceptor::max_que_size() > 0);
+
+    #if defined(__linux__)
+        tcp_acceptor acc(inet_address("localhost", 0));
+        REQUIRE(acc);
+
+        listen_stats st;
+        REQUIRE(acc.queue_stats(st));
+        REQUIRE(unsigned(acceptor::max_que_size()) == st.max_pending);
+    #endif
+}
+
+TEST_CASE("acceptor explicit queue size", "[acceptor]") {
+    tcp_acceptor acc(inet_address("localhost", 0), 8);
+    REQUIRE(acc);
+
+    #if defined(__linux__)
+        listen_stats st;
+        REQUIRE(acc.queue_stats(st));
+        REQUIRE(8 == st.max_pending);
+        REQUIRE(0 == st.pending);
+
+        tcp_connector conn0(acc.address()), conn1(acc.address());
+        REQUIRE(conn0);
+        REQUIRE(conn1);
+
+        REQUIRE(acc.queue_stats(st));
+        REQUIRE(2 == st.pending);
+    #endif
+}
+
+#if defined(TCP_DEFER_ACCEPT)
+TEST_CASE("acceptor defer accept", "[acceptor]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+    REQUIRE(acc.defer_accept(std::chrono::seconds(5)));
+
+    // The connection isn't ready to accept until the client sends data
+    tcp_connector conn(acc.address());
+    REQUIRE(conn);
+
+    listen_stats st;
+    REQUIRE(acc.queue_stats(st));
+    REQUIRE(0 == st.pending);
+
+    REQUIRE(1 == conn.write("x", 1));
+
+    tcp_socket sock = acc.accept();
+    REQUIRE(sock);
+
+    char c;
+    REQUIRE(1 == sock.read(&c, 1));
+    REQUIRE('x' == c);
+}
+#endif
@@ -0,0 +1,195 @@
+// test_buffer_tuner.cpp
+//
+// Unit tests for the socket buffer auto-tuner.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/buffer_tuner.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+namespace {
+
+// A TCP connection over the loopback, with a thread that streams data one
+// way across it until stopped.
+struct stream_conn
+{
+    tcp_connector tx;
+    tcp_socket rx;
+    std::atomic<bool> quit { false };
+    std::thread wr, rd;
+
+    explicit stream_conn(tcp_acceptor& acc) : tx(acc.address()), rx(acc.accept()) {}
+
+    ~stream_conn() { stop(); }
+
+    void start() {
+        wr = std::thread([this] {
+            std::vector<char> buf(256*1024, 'x');
+            while (!quit && tx.write(buf.data(), buf.size()) > 0)
+                ;
+            tx.shutdown(SHUT_WR);
+        });
+        rd = std::thread([this] {
+            std::vector<char> buf(256*1024);
+            while (rx.read(buf.data(), buf.size()) > 0)
+                ;
+        });
+    }
+
+    void stop() {
+        quit = true;
+        if (wr.joinable()) wr.join();
+        if (rd.joinable()) rd.join();
+    }
+};
+
+}
+
+TEST_CASE("buffer_tuner add/remove", "[buffer_tuner]") {
+    const size_t MIN_BUF = 32*1024;
+
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+    stream_conn conn(acc);
+    REQUIRE(conn.tx);
+    REQUIRE(conn.rx);
+
+    buffer_tuner tuner(1024*1024, MIN_BUF);
+
+    {
+        buffer_tuner::guard g(tuner, conn.tx);
+        REQUIRE(g);
+        REQUIRE(tuner.size() == 1);
+
+        buffer_sizes sz;
+        REQUIRE(tuner.get_sizes(conn.tx, sz));
+        REQUIRE(sz.sndBuf == MIN_BUF);
+        REQUIRE(sz.rcvBuf == MIN_BUF);
+        REQUIRE(tuner.used() == 2*MIN_BUF);
+
+        REQUIRE(!tuner.get_sizes(conn.rx, sz));
+    }
+    REQUIRE(tuner.size() == 0);
+    REQUIRE(tuner.used() == 0);
+
+    stream_socket closed;
+    REQUIRE(!tuner.add(closed));
+}
+
+TEST_CASE("buffer_tuner grows busy connections", "[buffer_tuner]") {
+    const size_t MIN_BUF = 64*1024;
+
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+    stream_conn conn(acc);
+
+    buffer_tuner tuner(64*1024*1024, MIN_BUF);
+    REQUIRE(tuner.add(conn.tx));
+    REQUIRE(tuner.add(conn.rx));
+
+    // The receive side needs an RTT sample from the kernel, which can take
+    // a few rounds on a busy machine.
+    buffer_sizes txSz, rxSz;
+    conn.start();
+    for (int i=0; i<100; ++i) {
+        std::this_thread::sleep_for(milliseconds(20));
+        tuner.tune();
+
+        REQUIRE(tuner.get_sizes(conn.tx, txSz));
+        REQUIRE(tuner.get_sizes(conn.rx, rxSz));
+        if (i >= 10 && txSz.sndBuf > MIN_BUF && rxSz.rcvBuf > MIN_BUF)
+            break;
+    }
+
+    conn.stop();
+    tuner.remove(conn.tx);
+    tuner.remove(conn.rx);
+
+    // A bulk sender on a small buffer is limited by it, and the receiver
+    // sees its window fill up.
+    REQUIRE(txSz.sndBuf > MIN_BUF);
+    REQUIRE(rxSz.rcvBuf > MIN_BUF);
+}
+
+TEST_CASE("buffer_tuner stays within budget", "[buffer_tuner]") {
+    const size_t N = 4, MIN_BUF = 64*1024, BUDGET = 4*1024*1024;
+
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+
+    buffer_tuner tuner(BUDGET, MIN_BUF);
+    std::vector<std::unique_ptr<stream_conn>> conns;
+
+    for (size_t i=0; i<N; ++i) {
+        conns.emplace_back(new stream_conn(acc));
+        REQUIRE(tuner.add(conns.back()->tx));
+        REQUIRE(tuner.add(conns.back()->rx));
+        conns.back()->start();
+    }
+
+    size_t maxUsed = 0;
+    for (int i=0; i<10; ++i) {
+        std::this_thread::sleep_for(milliseconds(20));
+        tuner.tune();
+        maxUsed = std::max(maxUsed, tuner.used());
+    }
+
+    // Shrink the budget down to the minimums
+    tuner.set_budget(0);
+    tuner.tune();
+    size_t minUsed = tuner.used();
+
+    for (auto& c : conns) {
+        c->stop();
+        tuner.remove(c->tx);
+        tuner.remove(c->rx);
+    }
+
+    REQUIRE(maxUsed > 4*N*MIN_BUF);
+    REQUIRE(maxUsed <= BUDGET);
+    REQUIRE(minUsed == 4*N*MIN_BUF);
+}
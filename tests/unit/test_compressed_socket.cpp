@@ -0,0 +1,239 @@
+// test_compressed_socket.cpp
+//
+// Unit tests for the compressed stream socket.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/compressed_socket.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+
+static const compressed_socket::algorithm ALL_ALGS[] = {
+    compressed_socket::LZ4, compressed_socket::ZSTD
+};
+
+// Repetitive text, which should compress well
+static std::string make_text(size_t n) {
+    std::string s;
+    unsigned x = 1;
+    while (s.size() < n) {
+        x = x * 1103515245 + 12345;
+        s += "{\"id\":" + std::to_string(x % 10000) + ",\"status\":\"ok\"}\n";
+    }
+    s.resize(n);
+    return s;
+}
+
+TEST_CASE("compressed_socket messages", "[compressed]") {
+    for (auto alg : ALL_ALGS) {
+        if (!compressed_socket::supported(alg))
+            continue;
+
+        stream_socket sock0, sock1;
+        std::tie(sock0, sock1) = stream_socket::pair();
+        REQUIRE(sock0);
+
+        compressed_socket tx(std::move(sock0), alg), rx(std::move(sock1), alg);
+        REQUIRE(tx);
+        REQUIRE(rx);
+
+        // Each write is flushed, so it can be read back on its own
+        const std::string MSG { "Hello, compressed world" };
+        REQUIRE(ssize_t(MSG.size()) == tx.write(MSG));
+
+        char buf[64];
+        REQUIRE(ssize_t(MSG.size()) == rx.read_n(buf, MSG.size()));
+        REQUIRE(MSG == std::string(buf, MSG.size()));
+
+        // A message built in pieces
+        REQUIRE(6 == tx.write_more("piece ", 6));
+        REQUIRE(3 == tx.write("one", 3));
+        REQUIRE(9 == rx.read_n(buf, 9));
+        REQUIRE("piece one" == std::string(buf, 9));
+
+        std::string a { "gather" }, b { "ed" };
+        std::vector<iovec> iov { iovec{ &a[0], a.size() }, iovec{ &b[0], b.size() } };
+        REQUIRE(8 == tx.write(iov));
+        REQUIRE(8 == rx.read_n(buf, 8));
+        REQUIRE("gathered" == std::string(buf, 8));
+
+        REQUIRE(tx.raw_bytes_sent() == MSG.size() + 17);
+    }
+}
+
+TEST_CASE("compressed_socket read_spin", "[compressed]") {
+    for (auto alg : ALL_ALGS) {
+        if (!compressed_socket::supported(alg))
+            continue;
+
+        stream_socket sock0, sock1;
+        std::tie(sock0, sock1) = stream_socket::pair();
+        REQUIRE(sock0);
+
+        compressed_socket tx(std::move(sock0), alg), rx(std::move(sock1), alg);
+
+        // Through the base class, the spin must still decompress
+        stream_socket& srx = rx;
+        const std::chrono::microseconds SPIN { 100 };
+        const std::string MSG { "spin, spin, spin" };
+        REQUIRE(ssize_t(MSG.size()) == tx.write(MSG));
+
+        char buf[64];
+        size_t nr = 0;
+        while (nr < MSG.size()) {
+            ssize_t n = srx.read_spin(buf+nr, sizeof(buf)-nr, SPIN);
+            REQUIRE(n > 0);
+            nr += size_t(n);
+        }
+        REQUIRE(MSG == std::string(buf, nr));
+    }
+}
+
+TEST_CASE("compressed_socket bulk", "[compressed]") {
+    for (auto alg : ALL_ALGS) {
+        if (!compressed_socket::supported(alg))
+            continue;
+
+        stream_socket sock0, sock1;
+        std::tie(sock0, sock1) = stream_socket::pair();
+
+        compressed_socket tx(std::move(sock0), alg), rx(std::move(sock1), alg);
+
+        // Enough to change levels a few times
+        const std::string TEXT = make_text(4*compressed_socket::ADAPT_INTERVAL);
+
+        // Force the level up at every chance
+        tx.set_level_range(1, 3);
+        tx.set_backlog_thresholds(0, 0);
+        REQUIRE(1 == tx.level());
+
+        std::thread thr([&] {
+            for (size_t i=0; i<TEXT.size(); i+=10000)
+                tx.write(TEXT.data()+i, std::min<size_t>(10000, TEXT.size()-i));
+            tx.finish();
+            tx.shutdown(SHUT_WR);
+        });
+
+        std::string recv(TEXT.size(), '\0');
+        ssize_t n = rx.read_n(&recv[0], recv.size());
+        thr.join();
+
+        REQUIRE(ssize_t(TEXT.size()) == n);
+        REQUIRE(TEXT == recv);
+
+        char c;
+        REQUIRE(0 == rx.read(&c, 1));
+
+        REQUIRE(3 == tx.level());
+        REQUIRE(tx.raw_bytes_sent() == TEXT.size());
+        REQUIRE(tx.wire_bytes_sent() < TEXT.size() / 2);
+    }
+}
+
+// The end of a frame arrives after its data was read, along with the next
+// frame, in a single read. Decoding the end of the first frame gives no
+// output, and the second frame has to be decoded from the same buffer.
+
+TEST_CASE("compressed_socket frames in one read", "[compressed]") {
+    for (auto alg : ALL_ALGS) {
+        if (!compressed_socket::supported(alg))
+            continue;
+
+        // The compressed stream is relayed from one pair to the other, to
+        // control how it's split up on the way.
+        stream_socket sock0, sock1, sock2, sock3;
+        std::tie(sock0, sock1) = stream_socket::pair();
+        std::tie(sock2, sock3) = stream_socket::pair();
+
+        compressed_socket tx(std::move(sock0), alg), rx(std::move(sock3), alg);
+        std::string wire(64*1024, '\0');
+
+        const std::string MSG1 = make_text(1000), MSG2 { "the second frame" };
+        REQUIRE(ssize_t(MSG1.size()) == tx.write(MSG1));
+
+        ssize_t nw = sock1.read(&wire[0], wire.size());
+        REQUIRE(nw > 0);
+        REQUIRE(nw == sock2.write_n(wire.data(), size_t(nw)));
+
+        std::string buf(MSG1.size(), '\0');
+        REQUIRE(ssize_t(MSG1.size()) == rx.read_n(&buf[0], buf.size()));
+        REQUIRE(MSG1 == buf);
+
+        REQUIRE(tx.finish());
+        REQUIRE(ssize_t(MSG2.size()) == tx.write(MSG2));
+        tx.shutdown(SHUT_WR);
+
+        nw = sock1.read_n(&wire[0], wire.size());
+        REQUIRE(nw > 0);
+        REQUIRE(nw == sock2.write_n(wire.data(), size_t(nw)));
+
+        // It's all there, so a read that goes back to the socket fails
+        REQUIRE(rx.set_non_blocking());
+
+        char buf2[64];
+        size_t nr = 0;
+        while (nr < MSG2.size()) {
+            ssize_t n = rx.read(buf2+nr, sizeof(buf2)-nr);
+            REQUIRE(n > 0);
+            nr += size_t(n);
+        }
+        REQUIRE(MSG2 == std::string(buf2, nr));
+    }
+}
+
+TEST_CASE("compressed_socket corrupt stream", "[compressed]") {
+    for (auto alg : ALL_ALGS) {
+        if (!compressed_socket::supported(alg))
+            continue;
+
+        stream_socket sock0, sock1;
+        std::tie(sock0, sock1) = stream_socket::pair();
+
+        compressed_socket rx(std::move(sock1), alg);
+
+        std::string junk(256, '\xA5');
+        REQUIRE(256 == sock0.write(junk));
+
+        char buf[256];
+        REQUIRE(-1 == rx.read(buf, sizeof(buf)));
+        REQUIRE(EPROTO == rx.last_error());
+    }
+}
@@ -0,0 +1,136 @@
+// test_connection_tracker.cpp
+//
+// Unit tests for the `connection_tracker` class and connection shutdown.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/connection_tracker.h"
+#include "sockpp/tcp_acceptor.h"
+#include <atomic>
+#include <thread>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("stream_socket half close", "[socket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    REQUIRE(sock0.shutdown(SHUT_WR));
+
+    char buf[8];
+    REQUIRE(0 == sock1.read(buf, sizeof(buf)));
+
+    // The other direction still works
+    REQUIRE(4 == sock1.write("done", 4));
+    REQUIRE(4 == sock0.read_n(buf, 4));
+
+    REQUIRE(sock1.linger(true));
+    REQUIRE(sock1.linger(false, seconds(5)));
+}
+
+TEST_CASE("connection_tracker drain", "[connection_tracker]") {
+    connection_tracker tracker;
+    stream_socket srv[3], cli[3];
+    for (int i=0; i<3; ++i)
+        std::tie(srv[i], cli[i]) = stream_socket::pair();
+
+    std::atomic<int> nready(0);
+    std::atomic<int> nfail(0);
+
+    // Handlers that quit as soon as they see EOF
+    auto handler = [&](stream_socket& sock, milliseconds lag) {
+        connection_tracker::guard g(tracker, sock);
+        if (!g) {
+            ++nfail;
+            return;
+        }
+        ++nready;
+        char buf[8];
+        while (sock.read(buf, sizeof(buf)) > 0)
+            ;
+        std::this_thread::sleep_for(lag);
+    };
+
+    std::thread thr0(handler, std::ref(srv[0]), milliseconds(0));
+    std::thread thr1(handler, std::ref(srv[1]), milliseconds(0));
+    // This one hangs on past the deadline
+    std::thread thr2(handler, std::ref(srv[2]), milliseconds(500));
+
+    while (nready < 3)
+        std::this_thread::yield();
+
+    REQUIRE(3 == tracker.size());
+    REQUIRE(!tracker.draining());
+
+    auto st = tracker.drain(milliseconds(100));
+
+    thr0.join();
+    thr1.join();
+    thr2.join();
+
+    REQUIRE(0 == nfail);
+    REQUIRE(2 == st.drained);
+    REQUIRE(1 == st.forced);
+    REQUIRE(tracker.draining());
+    REQUIRE(0 == tracker.size());
+
+    // No new connections once draining
+    REQUIRE(!tracker.add(srv[0]));
+}
+
+TEST_CASE("connection_tracker stops acceptor", "[connection_tracker]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+
+    connection_tracker tracker;
+    std::atomic<bool> accepted(false);
+
+    std::thread thr([&] {
+        tcp_socket sock = acc.accept();
+        accepted = bool(sock);
+    });
+
+    std::this_thread::sleep_for(milliseconds(50));
+    auto st = tracker.drain(acc, milliseconds(10));
+    thr.join();
+
+    REQUIRE(!accepted);
+    REQUIRE(0 == st.drained);
+    REQUIRE(0 == st.forced);
+}
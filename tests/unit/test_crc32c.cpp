@@ -0,0 +1,210 @@
+// test_crc32c.cpp
+//
+// Unit tests for the CRC32C checksums and the checksummed framer.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/crc32c.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+
+static const crc32c_impl ALL_IMPLS[] = {
+    crc32c_impl::TABLE, crc32c_impl::SSE42, crc32c_impl::PCLMUL
+};
+
+// Check values from RFC 3720 (iSCSI), B.4
+
+TEST_CASE("crc32c known values", "[crc32c]") {
+    uint8_t buf[32];
+
+    for (auto impl : ALL_IMPLS) {
+        REQUIRE(0xE3069283 == crc32c(impl, "123456789", 9));
+
+        std::fill(buf, buf+32, 0);
+        REQUIRE(0x8A9136AA == crc32c(impl, buf, 32));
+
+        std::fill(buf, buf+32, 0xFF);
+        REQUIRE(0x62A8AB43 == crc32c(impl, buf, 32));
+
+        for (int i=0; i<32; ++i)
+            buf[i] = uint8_t(i);
+        REQUIRE(0x46DD794E == crc32c(impl, buf, 32));
+
+        REQUIRE(0 == crc32c(impl, buf, 0));
+    }
+
+    REQUIRE(0xE3069283 == crc32c("123456789", 9));
+    REQUIRE(crc32c_supported(crc32c_impl::TABLE));
+    REQUIRE(crc32c_supported(crc32c_best()));
+}
+
+TEST_CASE("crc32c implementations agree", "[crc32c]") {
+    const size_t N = 100*1024;
+    std::vector<uint8_t> data(N);
+
+    uint32_t x = 12345;
+    for (auto& b : data) {
+        x = x * 1103515245 + 12345;
+        b = uint8_t(x >> 16);
+    }
+
+    const size_t lens[] = {
+        1, 7, 8, 9, 63, 255, 767, 768, 769, 1000, 12287, 12288, 12289,
+        40000, N-1
+    };
+
+    for (size_t len : lens) {
+        // Start from an odd address to catch alignment assumptions
+        const uint8_t* p = data.data() + 1;
+        uint32_t expected = crc32c(crc32c_impl::TABLE, p, len);
+
+        for (auto impl : ALL_IMPLS) {
+            REQUIRE(expected == crc32c(impl, p, len));
+
+            // Computed in two pieces
+            size_t half = len / 3;
+            uint32_t crc = crc32c(impl, p, half);
+            REQUIRE(expected == crc32c(impl, p+half, len-half, crc));
+        }
+    }
+}
+
+TEST_CASE("crc_framer roundtrip", "[crc32c]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+    REQUIRE(sock1);
+
+    crc_framer tx(sock0), rx(sock1);
+
+    const std::string MSG { "This is a test of the checksummed framer" };
+    REQUIRE(ssize_t(MSG.size()) == tx.write_frame(MSG.data(), MSG.size()));
+
+    std::string a { "hello" }, b { ", " }, c { "world" };
+    std::vector<iovec> iov {
+        iovec{ &a[0], a.size() }, iovec{ &b[0], b.size() }, iovec{ &c[0], c.size() }
+    };
+    REQUIRE(12 == tx.write_frame(iov));
+
+    std::string big(200*1024, 'x');
+    for (size_t i=0; i<big.size(); i+=97)
+        big[i] = char(i);
+
+    // The big frame would fill the socket buffers, so read it concurrently
+    std::thread thr([&] { tx.write_frame(big.data(), big.size()); sock0.shutdown(SHUT_WR); });
+
+    char buf[128];
+    REQUIRE(ssize_t(MSG.size()) == rx.read_frame(buf, sizeof(buf)));
+    REQUIRE(MSG == std::string(buf, MSG.size()));
+
+    std::string s;
+    REQUIRE(12 == rx.read_frame(s));
+    REQUIRE("hello, world" == s);
+
+    REQUIRE(ssize_t(big.size()) == rx.read_frame(s));
+    REQUIRE(big == s);
+
+    thr.join();
+
+    // Clean close between frames
+    REQUIRE(0 == rx.read_frame(s));
+    REQUIRE(s.empty());
+    REQUIRE(0 == sock1.last_error());
+}
+
+TEST_CASE("crc_framer errors", "[crc32c]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    crc_framer rx(sock1, 1024);
+
+    SECTION("corrupted payload") {
+        crc_framer tx(sock0);
+        const std::string MSG { "some data to corrupt" };
+
+        // Send a good frame through a scratch pair to capture its bytes
+        stream_socket s0, s1;
+        std::tie(s0, s1) = stream_socket::pair();
+        crc_framer(s0).write_frame(MSG.data(), MSG.size());
+
+        size_t n = crc_framer::HEADER_SIZE + MSG.size();
+        std::string raw(n, '\0');
+        REQUIRE(ssize_t(n) == s1.read_n(&raw[0], n));
+
+        raw[n-3] ^= 0x10;
+        REQUIRE(ssize_t(n) == sock0.write(raw));
+
+        std::string s;
+        REQUIRE(-1 == rx.read_frame(s));
+        REQUIRE(EBADMSG == sock1.last_error());
+    }
+
+    SECTION("oversized frame") {
+        crc_framer tx(sock0);
+        std::string big(2048, 'x');
+        REQUIRE(2048 == tx.write_frame(big.data(), big.size()));
+
+        std::string s;
+        REQUIRE(-1 == rx.read_frame(s));
+        REQUIRE(EMSGSIZE == sock1.last_error());
+    }
+
+    SECTION("frame larger than the buffer") {
+        crc_framer tx(sock0);
+        REQUIRE(10 == tx.write_frame("0123456789", 10));
+
+        char buf[8];
+        REQUIRE(-1 == rx.read_frame(buf, sizeof(buf)));
+        REQUIRE(EMSGSIZE == sock1.last_error());
+    }
+
+    SECTION("truncated frame") {
+        crc_framer tx(sock0);
+        std::string raw("\0\0\0\x10\0\0\0\0abc", 11);
+        REQUIRE(11 == sock0.write(raw));
+        sock0.close();
+
+        std::string s;
+        REQUIRE(-1 == rx.read_frame(s));
+        REQUIRE(ECONNRESET == sock1.last_error());
+    }
+}
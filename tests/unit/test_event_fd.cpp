@@ -0,0 +1,109 @@
+// test_event_fd.cpp
+//
+// Unit tests for the `event_fd` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/event_fd.h"
+#include <thread>
+
+using namespace sockpp;
+
+TEST_CASE("event_fd counts notifications", "[event_fd]") {
+    event_fd evt(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    REQUIRE(evt);
+    REQUIRE(evt.is_open());
+
+    uint64_t val = 0;
+
+    SECTION("empty") {
+        REQUIRE(!evt.read(val));
+        REQUIRE(EAGAIN == evt.last_error());
+        REQUIRE(0 == evt.try_read());
+    }
+
+    SECTION("coalesced") {
+        for (int i=0; i<10; ++i)
+            REQUIRE(evt.notify());
+        REQUIRE(evt.notify(5));
+
+        // All of them come out in one read
+        REQUIRE(evt.read(val));
+        REQUIRE(15 == val);
+        REQUIRE(0 == evt.try_read());
+    }
+
+    SECTION("move") {
+        REQUIRE(evt.notify(3));
+        socket_t h = evt.handle();
+
+        event_fd evt2(std::move(evt));
+        REQUIRE(!evt);
+        REQUIRE(h == evt2.handle());
+        REQUIRE(3 == evt2.try_read());
+    }
+}
+
+TEST_CASE("event_fd semaphore", "[event_fd]") {
+    event_fd evt(2, EFD_SEMAPHORE | EFD_NONBLOCK);
+    REQUIRE(evt);
+
+    uint64_t val = 0;
+    REQUIRE(evt.read(val));
+    REQUIRE(1 == val);
+    REQUIRE(evt.read(val));
+    REQUIRE(1 == val);
+    REQUIRE(!evt.read(val));
+}
+
+TEST_CASE("event_fd wakes a blocked reader", "[event_fd]") {
+    event_fd evt;
+    REQUIRE(evt);
+
+    std::thread thr([&evt] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        evt.notify(7);
+    });
+
+    uint64_t val = 0;
+    bool ok = evt.read(val);
+    thr.join();
+
+    REQUIRE(ok);
+    REQUIRE(7 == val);
+}
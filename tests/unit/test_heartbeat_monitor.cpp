@@ -0,0 +1,271 @@
+// test_heartbeat_monitor.cpp
+//
+// Unit tests for dead-peer detection: the keepalive and user timeout
+// options, and the heartbeat monitor.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/heartbeat_monitor.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include <atomic>
+#include <thread>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// Pings must not block, so they don't wait for room in the send buffer
+static heartbeat_monitor::ping_func pinger(const sockpp::socket& sock)
+{
+    return [&sock] {
+        return ::send(sock.handle(), "P", 1, MSG_DONTWAIT | MSG_NOSIGNAL) == 1;
+    };
+}
+
+static int get_int(sockpp::socket& sock, int level, int opt)
+{
+    int val = -1;
+    socklen_t len = sizeof(int);
+    sock.get_option(level, opt, &val, &len);
+    return val;
+}
+
+TEST_CASE("keepalive profiles", "[heartbeat]") {
+    auto prof = keepalive_profile::fast();
+    REQUIRE(prof.timeout() == seconds(25));
+    REQUIRE(keepalive_profile::standard().timeout() == seconds(110));
+
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+
+    #if defined(__linux__)
+    SECTION("on a connection") {
+        tcp_connector conn(acc.address());
+        REQUIRE(conn);
+
+        REQUIRE(get_int(conn, SOL_SOCKET, SO_KEEPALIVE) == 0);
+        REQUIRE(conn.detect_dead_peer(prof));
+
+        REQUIRE(get_int(conn, SOL_SOCKET, SO_KEEPALIVE) == 1);
+        REQUIRE(get_int(conn, IPPROTO_TCP, TCP_KEEPIDLE) == 10);
+        REQUIRE(get_int(conn, IPPROTO_TCP, TCP_KEEPINTVL) == 5);
+        REQUIRE(get_int(conn, IPPROTO_TCP, TCP_KEEPCNT) == 3);
+        REQUIRE(get_int(conn, IPPROTO_TCP, TCP_USER_TIMEOUT) == 25000);
+
+        REQUIRE(conn.keepalive(false));
+        REQUIRE(get_int(conn, SOL_SOCKET, SO_KEEPALIVE) == 0);
+    }
+
+    SECTION("inherited from the acceptor") {
+        REQUIRE(acc.detect_dead_peer(prof));
+
+        tcp_connector conn(acc.address());
+        REQUIRE(conn);
+        tcp_socket sock = acc.accept();
+        REQUIRE(sock);
+
+        REQUIRE(get_int(sock, SOL_SOCKET, SO_KEEPALIVE) == 1);
+        REQUIRE(get_int(sock, IPPROTO_TCP, TCP_KEEPIDLE) == 10);
+        REQUIRE(get_int(sock, IPPROTO_TCP, TCP_USER_TIMEOUT) == 25000);
+    }
+    #endif
+}
+
+TEST_CASE("heartbeat_monitor reaps silent peers", "[heartbeat]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+
+    // A live client that answers pings, and a dead one that doesn't
+    tcp_connector live(acc.address()), dead(acc.address());
+    REQUIRE(live);
+    REQUIRE(dead);
+    tcp_socket liveSrv = acc.accept(), deadSrv = acc.accept();
+    REQUIRE(liveSrv);
+    REQUIRE(deadSrv);
+
+    heartbeat_monitor mon(milliseconds(20), 3);
+
+    REQUIRE(mon.add(liveSrv, pinger(liveSrv)));
+    REQUIRE(mon.add(deadSrv, pinger(deadSrv)));
+    REQUIRE(mon.size() == 2);
+
+    // The server handlers, which end when their connections do
+    std::atomic<bool> liveDone { false }, deadDone { false };
+    auto handler = [&mon](tcp_socket& sock, std::atomic<bool>& done) {
+        char buf[16];
+        while (sock.read(buf, sizeof(buf)) > 0)
+            mon.received(sock);
+        done = true;
+    };
+    std::thread liveThr(handler, std::ref(liveSrv), std::ref(liveDone)),
+                deadThr(handler, std::ref(deadSrv), std::ref(deadDone));
+
+    std::thread client([&] {
+        char buf[16];
+        ssize_t n;
+        while ((n = live.read(buf, sizeof(buf))) > 0)
+            live.write(std::string(size_t(n), 'p'));
+    });
+
+    size_t nreaped = 0;
+    for (int i=0; i<40 && !deadDone; ++i) {
+        std::this_thread::sleep_for(milliseconds(5));
+        nreaped += mon.tick();
+    }
+    deadThr.join();
+
+    bool liveAlive = !liveDone;
+    auto st = mon.stats();
+
+    // Ending it from the server side, with the pings stopped, means the
+    // client can't be caught writing to a closed connection.
+    liveSrv.shutdown();
+    liveThr.join();
+    client.join();
+
+    mon.remove(liveSrv);
+    mon.remove(deadSrv, ETIMEDOUT);     // Already counted
+
+    REQUIRE(nreaped == 1);
+    REQUIRE(st.heartbeat == 1);
+    REQUIRE(st.kernel == 0);
+    REQUIRE(liveAlive);
+    REQUIRE(mon.size() == 0);
+    REQUIRE(mon.stats().total() == 1);
+}
+
+TEST_CASE("heartbeat_monitor counts kernel timeouts", "[heartbeat]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+    tcp_connector conn(acc.address());
+    REQUIRE(conn);
+
+    heartbeat_monitor mon(seconds(1));
+    {
+        heartbeat_monitor::guard g(mon, conn, nullptr);
+        REQUIRE(g);
+        REQUIRE(mon.size() == 1);
+        g.set_error(ETIMEDOUT);
+    }
+    REQUIRE(mon.size() == 0);
+    REQUIRE(mon.stats().kernel == 1);
+
+    {
+        heartbeat_monitor::guard g(mon, conn, nullptr);
+        g.set_error(ECONNRESET);
+    }
+    REQUIRE(mon.stats().total() == 1);
+
+    // A connection that keeps talking isn't pinged or reaped
+    mon.add(conn, [] { FAIL_CHECK("pinged"); return true; });
+    mon.received(conn);
+    REQUIRE(mon.tick() == 0);
+}
+
+TEST_CASE("heartbeat_monitor remove waits for a ping", "[heartbeat]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    heartbeat_monitor mon(milliseconds(1), 1000);
+
+    // A slow ping, on the first connection to be pinged, and a quick one
+    std::atomic<bool> inPing { false }, release { false }, pingDone { false };
+    mon.add(sock0, [&] {
+        inPing = true;
+        while (!release)
+            std::this_thread::sleep_for(milliseconds(1));
+        pingDone = true;
+        return true;
+    });
+    mon.add(sock1, pinger(sock1));
+    REQUIRE(sock0.handle() < sock1.handle());
+    std::this_thread::sleep_for(milliseconds(2));
+
+    std::thread ticker([&] { mon.tick(); });
+    while (!inPing)
+        std::this_thread::sleep_for(milliseconds(1));
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(milliseconds(100));
+        release = true;
+    });
+
+    // Removing the other connection doesn't wait for this ping
+    mon.remove(sock1);
+    bool releasedOnRemove1 = release;
+
+    // Once removed, the state the ping uses can go away
+    mon.remove(sock0);
+    bool doneOnRemove0 = pingDone;
+
+    ticker.join();
+    releaser.join();
+    REQUIRE(!releasedOnRemove1);
+    REQUIRE(doneOnRemove0);
+    REQUIRE(mon.size() == 0);
+
+    // A ping can remove its own connection without waiting on itself
+    mon.add(sock1, [&] { mon.remove(sock1); return true; });
+    std::this_thread::sleep_for(milliseconds(2));
+    REQUIRE(mon.tick() == 0);
+    REQUIRE(mon.size() == 0);
+}
+
+TEST_CASE("heartbeat_monitor counts failed pings", "[heartbeat]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    // Pinged once an interval goes by. A failed ping counts as a missed
+    // interval, so it's reaped after two, before it would be pinged again.
+    heartbeat_monitor mon(milliseconds(50), 3);
+
+    int npings = 0;
+    mon.add(sock0, [&] { ++npings; return false; });
+
+    size_t nreaped = 0;
+    for (int i=0; i<100 && nreaped == 0; ++i) {
+        std::this_thread::sleep_for(milliseconds(5));
+        nreaped += mon.tick();
+    }
+
+    REQUIRE(nreaped == 1);
+    REQUIRE(npings == 1);
+    mon.remove(sock0);
+}
@@ -0,0 +1,224 @@
+// test_http_server.cpp
+//
+// Unit tests for the HTTP server engine.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/http_server.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include <string>
+#include <thread>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("http_parser request", "[http]") {
+    const std::string s =
+        "POST /submit?x=1 HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "content-length:  5 \r\n"
+        "X-Empty:\r\n"
+        "\r\n"
+        "helloGET / HTTP/1.0\r\n\r\n";
+
+    http_parser parser;
+    http_request req;
+
+    // Fed a byte at a time, it's incomplete until the body is all there
+    size_t n1 = s.find("GET");
+    for (size_t i=0; i<n1; ++i)
+        REQUIRE(0 == parser.parse(s.data(), i, req));
+
+    REQUIRE(ssize_t(n1) == parser.parse(s.data(), s.size(), req));
+    REQUIRE(req.method == "POST");
+    REQUIRE(req.target == "/submit?x=1");
+    REQUIRE(1 == req.minor_version);
+    REQUIRE(req.keep_alive);
+    REQUIRE(3 == req.headers.size());
+    REQUIRE(req.header("Host") == "localhost");
+    REQUIRE(req.header("Content-Length") == "5");
+    REQUIRE(req.header("x-empty").empty());
+    REQUIRE(req.header("Missing").data == nullptr);
+    REQUIRE(req.body == "hello");
+
+    // The pipelined request that follows
+    REQUIRE(ssize_t(s.size() - n1) == parser.parse(s.data()+n1, s.size()-n1, req));
+    REQUIRE(req.method == "GET");
+    REQUIRE(0 == req.minor_version);
+    REQUIRE(!req.keep_alive);
+    REQUIRE(req.body.empty());
+}
+
+TEST_CASE("http_parser head scan", "[http]") {
+    // Put the end of the head at every offset, to cover the vector loops
+    // and their tails.
+    for (size_t pad=0; pad<100; ++pad) {
+        std::string s = "GET / HTTP/1.1\r\nX: " + std::string(pad, 'a') + "\r\n\r\n";
+        http_parser parser;
+        http_request req;
+        REQUIRE(0 == parser.parse(s.data(), s.size()-1, req));
+        REQUIRE(ssize_t(s.size()) == parser.parse(s.data(), s.size(), req));
+        REQUIRE(pad == req.header("x").size);
+    }
+}
+
+TEST_CASE("http_parser errors", "[http]") {
+    const char* bad[] = {
+        "GET / HTTP/2.0\r\n\r\n",
+        "GET /\r\n\r\n",
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\nName : value\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n",
+        "POST / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n",
+    };
+
+    for (auto s : bad) {
+        http_parser parser;
+        http_request req;
+        REQUIRE(-1 == parser.parse(s, strlen(s), req));
+    }
+
+    const char* s = "GET / HTTP/1.1\r\nConnection: Close\r\n\r\n";
+    http_parser parser;
+    http_request req;
+    REQUIRE(0 < parser.parse(s, strlen(s), req));
+    REQUIRE(!req.keep_alive);
+}
+
+TEST_CASE("http_server pipelined", "[http]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    http_server srv([](const http_request& req, http_response& rsp) {
+        if (req.target == "/missing")
+            rsp.set_status(404);
+        rsp.add_header("Content-Type", "text/plain");
+        rsp.set_body(req.target.str());
+    });
+
+    size_t nserved = 0;
+    std::thread thr([&] {
+        nserved = srv.serve(sock1);
+        sock1.close();
+    });
+
+    const std::string reqs =
+        "GET /a HTTP/1.1\r\n\r\n"
+        "GET /missing HTTP/1.1\r\n\r\n"
+        "GET /b HTTP/1.1\r\nConnection: close\r\n\r\n";
+    REQUIRE(ssize_t(reqs.size()) == sock0.write(reqs));
+
+    std::string rsp;
+    char buf[512];
+    ssize_t n;
+    while ((n = sock0.read(buf, sizeof(buf))) > 0)
+        rsp.append(buf, size_t(n));
+
+    thr.join();
+
+    REQUIRE(3 == nserved);
+    REQUIRE(rsp ==
+        "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n\r\n/a"
+        "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 8\r\n\r\n/missing"
+        "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\nConnection: close\r\n\r\n/b");
+}
+
+TEST_CASE("http_server HEAD", "[http]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    http_server srv([](const http_request& req, http_response& rsp) {
+        rsp.set_body(req.target.str());
+    });
+
+    std::thread thr([&] {
+        srv.serve(sock1);
+        sock1.close();
+    });
+
+    // The HEAD response has no body, so the GET response follows right on
+    const std::string reqs =
+        "HEAD /head HTTP/1.1\r\n\r\n"
+        "GET /get HTTP/1.1\r\nConnection: close\r\n\r\n";
+    REQUIRE(ssize_t(reqs.size()) == sock0.write(reqs));
+
+    std::string rsp;
+    char buf[512];
+    ssize_t n;
+    while ((n = sock0.read(buf, sizeof(buf))) > 0)
+        rsp.append(buf, size_t(n));
+
+    thr.join();
+
+    REQUIRE(rsp ==
+        "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n"
+        "HTTP/1.1 200 OK\r\nContent-Length: 4\r\nConnection: close\r\n\r\n/get");
+}
+
+TEST_CASE("http_server run and shutdown", "[http]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+
+    http_server srv([](const http_request&, http_response& rsp) {
+        rsp.set_body("ok");
+    });
+
+    std::thread thr([&] { srv.run(acc); });
+
+    tcp_connector conn(acc.address());
+    REQUIRE(conn);
+
+    const std::string req = "GET / HTTP/1.1\r\n\r\n";
+    REQUIRE(ssize_t(req.size()) == conn.write(req));
+
+    const std::string expected = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+    std::string rsp(expected.size(), '\0');
+    REQUIRE(ssize_t(rsp.size()) == conn.read_n(&rsp[0], rsp.size()));
+    REQUIRE(expected == rsp);
+
+    // The idle keep-alive connection is drained cleanly
+    auto st = srv.shutdown(seconds(2));
+    thr.join();
+
+    REQUIRE(1 == st.drained);
+    REQUIRE(0 == st.forced);
+
+    char c;
+    REQUIRE(0 == conn.read(&c, 1));
+}
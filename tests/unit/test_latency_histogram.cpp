@@ -0,0 +1,200 @@
+// test_latency_histogram.cpp
+//
+// Unit tests for the latency histogram and recorder.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/latency_histogram.h"
+#include <sstream>
+#include <thread>
+
+using namespace sockpp;
+
+TEST_CASE("latency_histogram buckets", "[latency_histogram]") {
+    using lh = latency_histogram;
+
+    SECTION("small values are exact") {
+        for (uint64_t v=0; v<lh::SUB_BUCKET_COUNT; ++v) {
+            REQUIRE(v == lh::bucket_index(v));
+            REQUIRE(v == lh::bucket_lowest(v));
+            REQUIRE(v == lh::bucket_highest(v));
+        }
+    }
+
+    SECTION("buckets are contiguous") {
+        for (size_t i=1; i<lh::NUM_BUCKETS; ++i) {
+            REQUIRE(lh::bucket_lowest(i) == lh::bucket_highest(i-1) + 1);
+            REQUIRE(i == lh::bucket_index(lh::bucket_lowest(i)));
+            REQUIRE(i == lh::bucket_index(lh::bucket_highest(i)));
+        }
+        REQUIRE(UINT64_MAX == lh::bucket_highest(lh::NUM_BUCKETS-1));
+        REQUIRE(lh::NUM_BUCKETS-1 == lh::bucket_index(UINT64_MAX));
+    }
+
+    SECTION("relative precision") {
+        for (uint64_t v=1; v < (uint64_t(1) << 40); v = v*3 + 7) {
+            size_t i = lh::bucket_index(v);
+            REQUIRE(lh::bucket_lowest(i) <= v);
+            REQUIRE(v <= lh::bucket_highest(i));
+            REQUIRE(double(lh::bucket_highest(i) - lh::bucket_lowest(i))
+                        <= double(v) / lh::SUB_BUCKET_HALF);
+        }
+    }
+}
+
+TEST_CASE("latency_histogram percentiles", "[latency_histogram]") {
+    latency_histogram h;
+
+    REQUIRE(h.empty());
+    REQUIRE(0 == h.value_at_percentile(50.0));
+
+    // 1us to 10ms, uniformly
+    for (uint64_t v=1; v<=10000; ++v)
+        h.record(v * 1000);
+
+    REQUIRE(10000 == h.count());
+    REQUIRE(1000 == h.min());
+    REQUIRE(10000000 == h.max());
+    REQUIRE(Approx(5000500.0) == h.mean());
+
+    for (double p : { 1.0, 25.0, 50.0, 90.0, 99.0, 99.9 }) {
+        double exact = p * 100000.0;
+        auto v = double(h.value_at_percentile(p));
+        REQUIRE(v >= exact);
+        REQUIRE(v <= exact * (1.0 + 1.0/latency_histogram::SUB_BUCKET_HALF));
+    }
+
+    REQUIRE(1000 == h.value_at_percentile(0.0));
+    REQUIRE(10000000 == h.value_at_percentile(100.0));
+
+    h.record(std::chrono::microseconds(-5));
+    REQUIRE(0 == h.min());
+
+    h.reset();
+    REQUIRE(h.empty());
+    REQUIRE(0 == h.max());
+}
+
+TEST_CASE("latency_histogram merge", "[latency_histogram]") {
+    latency_histogram a, b, all;
+
+    for (uint64_t v=1; v<=1000; ++v) {
+        (v % 2 ? a : b).record(v * 37);
+        all.record(v * 37);
+    }
+
+    a += b;
+    REQUIRE(all.count() == a.count());
+    REQUIRE(all.min() == a.min());
+    REQUIRE(all.max() == a.max());
+    REQUIRE(all.mean() == a.mean());
+
+    for (size_t i=0; i<latency_histogram::NUM_BUCKETS; ++i)
+        REQUIRE(all.count_at_index(i) == a.count_at_index(i));
+}
+
+TEST_CASE("latency_recorder snapshots", "[latency_histogram]") {
+    const int N = 4, NVAL = 20000;
+    latency_recorder recs[N];
+
+    // Each thread records into its own recorder, while this one reads
+    std::thread thrs[N];
+    for (int i=0; i<N; ++i) {
+        thrs[i] = std::thread([&recs, i] {
+            for (int j=0; j<NVAL; ++j)
+                recs[i].record(uint64_t(j + i*NVAL));
+        });
+    }
+
+    uint64_t prev = 0;
+    for (int k=0; k<10; ++k) {
+        uint64_t n = recs[0].snapshot().count();
+        REQUIRE(n >= prev);
+        prev = n;
+        std::this_thread::yield();
+    }
+
+    for (auto& thr : thrs)
+        thr.join();
+
+    latency_histogram total;
+    for (auto& rec : recs)
+        total += rec.snapshot();
+
+    REQUIRE(uint64_t(N*NVAL) == total.count());
+    REQUIRE(0 == total.min());
+    REQUIRE(uint64_t(N*NVAL - 1) == total.max());
+
+    recs[0].reset();
+    REQUIRE(recs[0].snapshot().empty());
+}
+
+TEST_CASE("latency_timer", "[latency_histogram]") {
+    latency_recorder rec;
+
+    int ret = timed(rec, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return 42;
+    });
+    REQUIRE(42 == ret);
+
+    {
+        latency_timer t(rec);
+    }
+
+    auto h = rec.snapshot();
+    REQUIRE(2 == h.count());
+    REQUIRE(h.max() >= 2000000);
+}
+
+TEST_CASE("latency_histogram output", "[latency_histogram]") {
+    latency_histogram h;
+    for (uint64_t v=1; v<=1000; ++v)
+        h.record(v * 1000);
+
+    std::ostringstream os;
+    h.print_summary(os, "Summary:");
+    h.print_spectrum(os, "Spectrum:");
+
+    auto s = os.str();
+    REQUIRE(s.find("Summary:\n") == 0);
+    REQUIRE(s.find("99.900%") != std::string::npos);
+    REQUIRE(s.find("Spectrum:\n") != std::string::npos);
+    REQUIRE(s.find("1.000000        1000") != std::string::npos);
+    REQUIRE(s.find("Total count = 1000") != std::string::npos);
+}
@@ -0,0 +1,124 @@
+// test_link_address.cpp
+//
+// Unit tests for the `link_address` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/link_address.h"
+#include "sockpp/exception.h"
+#include <sstream>
+#include <string>
+#include <net/if.h>
+
+using namespace sockpp;
+
+TEST_CASE("link_address default constructor", "[address]") {
+    link_address addr;
+
+    REQUIRE(!addr.is_set());
+    REQUIRE(0 == addr.ifindex());
+    REQUIRE(addr.ifname().empty());
+    REQUIRE(sizeof(sockaddr_ll) == addr.size());
+    REQUIRE(AF_PACKET == addr.sll_family);
+    REQUIRE("link:*" == addr.to_string());
+}
+
+TEST_CASE("link_address interface constructors", "[address]") {
+    const int LO_IDX = int(if_nametoindex("lo"));
+    REQUIRE(LO_IDX > 0);
+
+    SECTION("by index") {
+        link_address addr(LO_IDX, ETH_P_IP);
+
+        REQUIRE(addr.is_set());
+        REQUIRE(LO_IDX == addr.ifindex());
+        REQUIRE("lo" == addr.ifname());
+        REQUIRE(ETH_P_IP == addr.protocol());
+        REQUIRE(htons(ETH_P_IP) == addr.sll_protocol);
+        REQUIRE("link:lo" == addr.to_string());
+    }
+
+    SECTION("by name") {
+        link_address addr("lo");
+
+        REQUIRE(LO_IDX == addr.ifindex());
+        REQUIRE(ETH_P_ALL == addr.protocol());
+        REQUIRE(addr == link_address(LO_IDX));
+
+        std::ostringstream os;
+        os << addr;
+        REQUIRE("link:lo" == os.str());
+    }
+
+    SECTION("unknown name") {
+        REQUIRE_THROWS_AS(link_address("no-such-if0"), sys_error);
+    }
+}
+
+TEST_CASE("link_address conversions", "[address]") {
+    link_address addr("lo", ETH_P_ARP);
+
+    SECTION("sockaddr_ll") {
+        sockaddr_ll sll = *addr.sockaddr_ll_ptr();
+        link_address addr2(sll);
+        REQUIRE(addr == addr2);
+
+        sll.sll_family = AF_INET;
+        REQUIRE_THROWS_AS(link_address(sll), std::invalid_argument);
+    }
+
+    SECTION("sock_address") {
+        sock_address sa = addr.to_sock_address();
+        REQUIRE(AF_PACKET == sa.sockaddr_ptr()->sa_family);
+        REQUIRE(sizeof(sockaddr_ll) == sa.size());
+
+        link_address addr2(sa);
+        REQUIRE(addr == addr2);
+        REQUIRE(addr2 != link_address());
+    }
+
+    SECTION("hardware address") {
+        sockaddr_ll sll = *addr.sockaddr_ll_ptr();
+        const uint8_t mac[] = { 0x00, 0x1b, 0x21, 0x3a, 0x4f, 0x0c };
+        sll.sll_halen = sizeof(mac);
+        memcpy(sll.sll_addr, mac, sizeof(mac));
+
+        REQUIRE("00:1b:21:3a:4f:0c" == link_address(sll).hw_address());
+        REQUIRE(addr.hw_address().empty());
+    }
+}
@@ -0,0 +1,219 @@
+// test_mem_socket.cpp
+//
+// Unit tests for the in-memory stream sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/mem_socket.h"
+#include "sockpp/crc32c.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+
+TEST_CASE("mem_socket read/write", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    REQUIRE(!sock0);
+    REQUIRE(!sock0.is_connected());
+
+    std::tie(sock0, sock1) = mem_socket::pair();
+    REQUIRE(sock0);
+    REQUIRE(sock1);
+
+    REQUIRE(5 == sock0.write("hello", 5));
+    REQUIRE(5 == sock1.available());
+    REQUIRE(5 == sock0.send_queue_size());
+
+    char buf[16];
+    REQUIRE(5 == sock1.read(buf, sizeof(buf)));
+    REQUIRE("hello" == std::string(buf, 5));
+    REQUIRE(0 == sock0.send_queue_size());
+
+    // The other direction, with a gather write
+    std::string a { "abc" }, b { "defg" };
+    std::vector<iovec> iov { iovec{ &a[0], a.size() }, iovec{ &b[0], b.size() } };
+    REQUIRE(7 == sock1.write(iov));
+    REQUIRE(7 == sock0.read_n(buf, 7));
+    REQUIRE("abcdefg" == std::string(buf, 7));
+
+    // Through the base class
+    stream_socket& ss = sock0;
+    REQUIRE(6 == ss.write(std::string("string")));
+    REQUIRE(6 == sock1.read_n(buf, 6));
+    REQUIRE("string" == std::string(buf, 6));
+}
+
+TEST_CASE("mem_socket close", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    std::tie(sock0, sock1) = mem_socket::pair();
+
+    REQUIRE(3 == sock0.write("end", 3));
+    REQUIRE(sock0.shutdown(SHUT_WR));
+
+    // Buffered data is still read before the end of the stream
+    char buf[8];
+    REQUIRE(3 == sock1.read(buf, sizeof(buf)));
+    REQUIRE(0 == sock1.read(buf, sizeof(buf)));
+
+    REQUIRE(-1 == sock0.write("x", 1));
+    REQUIRE(EPIPE == sock0.last_error());
+
+    // Writing to a peer that has closed
+    REQUIRE(1 == sock1.write("y", 1));
+    sock0.close();
+    REQUIRE(!sock0.is_connected());
+    REQUIRE(-1 == sock1.write("z", 1));
+    REQUIRE(EPIPE == sock1.last_error());
+
+    REQUIRE(-1 == sock0.read(buf, 1));
+    REQUIRE(ENOTCONN == sock0.last_error());
+}
+
+TEST_CASE("mem_socket non-blocking", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    std::tie(sock0, sock1) = mem_socket::pair(100);
+    sock0.set_non_blocking();
+    sock1.set_non_blocking();
+
+    char buf[256] = { 0 };
+    REQUIRE(-1 == sock1.read(buf, 1));
+    REQUIRE(EAGAIN == sock1.last_error());
+
+    // The capacity is rounded up to a power of two
+    REQUIRE(128 == sock0.write(buf, sizeof(buf)));
+    REQUIRE(-1 == sock0.write(buf, 1));
+    REQUIRE(EAGAIN == sock0.last_error());
+
+    REQUIRE(100 == sock1.read(buf, 100));
+    REQUIRE(100 == sock0.write(buf, sizeof(buf)));
+    REQUIRE(128 == sock1.read(buf, sizeof(buf)));
+}
+
+TEST_CASE("mem_socket timeout", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    std::tie(sock0, sock1) = mem_socket::pair();
+
+    REQUIRE(sock1.read_timeout(std::chrono::milliseconds(10)));
+
+    char c;
+    REQUIRE(-1 == sock1.read(&c, 1));
+    REQUIRE(EAGAIN == sock1.last_error());
+}
+
+TEST_CASE("mem_socket read_spin", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    std::tie(sock0, sock1) = mem_socket::pair();
+
+    // Through the base class, the spin must still read the pipe
+    stream_socket& s1 = sock1;
+    const std::chrono::microseconds SPIN { 100 };
+    char buf[16];
+
+    REQUIRE(3 == sock0.write_n("abc", 3));
+    REQUIRE(3 == s1.read_spin(buf, sizeof(buf), SPIN));
+    REQUIRE(std::string("abc") == std::string(buf, 3));
+
+    sock1.set_non_blocking();
+    REQUIRE(-1 == s1.read_spin(buf, sizeof(buf), SPIN));
+    REQUIRE(EAGAIN == sock1.last_error());
+
+    sock0.shutdown(SHUT_WR);
+    REQUIRE(0 == s1.read_spin(buf, sizeof(buf), SPIN));
+}
+
+TEST_CASE("mem_socket partial I/O", "[mem_socket]") {
+    mem_socket sock0, sock1;
+    std::tie(sock0, sock1) = mem_socket::pair(1024);
+
+    sock0.set_write_limit(3);
+    sock1.set_read_limit(2);
+
+    REQUIRE(3 == sock0.write("abcdef", 6));
+    char buf[16];
+    REQUIRE(2 == sock1.read(buf, sizeof(buf)));
+    REQUIRE(1 == sock1.read(buf, sizeof(buf)));
+
+    // Random sizes, with the whole transfer wrapping the ring many times
+    sock0.set_write_limit(100, true);
+    sock1.set_read_limit(100, true);
+
+    std::string data(64*1024, '\0');
+    for (size_t i=0; i<data.size(); ++i)
+        data[i] = char(i * 7);
+
+    std::thread thr([&] { sock0.write_n(data.data(), data.size()); sock0.close(); });
+
+    std::string recv(data.size(), '\0');
+    ssize_t n = sock1.read_n(&recv[0], recv.size());
+    thr.join();
+
+    REQUIRE(ssize_t(data.size()) == n);
+    REQUIRE(data == recv);
+}
+
+// Many simulated connections, each carrying checksummed frames through
+// randomly-sized partial reads and writes.
+
+TEST_CASE("mem_socket many connections", "[mem_socket]") {
+    const size_t NCONN = 2000;
+    std::vector<mem_socket> clients, servers;
+
+    for (size_t i=0; i<NCONN; ++i) {
+        mem_socket s0, s1;
+        std::tie(s0, s1) = mem_socket::pair(4096);
+        s0.set_write_limit(13, true);
+        s1.set_read_limit(7, true);
+        clients.push_back(std::move(s0));
+        servers.push_back(std::move(s1));
+    }
+
+    size_t nbad = 0;
+    for (size_t i=0; i<NCONN; ++i) {
+        std::string msg = "message for connection #" + std::to_string(i);
+        crc_framer(clients[i]).write_frame(msg.data(), msg.size());
+        clients[i].close();
+
+        std::string s;
+        crc_framer rx(servers[i]);
+        if (rx.read_frame(s) != ssize_t(msg.size()) || s != msg
+                || rx.read_frame(s) != 0)
+            ++nbad;
+    }
+    REQUIRE(0 == nbad);
+}
@@ -0,0 +1,149 @@
+// test_mirrored_ring.cpp
+//
+// Unit tests for the `mirrored_ring` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/mirrored_ring.h"
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace sockpp;
+
+TEST_CASE("mirrored_ring capacity", "[mirrored_ring]") {
+    const size_t PG = size_t(::sysconf(_SC_PAGESIZE));
+
+    mirrored_ring empty;
+    REQUIRE(!empty);
+    REQUIRE(0 == empty.capacity());
+
+    mirrored_ring ring(100);
+    REQUIRE(ring);
+    REQUIRE(PG == ring.capacity());
+    REQUIRE(ring.empty());
+    REQUIRE(PG == ring.free_space());
+
+    mirrored_ring ring2(3*PG + 1);
+    REQUIRE(4*PG == ring2.capacity());
+
+    SECTION("move") {
+        mirrored_ring ring3(std::move(ring2));
+        REQUIRE(!ring2);
+        REQUIRE(4*PG == ring3.capacity());
+
+        ring = std::move(ring3);
+        REQUIRE(4*PG == ring.capacity());
+    }
+}
+
+TEST_CASE("mirrored_ring data wraps contiguously", "[mirrored_ring]") {
+    mirrored_ring ring(1);
+    const size_t CAP = ring.capacity();
+
+    // Move the head near the end
+    std::string fill(CAP - 10, 'x');
+    REQUIRE(fill.size() == ring.write(fill.data(), fill.size()));
+    ring.consume(fill.size());
+    REQUIRE(ring.empty());
+
+    // A message that straddles the end
+    std::string msg = "a message that wraps around the end of the ring";
+    REQUIRE(msg.size() == ring.write(msg.data(), msg.size()));
+    REQUIRE(msg.size() == ring.size());
+
+    // Readable in place, in one piece
+    REQUIRE(0 == memcmp(ring.data(), msg.data(), msg.size()));
+    iovec rd = ring.readable();
+    REQUIRE(rd.iov_base == ring.data());
+    REQUIRE(rd.iov_len == msg.size());
+
+    // And the free space is in one piece, too
+    iovec wr = ring.writable();
+    REQUIRE(wr.iov_len == CAP - msg.size());
+
+    // Filling it up, through the pointer
+    memset(wr.iov_base, 'z', wr.iov_len);
+    ring.commit(wr.iov_len);
+    REQUIRE(ring.full());
+    REQUIRE(0 == ring.write("!", 1));
+
+    std::string out(msg.size(), '\0');
+    REQUIRE(msg.size() == ring.read(&out[0], out.size()));
+    REQUIRE(msg == out);
+    REQUIRE(CAP - msg.size() == ring.size());
+    REQUIRE('z' == ring.data()[0]);
+    REQUIRE('z' == ring.data()[ring.size()-1]);
+
+    ring.clear();
+    REQUIRE(ring.empty());
+    REQUIRE(CAP == ring.free_space());
+}
+
+TEST_CASE("mirrored_ring with a socket", "[mirrored_ring]") {
+    stream_socket s1, s2;
+    std::tie(s1, s2) = stream_socket::pair();
+    REQUIRE(s1);
+
+    mirrored_ring ring(1);
+    const size_t CAP = ring.capacity();
+
+    // Put the head near the end, so the read wraps
+    std::string fill(CAP - 5, 'x');
+    ring.write(fill.data(), fill.size());
+    ring.consume(fill.size());
+
+    std::string msg = "hello, wrapped world";
+    REQUIRE(s1.write(msg) == int(msg.size()));
+
+    REQUIRE(ssize_t(msg.size()) == ring.read_from(s2));
+    REQUIRE(0 == memcmp(ring.data(), msg.data(), msg.size()));
+
+    REQUIRE(ssize_t(msg.size()) == ring.write_to(s2));
+    REQUIRE(ring.empty());
+
+    char buf[64];
+    REQUIRE(ssize_t(msg.size()) == s1.read(buf, sizeof(buf)));
+    REQUIRE(msg == std::string(buf, msg.size()));
+
+    // A full ring can't read more
+    std::string full(CAP, 'f');
+    ring.write(full.data(), full.size());
+    REQUIRE(-1 == ring.read_from(s2));
+    REQUIRE(ENOBUFS == s2.last_error());
+}
@@ -0,0 +1,306 @@
+// test_mux_client.cpp
+//
+// Unit tests for the multiplexing request/response client.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/mux_client.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("mux_client framing", "[mux_client]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    REQUIRE(mux_client::write_frame(sock0, 42, "hello", 5));
+    REQUIRE(mux_client::write_frame(sock0, 7, "", 0));
+
+    uint32_t id = 0;
+    std::string payload;
+    REQUIRE(mux_client::read_frame(sock1, id, payload));
+    REQUIRE(42 == id);
+    REQUIRE("hello" == payload);
+
+    REQUIRE(mux_client::read_frame(sock1, id, payload));
+    REQUIRE(7 == id);
+    REQUIRE(payload.empty());
+
+    REQUIRE(mux_client::write_frame(sock0, 1, "too big", 7));
+    REQUIRE(!mux_client::read_frame(sock1, id, payload, 4));
+    REQUIRE(EMSGSIZE == sock1.last_error());
+
+    // A frame cut short
+    char buf[8];
+    REQUIRE(7 == sock1.read_n(buf, 7));
+    REQUIRE(4 == sock0.write("\0\0\0\5", 4));
+    sock0.shutdown(SHUT_WR);
+    sock1.clear();
+    REQUIRE(!mux_client::read_frame(sock1, id, payload));
+    REQUIRE(ECONNRESET == sock1.last_error());
+
+    sock0.close();
+    sock1.clear();
+    REQUIRE(!mux_client::read_frame(sock1, id, payload));
+    REQUIRE(0 == sock1.last_error());
+}
+
+// The server collects a batch of requests, then answers them in reverse
+// order, so every response arrives out of order.
+
+TEST_CASE("mux_client out of order", "[mux_client]") {
+    const size_t N = 2000, BATCH = 100;
+
+    stream_socket cliSock, srvSock;
+    std::tie(cliSock, srvSock) = stream_socket::pair();
+
+    std::thread srvr([&srvSock, BATCH] {
+        std::vector<std::pair<uint32_t, std::string>> batch;
+        uint32_t id;
+        std::string req;
+
+        while (mux_client::read_frame(srvSock, id, req)) {
+            batch.emplace_back(id, "re:" + req);
+            if (batch.size() == BATCH) {
+                for (auto p = batch.rbegin(); p != batch.rend(); ++p)
+                    mux_client::write_frame(srvSock, p->first,
+                                            p->second.data(), p->second.size());
+                batch.clear();
+            }
+        }
+    });
+
+    std::atomic<size_t> nok { 0 }, nbad { 0 };
+    {
+        mux_client cli(std::move(cliSock));
+        REQUIRE(cli.is_connected());
+
+        for (size_t i=0; i<N; ++i) {
+            std::string req = std::to_string(i);
+            cli.async_call(req, microseconds(0), [&, req](int err, std::string&& resp) {
+                if (err == 0 && resp == "re:" + req)
+                    ++nok;
+                else
+                    ++nbad;
+            });
+        }
+
+        // A blocking call from another thread, in the same batches
+        std::string resp;
+        int err = -1;
+        std::thread caller([&] {
+            err = cli.call("sync", resp, seconds(10));
+        });
+
+        auto deadline = steady_clock::now() + seconds(10);
+        while (nok + nbad < N && steady_clock::now() < deadline)
+            std::this_thread::sleep_for(milliseconds(1));
+
+        // The sync call is left in a partial batch, once it's made
+        while (cli.in_flight() != 1 && steady_clock::now() < deadline)
+            std::this_thread::sleep_for(milliseconds(1));
+        REQUIRE(1 == cli.in_flight());
+        for (size_t i=1; i<BATCH; ++i)
+            cli.async_call("x", microseconds(0), [](int, std::string&&) {});
+        caller.join();
+
+        REQUIRE(0 == err);
+        REQUIRE("re:sync" == resp);
+    }
+    srvr.join();
+
+    REQUIRE(N == nok);
+    REQUIRE(0 == nbad);
+}
+
+TEST_CASE("mux_client deadlines", "[mux_client]") {
+    stream_socket cliSock, srvSock;
+    std::tie(cliSock, srvSock) = stream_socket::pair();
+
+    mux_client cli(std::move(cliSock));
+
+    // Nothing answers, so the request times out
+    std::string resp;
+    auto start = steady_clock::now();
+    REQUIRE(ETIMEDOUT == cli.call("hello", resp, milliseconds(50)));
+    REQUIRE(steady_clock::now() - start >= milliseconds(50));
+    REQUIRE(0 == cli.in_flight());
+
+    // The late response is dropped, and the next one still matches
+    uint32_t id, lateId;
+    std::string req;
+    REQUIRE(mux_client::read_frame(srvSock, lateId, req));
+
+    std::thread srvr([&] {
+        mux_client::read_frame(srvSock, id, req);
+        mux_client::write_frame(srvSock, lateId, "late", 4);
+        mux_client::write_frame(srvSock, id, "on time", 7);
+    });
+
+    REQUIRE(0 == cli.call("again", resp, seconds(5)));
+    REQUIRE("on time" == resp);
+    srvr.join();
+
+    // Several deadlines expire in order, whatever order they were set
+    std::vector<int> order;
+    std::mutex mtx;
+    for (int ms : { 60, 20, 40 }) {
+        cli.async_call("t", milliseconds(ms), [&, ms](int err, std::string&&) {
+            std::lock_guard<std::mutex> lk(mtx);
+            order.push_back(err == ETIMEDOUT ? ms : -1);
+        });
+    }
+    std::this_thread::sleep_for(milliseconds(150));
+
+    std::lock_guard<std::mutex> lk(mtx);
+    REQUIRE((std::vector<int>{ 20, 40, 60 }) == order);
+}
+
+// The server sends a flood of responses before it reads anything more, and
+// each response's callback makes a request too big for the socket buffer.
+// If the reader wrote those itself, it would block, and so would the
+// server.
+
+TEST_CASE("mux_client requests from callbacks", "[mux_client]") {
+    const size_t N = 32, RESP_SIZE = 64*1024, REQ_SIZE = 256*1024;
+
+    stream_socket cliSock, srvSock;
+    std::tie(cliSock, srvSock) = stream_socket::pair();
+
+    std::thread srvr([&srvSock, N, RESP_SIZE] {
+        std::vector<uint32_t> ids;
+        uint32_t id;
+        std::string req;
+
+        for (size_t i=0; i<N && mux_client::read_frame(srvSock, id, req); ++i)
+            ids.push_back(id);
+
+        const std::string resp(RESP_SIZE, 'r');
+        for (auto id : ids)
+            mux_client::write_frame(srvSock, id, resp.data(), resp.size());
+
+        while (mux_client::read_frame(srvSock, id, req))
+            mux_client::write_frame(srvSock, id, "ok", 2);
+    });
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t nfollow = 0, nbad = 0;
+    {
+        mux_client cli(std::move(cliSock));
+        const std::string bigReq(REQ_SIZE, 'q');
+
+        for (size_t i=0; i<N; ++i) {
+            cli.async_call("first", seconds(0), [&](int err, std::string&&) {
+                if (err) {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    ++nbad;
+                    return;
+                }
+                cli.async_call(bigReq, seconds(0), [&](int err, std::string&& resp) {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    if (err || resp != "ok")
+                        ++nbad;
+                    ++nfollow;
+                    cv.notify_one();
+                });
+            });
+        }
+
+        std::unique_lock<std::mutex> lk(mtx);
+        cv.wait_for(lk, seconds(10), [&] { return nfollow == N; });
+    }
+    srvr.join();
+
+    REQUIRE(N == nfollow);
+    REQUIRE(0 == nbad);
+}
+
+TEST_CASE("mux_client connection loss", "[mux_client]") {
+    stream_socket cliSock, srvSock;
+    std::tie(cliSock, srvSock) = stream_socket::pair();
+
+    std::atomic<int> nreset { 0 };
+    mux_client cli(std::move(cliSock));
+
+    for (int i=0; i<10; ++i) {
+        cli.async_call("x", seconds(10), [&](int err, std::string&&) {
+            if (err == ECONNRESET)
+                ++nreset;
+        });
+    }
+
+    srvSock.close();
+
+    // The callbacks run after the client is marked as down
+    auto deadline = steady_clock::now() + seconds(5);
+    while (nreset < 10 && steady_clock::now() < deadline)
+        std::this_thread::sleep_for(milliseconds(1));
+
+    REQUIRE(!cli.is_connected());
+    REQUIRE(10 == nreset);
+    REQUIRE(0 == cli.in_flight());
+
+    // New requests fail right away
+    int err = 0;
+    REQUIRE(!cli.async_call("x", seconds(1), [&](int e, std::string&&) { err = e; }));
+    REQUIRE(ECONNRESET == err);
+}
+
+TEST_CASE("mux_client close cancels", "[mux_client]") {
+    stream_socket cliSock, srvSock;
+    std::tie(cliSock, srvSock) = stream_socket::pair();
+
+    std::atomic<int> ncancel { 0 };
+    mux_client cli(std::move(cliSock));
+
+    for (int i=0; i<5; ++i) {
+        cli.async_call("x", microseconds(0), [&](int err, std::string&&) {
+            if (err == ECANCELED)
+                ++ncancel;
+        });
+    }
+
+    cli.close();
+    REQUIRE(5 == ncancel);
+    REQUIRE(!cli.is_connected());
+}
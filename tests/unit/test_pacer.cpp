@@ -0,0 +1,190 @@
+// test_pacer.cpp
+//
+// Unit tests for the send pacer, and the socket options for pacing.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/pacer.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "udp_pair.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+static int64_t to_ns(const timespec& ts)
+{
+    return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+TEST_CASE("pacer schedule", "[pacer]") {
+    const uint64_t T0 = 1000000000;
+    const uint64_t MS = 1000000;
+
+    SECTION("one packet per bucket") {
+        pacer p(1000000, 1000);     // 1 MB/s: 1 ms per 1000 bytes
+
+        REQUIRE(p.schedule(1000, T0) == T0);
+        REQUIRE(p.schedule(1000, T0) == T0 + MS);
+        REQUIRE(p.schedule(500, T0) == T0 + 3*MS/2);
+        REQUIRE(p.schedule(1000, T0 + MS) == T0 + 5*MS/2);
+    }
+
+    SECTION("burst after idle") {
+        pacer p(1000000, 3000);
+
+        for (int i=0; i<3; ++i)
+            REQUIRE(p.schedule(1000, T0) == T0);
+        REQUIRE(p.schedule(1000, T0) == T0 + MS);
+
+        // The bucket refills, but no more than the burst
+        const uint64_t T1 = T0 + 100*MS;
+        for (int i=0; i<3; ++i)
+            REQUIRE(p.schedule(1000, T1) == T1);
+        REQUIRE(p.schedule(1000, T1) == T1 + MS);
+    }
+
+    SECTION("packet bigger than the bucket") {
+        pacer p(1000000, 1000);
+
+        REQUIRE(p.schedule(4000, T0) == T0);
+        REQUIRE(p.schedule(1000, T0) == T0 + 4*MS);
+    }
+}
+
+TEST_CASE("pacer spaces out datagrams", "[pacer]") {
+    const size_t N = 40, PKT_SIZE = 1000;
+    const int64_t GAP = 2000000;        // 2 ms
+
+    datagram_socket tx, rx;
+    udp_pair(tx, rx);
+    REQUIRE(rx.rx_timestamps());
+
+    std::vector<char> buf(N * PKT_SIZE, 'x');
+    std::vector<iovec> pkts;
+    for (size_t i=0; i<N; ++i)
+        pkts.push_back(iovec{ &buf[i*PKT_SIZE], PKT_SIZE });
+
+    // The packets are read as they arrive. The kernel only stamps them on
+    // arrival once it has switched timestamps on, which can lag a bit, and
+    // until then they're stamped when they're read.
+    std::vector<int64_t> arrivals;
+    std::thread rdr([&] {
+        char rbuf[2048];
+        timespec ts;
+        for (size_t i=0; i<N; ++i) {
+            if (rx.recv_timestamped(rbuf, sizeof(rbuf), ts) != int(PKT_SIZE) || ts.tv_sec == 0)
+                break;
+            arrivals.push_back(to_ns(ts));
+        }
+    });
+
+    pacer p(PKT_SIZE * 1000000000 / GAP, PKT_SIZE);
+    int n = p.send(tx, pkts.data(), N);
+    rdr.join();
+
+    REQUIRE(n == int(N));
+    REQUIRE(arrivals.size() == N);
+
+    std::vector<int64_t> gaps;
+    for (size_t i=1; i<N; ++i)
+        gaps.push_back(arrivals[i] - arrivals[i-1]);
+    std::sort(gaps.begin(), gaps.end());
+
+    // The whole run can't be any faster than the rate, and most of the
+    // gaps should be close to the target, allowing for scheduler jitter.
+    REQUIRE(arrivals.back() - arrivals.front() >= int64_t(N-1) * GAP * 95 / 100);
+    REQUIRE(gaps[gaps.size()/2] >= GAP * 3 / 4);
+    REQUIRE(gaps[gaps.size()/2] <= GAP * 5 / 4);
+}
+
+TEST_CASE("pacer with txtime", "[pacer]") {
+    const size_t N = 50;
+
+    datagram_socket tx, rx;
+    udp_pair(tx, rx);
+
+    pacer p(10000000, 1000);
+    if (!p.use_txtime(tx)) {
+        WARN("SO_TXTIME not supported: " << tx.last_error_str());
+        return;
+    }
+    REQUIRE(p.is_txtime());
+
+    std::string msg(1000, 'y');
+    std::vector<iovec> pkts(N, iovec{ &msg[0], msg.size() });
+    REQUIRE(int(N) == p.send(tx, pkts.data(), N));
+    REQUIRE(int(msg.size()) == p.send(tx, msg.data(), msg.size()));
+
+    char rbuf[2048];
+    for (size_t i=0; i<=N; ++i)
+        REQUIRE(int(msg.size()) == rx.recv(rbuf, sizeof(rbuf)));
+}
+
+TEST_CASE("pacer paces stream writes", "[pacer]") {
+    tcp_acceptor acc(inet_address("localhost", 0));
+    REQUIRE(acc);
+    tcp_connector conn(acc.address());
+    REQUIRE(conn);
+    tcp_socket sock = acc.accept();
+    REQUIRE(sock);
+
+    REQUIRE(conn.max_pacing_rate(1000000));
+    REQUIRE(conn.max_pacing_rate(0));
+
+    // 20 kB at 200 kB/s, with the first 2 kB free: 90 ms
+    const size_t N = 20000;
+    std::string out(N, 'z'), in(N, '\0');
+
+    std::thread rdr([&] { sock.read_n(&in[0], N); });
+
+    pacer p(200000, 2000);
+    auto start = steady_clock::now();
+    ssize_t n = p.write(conn, out.data(), N);
+    auto elapsed = steady_clock::now() - start;
+    rdr.join();
+
+    REQUIRE(n == ssize_t(N));
+    REQUIRE(in == out);
+    REQUIRE(elapsed >= milliseconds(85));
+}
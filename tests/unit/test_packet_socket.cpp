@@ -0,0 +1,247 @@
+// test_packet_socket.cpp
+//
+// Unit tests for the `packet_socket` class and its receive ring.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/packet_socket.h"
+#include "sockpp/datagram_socket.h"
+#include "sockpp/inet_address.h"
+#include <string>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// The tests capture IP packets on the loopback, from the network header
+// on. Capturing takes CAP_NET_RAW, so they are skipped without it.
+
+static bool open_capture(packet_socket& sock)
+{
+    if (!sock.open(link_address("lo", ETH_P_IP), SOCK_DGRAM)) {
+        if (sock.last_error() == EPERM) {
+            WARN("Skipping test: capturing packets needs CAP_NET_RAW");
+            return false;
+        }
+        FAIL("Can't open the packet socket: " << sock.last_error_str());
+    }
+    return true;
+}
+
+// Sends UDP packets over the loopback, each with the marker and a count.
+
+static void send_udp(const std::string& marker, size_t n)
+{
+    inet_address addr("localhost", 0);
+    sock_address saddr(addr.sockaddr_ptr(), addr.size());
+
+    datagram_socket rcv(saddr), snd;
+    sock_address dst = rcv.address();
+
+    for (size_t i=0; i<n; ++i)
+        REQUIRE(snd.sendto(marker + std::to_string(i), dst) > 0);
+}
+
+// Determines if a frame is one of ours, coming in to the host.
+
+static bool is_ours(const packet_frame& f, const std::string& marker)
+{
+    std::string pkt(reinterpret_cast<const char*>(f.data()), f.size());
+    return f.pkttype() == PACKET_HOST && pkt.find(marker) != std::string::npos;
+}
+
+// Takes blocks from a ring, counting our packets, until there are no more
+// or we have all of them.
+
+static size_t drain(packet_socket& sock, const std::string& marker, size_t n,
+                    const milliseconds& timeout=milliseconds(250))
+{
+    size_t count = 0;
+
+    while (count < n) {
+        auto blk = sock.next_block(timeout);
+        if (!blk)
+            break;
+        for (const auto& f : blk)
+            if (is_ours(f, marker))
+                ++count;
+    }
+    return count;
+}
+
+static std::string make_marker()
+{
+    return "pktsock-" + std::to_string(::getpid()) + "-";
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("packet_socket recvfrom", "[packet_socket]") {
+    packet_socket sock;
+    if (!open_capture(sock))
+        return;
+
+    REQUIRE(sock);
+    REQUIRE(!sock.has_rx_ring());
+    REQUIRE(0 == sock.rx_ring_size());
+
+    // No ring yet
+    REQUIRE(!sock.next_block(milliseconds(0)));
+    REQUIRE(EINVAL == sock.last_error());
+
+    const std::string MARKER = make_marker();
+    send_udp(MARKER, 1);
+
+    char buf[2048];
+    link_address from;
+    bool found = false;
+
+    pollfd pfd { sock.handle(), POLLIN, 0 };
+    while (!found && ::poll(&pfd, 1, 1000) > 0) {
+        int n = sock.recvfrom(buf, sizeof(buf), 0, from);
+        REQUIRE(n > 0);
+        std::string pkt(buf, size_t(n));
+        found = from.pkttype() == PACKET_HOST && pkt.find(MARKER) != std::string::npos;
+    }
+
+    REQUIRE(found);
+    REQUIRE(from.ifname() == "lo");
+    REQUIRE(ETH_P_IP == from.protocol());
+
+    // The packet starts with the IPv4 header
+    REQUIRE(0x45 == uint8_t(buf[0]));
+}
+
+TEST_CASE("packet_socket rx ring", "[packet_socket]") {
+    packet_socket sock;
+    if (!open_capture(sock))
+        return;
+
+    const size_t BLOCK_SIZE = 1 << 16;
+    const unsigned NUM_BLOCKS = 8;
+
+    REQUIRE(sock.setup_rx_ring(BLOCK_SIZE, NUM_BLOCKS, 2048, milliseconds(10)));
+    REQUIRE(sock.has_rx_ring());
+    REQUIRE(BLOCK_SIZE*NUM_BLOCKS == sock.rx_ring_size());
+
+    // Only once
+    REQUIRE(!sock.setup_rx_ring());
+    REQUIRE(EBUSY == sock.last_error());
+
+    const std::string MARKER = make_marker();
+    const size_t N = 100;
+    send_udp(MARKER, N);
+
+    size_t count = 0;
+    size_t nxt = 0;
+    bool inOrder = true, whole = true, stamped = true;
+
+    while (count < N) {
+        auto blk = sock.next_block(milliseconds(500));
+        if (!blk)
+            break;
+        REQUIRE(blk.num_packets() > 0);
+
+        for (const auto& f : blk) {
+            if (!is_ours(f, MARKER))
+                continue;
+
+            // The UDP payload follows the 20-byte IP and 8-byte UDP headers
+            std::string payload(reinterpret_cast<const char*>(f.data()) + 28,
+                                f.size() - 28);
+            if (payload != MARKER + std::to_string(nxt))
+                inOrder = false;
+            ++nxt;
+            ++count;
+
+            if (f.truncated() || f.size() != f.wire_size()
+                    || f.network_data() != f.data())
+                whole = false;
+            if (f.timestamp().tv_sec == 0)
+                stamped = false;
+            if (f.address().ifname() != "lo")
+                whole = false;
+        }
+    }
+
+    REQUIRE(N == count);
+    REQUIRE(inOrder);
+    REQUIRE(whole);
+    REQUIRE(stamped);
+
+    packet_stats st;
+    REQUIRE(sock.get_stats(st));
+    REQUIRE(st.packets >= N);
+    REQUIRE(0 == st.drops);
+
+    SECTION("moving the socket keeps the ring") {
+        packet_socket sock2(std::move(sock));
+        REQUIRE(!sock.has_rx_ring());
+        REQUIRE(sock2.has_rx_ring());
+
+        send_udp(MARKER, 10);
+        REQUIRE(10 == drain(sock2, MARKER, 10));
+    }
+}
+
+TEST_CASE("packet_socket fanout", "[packet_socket]") {
+    packet_socket sock1, sock2;
+    if (!open_capture(sock1) || !open_capture(sock2))
+        return;
+
+    const uint16_t GROUP = uint16_t(::getpid());
+
+    REQUIRE(sock1.fanout(GROUP, PACKET_FANOUT_LB));
+    REQUIRE(sock2.fanout(GROUP, PACKET_FANOUT_LB));
+
+    REQUIRE(sock1.setup_rx_ring(1 << 16, 8, 2048, milliseconds(10)));
+    REQUIRE(sock2.setup_rx_ring(1 << 16, 8, 2048, milliseconds(10)));
+
+    const std::string MARKER = make_marker();
+    const size_t N = 64;
+    send_udp(MARKER, N);
+
+    size_t n1 = drain(sock1, MARKER, N, milliseconds(100)),
+           n2 = drain(sock2, MARKER, N, milliseconds(100));
+
+    // Each packet went to just one of the sockets
+    REQUIRE(N == n1 + n2);
+    REQUIRE(n1 > 0);
+    REQUIRE(n2 > 0);
+}
@@ -0,0 +1,155 @@
+// test_poller.cpp
+//
+// Unit tests for the `poller` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/poller.h"
+#include "sockpp/event_fd.h"
+#include "sockpp/timer_fd.h"
+#include "sockpp/stream_socket.h"
+#include <set>
+#include <thread>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("poller waits on mixed handles", "[poller]") {
+    poller p;
+    REQUIRE(p);
+
+    event_fd evt(0, EFD_NONBLOCK);
+    timer_fd tmr(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    stream_socket s1, s2;
+    std::tie(s1, s2) = stream_socket::pair();
+
+    REQUIRE(evt);
+    REQUIRE(tmr);
+    REQUIRE(s1);
+
+    REQUIRE(p.add(evt, EPOLLIN, 1));
+    REQUIRE(p.add(tmr, EPOLLIN, 2));
+    REQUIRE(p.add(s2));
+
+    // Already added
+    REQUIRE(!p.add(evt));
+    REQUIRE(EEXIST == p.last_error());
+
+    std::vector<epoll_event> evts(8);
+
+    // Nothing is ready
+    REQUIRE(0 == p.wait(evts, milliseconds(0)));
+
+    SECTION("each handle") {
+        REQUIRE(evt.notify());
+        REQUIRE(tmr.set(milliseconds(5)));
+        REQUIRE(s1.write("x") == 1);
+
+        std::set<uint64_t> ready;
+        auto deadline = steady_clock::now() + seconds(1);
+
+        while (ready.size() < 3 && steady_clock::now() < deadline) {
+            int n = p.wait(evts, milliseconds(100));
+            REQUIRE(n >= 0);
+            for (int i=0; i<n; ++i) {
+                ready.insert(evts[i].data.u64);
+                if (evts[i].data.u64 == 1)
+                    evt.try_read();
+                else if (evts[i].data.u64 == 2) {
+                    uint64_t x;
+                    tmr.read(x);
+                }
+                else {
+                    char c;
+                    s2.read(&c, 1);
+                }
+            }
+        }
+
+        REQUIRE(ready.count(1) == 1);
+        REQUIRE(ready.count(2) == 1);
+        REQUIRE(ready.count(uint64_t(s2.handle())) == 1);
+    }
+
+    SECTION("wakeup from another thread") {
+        std::thread thr([&evt] {
+            std::this_thread::sleep_for(milliseconds(20));
+            evt.notify();
+        });
+
+        int n = p.wait(evts, milliseconds(-1));
+        thr.join();
+
+        REQUIRE(1 == n);
+        REQUIRE(1 == evts[0].data.u64);
+        REQUIRE(1 == evt.try_read());
+    }
+
+    SECTION("modify and remove") {
+        REQUIRE(p.modify(evt, EPOLLIN | EPOLLONESHOT, 9));
+        REQUIRE(evt.notify());
+
+        REQUIRE(1 == p.wait(evts, milliseconds(0)));
+        REQUIRE(9 == evts[0].data.u64);
+
+        // One-shot: it's still set, but disarmed
+        REQUIRE(0 == p.wait(evts, milliseconds(0)));
+        REQUIRE(p.modify(evt, EPOLLIN));
+        REQUIRE(1 == p.wait(evts, milliseconds(0)));
+
+        REQUIRE(p.remove(evt));
+        REQUIRE(0 == p.wait(evts, milliseconds(0)));
+        REQUIRE(!p.remove(evt));
+        REQUIRE(ENOENT == p.last_error());
+    }
+}
+
+TEST_CASE("poller busy_poll", "[poller]") {
+    poller p;
+    REQUIRE(p);
+
+    // Older kernels don't know the ioctl
+    if (!p.busy_poll(microseconds(50), 0, true)) {
+        REQUIRE(ENOTTY == p.last_error());
+        return;
+    }
+    REQUIRE(p.busy_poll(microseconds(0)));
+
+    REQUIRE(!p.busy_poll(microseconds(-1)));
+    REQUIRE(EINVAL == p.last_error());
+}
@@ -0,0 +1,241 @@
+// test_rudp_socket.cpp
+//
+// Unit tests for the reliable UDP transport, and the batch datagram I/O
+// it's built on.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/rudp_socket.h"
+#include "sockpp/inet_address.h"
+#include "udp_pair.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("datagram_socket batch I/O", "[rudp_socket]") {
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    const unsigned N = 8;
+    std::string out[N];
+    iovec iov[N];
+    mmsghdr msgs[N] = {};
+
+    for (unsigned i=0; i<N; ++i) {
+        out[i] = "message " + std::to_string(i);
+        iov[i] = iovec{ &out[i][0], out[i].size() };
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    REQUIRE(int(N) == a.sendmmsg(msgs, N));
+
+    char bufs[N][64];
+    mmsghdr in[N] = {};
+    for (unsigned i=0; i<N; ++i) {
+        iov[i] = iovec{ bufs[i], sizeof(bufs[i]) };
+        in[i].msg_hdr.msg_iov = &iov[i];
+        in[i].msg_hdr.msg_iovlen = 1;
+    }
+    REQUIRE(int(N) == b.recvmmsg(in, N, MSG_WAITFORONE));
+
+    for (unsigned i=0; i<N; ++i)
+        REQUIRE(out[i] == std::string(bufs[i], in[i].msg_len));
+
+    REQUIRE(-1 == b.recvmmsg(in, N, MSG_DONTWAIT));
+    REQUIRE(EAGAIN == b.last_error());
+}
+
+TEST_CASE("rudp_socket in order", "[rudp_socket]") {
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    rudp_socket tx(std::move(a)), rx(std::move(b));
+    REQUIRE(tx);
+    REQUIRE(rx);
+
+    std::string msg;
+    REQUIRE(!rx.recv(msg, milliseconds(10)));
+    REQUIRE(EAGAIN == rx.last_error());
+
+    REQUIRE(!tx.send(std::string(rudp_socket::MAX_MESSAGE+1, 'x')));
+    REQUIRE(EMSGSIZE == tx.last_error());
+
+    REQUIRE(tx.send("hello"));
+    REQUIRE(rx.recv(msg, seconds(5)));
+    REQUIRE("hello" == msg);
+
+    REQUIRE(rx.send("world"));
+    REQUIRE(tx.recv(msg, seconds(5)));
+    REQUIRE("world" == msg);
+
+    REQUIRE(tx.flush(seconds(5)));
+    REQUIRE(rx.flush(seconds(5)));
+}
+
+// With loss in both directions, every message should still arrive, once,
+// and in order.
+
+TEST_CASE("rudp_socket with loss", "[rudp_socket]") {
+    const int N = 5000;
+
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    rudp_socket tx(std::move(a)), rx(std::move(b), 256);
+    tx.set_loss(0.1);
+    rx.set_loss(0.1);
+
+    std::thread sender([&tx, N] {
+        for (int i=0; i<N; ++i)
+            tx.send(std::to_string(i) + std::string(i % 200, '.'));
+    });
+
+    int nbad = 0, nrecv = 0;
+    std::string msg;
+    for (int i=0; i<N; ++i) {
+        if (!rx.recv(msg, seconds(10)))
+            break;
+        ++nrecv;
+        if (msg != std::to_string(i) + std::string(i % 200, '.'))
+            ++nbad;
+    }
+    sender.join();
+
+    REQUIRE(N == nrecv);
+    REQUIRE(0 == nbad);
+    REQUIRE(tx.flush(seconds(10)));
+
+    auto st = tx.get_stats();
+    REQUIRE(st.injectedLoss > 0);
+    REQUIRE(st.retransmits > 0);
+    REQUIRE(uint64_t(N) == st.msgsSent);
+    REQUIRE(uint64_t(N) == rx.get_stats().msgsRecv);
+    REQUIRE(!rx.recv(msg, milliseconds(10)));
+}
+
+TEST_CASE("rudp_socket unordered", "[rudp_socket]") {
+    const int N = 2000;
+
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    rudp_socket tx(std::move(a)), rx(std::move(b));
+    tx.set_ordered(false);
+    tx.set_loss(0.1);
+
+    std::thread sender([&tx, N] {
+        for (int i=0; i<N; ++i)
+            tx.send(std::to_string(i));
+    });
+
+    std::vector<int> seen(N, 0);
+    bool outOfOrder = false;
+    int prev = -1;
+    std::string msg;
+
+    for (int i=0; i<N; ++i) {
+        if (!rx.recv(msg, seconds(10)))
+            break;
+        int k = std::stoi(msg);
+        if (k < prev)
+            outOfOrder = true;
+        prev = k;
+        ++seen[k];
+    }
+    sender.join();
+
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == N);
+    REQUIRE(outOfOrder);
+    REQUIRE(tx.flush(seconds(10)));
+}
+
+// A receiver that stops reading closes its window, which has to reopen
+// when it starts again.
+
+TEST_CASE("rudp_socket flow control", "[rudp_socket]") {
+    const int N = 200;
+
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    rudp_socket tx(std::move(a), 16), rx(std::move(b), 16);
+
+    std::thread sender([&tx, N] {
+        for (int i=0; i<N; ++i)
+            tx.send(std::to_string(i));
+    });
+
+    std::this_thread::sleep_for(milliseconds(50));
+    REQUIRE(tx.get_stats().msgsSent < uint64_t(N));
+
+    std::string msg;
+    int nok = 0;
+    for (int i=0; i<N; ++i) {
+        if (rx.recv(msg, seconds(10)) && msg == std::to_string(i))
+            ++nok;
+    }
+    sender.join();
+
+    REQUIRE(N == nok);
+}
+
+TEST_CASE("rudp_socket peer gone", "[rudp_socket]") {
+    datagram_socket a, b;
+    udp_pair(a, b);
+
+    rudp_socket tx(std::move(a));
+    tx.set_min_rto(microseconds(100));
+
+    // Get an RTT sample first, so the timeouts start small
+    {
+        rudp_socket rx(std::move(b));
+        std::string msg;
+        REQUIRE(tx.send("hello"));
+        REQUIRE(rx.recv(msg, seconds(5)));
+        REQUIRE(tx.flush(seconds(5)));
+    }
+
+    REQUIRE(tx.send("anyone?"));
+    REQUIRE(!tx.flush(seconds(10)));
+    REQUIRE(ETIMEDOUT == tx.last_error());
+    REQUIRE(!tx);
+}
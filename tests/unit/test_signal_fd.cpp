@@ -0,0 +1,99 @@
+// test_signal_fd.cpp
+//
+// Unit tests for the `signal_fd` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/signal_fd.h"
+
+using namespace sockpp;
+
+// The signals are raised on this thread, which has them blocked, so they
+// can't be delivered anywhere else.
+
+TEST_CASE("signal_fd", "[signal_fd]") {
+    signal_fd sfd({ SIGUSR1, SIGUSR2 }, SFD_CLOEXEC | SFD_NONBLOCK);
+    REQUIRE(sfd);
+    REQUIRE(sigismember(&sfd.mask(), SIGUSR1));
+    REQUIRE(sigismember(&sfd.mask(), SIGUSR2));
+    REQUIRE(!sigismember(&sfd.mask(), SIGINT));
+
+    REQUIRE(sfd.block());
+
+    signalfd_siginfo infos[4];
+
+    SECTION("nothing pending") {
+        REQUIRE(-1 == sfd.read(infos, 4));
+        REQUIRE(EAGAIN == sfd.last_error());
+    }
+
+    SECTION("batched read") {
+        REQUIRE(0 == ::raise(SIGUSR1));
+        REQUIRE(0 == ::raise(SIGUSR2));
+
+        REQUIRE(2 == sfd.read(infos, 4));
+
+        bool got1 = false, got2 = false;
+        for (int i=0; i<2; ++i) {
+            got1 = got1 || infos[i].ssi_signo == SIGUSR1;
+            got2 = got2 || infos[i].ssi_signo == SIGUSR2;
+        }
+        REQUIRE(got1);
+        REQUIRE(got2);
+    }
+
+    SECTION("changing the mask") {
+        REQUIRE(sfd.set_mask(signal_fd::make_mask({ SIGUSR2 })));
+        REQUIRE(!sigismember(&sfd.mask(), SIGUSR1));
+
+        // Still blocked, but no longer read
+        REQUIRE(0 == ::raise(SIGUSR1));
+        REQUIRE(0 == ::raise(SIGUSR2));
+
+        REQUIRE(sfd.read(infos[0]));
+        REQUIRE(SIGUSR2 == int(infos[0].ssi_signo));
+        REQUIRE(!sfd.read(infos[0]));
+
+        // Clear the pending one before it's unblocked
+        REQUIRE(sfd.set_mask(signal_fd::make_mask({ SIGUSR1, SIGUSR2 })));
+        REQUIRE(sfd.read(infos[0]));
+        REQUIRE(SIGUSR1 == int(infos[0].ssi_signo));
+    }
+
+    REQUIRE(sfd.unblock());
+}
@@ -0,0 +1,134 @@
+// test_socket_streambuf.cpp
+//
+// Unit tests for the `socket_streambuf` and `socket_iostream` classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/socket_streambuf.h"
+#include <string>
+#include <thread>
+
+using namespace sockpp;
+
+TEST_CASE("socket_iostream formatted", "[socket_streambuf]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    socket_iostream os(sock0, 256), is(sock1, 256);
+
+    os << "answer " << 42 << ' ' << 3.5;
+
+    // Nothing is sent until the stream is flushed
+    char c;
+    REQUIRE(sock1.set_non_blocking());
+    REQUIRE(sock1.read(&c, 1) < 0);
+    REQUIRE(sock1.set_non_blocking(false));
+
+    os << std::endl;
+    REQUIRE(os);
+
+    std::string word;
+    int n = 0;
+    double x = 0.0;
+    is >> word >> n >> x;
+
+    REQUIRE(is);
+    REQUIRE("answer" == word);
+    REQUIRE(42 == n);
+    REQUIRE(3.5 == x);
+
+    // Reply in the other direction
+    is << "ok" << std::endl;
+    std::string reply;
+    os >> reply;
+    REQUIRE("ok" == reply);
+}
+
+TEST_CASE("socket_iostream large blocks", "[socket_streambuf]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    const size_t N = 1024*1024;
+    std::string data(N, '\0');
+    for (size_t i=0; i<N; ++i)
+        data[i] = char(i * 7 + (i >> 10));
+
+    bool ok = false;
+    std::thread thr([&] {
+        socket_iostream os(sock0, 4096);
+        os << "hdr";
+        os.write(data.data(), 100);
+        os.write(data.data() + 100, N - 100);
+        os.flush();
+        ok = bool(os);
+        sock0.shutdown(SHUT_WR);
+    });
+
+    socket_iostream is(sock1, 4096);
+    char hdr[3];
+    is.read(hdr, 3);
+
+    std::string buf(N, '\0');
+    is.read(&buf[0], N);
+    size_t nr = size_t(is.gcount());
+
+    // The peer's shutdown shows up as the end of the stream
+    is.get();
+    bool eof = is.eof();
+
+    thr.join();
+
+    REQUIRE(ok);
+    REQUIRE(std::string("hdr") == std::string(hdr, 3));
+    REQUIRE(N == nr);
+    REQUIRE(data == buf);
+    REQUIRE(eof);
+}
+
+TEST_CASE("socket_streambuf unbuffered output", "[socket_streambuf]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    socket_streambuf sb(sock0, 16, 0);
+    std::ostream os(&sb);
+    os << 'x' << "yz";
+
+    char buf[4];
+    REQUIRE(3 == sock1.read_n(buf, 3));
+    REQUIRE(std::string("xyz") == std::string(buf, 3));
+}
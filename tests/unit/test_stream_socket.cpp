@@ -0,0 +1,105 @@
+// test_stream_socket.cpp
+//
+// Unit tests for the `stream_socket` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/stream_socket.h"
+#include <string>
+
+using namespace sockpp;
+
+TEST_CASE("stream_socket pair", "[stream_socket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    REQUIRE(sock0);
+    REQUIRE(sock1);
+
+    const std::string MSG { "hello" };
+    char buf[16];
+
+    REQUIRE(ssize_t(MSG.size()) == sock0.write_n(MSG.data(), MSG.size()));
+    REQUIRE(ssize_t(MSG.size()) == sock1.read_n(buf, MSG.size()));
+    REQUIRE(MSG == std::string(buf, MSG.size()));
+}
+
+TEST_CASE("stream_socket gather write", "[stream_socket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    char a[] = "abc", b[] = "defg";
+    std::vector<iovec> iov {
+        iovec{ a, 3 },
+        iovec{ b, 4 }
+    };
+
+    REQUIRE(7 == sock0.write(iov));
+
+    char buf[16];
+    REQUIRE(7 == sock1.read_n(buf, 7));
+    REQUIRE(std::string("abcdefg") == std::string(buf, 7));
+}
+
+TEST_CASE("stream_socket write_more", "[stream_socket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    REQUIRE(3 == sock0.write_more("abc", 3));
+    REQUIRE(3 == sock0.write_n("def", 3));
+
+    char buf[16];
+    REQUIRE(6 == sock1.read_n(buf, 6));
+    REQUIRE(std::string("abcdef") == std::string(buf, 6));
+}
+
+TEST_CASE("stream_socket read_spin", "[stream_socket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    const std::chrono::microseconds SPIN { 100 };
+    char buf[16];
+
+    REQUIRE(3 == sock0.write_n("abc", 3));
+    REQUIRE(3 == sock1.read_spin(buf, sizeof(buf), SPIN));
+
+    // With nothing to read, a non-blocking socket gives up after spinning
+    REQUIRE(sock1.set_non_blocking());
+    REQUIRE(-1 == sock1.read_spin(buf, sizeof(buf), SPIN));
+    REQUIRE((sock1.last_error() == EAGAIN || sock1.last_error() == EWOULDBLOCK));
+}
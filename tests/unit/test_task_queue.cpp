@@ -0,0 +1,195 @@
+// test_task_queue.cpp
+//
+// Unit tests for the `task_queue` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/task_queue.h"
+#include "sockpp/poller.h"
+#include <memory>
+#include <thread>
+#include <vector>
+#include <poll.h>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// Determines if the wakeup counter has been written.
+static bool is_signaled(const task_queue& q)
+{
+    pollfd pfd { q.event().handle(), POLLIN, 0 };
+    return ::poll(&pfd, 1, 0) == 1;
+}
+
+TEST_CASE("task_queue runs tasks in order", "[task_queue]") {
+    task_queue q;
+    REQUIRE(q);
+    REQUIRE(q.empty());
+    REQUIRE(0 == q.run_pending());
+
+    std::vector<int> ran;
+    for (int i=0; i<10; ++i)
+        q.post([&ran, i] { ran.push_back(i); });
+    REQUIRE(!q.empty());
+
+    SECTION("all at once") {
+        REQUIRE(10 == q.run_pending());
+        REQUIRE(q.empty());
+    }
+
+    SECTION("in batches") {
+        REQUIRE(4 == q.run_pending(4));
+        REQUIRE(4 == ran.size());
+        REQUIRE(6 == q.run_pending(100));
+    }
+
+    SECTION("tasks posted by a task") {
+        q.post([&q, &ran] { q.post([&ran] { ran.push_back(10); }); });
+        REQUIRE(12 == q.run_pending());
+    }
+
+    REQUIRE(q.empty());
+    REQUIRE(ran.size() >= 10);
+    for (size_t i=0; i<ran.size(); ++i)
+        REQUIRE(int(i) == ran[i]);
+}
+
+TEST_CASE("task_queue only wakes a waiting loop", "[task_queue]") {
+    task_queue q;
+    int n = 0;
+
+    // A running loop gets no wakeups
+    q.post([&n] { ++n; });
+    q.post([&n] { ++n; });
+    REQUIRE(0 == q.num_wakeups());
+    REQUIRE(!is_signaled(q));
+
+    // Can't wait with tasks in the queue
+    REQUIRE(!q.prepare_wait());
+    REQUIRE(2 == q.run_pending());
+
+    // One wakeup, however many are posted
+    REQUIRE(q.prepare_wait());
+    for (int i=0; i<5; ++i)
+        q.post([&n] { ++n; });
+
+    REQUIRE(1 == q.num_wakeups());
+    REQUIRE(is_signaled(q));
+
+    REQUIRE(5 == q.run_pending());
+    REQUIRE(!is_signaled(q));
+    REQUIRE(7 == n);
+
+    // Armed again
+    REQUIRE(q.prepare_wait());
+    q.post([&n] { ++n; });
+    REQUIRE(2 == q.num_wakeups());
+    REQUIRE(1 == q.run(milliseconds(0)));
+    REQUIRE(!is_signaled(q));
+}
+
+TEST_CASE("task_queue in a poller", "[task_queue]") {
+    task_queue q;
+    poller p;
+    REQUIRE(p.add(q.event(), EPOLLIN, 1));
+
+    bool done = false;
+    REQUIRE(q.prepare_wait());
+
+    std::thread thr([&q, &done] {
+        std::this_thread::sleep_for(milliseconds(20));
+        q.post([&done] { done = true; });
+    });
+
+    epoll_event ev;
+    int n = p.wait(&ev, 1, seconds(2));
+    thr.join();
+
+    REQUIRE(1 == n);
+    REQUIRE(1 == ev.data.u64);
+    REQUIRE(1 == q.run_pending());
+    REQUIRE(done);
+    REQUIRE(0 == p.wait(&ev, 1, milliseconds(0)));
+}
+
+TEST_CASE("task_queue with many producers", "[task_queue]") {
+    const int NPROD = 4, N = 20000;
+
+    task_queue q;
+    std::vector<int> last(NPROD, -1);
+    bool inOrder = true;
+    int total = 0;
+
+    std::vector<std::thread> prods;
+    for (int i=0; i<NPROD; ++i) {
+        prods.emplace_back([&, i] {
+            for (int j=0; j<N; ++j) {
+                q.post([&, i, j] {
+                    if (j != last[i] + 1)
+                        inOrder = false;
+                    last[i] = j;
+                    ++total;
+                });
+            }
+        });
+    }
+
+    auto deadline = steady_clock::now() + seconds(10);
+    while (total < NPROD*N && steady_clock::now() < deadline)
+        q.run(milliseconds(100));
+
+    for (auto& thr : prods)
+        thr.join();
+
+    REQUIRE(NPROD*N == total);
+    REQUIRE(inOrder);
+    REQUIRE(q.empty());
+    REQUIRE(q.num_wakeups() < uint64_t(NPROD*N));
+}
+
+TEST_CASE("task_queue discards tasks that weren't run", "[task_queue]") {
+    auto p = std::make_shared<int>(0);
+    {
+        task_queue q;
+        q.post([p] { ++*p; });
+        q.post([p] { ++*p; });
+        REQUIRE(3 == p.use_count());
+    }
+    REQUIRE(1 == p.use_count());
+    REQUIRE(0 == *p);
+}
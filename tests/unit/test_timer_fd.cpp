@@ -0,0 +1,103 @@
+// test_timer_fd.cpp
+//
+// Unit tests for the `timer_fd` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/timer_fd.h"
+#include <thread>
+
+using namespace sockpp;
+using namespace std::chrono;
+
+TEST_CASE("timer_fd one-shot", "[timer_fd]") {
+    timer_fd tmr(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    REQUIRE(tmr);
+
+    uint64_t n = 0;
+    nanoseconds left;
+
+    // Not armed
+    REQUIRE(tmr.remaining(left));
+    REQUIRE(left == nanoseconds::zero());
+    REQUIRE(!tmr.read(n));
+    REQUIRE(EAGAIN == tmr.last_error());
+
+    SECTION("relative") {
+        REQUIRE(tmr.set(milliseconds(100)));
+        REQUIRE(tmr.remaining(left));
+        REQUIRE(left > milliseconds(50));
+        REQUIRE(left <= milliseconds(100));
+
+        REQUIRE(tmr.cancel());
+        REQUIRE(tmr.remaining(left));
+        REQUIRE(left == nanoseconds::zero());
+    }
+
+    SECTION("zero delay expires right away") {
+        REQUIRE(tmr.set(nanoseconds::zero()));
+        std::this_thread::sleep_for(milliseconds(1));
+        REQUIRE(tmr.read(n));
+        REQUIRE(1 == n);
+    }
+
+    SECTION("absolute, in the past") {
+        REQUIRE(tmr.set_at(steady_clock::now() - seconds(1)));
+        REQUIRE(tmr.read(n));
+        REQUIRE(1 == n);
+    }
+}
+
+TEST_CASE("timer_fd periodic", "[timer_fd]") {
+    timer_fd tmr;
+    REQUIRE(tmr);
+
+    auto start = steady_clock::now();
+    REQUIRE(tmr.set_at(start + milliseconds(10), milliseconds(10)));
+
+    // A blocking read waits for the first one
+    uint64_t n = 0;
+    REQUIRE(tmr.read(n));
+    REQUIRE(n >= 1);
+    REQUIRE(steady_clock::now() - start >= milliseconds(10));
+
+    // Falling behind gets all the missed expirations at once
+    std::this_thread::sleep_for(milliseconds(55));
+    REQUIRE(tmr.read(n));
+    REQUIRE(n >= 5);
+}
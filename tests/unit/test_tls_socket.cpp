@@ -0,0 +1,191 @@
+// test_tls_socket.cpp
+//
+// Unit tests for the `tls_socket` and `tls_context` classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/tls_socket.h"
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace sockpp;
+
+namespace {
+
+// Creates a self-signed certificate for "localhost", returning the
+// certificate and key as PEM text.
+
+std::tuple<std::string, std::string> make_cert()
+{
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"),
+                               -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha256());
+
+    auto to_pem = [](BIO* bio) {
+        char* p;
+        long n = BIO_get_mem_data(bio, &p);
+        std::string s(p, size_t(n));
+        BIO_free(bio);
+        return s;
+    };
+
+    BIO* bio = BIO_new(BIO_s_mem());
+    PEM_write_bio_X509(bio, cert);
+    std::string certPem = to_pem(bio);
+
+    bio = BIO_new(BIO_s_mem());
+    PEM_write_bio_PrivateKey(bio, key, nullptr, nullptr, 0, nullptr, nullptr);
+    std::string keyPem = to_pem(bio);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return std::make_tuple(certPem, keyPem);
+}
+
+}
+
+TEST_CASE("tls_socket connection", "[tls]") {
+    std::string certPem, keyPem;
+    std::tie(certPem, keyPem) = make_cert();
+
+    tls_context srvCtx(tls_context::SERVER), cliCtx(tls_context::CLIENT);
+    REQUIRE(srvCtx.use_certificate(certPem, keyPem));
+    REQUIRE(cliCtx.add_ca_certificate(certPem));
+    REQUIRE(srvCtx);
+    REQUIRE(cliCtx);
+
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    tls_socket cli(cliCtx, std::move(sock0));
+    REQUIRE(cli.set_host("localhost"));
+
+    // A file to send
+    std::string data(200*1000, '\0');
+    for (size_t i=0; i<data.size(); ++i)
+        data[i] = char(i % 251);
+
+    FILE* f = std::tmpfile();
+    REQUIRE(f);
+    REQUIRE(data.size() == std::fwrite(data.data(), 1, data.size(), f));
+    std::fflush(f);
+
+    bool srvOk = false;
+    ssize_t nfile = 0, nvec = 0;
+    std::string srvGot(5, '\0');
+
+    std::thread thr([&] {
+        tls_socket srv(srvCtx, std::move(sock1));
+        if (!srv.handshake())
+            return;
+        srvOk = srv.read_n(&srvGot[0], 5) == 5;
+        nfile = srv.sendfile(fileno(f), 1000, data.size());
+        std::vector<iovec> iov {
+            iovec{ const_cast<char*>("ab"), 2 },
+            iovec{ const_cast<char*>("cde"), 3 }
+        };
+        nvec = srv.write(iov);
+        srv.close_notify();
+    });
+
+    REQUIRE(cli.handshake());
+    REQUIRE(cli.version() >= "TLSv1.2");
+    REQUIRE(!cli.cipher().empty());
+
+    REQUIRE(5 == cli.write("hello", 5));
+
+    std::string got(data.size() - 1000, '\0');
+    REQUIRE(ssize_t(got.size()) == cli.read_n(&got[0], got.size()));
+
+    char buf[8];
+    REQUIRE(5 == cli.read_n(buf, 5));
+
+    // The close_notify is the end of the stream
+    REQUIRE(0 == cli.read(buf, 1));
+    thr.join();
+    std::fclose(f);
+
+    REQUIRE(srvOk);
+    REQUIRE("hello" == srvGot);
+    REQUIRE(ssize_t(data.size() - 1000) == nfile);
+    REQUIRE(data.substr(1000) == got);
+    REQUIRE(5 == nvec);
+    REQUIRE(std::string("abcde") == std::string(buf, 5));
+}
+
+TEST_CASE("tls_socket verify failure", "[tls]") {
+    std::string certPem, keyPem;
+    std::tie(certPem, keyPem) = make_cert();
+
+    tls_context srvCtx(tls_context::SERVER), cliCtx(tls_context::CLIENT);
+    REQUIRE(srvCtx.use_certificate(certPem, keyPem));
+
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    bool srvOk = true;
+    std::thread thr([&] {
+        tls_socket srv(srvCtx, std::move(sock1));
+        srvOk = srv.handshake();
+    });
+
+    // The client doesn't trust the self-signed certificate
+    tls_socket cli(cliCtx, std::move(sock0));
+    REQUIRE(!cli.handshake());
+    REQUIRE(EPROTO == cli.last_error());
+    REQUIRE(0 != cli.ssl_error());
+
+    cli.close();
+    thr.join();
+    REQUIRE(!srvOk);
+}
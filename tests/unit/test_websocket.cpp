@@ -0,0 +1,238 @@
+// test_websocket.cpp
+//
+// Unit tests for the WebSocket framing classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/websocket.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+
+TEST_CASE("ws_frame_header encode/parse", "[websocket]") {
+    const uint8_t key[4] = { 0x11, 0x22, 0x33, 0x44 };
+
+    for (uint64_t len : { 0ULL, 125ULL, 126ULL, 65535ULL, 65536ULL, 1ULL << 40 }) {
+        for (bool masked : { false, true }) {
+            ws_frame_header hdr(ws_opcode::TEXT, len);
+            hdr.fin = !masked;
+            hdr.masked = masked;
+            if (masked)
+                std::copy(key, key+4, hdr.mask_key);
+
+            uint8_t buf[ws_frame_header::MAX_SIZE];
+            size_t n = hdr.encode(buf);
+            REQUIRE(n == hdr.size());
+
+            ws_frame_header hdr2;
+            REQUIRE(0 == ws_frame_header::parse(buf, n-1, hdr2));
+            REQUIRE(ssize_t(n) == ws_frame_header::parse(buf, n, hdr2));
+
+            REQUIRE(hdr.fin == hdr2.fin);
+            REQUIRE(ws_opcode::TEXT == hdr2.opcode);
+            REQUIRE(masked == hdr2.masked);
+            REQUIRE(len == hdr2.payload_len);
+            if (masked)
+                REQUIRE(std::equal(key, key+4, hdr2.mask_key));
+        }
+    }
+
+    // A 64-bit length with the top bit set is invalid
+    const uint8_t bad[] = { 0x82, 0x7F, 0x80, 0, 0, 0, 0, 0, 0, 1 };
+    ws_frame_header hdr;
+    REQUIRE(-1 == ws_frame_header::parse(bad, sizeof(bad), hdr));
+}
+
+TEST_CASE("ws_mask implementations", "[websocket]") {
+    const uint8_t key[4] = { 0xA5, 0x3C, 0x0F, 0x96 };
+
+    std::vector<uint8_t> data(1000);
+    for (size_t i=0; i<data.size(); ++i)
+        data[i] = uint8_t(i * 31 + 7);
+
+    REQUIRE(ws_mask_supported(ws_mask_impl::SCALAR));
+    REQUIRE(ws_mask_supported(ws_mask_best()));
+
+    for (auto impl : { ws_mask_impl::SCALAR, ws_mask_impl::SSE2,
+                       ws_mask_impl::AVX2, ws_mask_impl::AVX512 }) {
+        for (size_t n : { 0, 1, 3, 15, 16, 33, 64, 255, 256, 999 }) {
+            for (size_t pos=0; pos<4; ++pos) {
+                std::vector<uint8_t> buf(data.begin()+1, data.begin()+1+n);
+                ws_mask(impl, buf.data(), n, key, pos);
+
+                bool ok = true;
+                for (size_t i=0; i<n; ++i)
+                    ok = ok && (buf[i] == uint8_t(data[i+1] ^ key[(pos+i) & 3]));
+                REQUIRE(ok);
+
+                ws_mask(buf.data(), n, key, pos);
+                REQUIRE(std::equal(buf.begin(), buf.end(), data.begin()+1));
+            }
+        }
+    }
+}
+
+TEST_CASE("websocket messages", "[websocket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    websocket cli(sock0, websocket::CLIENT), srv(sock1, websocket::SERVER);
+    ws_message msg;
+
+    REQUIRE(cli.send_text("hello"));
+    REQUIRE(srv.recv(msg));
+    REQUIRE(ws_opcode::TEXT == msg.opcode);
+    REQUIRE("hello" == msg.data);
+
+    // A fragmented message with a ping in the middle
+    REQUIRE(cli.send(ws_opcode::BINARY, "abc", 3, false));
+    REQUIRE(cli.ping("p"));
+    REQUIRE(cli.send(ws_opcode::CONTINUATION, "", 0, false));
+    REQUIRE(cli.send(ws_opcode::CONTINUATION, "def", 3));
+    REQUIRE(srv.recv(msg));
+    REQUIRE(ws_opcode::BINARY == msg.opcode);
+    REQUIRE("abcdef" == msg.data);
+
+    // A large message from the server, after the pong
+    std::string big(300*1024, '\0');
+    for (size_t i=0; i<big.size(); ++i)
+        big[i] = char(i ^ (i >> 8));
+
+    bool sent = false;
+    std::thread thr([&] { sent = srv.send_binary(big.data(), big.size()); });
+    bool got = cli.recv(msg);
+    thr.join();
+
+    REQUIRE(sent);
+    REQUIRE(got);
+    REQUIRE(ws_opcode::BINARY == msg.opcode);
+    REQUIRE(big == msg.data);
+
+    // Closing handshake
+    REQUIRE(cli.close(websocket::CLOSE_GOING_AWAY, "bye"));
+    REQUIRE(srv.recv(msg));
+    REQUIRE(ws_opcode::CLOSE == msg.opcode);
+    REQUIRE("bye" == msg.data);
+    REQUIRE(websocket::CLOSE_GOING_AWAY == srv.close_code());
+    REQUIRE(srv.is_closed());
+
+    REQUIRE(cli.recv(msg));
+    REQUIRE(ws_opcode::CLOSE == msg.opcode);
+    REQUIRE(cli.is_closed());
+}
+
+TEST_CASE("websocket concurrent send and recv", "[websocket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    websocket cli(sock0, websocket::CLIENT), srv(sock1, websocket::SERVER);
+    const int N = 2000;
+
+    // The client's reader answers pings while its main thread sends, so
+    // the pongs have to go out between the messages, not into them.
+    bool cliClosed = false;
+    std::thread cliReader([&] {
+        ws_message msg;
+        while (cli.recv(msg)) {
+            if (msg.opcode == ws_opcode::CLOSE) {
+                cliClosed = true;
+                break;
+            }
+        }
+    });
+
+    std::thread srvPinger([&] {
+        for (int i=0; i<N && srv.ping("ping"); ++i)
+            ;
+    });
+
+    std::vector<std::string> got;
+    std::thread srvReader([&] {
+        ws_message msg;
+        while (srv.recv(msg) && msg.opcode != ws_opcode::CLOSE)
+            got.push_back(msg.data);
+    });
+
+    bool sentAll = true;
+    for (int i=0; i<N; ++i)
+        sentAll = cli.send_text("message " + std::to_string(i)) && sentAll;
+
+    srvPinger.join();
+    REQUIRE(cli.close());
+    srvReader.join();
+    cliReader.join();
+
+    REQUIRE(sentAll);
+    REQUIRE(cliClosed);
+    REQUIRE(got.size() == size_t(N));
+    for (int i=0; i<N; ++i)
+        REQUIRE(got[i] == "message " + std::to_string(i));
+}
+
+TEST_CASE("websocket protocol errors", "[websocket]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+
+    websocket srv(sock1, websocket::SERVER);
+    ws_message msg;
+
+    // An unmasked frame from the client
+    const uint8_t frame[] = { 0x81, 0x02, 'h', 'i' };
+    REQUIRE(sizeof(frame) == sock0.write(frame, sizeof(frame)));
+
+    REQUIRE(!srv.recv(msg));
+    REQUIRE(websocket::CLOSE_PROTOCOL_ERROR == srv.close_code());
+
+    // The server sent a close with the error status
+    uint8_t buf[4];
+    REQUIRE(4 == sock0.read_n(buf, 4));
+    REQUIRE(0x88 == buf[0]);
+    REQUIRE(2 == buf[1]);
+    REQUIRE(websocket::CLOSE_PROTOCOL_ERROR == ((buf[2] << 8) | buf[3]));
+
+    // A message that's too big
+    stream_socket sock2, sock3;
+    std::tie(sock2, sock3) = stream_socket::pair();
+    websocket cli2(sock2, websocket::CLIENT), srv2(sock3, websocket::SERVER, 8);
+
+    REQUIRE(cli2.send_text("0123456789"));
+    REQUIRE(!srv2.recv(msg));
+    REQUIRE(websocket::CLOSE_TOO_BIG == srv2.close_code());
+}
@@ -0,0 +1,237 @@
+// test_write_queue.cpp
+//
+// Unit tests for the `write_queue` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2/catch.hpp"
+#include "sockpp/write_queue.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sockpp;
+
+TEST_CASE("write_queue single thread", "[write_queue]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+    REQUIRE(sock1);
+
+    write_queue que(sock0, 16);
+
+    REQUIRE(que.empty());
+    REQUIRE(!que.over_watermark());
+
+    REQUIRE(5 == que.push("hello", 5));
+    REQUIRE(5 == que.push(std::string()));
+    REQUIRE(11 == que.push(std::string(" world")));
+    REQUIRE(11 == que.size());
+    REQUIRE(!que.over_watermark());
+
+    que.push(std::string("!!!!!"));
+    REQUIRE(que.over_watermark());
+
+    REQUIRE(16 == que.flush());
+    REQUIRE(que.empty());
+    REQUIRE(0 == que.flush());
+
+    char buf[32];
+    REQUIRE(16 == sock1.read_n(buf, 16));
+    REQUIRE(std::string("hello world!!!!!") == std::string(buf, 16));
+}
+
+TEST_CASE("write_queue watermarks", "[write_queue]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    write_queue que(sock0);
+    que.set_watermarks(16, 4);
+
+    REQUIRE(16 == que.high_watermark());
+    REQUIRE(4 == que.low_watermark());
+
+    int nwritable = 0;
+    que.on_writable([&nwritable] { ++nwritable; });
+
+    // Below the high watermark, no notification
+    que.push(std::string(8, 'a'));
+    REQUIRE(8 == que.flush());
+    REQUIRE(0 == nwritable);
+
+    // Over, then drained: one notification
+    que.push(std::string(20, 'b'));
+    REQUIRE(que.over_watermark());
+    REQUIRE(20 == que.flush());
+    REQUIRE(1 == nwritable);
+
+    REQUIRE(0 == que.flush());
+    REQUIRE(1 == nwritable);
+}
+
+// A producer that crosses the high watermark while a flush is blocked in
+// the middle of a write still gets its wakeup from that flush.
+
+TEST_CASE("write_queue crossing the watermark during a flush", "[write_queue]") {
+    const size_t HI_WATER = 64*1024;
+
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    // Fill the kernel buffers, so that the flush blocks
+    char buf[4096] = { 0 };
+    size_t nfill = 0;
+    REQUIRE(sock0.set_non_blocking());
+    ssize_t n;
+    while ((n = sock0.write(buf, sizeof(buf))) > 0)
+        nfill += size_t(n);
+    REQUIRE(sock0.set_non_blocking(false));
+
+    write_queue que(sock0, HI_WATER);
+    std::atomic<int> nwritable { 0 };
+    que.on_writable([&nwritable] { ++nwritable; });
+
+    que.push(std::string(HI_WATER - 4096, 'a'));
+    REQUIRE(!que.over_watermark());
+
+    ssize_t nflush = 0;
+    std::thread owner([&que, &nflush] { nflush = que.flush(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(que.push(std::string(8192, 'b')) >= HI_WATER);
+    REQUIRE(que.over_watermark());
+
+    const size_t NTOTAL = nfill + HI_WATER + 4096;
+    size_t nread = 0;
+    while (nread < NTOTAL && (n = sock1.read(buf, sizeof(buf))) > 0)
+        nread += size_t(n);
+
+    owner.join();
+
+    REQUIRE(NTOTAL == nread);
+    REQUIRE(ssize_t(HI_WATER + 4096) == nflush);
+    REQUIRE(que.empty());
+    REQUIRE(1 == nwritable);
+}
+
+TEST_CASE("write_queue non-blocking", "[write_queue]") {
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+    REQUIRE(sock0.set_non_blocking());
+
+    // Fill the kernel buffers until the socket would block
+    char buf[4096] = { 0 };
+    while (sock0.write(buf, sizeof(buf)) > 0)
+        ;
+    REQUIRE((sock0.last_error() == EAGAIN || sock0.last_error() == EWOULDBLOCK));
+
+    write_queue que(sock0);
+    que.push(std::string(100, 'x'));
+
+    REQUIRE(0 == que.flush());
+    REQUIRE(100 == que.size());
+
+    // Drain the peer, then the queue should go out
+    REQUIRE(sock1.set_non_blocking());
+    while (sock1.read(buf, sizeof(buf)) > 0)
+        ;
+
+    while (!que.empty())
+        REQUIRE(que.flush() >= 0);
+}
+
+// Each producer writes fixed-size records tagged with its ID and a
+// sequence number. If the owner ever interleaved partial writes, the
+// reader would see a torn record.
+
+TEST_CASE("write_queue multiple producers", "[write_queue]") {
+    const int NPROD = 4, NMSG = 2000;
+    const size_t REC_SZ = 2*sizeof(int);
+
+    stream_socket sock0, sock1;
+    std::tie(sock0, sock1) = stream_socket::pair();
+    REQUIRE(sock0);
+
+    write_queue que(sock0);
+
+    std::vector<int> next(NPROD, 0);
+
+    std::thread rdr([&] {
+        int rec[2];
+        for (int i=0; i<NPROD*NMSG; ++i) {
+            if (sock1.read_n(rec, REC_SZ) != ssize_t(REC_SZ))
+                break;
+            if (rec[0] >= 0 && rec[0] < NPROD && rec[1] == next[rec[0]])
+                ++next[rec[0]];
+        }
+    });
+
+    std::atomic<int> nrunning { NPROD };
+    std::vector<std::thread> prods;
+
+    for (int id=0; id<NPROD; ++id) {
+        prods.emplace_back([&que, &nrunning, id] {
+            for (int i=0; i<NMSG; ++i) {
+                int rec[2] = { id, i };
+                que.push(rec, sizeof(rec));
+            }
+            --nrunning;
+        });
+    }
+
+    // The owner flushes concurrently with the producers
+    bool ok = true;
+    while (nrunning > 0 || !que.empty()) {
+        if (que.flush() < 0) {
+            ok = false;
+            break;
+        }
+    }
+
+    for (auto& thr : prods)
+        thr.join();
+    rdr.join();
+
+    REQUIRE(ok);
+    for (int i=0; i<NPROD; ++i)
+        REQUIRE(NMSG == next[i]);
+}